@@ -0,0 +1,39 @@
+# Use an installed Google Benchmark if there is one
+find_package(benchmark QUIET)
+if(benchmark_FOUND)
+    return()
+endif()
+
+# Download and unpack Google Benchmark at configure time
+configure_file(
+    ${CMAKE_SOURCE_DIR}/cmake/CMakeListsGoogleBenchmark.txt.in
+    ${CMAKE_BINARY_DIR}/googlebenchmark-download/CMakeLists.txt
+)
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -G ${CMAKE_GENERATOR} .
+    RESULT_VARIABLE result
+    WORKING_DIRECTORY ${CMAKE_BINARY_DIR}/googlebenchmark-download
+)
+if(result)
+    message(FATAL_ERROR "CMake step for Google Benchmark failed: ${result}")
+endif()
+execute_process(
+    COMMAND ${CMAKE_COMMAND} --build .
+    RESULT_VARIABLE result
+    WORKING_DIRECTORY ${CMAKE_BINARY_DIR}/googlebenchmark-download
+)
+if(result)
+    message(FATAL_ERROR "Build step for Google Benchmark failed: ${result}")
+endif()
+
+# Only the library is needed, not its own tests
+set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+
+# Add Google Benchmark directly to our build and define the
+# benchmark::benchmark and benchmark::benchmark_main targets
+add_subdirectory(
+    ${CMAKE_BINARY_DIR}/googlebenchmark-source
+    ${CMAKE_BINARY_DIR}/googlebenchmark-build
+    EXCLUDE_FROM_ALL
+)
@@ -114,6 +114,87 @@ def _fastq_tests(executables):
             ])
 
 
+# Boxes defined by ISO/IEC 23092-1 that Genie writes, and the ones among them
+# that contain further boxes
+_mgg_box_keys = {
+    'flhd', 'dgcn', 'dghd', 'rfgn', 'rfmd', 'labl', 'lbll', 'dgmd', 'dgpr',
+    'dtcn', 'dthd', 'dtmd', 'dtpr', 'pars', 'mitb', 'dmtl', 'dmtb', 'aucn',
+    'auhd', 'auin', 'aupr', 'dscn', 'dshd', 'dspr',
+}
+_mgg_container_keys = {'dgcn', 'dtcn', 'aucn'}
+
+
+def _collect_mgg_boxes(data, begin, end, keys):
+    position = begin
+    while position + 12 <= end:
+        key = data[position:position + 4].decode('ascii', errors='replace')
+        size = int.from_bytes(data[position + 4:position + 12], 'big')
+        if size < 12 or position + size > end:
+            break
+        keys.append(key)
+        if key in _mgg_container_keys:
+            _collect_mgg_boxes(data, position + 12, position + size, keys)
+        if key not in _mgg_box_keys:
+            # Payload that is not a box, e.g. the blocks of an access unit
+            break
+        position += size
+
+
+def _mgg_boxes(mgg_file):
+    with open(mgg_file, 'rb') as f:
+        data = f.read()
+    keys = []
+    _collect_mgg_boxes(data, 0, len(data), keys)
+    return keys
+
+
+def _capsulator_tests(executables):
+    git_root = _get_git_root()
+
+    fastq_file = os.path.join(git_root, "data/fastq/fourteen-records.fastq")
+
+    for build_type in executables:
+        executable = executables[build_type]
+        log.info('executable: {}'.format(executable))
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            mgb_file = os.path.join(tmp_dir, 'fourteen-records.mgb')
+            mgg_file = os.path.join(tmp_dir, 'fourteen-records.mgg')
+            subprocess.run([
+                executable,
+                'run',
+                '--force',
+                '--low-latency',
+                '--input-file', fastq_file,
+                '--output-file', mgb_file
+            ], check=True)
+
+            # The low-latency encoder puts access unit statistics into the
+            # json sidecar, but the aust box holding them is not part of MPEG-G
+            subprocess.run([
+                executable,
+                'capsulate',
+                '--force',
+                '--input-file', mgb_file,
+                '--output-file', mgg_file
+            ], check=True)
+            keys = _mgg_boxes(mgg_file)
+            if 'aucn' not in keys:
+                raise InternalError('no access unit found in ' + mgg_file)
+            if 'aust' in keys:
+                raise InternalError('default capsulator output contains aust')
+
+            subprocess.run([
+                executable,
+                'capsulate',
+                '--force',
+                '--au-statistics',
+                '--input-file', mgb_file,
+                '--output-file', mgg_file
+            ], check=True)
+            if 'aust' not in _mgg_boxes(mgg_file):
+                raise InternalError('--au-statistics did not write aust')
+
+
 def main():
     # Basic log config
     format_string = '[%(asctime)s] [%(filename)20s:%(funcName)-20s] [%(levelname)-8s] --- %(message)s'
@@ -178,6 +259,7 @@ def main():
 
         # Test
         # _fastq_tests(executables=executables)
+        _capsulator_tests(executables=executables)
 
         # Clean
         _clean()
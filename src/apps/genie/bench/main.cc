@@ -0,0 +1,354 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#define NOMINMAX  // NOLINT
+
+#include "apps/genie/bench/main.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <filesystem>  // NOLINT
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "apps/genie/bench/program_options.h"
+#include "apps/genie/run/main.h"
+#include "apps/genie/run/program_options.h"
+#include "genie/core/stats/metric_registry.h"
+#include "genie/core/stats/perf_stats.h"
+#include "genie/core/stats/stage_timer.h"
+#include "genie/util/runtime_exception.h"
+#include "genie/util/stop_watch.h"
+#include "nlohmann/json.hpp"
+#include "util/log.h"
+
+constexpr auto kLogModuleName = "App/Bench";
+
+// -----------------------------------------------------------------------------
+
+namespace genie_app::bench {
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/**
+ * @brief CPU time consumed by the process so far.
+ * @return User plus system time in seconds, 0 if not available.
+ */
+double CpuTime() {
+#ifndef _WIN32
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+         static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) /
+             1e6;
+#else
+  return 0;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Restarts tracking of the peak memory, so every run reports its own.
+ */
+void ResetPeakRss() {
+#ifdef __linux__
+  std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Peak resident set size since the last ResetPeakRss().
+ * @return Size in bytes, 0 if not available.
+ */
+uint64_t PeakRss() {
+#ifdef __linux__
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind("VmHWM:", 0) == 0) {
+      return std::stoull(line.substr(6)) * 1024;
+    }
+  }
+#endif
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Combined size of some files.
+ * @param files Paths, empty ones are skipped.
+ * @return Size in bytes.
+ */
+uint64_t FileSize(const std::vector<std::string>& files) {
+  uint64_t ret = 0;
+  for (const auto& f : files) {
+    if (!f.empty() && std::filesystem::exists(f)) {
+      ret += std::filesystem::file_size(f);
+    }
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Paths of one encode / decode round trip.
+ */
+struct Files {
+  std::string input;        //!< @brief Original input.
+  std::string input_sup;    //!< @brief Paired original input.
+  std::string encoded;      //!< @brief MPEG-G bitstream.
+  std::string decoded;      //!< @brief Decoded file.
+  std::string decoded_sup;  //!< @brief Paired decoded file.
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Builds the options of one genie run.
+ * @param opts Benchmark options.
+ * @param input Input file.
+ * @param input_sup Paired input file, may be empty.
+ * @param output Output file.
+ * @param output_sup Paired output file, may be empty.
+ * @param threads Number of threads.
+ * @return Options as if given on the command line of genie run.
+ */
+run::ProgramOptions RunOptions(const ProgramOptions& opts,
+                               const std::string& input,
+                               const std::string& input_sup,
+                               const std::string& output,
+                               const std::string& output_sup,
+                               const size_t threads) {
+  std::vector<std::string> args = {"run",
+                                   "-i",
+                                   input,
+                                   "-o",
+                                   output,
+                                   "-w",
+                                   opts.working_directory_,
+                                   "-t",
+                                   std::to_string(threads),
+                                   "-f",
+                                   "--qv",
+                                   opts.qv_mode_,
+                                   "--read-ids",
+                                   opts.read_name_mode_,
+                                   "--entropy",
+                                   opts.entropy_mode_};
+  if (!input_sup.empty()) {
+    args.insert(args.end(), {"-j", input_sup});
+  }
+  if (!output_sup.empty()) {
+    args.insert(args.end(), {"-u", output_sup});
+  }
+  if (!opts.input_ref_file_.empty()) {
+    args.insert(args.end(), {"-r", opts.input_ref_file_});
+  }
+  if (opts.low_latency_) {
+    args.emplace_back("--low-latency");
+  }
+  std::vector<char*> argv;
+  argv.reserve(args.size());
+  for (auto& a : args) {
+    argv.push_back(a.data());
+  }
+  return {static_cast<int>(argv.size()), argv.data()};
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Runs one pipeline and measures it.
+ * @param encode Encode if true, decode otherwise.
+ * @param run_opts Pipeline options.
+ * @param threads Number of threads.
+ * @param inputs Files read.
+ * @param outputs Files written.
+ * @return JSON object describing the run.
+ */
+nlohmann::json Measure(const bool encode, const run::ProgramOptions& run_opts,
+                       const size_t threads,
+                       const std::vector<std::string>& inputs,
+                       const std::vector<std::string>& outputs) {
+  using genie::core::stats::StageTimer;
+  std::unique_ptr<genie::core::FlowGraph> flow;
+  std::vector<std::unique_ptr<std::istream>> input_files;
+  std::vector<std::unique_ptr<std::ostream>> output_files;
+  flow = encode ? run::BuildEncoder(run_opts, input_files, output_files)
+                : run::BuildDecoder(run_opts, input_files, output_files);
+
+  StageTimer::Reset();
+  ResetPeakRss();
+  const double cpu_start = CpuTime();
+  const genie::util::Watch watch;
+  flow->Run();
+  const double wall = watch.Check();
+  const double cpu = CpuTime() - cpu_start;
+  const uint64_t peak_rss = PeakRss();
+  const auto stage_times = StageTimer::Collect();
+
+  const auto stats = flow->GetStats();
+  const auto* reads_stat =
+      stats.Get(genie::core::stats::Intern("count-reads"));
+  const int64_t reads = reads_stat ? reads_stat->sum.i_data : 0;
+
+  // Close all files before measuring the output
+  flow.reset();
+  output_files.clear();
+  input_files.clear();
+
+  const auto input_size = FileSize(inputs);
+  // Thread-seconds available: the workers plus the writer thread of the
+  // exporter's ReorderBuffer, which runs the export stage
+  const double thread_time = wall * static_cast<double>(threads + 1);
+  nlohmann::json ret;
+  ret["operation"] = encode ? "encode" : "decode";
+  ret["threads"] = threads;
+  ret["thread-budget"] = thread_time;
+  ret["wall-time"] = wall;
+  ret["cpu-time"] = cpu;
+  ret["cpu-utilization"] = wall > 0 ? cpu / thread_time : 0.0;
+  ret["reads"] = reads;
+  ret["reads-per-second"] = wall > 0 ? static_cast<double>(reads) / wall : 0.0;
+  ret["input-size"] = input_size;
+  ret["input-bytes-per-second"] =
+      wall > 0 ? static_cast<double>(input_size) / wall : 0.0;
+  ret["output-size"] = FileSize(outputs);
+  ret["peak-rss"] = peak_rss;
+
+  // Busy: exclusive thread-seconds in the stage. Idle: thread-seconds of the
+  // run the stage was not running.
+  double busy_total = 0;
+  nlohmann::json stages = nlohmann::json::object();
+  for (size_t i = 0; i < genie::core::stats::kNumStages; ++i) {
+    const auto& t = stage_times[i];
+    busy_total += t.busy;
+    stages[genie::core::stats::GetStageName(
+        static_cast<genie::core::stats::Stage>(i))] = {
+        {"busy", t.busy},
+        {"idle", std::max(thread_time - t.busy, 0.0)},
+        {"calls", t.calls}};
+  }
+  ret["stages"] = stages;
+  ret["idle"] = std::max(thread_time - busy_total, 0.0);
+
+  UTILS_LOG(genie::util::Logger::Severity::INFO,
+            std::string(encode ? "Encoded" : "Decoded") + " with " +
+                std::to_string(threads) + " threads in " +
+                std::to_string(wall) + "s, " +
+                std::to_string(static_cast<int64_t>(
+                    wall > 0 ? static_cast<double>(reads) / wall : 0)) +
+                " reads/s");
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Thread counts to measure.
+ * @param max Largest count.
+ * @return Powers of two below max, then max.
+ */
+std::vector<size_t> ThreadCounts(const size_t max) {
+  std::vector<size_t> ret;
+  for (size_t t = 1; t < max; t *= 2) {
+    ret.push_back(t);
+  }
+  ret.push_back(max);
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+  try {
+    const ProgramOptions opts(argc, argv);
+    if (opts.help_) {
+      return 0;
+    }
+    genie::core::stats::PerfStats::SetEnabled(true);
+
+    const auto ext = run::file_extension(opts.input_file_);
+    const std::string prefix = opts.working_directory_ + "/genie-bench";
+    Files files{opts.input_file_, opts.input_sup_file_, prefix + ".mgb",
+                prefix + "-decoded." + ext, ""};
+    if (!opts.input_sup_file_.empty()) {
+      files.decoded_sup = prefix + "-decoded-2." + ext;
+    }
+
+    nlohmann::json report;
+    report["input"] = opts.input_file_;
+    report["input-suppl"] = opts.input_sup_file_;
+    report["hardware-threads"] = std::thread::hardware_concurrency();
+    report["runs"] = nlohmann::json::array();
+    for (const auto threads : ThreadCounts(opts.max_threads_)) {
+      for (size_t rep = 0; rep < opts.repetitions_; ++rep) {
+        auto encoded = Measure(
+            true,
+            RunOptions(opts, files.input, files.input_sup, files.encoded, "",
+                       threads),
+            threads, {files.input, files.input_sup}, {files.encoded});
+        encoded["repetition"] = rep;
+        report["runs"].push_back(std::move(encoded));
+
+        auto decoded = Measure(
+            false,
+            RunOptions(opts, files.encoded, "", files.decoded,
+                       files.decoded_sup, threads),
+            threads, {files.encoded}, {files.decoded, files.decoded_sup});
+        decoded["repetition"] = rep;
+        report["runs"].push_back(std::move(decoded));
+      }
+    }
+
+    for (const auto& f : {files.encoded, files.encoded + ".unsupported.mgrec",
+                          files.decoded, files.decoded_sup}) {
+      std::error_code ec;
+      std::filesystem::remove(f, ec);
+    }
+
+    std::ofstream file;
+    if (!opts.report_file_.empty()) {
+      file.open(opts.report_file_);
+      UTILS_DIE_IF(!file, "Could not open report file " + opts.report_file_);
+    }
+    std::ostream& stream = file.is_open() ? file : std::cout;
+    stream << report.dump(4) << std::endl;
+    return 0;
+  } catch (std::exception& e) {
+    UTILS_LOG(genie::util::Logger::Severity::ERROR, e.what());
+    return 1;
+  } catch (...) {
+    UTILS_LOG(genie::util::Logger::Severity::ERROR, "Unknown error");
+    return 1;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie_app::bench
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
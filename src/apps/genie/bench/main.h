@@ -0,0 +1,33 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#ifndef SRC_APPS_GENIE_BENCH_MAIN_H_
+#define SRC_APPS_GENIE_BENCH_MAIN_H_
+
+// -----------------------------------------------------------------------------
+
+namespace genie_app::bench {
+
+/**
+ * @brief Encodes and decodes a file at increasing thread counts and reports
+ * throughput and per stage busy time as JSON.
+ * @param argc
+ * @param argv
+ * @return
+ */
+int main(int argc, char* argv[]);
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie_app::bench
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_APPS_GENIE_BENCH_MAIN_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
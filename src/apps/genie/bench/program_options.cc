@@ -0,0 +1,126 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "apps/genie/bench/program_options.h"
+
+#include <algorithm>
+#include <filesystem>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+
+#include "apps/genie/run/main.h"
+#include "cli11/CLI11.hpp"
+#include "genie/util/runtime_exception.h"
+#include "util/log.h"
+
+// -----------------------------------------------------------------------------
+
+constexpr auto kLogModuleName = "App/Bench";
+
+namespace genie_app::bench {
+
+// -----------------------------------------------------------------------------
+
+ProgramOptions::ProgramOptions(const int argc, char* argv[]) : help_(false) {
+  CLI::App app(
+      "Genie end-to-end benchmark\n"
+      "Encodes and decodes the input at 1, 2, 4, ... threads and \n"
+      "reports time, CPU utilization, busy time per pipeline \n"
+      "stage and peak memory as JSON.\n");
+
+  app.add_option("-i,--input-file", input_file_,
+                 "Input file (fastq, sam or mgrec)\n")
+      ->mandatory(true);
+
+  input_sup_file_ = "";
+  app.add_option("-j,--input-suppl-file", input_sup_file_,
+                 "Paired input fastq file\n");
+
+  input_ref_file_ = "";
+  app.add_option("-r,--input-ref-file", input_ref_file_,
+                 "Path to a reference fasta file.\n");
+
+  working_directory_ = std::filesystem::temp_directory_path().string();
+  app.add_option("-w,--working-dir", working_directory_,
+                 "Directory for the encoded and decoded \nfiles, which are "
+                 "overwritten by every \nrun. Defaults to the temporary "
+                 "\ndirectory of the system.\n");
+
+  report_file_ = "";
+  app.add_option("-o,--report-file", report_file_,
+                 "File to write the JSON report to. If no \npath is "
+                 "provided, stdout is used. Log \noutput goes to stderr.\n");
+
+  qv_mode_ = "lossless";
+  app.add_option("--qv", qv_mode_, "Quality value mode, see genie run.\n");
+
+  read_name_mode_ = "lossless";
+  app.add_option("--read-ids", read_name_mode_,
+                 "Read name mode, see genie run.\n");
+
+  entropy_mode_ = "zstd";
+  app.add_option("--entropy", entropy_mode_,
+                 "Entropy codec, see genie run.\n");
+
+  low_latency_ = false;
+  app.add_flag("--low-latency", low_latency_,
+               "Low latency mode, see genie run.\n");
+
+  max_threads_ = std::max(std::thread::hardware_concurrency(), 1u);
+  app.add_option("-t,--threads", max_threads_,
+                 "Largest number of threads. Powers of two \nbelow it and "
+                 "the number itself are \nmeasured.\n");
+
+  repetitions_ = 1;
+  app.add_option("--repetitions", repetitions_,
+                 "Runs per thread count (default 1).\n");
+
+  try {
+    app.parse(argc, argv);
+    while (working_directory_.size() > 1 && working_directory_.back() == '/') {
+      working_directory_.pop_back();
+    }
+  } catch (const CLI::CallForHelp&) {
+    UTILS_LOG(genie::util::Logger::Severity::ERROR, app.help());
+    help_ = true;
+    return;
+  } catch (const CLI::ParseError& e) {
+    UTILS_DIE("Command line parsing failed:" + std::to_string(app.exit(e)));
+  }
+
+  validate();
+}
+
+// -----------------------------------------------------------------------------
+
+void ProgramOptions::validate() const {
+  const auto ext = run::file_extension(input_file_);
+  UTILS_DIE_IF(ext != "fastq" && ext != "sam" && ext != "mgrec",
+               "Benchmark input must be fastq, sam or mgrec: " + input_file_);
+  UTILS_DIE_IF(!std::filesystem::exists(input_file_),
+               "Input file does not exist: " + input_file_);
+  UTILS_DIE_IF(!input_sup_file_.empty() &&
+                   !std::filesystem::exists(input_sup_file_),
+               "Input file does not exist: " + input_sup_file_);
+  UTILS_DIE_IF(!std::filesystem::is_directory(working_directory_),
+               "Working directory does not exist: " + working_directory_);
+  const auto hardware_threads = std::thread::hardware_concurrency();
+  UTILS_DIE_IF(max_threads_ == 0 ||
+                   (hardware_threads && max_threads_ > hardware_threads),
+               "Invalid number of threads: " + std::to_string(max_threads_) +
+                   ". Your system supports between 1 and " +
+                   std::to_string(hardware_threads) +
+                   " threads.");
+  UTILS_DIE_IF(repetitions_ == 0, "At least one repetition is required");
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie_app::bench
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
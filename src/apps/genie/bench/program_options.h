@@ -0,0 +1,64 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#ifndef SRC_APPS_GENIE_BENCH_PROGRAM_OPTIONS_H_
+#define SRC_APPS_GENIE_BENCH_PROGRAM_OPTIONS_H_
+
+// -----------------------------------------------------------------------------
+
+#include <string>
+
+// -----------------------------------------------------------------------------
+
+namespace genie_app::bench {
+
+/**
+ * @brief Options of the end-to-end benchmark.
+ */
+class ProgramOptions {
+ public:
+  /**
+   * @brief
+   * @param argc
+   * @param argv
+   */
+  ProgramOptions(int argc, char* argv[]);
+
+  std::string input_file_;      //!< @brief fastq, sam or mgrec
+  std::string input_sup_file_;  //!< @brief Paired fastq file
+  std::string input_ref_file_;  //!< @brief Reference fasta file
+
+  std::string working_directory_;  //!< @brief Encoded and decoded files
+  std::string report_file_;        //!< @brief JSON report, stderr if empty
+
+  std::string qv_mode_;         //!< @brief As in genie run
+  std::string read_name_mode_;  //!< @brief As in genie run
+  std::string entropy_mode_;    //!< @brief As in genie run
+  bool low_latency_;            //!< @brief As in genie run
+
+  size_t max_threads_;  //!< @brief Largest thread count measured
+  size_t repetitions_;  //!< @brief Runs per thread count
+
+  bool help_;  //!< @brief
+
+ private:
+  /**
+   * @brief
+   */
+  void validate() const;
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie_app::bench
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_APPS_GENIE_BENCH_PROGRAM_OPTIONS_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
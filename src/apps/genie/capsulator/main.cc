@@ -39,7 +39,8 @@ void encapsulate(ProgramOptions& options) {
 
   auto inputs = genie::util::Tokenize(options.input_file_, ';');
   auto input_file =
-      genie::format::mgg::encapsulator::EncapsulatedFile(inputs, version);
+      genie::format::mgg::encapsulator::EncapsulatedFile(
+          inputs, version, options.au_statistics_);
   auto mgg_file = input_file.assemble(version);
 
   std::ofstream output_stream(options.output_file_);
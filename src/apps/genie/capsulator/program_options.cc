@@ -34,6 +34,11 @@ ProgramOptions::ProgramOptions(const int argc, char* argv[]) : help_(false) {
   force_overwrite_ = false;
   app.add_flag("-f,--force", force_overwrite_, "");
 
+  au_statistics_ = false;
+  app.add_flag("--au-statistics", au_statistics_,
+               "Keep the access unit statistics in private aust boxes. The "
+               "output is not MPEG-G conformant.");
+
   try {
     app.parse(argc, argv);
   } catch (const CLI::CallForHelp&) {
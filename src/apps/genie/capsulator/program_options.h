@@ -34,6 +34,8 @@ class ProgramOptions {
 
   bool force_overwrite_;  //!< @brief
 
+  bool au_statistics_;  //!< @brief Write the non-standard `aust` boxes.
+
   bool help_;  //!< @brief
 
  private:
@@ -13,6 +13,7 @@
 #include <string>
 
 #include "cli11/CLI11.hpp"
+#include "genie/bench/main.h"
 #include "genie/capsulator/main.h"
 #include "genie/gabac/main.h"
 #include "genie/module/manager.h"
@@ -45,7 +46,7 @@ int help(int, char*[]) {
   UTILS_LOG(genie::util::Logger::Severity::ERROR,
             "Usage: \ngenie <operation> <operation specific options> \n\nList "
             "of operations:\n"
-            "help\nrun\ntranscode-fastq\ntranscode-sam\n\n"
+            "help\nrun\nbench\ntranscode-fastq\ntranscode-sam\n\n"
             "To learn more about an operation, type \"genie <operation> "
             "--help\".");
   return 0;
@@ -54,6 +55,14 @@ int help(int, char*[]) {
 // -----------------------------------------------------------------------------
 
 int main(const int argc, char* argv[]) {
+  constexpr int operation_index = 1;
+  std::string operation = argc > operation_index ? argv[operation_index] : "";
+  transform(operation.begin(), operation.end(), operation.begin(),
+            [](const char x) -> char { return static_cast<char>(tolower(x)); });
+  if (operation == "bench") {
+    // The bench report goes to stdout, keep it free of log lines
+    genie::util::Logger::GetInstance().SetOutputStream(&std::cerr);
+  }
   const std::string genie =
       R"(   ______           _
   / ____/__  ____  (_)__
@@ -64,15 +73,13 @@ int main(const int argc, char* argv[]) {
   PrintCmdLine(argc, argv);
   genie::module::detect();
   try {
-    constexpr int operation_index = 1;
     UTILS_DIE_IF(argc <= operation_index,
                  "No operation specified, type 'genie help' for more info.");
-    std::string operation = argv[operation_index];
-    transform(
-        operation.begin(), operation.end(), operation.begin(),
-        [](const char x) -> char { return static_cast<char>(tolower(x)); });
     if (operation == "run") {
       genie_app::run::main(argc - operation_index, argv + operation_index);
+    } else if (operation == "bench") {
+      return genie_app::bench::main(argc - operation_index,
+                                    argv + operation_index);
     } else if (operation == "stat") {
       stat(argc - operation_index, argv + operation_index);
     } else if (operation == "transcode-fasta") {
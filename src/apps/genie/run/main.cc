@@ -21,6 +21,7 @@
 #include "apps/genie/run/program_options.h"
 #include "genie/core/format_importer_null.h"
 #include "genie/core/name_encoder_none.h"
+#include "genie/core/stats/perf_stats.h"
 #include "genie/format/fasta/exporter.h"
 #include "genie/format/fasta/manager.h"
 #include "genie/format/fastq/exporter.h"
@@ -32,10 +33,9 @@
 #include "genie/format/sam/exporter.h"
 #include "genie/format/sam/importer.h"
 #include "genie/module/default_setup.h"
-#include "genie/quality/calq/encoder.h"
-#include "genie/quality/qvwriteout/encoder_none.h"
 #include "genie/read/lowlatency/encoder.h"
 #include "genie/util/stop_watch.h"
+#include "genie/util/trace.h"
 #include "genie/util/zlib/istream.h"
 #include "genie/util/zlib/ostream.h"
 #include "util/log.h"
@@ -83,7 +83,8 @@ enum class FileType { UNKNOWN = 0, MPEG = 1, THIRD_PARTY = 2 };
 // -----------------------------------------------------------------------------
 
 FileType GetType(const std::string& ext) {
-  if (ext == "mgrec" || ext == "fasta" || ext == "fastq" || ext == "sam") {
+  if (ext == "mgrec" || ext == "fasta" || ext == "fastq" || ext == "sam" ||
+      ext == "bam") {
     return FileType::THIRD_PARTY;
   }
   if (ext == "mgb") {
@@ -120,9 +121,16 @@ OperationCase GetOperation(const std::string& filename_in,
 template <class T>
 void AttachExporter(T& flow, const ProgramOptions& p_opts,
                     std::vector<std::unique_ptr<std::ostream>>& output_files) {
+  // FASTQ output is compressed by the exporter itself (BGZF, in parallel)
+  const bool fastq_out = file_extension(p_opts.output_file_) == "fastq";
+  const bool bgzf = fastq_out && is_compressed(p_opts.output_file_);
   std::ostream* file1 = &std::cout;
   if (p_opts.output_file_.substr(0, 2) != "-.") {
-    if (is_compressed(p_opts.output_file_)) {
+    if (bgzf) {
+      output_files.emplace_back(
+          std::make_unique<std::ofstream>(p_opts.output_file_,
+                                          std::ios::binary));
+    } else if (is_compressed(p_opts.output_file_)) {
       output_files.emplace_back(
           std::make_unique<genie::util::zlib::OutputStream>(
               std::make_unique<genie::util::zlib::StreamBuffer>(
@@ -133,23 +141,24 @@ void AttachExporter(T& flow, const ProgramOptions& p_opts,
     }
     file1 = output_files.back().get();
   }
-  if (file_extension(p_opts.output_file_) == "fastq") {
+  if (fastq_out) {
     if (file_extension(p_opts.output_sup_file_) == "fastq") {
-      if (is_compressed(p_opts.output_sup_file_)) {
-        output_files.emplace_back(
-            std::make_unique<genie::util::zlib::OutputStream>(
-                std::make_unique<genie::util::zlib::StreamBuffer>(
-                    p_opts.output_sup_file_, true)));
+      UTILS_DIE_IF(is_compressed(p_opts.output_sup_file_) != bgzf,
+                   "Paired FASTQ outputs must both be compressed or both "
+                   "uncompressed");
+      if (bgzf) {
+        output_files.emplace_back(std::make_unique<std::ofstream>(
+            p_opts.output_sup_file_, std::ios::binary));
       } else {
         output_files.emplace_back(
             std::make_unique<std::ofstream>(p_opts.output_sup_file_));
       }
       std::ostream* file2 = output_files.back().get();
-      flow.AddExporter(
-          std::make_unique<genie::format::fastq::Exporter>(*file1, *file2));
+      flow.AddExporter(std::make_unique<genie::format::fastq::Exporter>(
+          *file1, *file2, bgzf));
     } else {
       flow.AddExporter(
-          std::make_unique<genie::format::fastq::Exporter>(*file1));
+          std::make_unique<genie::format::fastq::Exporter>(*file1, bgzf));
     }
   } else if (file_extension(p_opts.output_file_) == "mgrec") {
     flow.AddExporter(std::make_unique<genie::format::mgrec::Exporter>(*file1));
@@ -174,20 +183,10 @@ void AddFasta(const std::string& fasta_file_path,
       "sha256";
   auto fasta_file = std::make_unique<std::ifstream>(fasta_file_path);
   UTILS_DIE_IF(!fasta_file, "Cannot open file to read: " + fasta_file_path);
-  if (!std::filesystem::exists(fai)) {
+  if (!std::filesystem::exists(fai) || !std::filesystem::exists(sha)) {
     UTILS_LOG(genie::util::Logger::Severity::INFO,
-              "Indexing " + fasta_file_path);
-    std::ofstream fai_file(fai);
-    genie::format::fasta::FastaReader::index(*fasta_file, fai_file);
-  }
-  if (!std::filesystem::exists(sha)) {
-    UTILS_LOG(genie::util::Logger::Severity::INFO,
-              "Calculating hashes " + fasta_file_path);
-    std::ofstream sha_file(sha);
-    std::ifstream fai_file(fai);
-    UTILS_DIE_IF(!fai_file, "Cannot open file to read: " + fai);
-    genie::format::fasta::FaiFile fai_reader(fai_file);
-    genie::format::fasta::FastaReader::hash(fai_reader, *fasta_file, sha_file);
+              "Indexing and hashing " + fasta_file_path);
+    genie::format::fasta::FastaReader::IndexAndHash(fasta_file_path, fai, sha);
   }
   auto fai_file = std::make_unique<std::ifstream>(fai);
   UTILS_DIE_IF(!fai_file, "Cannot open file to read: " + fai);
@@ -230,63 +229,56 @@ void AttachImporterMgrec(
 
 // -----------------------------------------------------------------------------
 
+std::istream* OpenFastq(
+    const std::string& path,
+    std::vector<std::unique_ptr<std::istream>>& input_files) {
+  if (path.substr(0, 2) == "-.") {
+    return &std::cin;
+  }
+  if (is_compressed(path)) {
+    input_files.emplace_back(std::make_unique<genie::util::zlib::InputStream>(
+        std::make_unique<genie::util::zlib::StreamBuffer>(path, false)));
+  } else {
+    input_files.emplace_back(std::make_unique<std::ifstream>(path));
+  }
+  UTILS_DIE_IF(!input_files.back(), "Cannot open file to read: " + path);
+  return input_files.back().get();
+}
+
+// -----------------------------------------------------------------------------
+
 template <class T>
 void AttachImporterFastq(
     T& flow, const ProgramOptions& p_opts,
-    std::vector<std::unique_ptr<std::istream>>& input_files,
-    const bool compressed) {
+    std::vector<std::unique_ptr<std::istream>>& input_files) {
   constexpr size_t block_size = 256000;
-  std::istream* file1 = &std::cin;
-  if (p_opts.input_file_.substr(0, 2) != "-.") {
-    if (compressed) {
-      input_files.emplace_back(std::make_unique<genie::util::zlib::InputStream>(
-          std::make_unique<genie::util::zlib::StreamBuffer>(p_opts.input_file_,
-                                                            false)));
-    } else {
-      input_files.emplace_back(
-          std::make_unique<std::ifstream>(p_opts.input_file_));
-    }
-    UTILS_DIE_IF(!input_files.back(),
-                 "Cannot open file to read: " + p_opts.input_file_);
-    file1 = input_files.back().get();
-  }
+  // One entry per lane, each with one file or a pair
+  std::vector<std::vector<std::istream*>> lanes(
+      1 + p_opts.input_lane_files_.size());
+  lanes.front().push_back(OpenFastq(p_opts.input_file_, input_files));
   if (file_extension(p_opts.input_sup_file_) == "fastq") {
-    std::istream* file2 = &std::cin;
-    if (p_opts.input_sup_file_.substr(0, 2) != "-.") {
-      if (compressed) {
-        input_files.emplace_back(
-            std::make_unique<genie::util::zlib::InputStream>(
-                std::make_unique<genie::util::zlib::StreamBuffer>(
-                    p_opts.input_sup_file_, false)));
-      } else {
-        input_files.emplace_back(
-            std::make_unique<std::ifstream>(p_opts.input_sup_file_));
-      }
-      UTILS_DIE_IF(!input_files.back(),
-                   "Cannot open file to read: " + p_opts.input_sup_file_);
-      file2 = input_files.back().get();
+    lanes.front().push_back(OpenFastq(p_opts.input_sup_file_, input_files));
+  }
+  for (size_t i = 0; i < p_opts.input_lane_files_.size(); ++i) {
+    lanes[i + 1].push_back(
+        OpenFastq(p_opts.input_lane_files_[i], input_files));
+    if (i < p_opts.input_sup_lane_files_.size()) {
+      lanes[i + 1].push_back(
+          OpenFastq(p_opts.input_sup_lane_files_[i], input_files));
     }
-    flow.AddImporter(std::make_unique<genie::format::fastq::Importer>(
-        block_size, *file1, *file2));
-  } else {
-    flow.AddImporter(
-        std::make_unique<genie::format::fastq::Importer>(block_size, *file1));
   }
+  flow.AddImporter(
+      std::make_unique<genie::format::fastq::Importer>(block_size, lanes));
 }
 
 template <class T>
-void AttachImporterSam(
-    T& flow, const ProgramOptions& p_opts,
-    std::vector<std::unique_ptr<std::istream>>& input_files) {
+void AttachImporterSam(T& flow, const ProgramOptions& p_opts) {
   constexpr size_t block_size = 128000;
-  // std::istream* in_ptr = &std::cin;
-  if (p_opts.input_file_.substr(0, 2) != "-.") {
-    input_files.emplace_back(
-        std::make_unique<std::ifstream>(p_opts.input_file_));
-    // in_ptr = inputFiles.back().get();
-  }
+  // htslib opens the file itself, "-.sam" / "-.bam" are read from stdin
   flow.AddImporter(std::make_unique<genie::format::sam::Importer>(
-      block_size, p_opts.input_file_, p_opts.input_ref_file_));
+      block_size, p_opts.input_file_, p_opts.input_ref_file_,
+      p_opts.number_of_threads_, p_opts.working_directory_,
+      p_opts.max_memory_ * 1024 * 1024));
 }
 
 // -----------------------------------------------------------------------------
@@ -309,7 +301,8 @@ std::unique_ptr<genie::core::FlowGraph> BuildEncoder(
   }
   auto flow = genie::module::build_default_encoder(
       p_opts.number_of_threads_, p_opts.working_directory_, block_size, mode,
-      p_opts.raw_reference_, p_opts.raw_streams_, p_opts.entropy_mode_);
+      p_opts.raw_reference_, p_opts.raw_streams_, p_opts.entropy_mode_,
+      p_opts.qv_mode_, p_opts.zstd_level_, p_opts.zstd_dictionary_aus_);
   if (file_extension(p_opts.input_file_) == "fasta") {
     AddFasta(p_opts.input_file_, flow.get(), input_files);
   } else if (!p_opts.input_ref_file_.empty()) {
@@ -328,20 +321,14 @@ std::unique_ptr<genie::core::FlowGraph> BuildEncoder(
   }
   flow->AddExporter(std::make_unique<genie::format::mgb::Exporter>(out_ptr));
   if (file_extension(p_opts.input_file_) == "fastq") {
-    AttachImporterFastq(*flow, p_opts, input_files,
-                        is_compressed(p_opts.input_file_));
-  } else if (file_extension(p_opts.input_file_) == "sam") {
-    AttachImporterSam(*flow, p_opts, input_files);
+    AttachImporterFastq(*flow, p_opts, input_files);
+  } else if (file_extension(p_opts.input_file_) == "sam" ||
+             file_extension(p_opts.input_file_) == "bam") {
+    AttachImporterSam(*flow, p_opts);
   } else {
     AttachImporterMgrec(*flow, p_opts, input_files, output_files);
   }
-  if (p_opts.qv_mode_ == "none") {
-    flow->SetQvCoder(
-        std::make_unique<genie::quality::qvwriteout::NoneEncoder>(), 0);
-  }
-  if (p_opts.qv_mode_ == "calq") {
-    flow->SetQvCoder(std::make_unique<genie::quality::calq::Encoder>(), 0);
-  }
+  flow->SetMemoryLimit(p_opts.max_memory_ * 1024 * 1024);
   if (p_opts.read_name_mode_ == "none") {
     flow->SetNameCoder(std::make_unique<genie::core::NameEncoderNone>(), 0);
   }
@@ -402,21 +389,11 @@ std::unique_ptr<genie::core::FlowGraph> BuildDecoder(
           json_uri_path.substr(0, json_uri_path.find_last_of('.') + 1) +
           "sha256";
       auto fasta_file = std::make_unique<std::ifstream>(json_uri_path);
-      if (!std::filesystem::exists(fai)) {
+      if (!std::filesystem::exists(fai) || !std::filesystem::exists(sha)) {
         UTILS_LOG(genie::util::Logger::Severity::INFO,
-                  "Indexing " + json_uri_path);
-        std::ofstream fai_file(fai);
-        genie::format::fasta::FastaReader::index(*fasta_file, fai_file);
-      }
-      if (!std::filesystem::exists(sha)) {
-        UTILS_LOG(genie::util::Logger::Severity::INFO,
-                  "Calculating hashes " + json_uri_path);
-        std::ofstream sha_file(sha);
-        std::ifstream fai_file(fai);
-        UTILS_DIE_IF(!fai_file, "Cannot open file to read: " + fai);
-        genie::format::fasta::FaiFile fai_reader(fai_file);
-        genie::format::fasta::FastaReader::hash(fai_reader, *fasta_file,
-                                                sha_file);
+                  "Indexing and hashing " + json_uri_path);
+        genie::format::fasta::FastaReader::IndexAndHash(json_uri_path, fai,
+                                                        sha);
       }
       auto fai_file = std::make_unique<std::ifstream>(fai);
       auto sha_file = std::make_unique<std::ifstream>(sha);
@@ -448,12 +425,39 @@ std::unique_ptr<genie::core::FlowGraph> BuildDecoder(
 
 // -----------------------------------------------------------------------------
 
+void WriteStats(const genie::core::stats::PerfStats& stats,
+                const ProgramOptions& p_opts) {
+  if (p_opts.stats_mode_ == "none") {
+    return;
+  }
+  if (p_opts.stats_mode_ == "log") {
+    stats.print();
+    return;
+  }
+  std::ofstream file;
+  if (!p_opts.stats_file_.empty()) {
+    file.open(p_opts.stats_file_);
+    UTILS_DIE_IF(!file, "Could not open statistics file " + p_opts.stats_file_);
+  }
+  std::ostream& stream = file.is_open() ? file : std::cerr;
+  if (p_opts.stats_mode_ == "json") {
+    stream << stats.ToJson().dump(4) << std::endl;
+  } else {
+    stats.WritePrometheus(stream);
+    stream.flush();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 int main(int argc, char* argv[]) {
   try {
     ProgramOptions p_opts(argc, argv);
     if (p_opts.help_) {
       return 0;
     }
+    genie::core::stats::PerfStats::SetEnabled(p_opts.stats_mode_ != "none");
+    genie::util::Tracer::SetEnabled(!p_opts.trace_file_.empty());
     genie::util::Watch watch;
     std::unique_ptr<genie::core::FlowGraph> flow_graph;
     std::vector<std::unique_ptr<std::istream>> input_files;
@@ -475,6 +479,13 @@ int main(int argc, char* argv[]) {
 
     flow_graph->Run();
 
+    if (!p_opts.trace_file_.empty()) {
+      std::ofstream trace_file(p_opts.trace_file_);
+      UTILS_DIE_IF(!trace_file,
+                   "Could not open trace file " + p_opts.trace_file_);
+      genie::util::Tracer::Write(trace_file);
+    }
+
     if (GetOperation(p_opts.input_file_, p_opts.output_file_) ==
         OperationCase::ENCODE) {
       std::ofstream jsonfile(p_opts.output_file_ + ".json");
@@ -485,7 +496,7 @@ int main(int argc, char* argv[]) {
 
     auto stats = flow_graph->GetStats();
     stats.AddDouble("time-wallclock", watch.Check());
-    stats.print();
+    WriteStats(stats, p_opts);
 
     return 0;
   } catch (std::exception& e) {
@@ -7,14 +7,46 @@
 
 #ifndef SRC_APPS_GENIE_RUN_MAIN_H_
 #define SRC_APPS_GENIE_RUN_MAIN_H_
+#include <istream>
+#include <memory>
+#include <ostream>
 #include <string>
+#include <vector>
+
+#include "genie/core/flow_graph.h"
 
 // -----------------------------------------------------------------------------
 
 namespace genie_app::run {
 
+class ProgramOptions;
+
 std::string file_extension(const std::string& path);
 
+/**
+ * @brief Sets up the encoding pipeline described by the options.
+ * @param p_opts Options of the run.
+ * @param input_files Receives the opened input streams.
+ * @param output_files Receives the opened output streams.
+ * @return Flow graph, ready to run.
+ */
+std::unique_ptr<genie::core::FlowGraph> BuildEncoder(
+    const ProgramOptions& p_opts,
+    std::vector<std::unique_ptr<std::istream>>& input_files,
+    std::vector<std::unique_ptr<std::ostream>>& output_files);
+
+/**
+ * @brief Sets up the decoding pipeline described by the options.
+ * @param p_opts Options of the run.
+ * @param input_files Receives the opened input streams.
+ * @param output_files Receives the opened output streams.
+ * @return Flow graph, ready to run.
+ */
+std::unique_ptr<genie::core::FlowGraph> BuildDecoder(
+    const ProgramOptions& p_opts,
+    std::vector<std::unique_ptr<std::istream>>& input_files,
+    std::vector<std::unique_ptr<std::ostream>>& output_files);
+
 /**
  * @brief
  * @param argc
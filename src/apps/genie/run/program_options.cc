@@ -58,6 +58,15 @@ ProgramOptions::ProgramOptions(const int argc, char* argv[]) : help_(false) {
   app.add_option("-j, --input-suppl-file", input_sup_file_,
                  "Paired input fastq file\n");
 
+  app.add_option("--input-lane-file", input_lane_files_,
+                 "Further fastq lane of the same sample. \n"
+                 "Repeat for every lane, all lanes are \nread in parallel "
+                 "into one output.\n");
+
+  app.add_option("--input-suppl-lane-file", input_sup_lane_files_,
+                 "Paired fastq file of each further \nlane, in the same "
+                 "order.\n");
+
   output_sup_file_ = "";
   app.add_option("-u, --output-suppl-file", output_sup_file_,
                  "Paired output fastq file\n");
@@ -94,6 +103,18 @@ ProgramOptions::ProgramOptions(const int argc, char* argv[]) : help_(false) {
                  "Which entropy codec to use. Possible values \n"
                  "are \"zstd\" (default), \"gabac\", \"lzma\", \"bsc\"\n");
 
+  zstd_level_ = 3;
+  app.add_option("--zstd-level", zstd_level_,
+                 "Compression level of the zstd entropy \ncodec, 1 to 22 "
+                 "(default 3).\n");
+
+  zstd_dictionary_aus_ = 0;
+  app.add_option("--zstd-dictionary", zstd_dictionary_aus_,
+                 "Train zstd dictionaries per descriptor \nsubsequence on "
+                 "the given number of \naccess units and use them for all "
+                 "\nfollowing ones. Helps small access \nunits, e.g. with "
+                 "--low-latency. \n0 (default) disables dictionaries.\n");
+
   force_overwrite_ = false;
   app.add_flag("-f,--force", force_overwrite_,
                "Flag, if set already existing output \n"
@@ -126,10 +147,34 @@ ProgramOptions::ProgramOptions(const int argc, char* argv[]) : help_(false) {
      kept externally for decompression),\n" " \"relevant\" (only parts of the
      reference \nneeded for decoding are encoded)\n");*/
 
+  stats_mode_ = "log";
+  app.add_option("--stats", stats_mode_,
+                 "How to report performance statistics. \nPossible values "
+                 "are \"log\" (default, \nprint sums to the log), \"json\", "
+                 "\n\"prometheus\" (text exposition format) \nand \"none\" "
+                 "(do not collect statistics).\n");
+
+  stats_file_ = "";
+  app.add_option("--stats-file", stats_file_,
+                 "File to write json or prometheus \nstatistics to. If no "
+                 "path is provided, \nstderr is used.\n");
+
+  trace_file_ = "";
+  app.add_option("--trace-file", trace_file_,
+                 "Record a timeline of the pipeline and \nwrite it to this "
+                 "file in the Chrome \ntrace format (chrome://tracing, "
+                 "\nui.perfetto.dev). Off by default.\n");
+
   number_of_threads_ = std::thread::hardware_concurrency();
   app.add_option("-t,--threads", number_of_threads_,
                  "Number of threads to use.\n");
 
+  max_memory_ = 0;
+  app.add_option("--max-memory", max_memory_,
+                 "Memory budget in MiB for records and \naccess units in "
+                 "flight while encoding. \nImporting pauses while it is "
+                 "\nexhausted. 0 (default) means no limit.\n");
+
   raw_reference_ = false;
   // Deactivated for now, as broken in connection with part 1
   /* app.add_flag("--raw-ref", rawReference,
@@ -298,6 +343,27 @@ void ProgramOptions::validate() {
               "Input file 2: " + input_sup_file_ + " with Size " +
                   size_string(std::filesystem::file_size(input_sup_file_)));
   }
+  if (!input_lane_files_.empty() || !input_sup_lane_files_.empty()) {
+    UTILS_DIE_IF(file_extension(input_file_) != "fastq",
+                 "Lanes are only supported for fastq input");
+    UTILS_DIE_IF(input_sup_lane_files_.size() !=
+                     (input_sup_file_.empty() ? 0 : input_lane_files_.size()),
+                 "Every lane needs a paired file if and only if the first "
+                 "input is paired");
+  }
+  for (auto* files : {&input_lane_files_, &input_sup_lane_files_}) {
+    for (auto& file : *files) {
+      UTILS_DIE_IF(file.substr(0, 2) == "-.",
+                   "Lanes cannot be read from stdin");
+      ValidateInputFile(file);
+      ValidatePairedFiles(input_file_, file);
+      file = std::filesystem::canonical(file).string();
+      std::replace(file.begin(), file.end(), '\\', '/');
+      UTILS_LOG(genie::util::Logger::Severity::INFO,
+                "Input lane file: " + file + " with size " +
+                    size_string(std::filesystem::file_size(file)));
+    }
+  }
   if (!input_ref_file_.empty()) {
     ValidateInputFile(input_ref_file_);
     input_ref_file_ = std::filesystem::canonical(input_ref_file_).string();
@@ -362,6 +428,11 @@ void ProgramOptions::validate() {
   UTILS_DIE_IF(entropy_mode_ != "gabac" && entropy_mode_ != "zstd" &&
                    entropy_mode_ != "lzma" && entropy_mode_ != "bsc",
                "Entropy mode " + entropy_mode_ + " unknown");
+  UTILS_DIE_IF(zstd_level_ < 1 || zstd_level_ > 22,
+               "Zstd level must be between 1 and 22");
+  UTILS_DIE_IF(stats_mode_ != "log" && stats_mode_ != "json" &&
+                   stats_mode_ != "prometheus" && stats_mode_ != "none",
+               "Statistics mode " + stats_mode_ + " unknown");
 
   if (std::thread::hardware_concurrency()) {
     UTILS_DIE_IF(
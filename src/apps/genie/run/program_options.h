@@ -11,6 +11,7 @@
 // -----------------------------------------------------------------------------
 
 #include <string>
+#include <vector>
 
 // -----------------------------------------------------------------------------
 
@@ -32,6 +33,11 @@ class ProgramOptions {
   std::string input_sup_file_;  //!< @brief
   std::string input_ref_file_;  //!< @brief
 
+  /// Further fastq lanes of the same sample, imported in parallel
+  std::vector<std::string> input_lane_files_;
+  /// Paired files of the further lanes, empty for single-end data
+  std::vector<std::string> input_sup_lane_files_;
+
   std::string output_file_;      //!< @brief
   std::string output_sup_file_;  //!< @brief
 
@@ -42,7 +48,13 @@ class ProgramOptions {
   std::string qv_mode_;         //!< @brief
   std::string read_name_mode_;  //!< @brief
 
-  std::string entropy_mode_;  //!< @brief
+  std::string entropy_mode_;    //!< @brief
+  int zstd_level_;              //!< @brief Zstd compression level
+  size_t zstd_dictionary_aus_;  //!< @brief Dictionary training AUs, 0: off
+
+  std::string stats_mode_;  //!< @brief log, json, prometheus or none
+  std::string stats_file_;  //!< @brief Destination of json / prometheus
+  std::string trace_file_;  //!< @brief Chrome trace output, off if empty
 
   bool force_overwrite_;  //!< @brief
 
@@ -52,6 +64,7 @@ class ProgramOptions {
   std::string ref_mode_;  //!< @brief
 
   size_t number_of_threads_;  //!< @brief
+  size_t max_memory_;         //!< @brief MiB held in flight, 0: no limit
   bool raw_reference_;        //!< @brief
   bool raw_streams_;          //!< @brief
 
@@ -61,21 +61,8 @@ int main(int argc, char* argv[]) {
     std::string sha_name =
         p_opts.inputFile.substr(0, p_opts.inputFile.find_last_of('.')) +
         ".sha256";
-    if (!std::filesystem::exists(fai_name)) {
-      std::ifstream fasta_in(p_opts.inputFile);
-      UTILS_DIE_IF(!fasta_in, "Cannot open file to read: " + p_opts.inputFile);
-      std::ofstream fai_out(fai_name);
-      genie::format::fasta::FastaReader::index(fasta_in, fai_out);
-    }
-    if (!std::filesystem::exists(sha_name)) {
-      std::ifstream fasta_in(p_opts.inputFile);
-      UTILS_DIE_IF(!fasta_in, "Cannot open file to read: " + p_opts.inputFile);
-      std::ifstream fai_in(fai_name);
-      UTILS_DIE_IF(!fai_in, "Cannot open file to read: " + fai_name);
-      genie::format::fasta::FaiFile fai_file(fai_in);
-      std::ofstream sha_out(sha_name);
-      genie::format::fasta::FastaReader::hash(fai_file, fasta_in, sha_out);
-    }
+    genie::format::fasta::FastaReader::IndexAndHash(p_opts.inputFile, fai_name,
+                                                    sha_name);
 
     auto fasta_file = std::make_unique<std::ifstream>(p_opts.inputFile);
     UTILS_DIE_IF(!fasta_file, "Cannot open file to read: " + p_opts.inputFile);
@@ -113,20 +113,10 @@ void AttachImporter(T& flow, const ProgramOptions& p_opts,
   constexpr size_t blocksize = 256000;
   if (file_extension(p_opts.input_file_) == "sam" ||
       file_extension(p_opts.input_file_) == "bam") {
-    UTILS_DIE_IF(
-        p_opts.input_file_ == "-.sam",
-        "Sam input from stdin currently not supported.");  // TODO(renzDef)
-                                                           // add after
-                                                           // refactoring
-                                                           // importer
-    UTILS_DIE_IF(
-        p_opts.input_file_ == "-.bam",
-        "Bam input from stdin currently not supported.");  // TODO(renzDef)
-                                                           // add after
-                                                           // refactoring
-                                                           // importer
+    // htslib opens the file itself, "-.sam" / "-.bam" are read from stdin
     flow.AddImporter(std::make_unique<genie::format::sam::Importer>(
-        blocksize, p_opts.input_file_, p_opts.fasta_file_path_));
+        blocksize, p_opts.input_file_, p_opts.fasta_file_path_,
+        p_opts.num_threads_, p_opts.tmp_dir_path_));
   } else if (file_extension(p_opts.input_file_) == "mgrec") {
     auto tmp_file = p_opts.output_file_ + ".unsupported.mgrec";
     output_files.emplace_back(std::make_unique<std::ofstream>(tmp_file));
@@ -521,6 +521,22 @@ void AccessUnit::SetStats(stats::PerfStats&& stats) {
 
 // -----------------------------------------------------------------------------
 
+const std::optional<stats::AuStatistics>& AccessUnit::GetStatistics() const {
+  return statistics_;
+}
+
+// -----------------------------------------------------------------------------
+
+void AccessUnit::SetStatistics(stats::AuStatistics&& statistics) {
+  statistics_ = std::move(statistics);
+}
+
+// -----------------------------------------------------------------------------
+
+util::MemoryBudget::Reservation& AccessUnit::GetMemory() { return memory_; }
+
+// -----------------------------------------------------------------------------
+
 void AccessUnit::SetReference(
     const ReferenceManager::ReferenceExcerpt& ex,
     const std::vector<std::pair<size_t, size_t>>& ref2_write) {
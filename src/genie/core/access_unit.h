@@ -11,6 +11,7 @@
 // -----------------------------------------------------------------------------
 
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -18,8 +19,10 @@
 #include "genie/core/mismatch_decoder.h"
 #include "genie/core/parameter/parameter_set.h"
 #include "genie/core/reference_manager.h"
+#include "genie/core/stats/au_statistics.h"
 #include "genie/core/stats/perf_stats.h"
 #include "genie/util/data_block.h"
+#include "genie/util/memory_budget.h"
 
 // -----------------------------------------------------------------------------
 
@@ -554,6 +557,26 @@ class AccessUnit {
    */
   void SetStats(stats::PerfStats&& stats);
 
+  /**
+   * @brief
+   * @return Record statistics, if the read coder computed them
+   */
+  [[nodiscard]] const std::optional<stats::AuStatistics>& GetStatistics()
+      const;
+
+  /**
+   * @brief
+   * @param statistics Record statistics of the encoded records
+   */
+  void SetStatistics(stats::AuStatistics&& statistics);
+
+  /**
+   * @brief
+   * @return Reservation covering the memory held on behalf of this access
+   * unit. Returned to the budget once the access unit has been written.
+   */
+  util::MemoryBudget::Reservation& GetMemory();
+
   /**
    * @brief
    * @param ex
@@ -592,6 +615,7 @@ class AccessUnit {
   std::vector<Descriptor> descriptors_;                  //!< @brief
   parameter::EncodingSet parameters_;                    //!< @brief
   stats::PerfStats stats_;                               //!< @brief
+  std::optional<stats::AuStatistics> statistics_;        //!< @brief
   ReferenceManager::ReferenceExcerpt reference_;         //!< @brief
   std::vector<std::pair<size_t, size_t>> ref_to_write_;  //!< @brief
   bool reference_only_;                                  //!< @brief
@@ -603,6 +627,8 @@ class AccessUnit {
   uint64_t max_pos_;        //!< @brief
 
   uint16_t reference_sequence_;  //!< @brief
+
+  util::MemoryBudget::Reservation memory_;  //!< @brief
 };
 
 // -----------------------------------------------------------------------------
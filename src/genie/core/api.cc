@@ -7,15 +7,77 @@
 
 #include "genie/core/api.h"
 
+#include <limits>
+#include <map>
+#include <mutex>  // NOLINT
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "genie/core/meta/dataset.h"
+#include "genie/core/stats/au_statistics.h"
+
 // -----------------------------------------------------------------------------
 
 namespace genie::core::api {
 
 // -----------------------------------------------------------------------------
 
+namespace {
+
+/**
+ * @brief Datasets added through GenieState::AddDataset()
+ */
+struct Datasets {
+  std::mutex lock;  //!< @brief Guards the map
+  std::map<std::pair<uint64_t, uint64_t>, meta::Dataset>
+      map;  //!< @brief Metadata by group and dataset ID
+};
+
+// -----------------------------------------------------------------------------
+
+Datasets& GetDatasets() {
+  static Datasets datasets;
+  return datasets;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Merge the access unit statistics of a dataset in a region
+ * @param dataset_group_id
+ * @param dataset_id
+ * @param sequence_id
+ * @param start_pos
+ * @param end_pos
+ * @return Statistics of the region
+ */
+stats::AuStatistics GetStatistics(const uint64_t dataset_group_id,
+                                  const uint64_t dataset_id,
+                                  const uint64_t sequence_id,
+                                  const uint64_t start_pos,
+                                  const uint64_t end_pos) {
+  auto& datasets = GetDatasets();
+  std::lock_guard guard(datasets.lock);
+  const auto it = datasets.map.find({dataset_group_id, dataset_id});
+  if (it == datasets.map.end()) {
+    throw ExceptionDatasetNotFound(
+        __FILE__, "", __LINE__,
+        "Dataset " + std::to_string(dataset_group_id) + "/" +
+            std::to_string(dataset_id));
+  }
+  // Sequence IDs are 16 bit in MPEG-G, nothing maps to larger ones
+  if (sequence_id > std::numeric_limits<uint16_t>::max()) {
+    return {};
+  }
+  return it->second.GetStatistics(static_cast<uint16_t>(sequence_id),
+                                  start_pos, end_pos);
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
 std::string ExceptionPartiallyAuthorized::Msg() const {
   return "Only partially authorized. " + RuntimeException::Msg();
 }
@@ -100,6 +162,26 @@ std::string ExceptionBitstreamInvalid::Msg() const {
 
 // -----------------------------------------------------------------------------
 
+void GenieState::AddDataset(const uint64_t dataset_group_id,
+                            const uint64_t dataset_id,
+                            meta::Dataset dataset) {
+  auto& datasets = GetDatasets();
+  std::lock_guard guard(datasets.lock);
+  datasets.map.insert_or_assign({dataset_group_id, dataset_id},
+                                std::move(dataset));
+}
+
+// -----------------------------------------------------------------------------
+
+void GenieState::RemoveDataset(const uint64_t dataset_group_id,
+                               const uint64_t dataset_id) {
+  auto& datasets = GetDatasets();
+  std::lock_guard guard(datasets.lock);
+  datasets.map.erase({dataset_group_id, dataset_id});
+}
+
+// -----------------------------------------------------------------------------
+
 Hierarchy GenieState::GetHierarchy() {
   // UTILS_DIE_("Not implemented");
   return Hierarchy{};
@@ -225,13 +307,9 @@ std::vector<SimpleSegmentStatistics> GenieState::GetSimpleStatistics(
     const uint64_t dataset_group_id, const uint64_t dataset_id,
     const uint64_t sequence_id, const uint64_t start_pos,
     const uint64_t end_pos) {
-  (void)dataset_group_id;
-  (void)dataset_id;
-  (void)sequence_id;
-  (void)start_pos;
-  (void)end_pos;
-  // UTILS_DIE_("Not implemented");
-  return {};
+  return {GetStatistics(dataset_group_id, dataset_id, sequence_id, start_pos,
+                        end_pos)
+              .ToSimpleStatistics()};
 }
 
 // -----------------------------------------------------------------------------
@@ -240,13 +318,9 @@ std::vector<AdvancedSegmentStatistics> GenieState::GetAdvancedStatistics(
     const uint64_t dataset_group_id, const uint64_t dataset_id,
     const uint64_t sequence_id, const uint64_t start_pos,
     const uint64_t end_pos) {
-  (void)dataset_group_id;
-  (void)dataset_id;
-  (void)sequence_id;
-  (void)start_pos;
-  (void)end_pos;
-  // UTILS_DIE_("Not implemented");
-  return {};
+  return {GetStatistics(dataset_group_id, dataset_id, sequence_id, start_pos,
+                        end_pos)
+              .ToAdvancedStatistics()};
 }
 
 // -----------------------------------------------------------------------------
@@ -22,6 +22,12 @@
 
 // -----------------------------------------------------------------------------
 
+namespace genie::core::meta {
+class Dataset;
+}  // namespace genie::core::meta
+
+// -----------------------------------------------------------------------------
+
 namespace genie::core::api {
 
 /**
@@ -89,6 +95,8 @@ class ExceptionDatasetGroupNotFound final : public util::RuntimeException {
  */
 class ExceptionDatasetNotFound final : public util::RuntimeException {
  public:
+  using RuntimeException::RuntimeException;
+
   /**
    * @brief
    * @return
@@ -734,6 +742,24 @@ struct AdvancedFilter {
  */
 class GenieState {
  public:
+  /**
+   * @brief Make the metadata of a dataset available to the queries, e.g.
+   * after decapsulating an MGG file or loading the json sidecar of an MGB
+   * file. Replaces a dataset added before under the same IDs.
+   * @param dataset_group_id
+   * @param dataset_id
+   * @param dataset Metadata, including the statistics of the access units
+   */
+  static void AddDataset(uint64_t dataset_group_id, uint64_t dataset_id,
+                         meta::Dataset dataset);
+
+  /**
+   * @brief
+   * @param dataset_group_id
+   * @param dataset_id
+   */
+  static void RemoveDataset(uint64_t dataset_group_id, uint64_t dataset_id);
+
   /**
    * @brief
    * @return
@@ -843,26 +869,28 @@ class GenieState {
                                           bool include_sequences);
 
   /**
-   * @brief
+   * @brief Merge the statistics the encoder stored for the access units
+   * overlapping a region. No descriptor is decoded.
    * @param dataset_group_id
    * @param dataset_id
    * @param sequence_id
    * @param start_pos
    * @param end_pos
-   * @return
+   * @return Statistics of the region as a single entry
    */
   static std::vector<SimpleSegmentStatistics> GetSimpleStatistics(
       uint64_t dataset_group_id, uint64_t dataset_id, uint64_t sequence_id,
       uint64_t start_pos, uint64_t end_pos);
 
   /**
-   * @brief
+   * @brief Like GetSimpleStatistics(), split by strand. The extended
+   * statistics are not stored by the encoder and are left empty.
    * @param dataset_group_id
    * @param dataset_id
    * @param sequence_id
    * @param start_pos
    * @param end_pos
-   * @return
+   * @return Statistics of the region as a single entry
    */
   static std::vector<AdvancedSegmentStatistics> GetAdvancedStatistics(
       uint64_t dataset_group_id, uint64_t dataset_id, uint64_t sequence_id,
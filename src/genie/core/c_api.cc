@@ -9,6 +9,125 @@
 
 #include "genie/core/c_api.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "genie/core/api.h"
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+using genie::core::api::GenieState;
+using genie::core::api::SimpleSegmentStatistics;
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Copy a histogram into a new C array, padding or cutting it
+ * @param histogram Histogram
+ * @param size Number of entries of the C array
+ * @return Array to release with free()
+ */
+uint64_t* CopyHistogram(const std::vector<uint64_t>& histogram,
+                        const size_t size) {
+  auto* ret = static_cast<uint64_t*>(calloc(std::max<size_t>(size, 1),
+                                            sizeof(uint64_t)));
+  std::copy_n(histogram.begin(), std::min(size, histogram.size()), ret);
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Fill the C representation of simple statistics
+ * @param in Statistics
+ * @param max_segments Entries of the segment distribution
+ * @param out Zeroed statistics to fill
+ */
+void CopyStatistics(const SimpleSegmentStatistics& in,
+                    const uint64_t max_segments,
+                    GenieSimpleSegmentStatistics& out) {
+  out.reads_number = in.reads_number;
+  out.segments_number_reads_distribution =
+      CopyHistogram(in.segments_number_reads_distribution, max_segments);
+  out.quality_check_failed_reads_number = in.quality_check_failed_reads_number;
+  std::copy(in.segment_length.begin(), in.segment_length.end(),
+            out.segment_length);
+  std::copy(in.mapped_strand_segment_distribution.begin(),
+            in.mapped_strand_segment_distribution.end(),
+            out.mapped_strand_segment_distribution);
+  out.properly_paired_number = in.properly_paired_number;
+  std::copy(in.mapped_strand_pair_distribution.begin(),
+            in.mapped_strand_pair_distribution.end(),
+            out.mapped_strand_pair_distribution);
+  out.max_alignments = in.max_alignments;
+  out.multiple_alignment_segment_distribution = CopyHistogram(
+      in.multiple_alignment_segment_distribution, in.max_alignments + 1);
+  std::copy(in.coverage.begin(), in.coverage.end(), out.coverage);
+  std::copy(in.weighted_coverage.begin(), in.weighted_coverage.end(),
+            out.weighted_coverage);
+  std::copy(in.errors_number.begin(), in.errors_number.end(),
+            out.errors_number);
+  std::copy(in.substitutions_number.begin(), in.substitutions_number.end(),
+            out.substitutions_number);
+  std::copy(in.insertions_number.begin(), in.insertions_number.end(),
+            out.insertions_number);
+  std::copy(in.insertions_length.begin(), in.insertions_length.end(),
+            out.insertions_length);
+  std::copy(in.deletions_number.begin(), in.deletions_number.end(),
+            out.deletions_number);
+  std::copy(in.deletions_length.begin(), in.deletions_length.end(),
+            out.deletions_length);
+  std::copy(in.splices_number.begin(), in.splices_number.end(),
+            out.splices_number);
+  std::copy(in.splices_length.begin(), in.splices_length.end(),
+            out.splices_length);
+  std::copy(in.alignment_score.begin(), in.alignment_score.end(),
+            out.alignment_score);
+  std::copy(in.class_segment_distribution.begin(),
+            in.class_segment_distribution.end(),
+            out.class_segment_distribution);
+  std::copy(in.clipped_segment_distribution.begin(),
+            in.clipped_segment_distribution.end(),
+            out.clipped_segment_distribution);
+  out.optical_duplicates_number = in.optical_duplicates_number;
+  out.chimeras_number = in.chimeras_number;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Release the arrays of simple statistics
+ * @param statistics Statistics filled by CopyStatistics()
+ */
+void FreeArrays(const GenieSimpleSegmentStatistics& statistics) {
+  free(statistics.segments_number_reads_distribution);
+  free(statistics.multiple_alignment_segment_distribution);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Run a query, mapping its exceptions to return codes
+ * @param query Query
+ * @return Return code
+ */
+template <typename Query>
+GenieReturnCode Call(Query&& query) {
+  try {
+    query();
+  } catch (const genie::core::api::ExceptionDatasetNotFound&) {
+    return kGenieReturnCodeGDatasetNotfound;
+  } catch (...) {
+    return kGenieReturnCodeGUnlistedError;
+  }
+  return kGenieReturnCodeGSuccess;
+}
+
+}  // namespace
+
 // -----------------------------------------------------------------------------
 
 extern "C" {
@@ -155,14 +274,17 @@ GenieReturnCode GenieGetSimpleStatistics(
     const uint64_t sequence_id, const uint64_t start_pos,
     const uint64_t end_pos, const uint64_t* max_segments,
     GenieSimpleSegmentStatistics** output_statistics) {
-  (void)dataset_group_id;
-  (void)dataset_id;
-  (void)sequence_id;
-  (void)start_pos;
-  (void)end_pos;
-  (void)max_segments;
-  (void)output_statistics;
-  return kGenieReturnCodeGUnlistedError;
+  if (max_segments == nullptr || output_statistics == nullptr) {
+    return kGenieReturnCodeGInvalidParameter;
+  }
+  return Call([&] {
+    const auto statistics = GenieState::GetSimpleStatistics(
+        dataset_group_id, dataset_id, sequence_id, start_pos, end_pos);
+    auto* ret = static_cast<GenieSimpleSegmentStatistics*>(
+        calloc(1, sizeof(GenieSimpleSegmentStatistics)));
+    CopyStatistics(statistics.front(), *max_segments, *ret);
+    *output_statistics = ret;
+  });
 }
 
 // -----------------------------------------------------------------------------
@@ -172,14 +294,42 @@ GenieReturnCode GenieGetAdvancedStatistics(
     const uint64_t sequence_id, const uint64_t start_pos,
     const uint64_t end_pos, const uint64_t* max_segments,
     GenieAdvancedSegmentStatistics** output_statistics) {
-  (void)dataset_group_id;
-  (void)dataset_id;
-  (void)sequence_id;
-  (void)start_pos;
-  (void)end_pos;
-  (void)max_segments;
-  (void)output_statistics;
-  return kGenieReturnCodeGUnlistedError;
+  if (max_segments == nullptr || output_statistics == nullptr) {
+    return kGenieReturnCodeGInvalidParameter;
+  }
+  return Call([&] {
+    const auto statistics = GenieState::GetAdvancedStatistics(
+        dataset_group_id, dataset_id, sequence_id, start_pos, end_pos);
+    auto* ret = static_cast<GenieAdvancedSegmentStatistics*>(
+        calloc(1, sizeof(GenieAdvancedSegmentStatistics)));
+    for (size_t i = 0; i < kGenieStrandStrictCount; ++i) {
+      CopyStatistics(statistics.front().simple_statistics[i], *max_segments,
+                     ret->simple_statistics[i]);
+    }
+    *output_statistics = ret;
+  });
+}
+
+// -----------------------------------------------------------------------------
+
+void GenieFreeSimpleStatistics(GenieSimpleSegmentStatistics* statistics) {
+  if (statistics == nullptr) {
+    return;
+  }
+  FreeArrays(*statistics);
+  free(statistics);
+}
+
+// -----------------------------------------------------------------------------
+
+void GenieFreeAdvancedStatistics(GenieAdvancedSegmentStatistics* statistics) {
+  if (statistics == nullptr) {
+    return;
+  }
+  for (const auto& s : statistics->simple_statistics) {
+    FreeArrays(s);
+  }
+  free(statistics);
 }
 
 // -----------------------------------------------------------------------------
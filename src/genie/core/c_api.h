@@ -590,14 +590,17 @@ GenieReturnCode GenieGetDatasetReference(
     uint64_t dataset_group_id, uint64_t dataset_id, bool include_sequences,
     const GenieReference* output_reference);
 /**
- * @brief
+ * @brief Statistics of a region, merged from the summaries the encoder
+ * stored per access unit.
  * @param dataset_group_id
  * @param dataset_id
  * @param sequence_id
  * @param start_pos
  * @param end_pos
- * @param max_segments
- * @param output_statistics
+ * @param max_segments Number of entries to allocate for
+ * segments_number_reads_distribution
+ * @param output_statistics Set to a single entry, release it with
+ * GenieFreeSimpleStatistics()
  * @return
  */
 GenieReturnCode GenieGetSimpleStatistics(
@@ -606,14 +609,17 @@ GenieReturnCode GenieGetSimpleStatistics(
     GenieSimpleSegmentStatistics** output_statistics);
 
 /**
- * @brief
+ * @brief Like GenieGetSimpleStatistics(), split by strand. The extended
+ * statistics are left empty.
  * @param dataset_group_id
  * @param dataset_id
  * @param sequence_id
  * @param start_pos
  * @param end_pos
- * @param max_segments
- * @param output_statistics
+ * @param max_segments Number of entries to allocate for
+ * segments_number_reads_distribution
+ * @param output_statistics Set to a single entry, release it with
+ * GenieFreeAdvancedStatistics()
  * @return
  */
 GenieReturnCode GenieGetAdvancedStatistics(
@@ -621,6 +627,18 @@ GenieReturnCode GenieGetAdvancedStatistics(
     uint64_t start_pos, uint64_t end_pos, const uint64_t* max_segments,
     GenieAdvancedSegmentStatistics** output_statistics);
 
+/**
+ * @brief
+ * @param statistics Returned by GenieGetSimpleStatistics(), may be NULL
+ */
+void GenieFreeSimpleStatistics(GenieSimpleSegmentStatistics* statistics);
+
+/**
+ * @brief
+ * @param statistics Returned by GenieGetAdvancedStatistics(), may be NULL
+ */
+void GenieFreeAdvancedStatistics(GenieAdvancedSegmentStatistics* statistics);
+
 /* ---------------------------------------------------------------------------*/
 
 #ifdef __cplusplus
@@ -12,6 +12,7 @@
 // -----------------------------------------------------------------------------
 
 #include "genie/core/record/chunk.h"
+#include "genie/util/memory_budget.h"
 
 // -----------------------------------------------------------------------------
 
@@ -39,6 +40,13 @@ class Classifier {
    */
   virtual void Flush() = 0;
 
+  /**
+   * @brief Sets the budget the records held by the classifier are accounted
+   * against. The reservations are handed on with the returned chunks.
+   * @param budget Budget, nullptr to disable accounting.
+   */
+  virtual void SetMemoryBudget(util::MemoryBudget*) {}
+
   /**
    * @brief
    */
@@ -22,7 +22,7 @@ record::Chunk ClassifierBypass::GetChunk() {
     return ret;
   }
   ret = std::move(vec_.front());
-  vec_.erase(vec_.begin());
+  vec_.pop_front();
   return ret;
 }
 
@@ -10,7 +10,7 @@
 
 // -----------------------------------------------------------------------------
 
-#include <vector>
+#include <deque>
 
 #include "genie/core/classifier.h"
 
@@ -22,8 +22,8 @@ namespace genie::core {
  * @brief
  */
 class ClassifierBypass final : public Classifier {
-  std::vector<record::Chunk> vec_;  //!< @brief
-  bool flushing_ = false;           //!< @brief
+  std::deque<record::Chunk> vec_;  //!< @brief
+  bool flushing_ = false;         //!< @brief
 
  public:
   /**
@@ -25,20 +25,34 @@ namespace genie::core {
 
 // -----------------------------------------------------------------------------
 
-bool ClassifierRegroup::IsCovered(const size_t start, const size_t end) const {
-  size_t position = start;
-
-  for (auto it = current_seq_coverage_.begin();
-       it != current_seq_coverage_.end(); ++it) {
-    if (position >= it->first && position < it->second) {
-      position = it->second - 1;
-      it = current_seq_coverage_.begin();
-    }
-    if (position >= end - 1) {
-      return true;
+void ClassifierRegroup::SetCoverage(
+    const std::vector<std::pair<size_t, size_t>>& coverage) {
+  auto sorted = coverage;
+  std::sort(sorted.begin(), sorted.end());
+  current_seq_coverage_.clear();
+  for (const auto& [start, end] : sorted) {
+    if (!current_seq_coverage_.empty() &&
+        start <= std::prev(current_seq_coverage_.end())->second) {
+      auto& last_end = std::prev(current_seq_coverage_.end())->second;
+      last_end = std::max(last_end, end);
+    } else {
+      current_seq_coverage_.emplace_hint(current_seq_coverage_.end(), start,
+                                         end);
     }
   }
-  return false;
+}
+
+// -----------------------------------------------------------------------------
+
+bool ClassifierRegroup::IsCovered(const size_t start, const size_t end) const {
+  // Last range starting at or before start. Ranges are merged, so it is the
+  // only one that can contain start.
+  auto it = current_seq_coverage_.upper_bound(start);
+  if (it == current_seq_coverage_.begin()) {
+    return false;
+  }
+  --it;
+  return start < it->second && end <= it->second;
 }
 
 // -----------------------------------------------------------------------------
@@ -61,6 +75,45 @@ bool ClassifierRegroup::IsCovered(const record::Record& r) const {
 
 // -----------------------------------------------------------------------------
 
+void ClassifierRegroup::AddReference(record::Chunk& chunk,
+                                     const record::Record& r) {
+  const auto& alignment = r.GetAlignments().front();
+  const size_t start = alignment.GetPosition();
+  size_t end = 0;
+  if (alignment.GetAlignmentSplits().empty() ||
+      alignment.GetAlignmentSplits().front()->GetType() !=
+          record::AlignmentSplit::Type::kSameRec) {
+    end = start + r.GetMappedLength(0, 0);
+  } else {
+    end = start + r.GetMappedLength(0, 1) +
+          dynamic_cast<const record::alignment_split::SameRec&>(
+              *alignment.GetAlignmentSplits().front())
+              .GetDelta();
+    end = std::max(end, start + r.GetMappedLength(0, 0));
+  }
+
+  const auto seq_id = r.GetAlignmentSharedData().GetSeqId();
+  auto& excerpt = chunk.GetRef();
+  if (chunk.GetData().empty() || start < excerpt.GetGlobalStart()) {
+    // Fresh excerpt for a new chunk. Records arriving out of order restart
+    // the excerpt at the lower position, keeping the chunks loaded so far.
+    auto name = seq_id == current_seq_id_ && !current_seq_name_.empty()
+                    ? current_seq_name_
+                    : ref_mgr_->Id2Ref(seq_id);
+    ReferenceManager::ReferenceExcerpt fresh(std::move(name), start, end);
+    ref_mgr_->LoadInto(fresh, start, end);
+    if (!chunk.GetData().empty()) {
+      ref_mgr_->LoadInto(fresh, excerpt.GetGlobalStart(),
+                         excerpt.GetGlobalEnd());
+    }
+    excerpt = std::move(fresh);
+    return;
+  }
+  ref_mgr_->LoadInto(excerpt, start, end);
+}
+
+// -----------------------------------------------------------------------------
+
 void ClassifierRegroup::QueueFinishedChunk(record::Chunk& data) {
   if (!data.GetRef().IsEmpty()) {
     if (ref_mode_ == RefMode::kRelevant) {
@@ -93,6 +146,9 @@ void ClassifierRegroup::QueueFinishedChunk(record::Chunk& data) {
           }
           record::Segment segment(std::move(seq));
           rec.AddSegment(std::move(segment));
+          if (budget_) {
+            ref_chunk.GetMemory() = budget_->Reserve(rec.GetMemoryUsage());
+          }
           ref_chunk.GetData().push_back(std::move(rec));
           finished_chunks_.push_back(std::move(ref_chunk));
         }
@@ -101,11 +157,90 @@ void ClassifierRegroup::QueueFinishedChunk(record::Chunk& data) {
 
     data.SetRefId(ref_mgr_->Ref2Id(data.GetRef().GetRefName()));
   }
+  // Finished chunks are released by the pipeline, importers may wait for them
+  data.GetMemory().SetPinned(false);
   finished_chunks_.push_back(std::move(data));
 }
 
 // -----------------------------------------------------------------------------
 
+void ClassifierRegroup::Append(record::Chunk& chunk,
+                               record::Record&& r) const {
+  if (budget_) {
+    chunk.GetMemory().Merge(budget_->Reserve(r.GetMemoryUsage(), true));
+  }
+  chunk.GetData().push_back(std::move(r));
+}
+
+// -----------------------------------------------------------------------------
+
+void ClassifierRegroup::Append(record::Chunk& chunk,
+                               const record::RecordBatch& batch,
+                               const size_t r) const {
+  if (budget_) {
+    chunk.GetMemory().Merge(budget_->Reserve(batch.GetMemoryUsage(r), true));
+  }
+  chunk.GetBatch().Append(batch, r);
+}
+
+// -----------------------------------------------------------------------------
+
+void ClassifierRegroup::AddBatch(record::Chunk& chunk) {
+  auto& batch = chunk.GetBatch();
+
+  // A batch of complete reads with the same pairing that fits into an empty
+  // chunk is handed over as is
+  const bool paired = batch.GetNumberOfTemplateSegments(0) > 1;
+  bool uniform = true;
+  for (size_t r = 0; r < batch.Size() && uniform; ++r) {
+    uniform = batch.GetNumberOfTemplateSegments(r) == batch.GetNumSegments(r) &&
+              (batch.GetNumberOfTemplateSegments(r) > 1) == paired;
+  }
+  if (auto& target =
+          current_chunks_[false][paired]
+                         [static_cast<uint8_t>(record::ClassType::kClassU) - 1];
+      uniform && target.Empty() && batch.Size() <= au_size_) {
+    if (budget_) {
+      target.GetMemory().Merge(budget_->Reserve(batch.GetMemoryUsage(), true));
+    }
+    target.GetRef() = ReferenceManager::ReferenceExcerpt();
+    target.GetStats().Add(chunk.GetStats());
+    target.GetBatch() = std::move(batch);
+    if (target.Size() == au_size_) {
+      QueueFinishedChunk(target);
+    }
+    return;
+  }
+
+  bool moved_stats = false;
+  for (size_t r = 0; r < batch.Size(); ++r) {
+    if (batch.GetNumberOfTemplateSegments(r) != batch.GetNumSegments(r)) {
+      Append(current_unpaired_u_chunk_, batch, r);
+      if (current_unpaired_u_chunk_.Size() >= au_size_) {
+        QueueFinishedChunk(current_unpaired_u_chunk_);
+      }
+      continue;
+    }
+
+    auto& target =
+        current_chunks_[false][batch.GetNumberOfTemplateSegments(r) > 1]
+                       [static_cast<uint8_t>(record::ClassType::kClassU) - 1];
+    if (target.Empty()) {
+      target.GetRef() = ReferenceManager::ReferenceExcerpt();
+    }
+    if (!moved_stats) {
+      target.GetStats().Add(chunk.GetStats());
+      moved_stats = true;
+    }
+    Append(target, batch, r);
+    if (target.Size() == au_size_) {
+      QueueFinishedChunk(target);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 bool ClassifierRegroup::IsWritten(const std::string& ref, const size_t index) {
   if (ref_state_.find(ref) == ref_state_.end()) {
     ref_state_.insert(std::make_pair(ref, std::vector<uint8_t>(1, 0)));
@@ -139,11 +274,15 @@ ClassifierRegroup::ClassifierRegroup(const size_t au_size,
 
 record::Chunk ClassifierRegroup::GetChunk() {
   if (ref_mode_ == RefMode::kFull) {
-    auto seq_vec = ref_mgr_->GetSequences();
+    if (ref_mode_full_seqs_.empty()) {
+      for (auto& seq : ref_mgr_->GetSequences()) {
+        auto coverage = ref_mgr_->GetCoverage(seq);
+        ref_mode_full_seqs_.emplace_back(std::move(seq), std::move(coverage));
+      }
+    }
     while (true) {
-      if (ref_mode_full_seq_id_ != seq_vec.size()) {
-        const auto& seq = seq_vec.at(ref_mode_full_seq_id_);
-        auto cov_vec = ref_mgr_->GetCoverage(seq);
+      if (ref_mode_full_seq_id_ != ref_mode_full_seqs_.size()) {
+        const auto& [seq, cov_vec] = ref_mode_full_seqs_[ref_mode_full_seq_id_];
         auto [fst, snd] = cov_vec.at(ref_mode_full_cov_id_);
 
         if (size_t chunk_offset = fst / ReferenceManager::GetChunkSize();
@@ -244,7 +383,7 @@ record::Chunk ClassifierRegroup::GetChunk() {
   }
 
   ret = std::move(finished_chunks_.front());
-  finished_chunks_.erase(finished_chunks_.begin());
+  finished_chunks_.pop_front();
 
 #define AU_DEBUG_WRITE 0
 #if AU_DEBUG_WRITE
@@ -268,16 +407,19 @@ void ClassifierRegroup::Add(record::Chunk&& c) {
   if (chunk.GetRefId() != current_seq_id_) {
     current_seq_id_ = static_cast<uint16_t>(chunk.GetRefId());
     if (ref_mgr_->RefKnown(current_seq_id_)) {
-      current_seq_coverage_ =
-          ref_mgr_->GetCoverage(ref_mgr_->Id2Ref(current_seq_id_));
+      current_seq_name_ = ref_mgr_->Id2Ref(current_seq_id_);
+      SetCoverage(ref_mgr_->GetCoverage(current_seq_name_));
     } else {
-      current_seq_coverage_ = std::vector<std::pair<size_t, size_t>>();
+      current_seq_name_.clear();
+      current_seq_coverage_.clear();
     }
     for (auto& ref_block : current_chunks_) {
       for (auto& pair_block : ref_block) {
         for (auto& class_block : pair_block) {
-          if (class_block.GetData().empty() ||
-              class_block.GetData().front().GetClassId() ==
+          if (class_block.Empty() ||
+              (class_block.IsBatched()
+                   ? class_block.GetBatch().GetClassId(0)
+                   : class_block.GetData().front().GetClassId()) ==
                   record::ClassType::kClassU) {
             continue;
           }
@@ -287,6 +429,18 @@ void ClassifierRegroup::Add(record::Chunk&& c) {
     }
   }
 
+  if (chunk.IsBatched()) {
+    bool unaligned = true;
+    for (size_t r = 0; r < chunk.GetBatch().Size(); ++r) {
+      unaligned = unaligned && chunk.GetBatch().GetClassId(r) ==
+                                   record::ClassType::kClassU;
+    }
+    if (unaligned) {
+      AddBatch(chunk);
+      return;
+    }
+  }
+
   for (auto& r : chunk.GetData()) {
     auto class_type = r.GetClassId();  // Only look at the e_cigar for first
                                        // classification
@@ -295,66 +449,33 @@ void ClassifierRegroup::Add(record::Chunk&& c) {
 
     if (r.GetClassId() == record::ClassType::kClassU &&
         r.GetNumberOfTemplateSegments() != r.GetSegments().size()) {
-      current_unpaired_u_chunk_.GetData().emplace_back(std::move(r));
-      if (current_unpaired_u_chunk_.GetData().size() >= au_size_) {
+      Append(current_unpaired_u_chunk_, std::move(r));
+      if (current_unpaired_u_chunk_.Size() >= au_size_) {
         QueueFinishedChunk(current_unpaired_u_chunk_);
       }
       continue;
     }
 
-    ReferenceManager::ReferenceExcerpt record_reference;
-
     // Unaligned reads can't be ref based, otherwise check if reference
     // available
     if (class_type != record::ClassType::kClassU) {
       ref_based = IsCovered(r);
-      if (ref_based) {
-        size_t end = 0;
-        if (r.GetAlignments().front().GetAlignmentSplits().empty() ||
-            r.GetAlignments().front().GetAlignmentSplits().front()->GetType() !=
-                record::AlignmentSplit::Type::kSameRec) {
-          end =
-              r.GetAlignments().front().GetPosition() + r.GetMappedLength(0, 0);
-        } else {
-          end = r.GetAlignments().front().GetPosition() +
-                r.GetMappedLength(0, 1) +
-                dynamic_cast<const record::alignment_split::SameRec&>(
-                    *r.GetAlignments().front().GetAlignmentSplits().front())
-                    .GetDelta();
-          end = std::max(end, r.GetAlignments().front().GetPosition() +
-                                  r.GetMappedLength(0, 0));
-        }
-        record_reference = this->ref_mgr_->Load(
-            ref_mgr_->Id2Ref(r.GetAlignmentSharedData().GetSeqId()),
-            r.GetAlignments().front().GetPosition(), end);
-      }
     }
 
-    if (current_chunks_[ref_based][paired][static_cast<uint8_t>(class_type) - 1]
-            .GetData()
-            .empty()) {
-      current_chunks_[ref_based][paired][static_cast<uint8_t>(class_type) - 1]
-          .GetRef() = record_reference;
-    } else {
-      current_chunks_[ref_based][paired][static_cast<uint8_t>(class_type) - 1]
-          .GetRef()
-          .Merge(record_reference);
+    auto& target = current_chunks_[ref_based][paired]
+                                  [static_cast<uint8_t>(class_type) - 1];
+    if (ref_based) {
+      AddReference(target, r);
+    } else if (target.Empty()) {
+      target.GetRef() = ReferenceManager::ReferenceExcerpt();
     }
     if (!moved_stats) {
-      current_chunks_[ref_based][paired][static_cast<uint8_t>(class_type) - 1]
-          .GetStats()
-          .Add(chunk.GetStats());
+      target.GetStats().Add(chunk.GetStats());
       moved_stats = true;
     }
-    current_chunks_[ref_based][paired][static_cast<uint8_t>(class_type) - 1]
-        .GetData()
-        .push_back(r);
-    if (current_chunks_[ref_based][paired][static_cast<uint8_t>(class_type) - 1]
-            .GetData()
-            .size() == au_size_) {
-      auto& class_block = current_chunks_[ref_based][paired]
-                                         [static_cast<uint8_t>(class_type) - 1];
-      QueueFinishedChunk(class_block);
+    Append(target, std::move(r));
+    if (target.Size() == au_size_) {
+      QueueFinishedChunk(target);
     }
   }
 }
@@ -365,20 +486,26 @@ void ClassifierRegroup::Flush() {
   for (auto& ref_block : current_chunks_) {
     for (auto& pair_block : ref_block) {
       for (auto& class_block : pair_block) {
-        if (class_block.GetData().empty()) {
+        if (class_block.Empty()) {
           continue;
         }
         QueueFinishedChunk(class_block);
       }
     }
   }
-  if (!current_unpaired_u_chunk_.GetData().empty()) {
+  if (!current_unpaired_u_chunk_.Empty()) {
     QueueFinishedChunk(current_unpaired_u_chunk_);
   }
 }
 
 // -----------------------------------------------------------------------------
 
+void ClassifierRegroup::SetMemoryBudget(util::MemoryBudget* budget) {
+  budget_ = budget;
+}
+
+// -----------------------------------------------------------------------------
+
 }  // namespace genie::core
 
 // -----------------------------------------------------------------------------
@@ -10,6 +10,7 @@
 
 // -----------------------------------------------------------------------------
 
+#include <deque>
 #include <map>
 #include <string>
 #include <utility>
@@ -30,7 +31,8 @@ class ClassifierRegroup final : public Classifier {
   enum class RefMode { kNone = 0, kRelevant = 1, kFull = 2 };
 
  private:
-  std::vector<record::Chunk> finished_chunks_;  //!< @brief
+  /// Chunks ready to be handed out, in order. Popped from the front.
+  std::deque<record::Chunk> finished_chunks_;
 
   using class_block_type = std::vector<record::Chunk>;      //!< @brief
   using paired_block_type = std::vector<class_block_type>;  //!< @brief
@@ -39,7 +41,11 @@ class ClassifierRegroup final : public Classifier {
   record::Chunk current_unpaired_u_chunk_;                       //! @brief
   ReferenceManager* ref_mgr_;                                    //!< @brief
   uint16_t current_seq_id_;                                      //!< @brief
-  std::vector<std::pair<size_t, size_t>> current_seq_coverage_;  //!< @brief
+  std::string current_seq_name_;  //!< @brief Name of current_seq_id_.
+
+  /// Covered ranges of the current reference as start -> end (exclusive).
+  /// Overlapping and adjacent ranges are merged, so a query is one lookup.
+  std::map<size_t, size_t> current_seq_coverage_;
   std::map<std::string, std::vector<uint8_t>> ref_state_;        //!< @brief
 
   size_t au_size_;                    //!< @brief
@@ -49,8 +55,21 @@ class ClassifierRegroup final : public Classifier {
   size_t ref_mode_full_cov_id_{0};    //!< @brief
   size_t ref_mode_full_chunk_id_{0};  //!< @brief
 
+  /// Reference sequences with their coverage for RefMode::kFull, read from
+  /// the reference manager with the first chunk instead of on every call.
+  std::vector<std::pair<std::string, std::vector<std::pair<size_t, size_t>>>>
+      ref_mode_full_seqs_;
+
   bool raw_ref_mode_ = true;  //!< @brief
 
+  util::MemoryBudget* budget_{nullptr};  //!< @brief
+
+  /**
+   * @brief Replaces the coverage of the current reference.
+   * @param coverage Covered ranges, in any order and possibly overlapping.
+   */
+  void SetCoverage(const std::vector<std::pair<size_t, size_t>>& coverage);
+
   /**
    * @brief
    * @param start
@@ -59,6 +78,15 @@ class ClassifierRegroup final : public Classifier {
    */
   [[nodiscard]] bool IsCovered(size_t start, size_t end) const;
 
+  /**
+   * @brief Grows the reference excerpt of a chunk to cover a record. The
+   * excerpt is started with the first record and only loads the reference
+   * chunks it does not hold yet.
+   * @param chunk Chunk the record is added to.
+   * @param r Record.
+   */
+  void AddReference(record::Chunk& chunk, const record::Record& r);
+
   /**
    * @brief
    * @param r
@@ -72,6 +100,33 @@ class ClassifierRegroup final : public Classifier {
    */
   void QueueFinishedChunk(record::Chunk& data);
 
+  /**
+   * @brief Moves a record into a chunk and charges its memory to the budget.
+   * The bytes stay pinned until the chunk is finished, as only more input
+   * can complete it.
+   * @param chunk Chunk to append to.
+   * @param r Record.
+   */
+  void Append(record::Chunk& chunk, record::Record&& r) const;
+
+  /**
+   * @brief Copies a record of a columnar batch into the batch of a chunk and
+   * charges its memory to the budget, see the overload for records.
+   * @param chunk Chunk to append to.
+   * @param batch Batch holding the record.
+   * @param r Record index.
+   */
+  void Append(record::Chunk& chunk, const record::RecordBatch& batch,
+              size_t r) const;
+
+  /**
+   * @brief Regroups a chunk of unaligned records held in its batch. The
+   * records stay in columnar form, a batch that fits into an empty chunk is
+   * handed over without copying.
+   * @param chunk Chunk from the importer.
+   */
+  void AddBatch(record::Chunk& chunk);
+
  public:
   /**
    * @brief
@@ -107,6 +162,12 @@ class ClassifierRegroup final : public Classifier {
    * @brief
    */
   void Flush() override;
+
+  /**
+   * @brief
+   * @param budget
+   */
+  void SetMemoryBudget(util::MemoryBudget* budget) override;
 };
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,28 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/core/entropy_codec_context.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::core {
+
+// -----------------------------------------------------------------------------
+
+uint8_t* EntropyCodecContext::GetScratch(const size_t size) {
+  if (scratch_.size() < size) {
+    scratch_.resize(size);
+  }
+  return scratch_.data();
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::core
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
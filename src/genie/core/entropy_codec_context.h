@@ -0,0 +1,61 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#ifndef SRC_GENIE_CORE_ENTROPY_CODEC_CONTEXT_H_
+#define SRC_GENIE_CORE_ENTROPY_CODEC_CONTEXT_H_
+
+// -----------------------------------------------------------------------------
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "genie/util/object_pool.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::core {
+
+/**
+ * @brief State an entropy codec keeps alive between subsequences: initialized
+ * library contexts and a grow-only scratch buffer. Codecs with library state
+ * derive from this class.
+ */
+class EntropyCodecContext {
+ public:
+  /**
+   * @brief
+   */
+  virtual ~EntropyCodecContext() = default;
+
+  /**
+   * @brief Get the scratch buffer. It only ever grows, so after the first
+   * few subsequences no allocation takes place anymore.
+   * @param size Minimum size in bytes.
+   * @return Buffer of at least `size` bytes, valid until the next call.
+   */
+  uint8_t* GetScratch(size_t size);
+
+ private:
+  std::vector<uint8_t> scratch_;  //!< @brief Scratch buffer.
+};
+
+/**
+ * @brief Contexts of one codec, one per thread currently coding.
+ */
+using EntropyContextPool = util::ObjectPool<EntropyCodecContext>;
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::core
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_CORE_ENTROPY_CODEC_CONTEXT_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
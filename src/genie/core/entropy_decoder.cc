@@ -0,0 +1,32 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/core/entropy_decoder.h"
+
+#include <utility>
+
+// -----------------------------------------------------------------------------
+
+namespace genie::core {
+
+// -----------------------------------------------------------------------------
+
+EntropyDecoder::EntropyDecoder(EntropyContextPool::Factory context_factory)
+    : contexts_(std::move(context_factory)) {}
+
+// -----------------------------------------------------------------------------
+
+EntropyContextPool::Lease EntropyDecoder::AcquireContext() {
+  return contexts_.Acquire();
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::core
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -13,6 +13,7 @@
 #include <tuple>
 
 #include "genie/core/access_unit.h"
+#include "genie/core/entropy_codec_context.h"
 
 // -----------------------------------------------------------------------------
 
@@ -39,6 +40,25 @@ class EntropyDecoder {
   virtual std::tuple<AccessUnit::Descriptor, stats::PerfStats> Process(
       const parameter::DescriptorSubSequenceCfg& param,
       AccessUnit::Descriptor& desc, bool mm_coder_enabled) = 0;
+
+ protected:
+  /**
+   * @brief
+   * @param context_factory Creates the codec contexts. Codecs with library
+   * state pass a factory for their derived context type.
+   */
+  explicit EntropyDecoder(EntropyContextPool::Factory context_factory =
+                              std::make_unique<EntropyCodecContext>);
+
+  /**
+   * @brief Borrow a codec context for the current Process() call. Contexts
+   * are reused across calls, so their state only has to be initialized once.
+   * @return Context, returned to the pool when the lease is destroyed.
+   */
+  EntropyContextPool::Lease AcquireContext();
+
+ private:
+  EntropyContextPool contexts_;  //!< @brief Idle codec contexts.
 };
 
 // -----------------------------------------------------------------------------
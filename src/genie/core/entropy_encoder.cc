@@ -0,0 +1,40 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/core/entropy_encoder.h"
+
+#include <utility>
+
+// -----------------------------------------------------------------------------
+
+namespace genie::core {
+
+// -----------------------------------------------------------------------------
+
+EntropyEncoder::EntropyEncoder(EntropyContextPool::Factory context_factory)
+    : contexts_(std::move(context_factory)) {}
+
+// -----------------------------------------------------------------------------
+
+size_t EntropyEncoder::GetWarmUp() const { return 0; }
+
+// -----------------------------------------------------------------------------
+
+void EntropyEncoder::FinishWarmUp() {}
+
+// -----------------------------------------------------------------------------
+
+EntropyContextPool::Lease EntropyEncoder::AcquireContext() {
+  return contexts_.Acquire();
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::core
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
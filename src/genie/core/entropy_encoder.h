@@ -10,9 +10,11 @@
 
 // -----------------------------------------------------------------------------
 
+#include <cstddef>
 #include <tuple>
 
 #include "genie/core/access_unit.h"
+#include "genie/core/entropy_codec_context.h"
 #include "genie/core/module.h"
 #include "genie/core/parameter/descriptor_present/decoder.h"
 
@@ -41,6 +43,40 @@ class EntropyEncoder {
    * @return
    */
   virtual entropy_coded Process(AccessUnit::Descriptor& desc) = 0;
+
+  /**
+   * @brief Number of access units the coder learns from before its output
+   * settles, e.g. to train dictionaries. The flow graph passes the sections
+   * producing them in section order, so the output does not depend on the
+   * thread count.
+   * @return Number of access units, 0 if the coder does not learn.
+   */
+  [[nodiscard]] virtual size_t GetWarmUp() const;
+
+  /**
+   * @brief Called once after the warm-up sections were coded, also if they
+   * produced fewer access units than requested by GetWarmUp().
+   */
+  virtual void FinishWarmUp();
+
+ protected:
+  /**
+   * @brief
+   * @param context_factory Creates the codec contexts. Codecs with library
+   * state pass a factory for their derived context type.
+   */
+  explicit EntropyEncoder(EntropyContextPool::Factory context_factory =
+                              std::make_unique<EntropyCodecContext>);
+
+  /**
+   * @brief Borrow a codec context for the current Process() call. Contexts
+   * are reused across calls, so their state only has to be initialized once.
+   * @return Context, returned to the pool when the lease is destroyed.
+   */
+  EntropyContextPool::Lease AcquireContext();
+
+ private:
+  EntropyContextPool contexts_;  //!< @brief Idle codec contexts.
 };
 
 // -----------------------------------------------------------------------------
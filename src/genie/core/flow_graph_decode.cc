@@ -199,7 +199,7 @@ void FlowGraphDecode::Run() {
     imps.emplace_back(i.get());
   }
   mgr_.SetSource(std::move(imps));
-  mgr_.Run();
+  num_reads_ = mgr_.Run();
 }
 
 // -----------------------------------------------------------------------------
@@ -209,6 +209,7 @@ stats::PerfStats FlowGraphDecode::GetStats() {
   for (const auto& e : exporters_) {
     ret.Add(e->GetStats());
   }
+  ret.AddInteger("count-reads", static_cast<int64_t>(num_reads_));
   return ret;
 }
 
@@ -34,6 +34,7 @@ namespace genie::core {
  */
 class FlowGraphDecode final : public FlowGraph {
   util::ThreadManager mgr_;  //!< @brief
+  uint64_t num_reads_{};     //!< @brief Reads decoded by the last Run().
   std::vector<std::unique_ptr<FormatImporterCompressed>>
       importers_;  //!< @brief
 
@@ -7,6 +7,7 @@
 
 #include "genie/core/flow_graph_encode.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -45,6 +46,7 @@ void FlowGraphEncode::AddImporter(std::unique_ptr<FormatImporter> dat) {
 
 void FlowGraphEncode::SetClassifier(std::unique_ptr<Classifier> classifier) {
   classifier_ = std::move(classifier);
+  classifier_->SetMemoryBudget(&budget_);
 
   for (const auto& i : importers_) {
     i->SetClassifier(classifier_.get());
@@ -58,6 +60,13 @@ void FlowGraphEncode::SetImporter(std::unique_ptr<FormatImporter> dat,
   importers_[index] = std::move(dat);
   importers_[index]->SetDrain(&read_selector_);
   importers_[index]->SetClassifier(classifier_.get());
+  importers_[index]->SetMemoryBudget(&budget_);
+}
+
+// -----------------------------------------------------------------------------
+
+void FlowGraphEncode::SetMemoryLimit(const size_t bytes) {
+  budget_.SetLimit(bytes);
 }
 
 // -----------------------------------------------------------------------------
@@ -190,13 +199,25 @@ void FlowGraphEncode::SetExporterSelector(
 // -----------------------------------------------------------------------------
 
 void FlowGraphEncode::Run() {
+  // Coders learning from their input see its start in section order
+  size_t warm_up = 0;
+  for (const auto& e : entropy_coders_) {
+    warm_up = std::max(warm_up, e->GetWarmUp());
+  }
+  if (warm_up && !importers_.empty()) {
+    importers_.front()->SetWarmUp(warm_up, [this] {
+      for (const auto& e : entropy_coders_) {
+        e->FinishWarmUp();
+      }
+    });
+  }
   std::vector<util::OriginalSource*> imps;
   imps.reserve(importers_.size());
   for (auto& i : importers_) {
     imps.emplace_back(i.get());
   }
   mgr_.SetSource(std::move(imps));
-  mgr_.Run();
+  num_reads_ = mgr_.Run();
 }
 
 // -----------------------------------------------------------------------------
@@ -210,6 +231,8 @@ stats::PerfStats FlowGraphEncode::GetStats() {
   for (const auto& e : exporters_) {
     ret.Add(e->GetStats());
   }
+  ret.AddInteger("memory-peak", static_cast<int64_t>(budget_.GetPeak()));
+  ret.AddInteger("count-reads", static_cast<int64_t>(num_reads_));
   return ret;
 }
 
@@ -221,6 +244,11 @@ meta::Dataset FlowGraphEncode::GetMeta() const {
   if (!ref_sources_.empty()) {
     ret.SetReference(this->ref_sources_.front()->GetMeta());
   }
+  for (const auto& e : exporters_) {
+    for (const auto& au : e->GetAccessUnitMeta()) {
+      ret.AddAccessUnit(au);
+    }
+  }
   return ret;
 }
 
@@ -19,6 +19,7 @@
 #include "genie/core/format_importer.h"
 #include "genie/core/read_encoder.h"
 #include "genie/core/reference_source.h"
+#include "genie/util/memory_budget.h"
 #include "genie/util/selector.h"
 #include "genie/util/thread_manager.h"
 
@@ -30,7 +31,9 @@ namespace genie::core {
  * @brief
  */
 class FlowGraphEncode final : public FlowGraph {
+  util::MemoryBudget budget_;                                  //!< @brief
   util::ThreadManager mgr_;                                    //!< @brief
+  uint64_t num_reads_{};                                       //!< @brief
   std::unique_ptr<ReferenceManager> ref_mgr_;                  //!< @brief
   std::vector<std::unique_ptr<ReferenceSource>> ref_sources_;  //!< @brief
   std::unique_ptr<Classifier> classifier_;                     //!< @brief
@@ -88,6 +91,15 @@ class FlowGraphEncode final : public FlowGraph {
    */
   void SetClassifier(std::unique_ptr<Classifier> classifier);
 
+  /**
+   * @brief Limits the memory held by the records and access units in flight.
+   * Importers stall while the limit is reached. Records the classifier needs
+   * to complete an access unit are always admitted, so the limit should not
+   * be lower than a few access units.
+   * @param bytes Maximum number of bytes, 0 for no limit.
+   */
+  void SetMemoryLimit(size_t bytes);
+
   /**
    * @brief
    * @param dat
@@ -7,6 +7,9 @@
 
 #include "genie/core/format_exporter_compressed.h"
 
+#include <utility>
+#include <vector>
+
 // -----------------------------------------------------------------------------
 
 namespace genie::core {
@@ -17,6 +20,25 @@ stats::PerfStats& FormatExporterCompressed::GetStats() { return stats_; }
 
 // -----------------------------------------------------------------------------
 
+void FormatExporterCompressed::AddAccessUnitMeta(const size_t id,
+                                                 const AccessUnit& au) {
+  if (!au.GetStatistics()) {
+    return;
+  }
+  meta::AccessUnit meta(id);
+  meta.SetStatistics(*au.GetStatistics());
+  au_meta_.emplace_back(std::move(meta));
+}
+
+// -----------------------------------------------------------------------------
+
+const std::vector<meta::AccessUnit>&
+FormatExporterCompressed::GetAccessUnitMeta() const {
+  return au_meta_;
+}
+
+// -----------------------------------------------------------------------------
+
 void FormatExporterCompressed::SkipIn(const util::Section&) {}
 
 // -----------------------------------------------------------------------------
@@ -10,7 +10,10 @@
 
 // -----------------------------------------------------------------------------
 
+#include <vector>
+
 #include "genie/core/access_unit.h"
+#include "genie/core/meta/access_unit.h"
 #include "genie/util/drain.h"
 
 // -----------------------------------------------------------------------------
@@ -23,6 +26,17 @@ namespace genie::core {
 class FormatExporterCompressed : public util::Drain<AccessUnit> {
   stats::PerfStats stats_;  //!< @brief
 
+  /// Metadata of the written access units
+  std::vector<meta::AccessUnit> au_meta_;
+
+ protected:
+  /**
+   * @brief Keep the record statistics of a written access unit
+   * @param id ID the access unit was written with
+   * @param au Access unit
+   */
+  void AddAccessUnitMeta(size_t id, const AccessUnit& au);
+
  public:
   /**
    * @brief
@@ -30,6 +44,12 @@ class FormatExporterCompressed : public util::Drain<AccessUnit> {
    */
   stats::PerfStats& GetStats();
 
+  /**
+   * @brief
+   * @return Metadata of the written access units
+   */
+  [[nodiscard]] const std::vector<meta::AccessUnit>& GetAccessUnitMeta() const;
+
   /**
    * @brief
    * @param id
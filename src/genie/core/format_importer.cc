@@ -9,6 +9,9 @@
 
 #include <utility>
 
+#include "genie/core/stats/stage_timer.h"
+#include "genie/util/trace.h"
+
 // -----------------------------------------------------------------------------
 
 namespace genie::core {
@@ -21,37 +24,97 @@ void FormatImporter::SetClassifier(Classifier* classifier) {
 
 // -----------------------------------------------------------------------------
 
+void FormatImporter::SetMemoryBudget(util::MemoryBudget* budget) {
+  budget_ = budget;
+}
+
+// -----------------------------------------------------------------------------
+
+void FormatImporter::PrepareRetrieve() {}
+
+// -----------------------------------------------------------------------------
+
+void FormatImporter::SetWarmUp(const size_t sections,
+                               std::function<void()> done) {
+  warm_up_ = sections;
+  warm_up_done_ = std::move(done);
+}
+
+// -----------------------------------------------------------------------------
+
 bool FormatImporter::Pump(uint64_t& id, std::mutex& lock) {
   record::Chunk chunk;
   util::Section sec{};
+  bool stalled = false;
+  if (!budget_ || !budget_->IsExhausted()) {
+    util::TraceScope trace("prepare", "import", util::TraceScope::kNone);
+    stats::StageTimer import(stats::Stage::kImport);
+    PrepareRetrieve();
+  }
+  // During the warm-up the lock is kept until the chunk left the pipeline
+  std::unique_lock guard(lock, std::defer_lock);
   {
-    std::unique_lock guard(lock);
+    {
+      util::TraceScope wait("importer-lock", "wait", util::TraceScope::kNone);
+      guard.lock();
+    }
+    stats::StageTimer classify(stats::Stage::kClassify);
     chunk = classifier_->GetChunk();
+    classify.Stop();
     uint32_t segment_count = 0;
-    for (const auto& r : chunk.GetData()) {
-      segment_count += static_cast<uint32_t>(r.GetSegments().size());
+    if (chunk.IsBatched()) {
+      segment_count = static_cast<uint32_t>(chunk.GetBatch().GetNumSegments());
+    } else {
+      for (const auto& r : chunk.GetData()) {
+        segment_count += static_cast<uint32_t>(r.GetSegments().size());
+      }
     }
-    if (chunk.GetData().empty()) {
+    if (chunk.Empty()) {
       segment_count = 1;
     }
-    if (!chunk.GetData().empty() || !chunk.GetRefToWrite().empty()) {
+    if (!chunk.Empty() || !chunk.GetRefToWrite().empty()) {
       sec = {id, segment_count, true};
       id += segment_count;
+    } else if (budget_ && budget_->IsExhausted()) {
+      stalled = true;
     } else {
+      util::TraceScope trace("pump", "import", util::TraceScope::kNone);
+      stats::StageTimer import(stats::Stage::kImport);
       const bool data_left = PumpRetrieve(classifier_);
+      import.Stop();
+      trace.Stop();
       if (!data_left && !flushing_) {
+        util::TraceScope flush_trace("flush", "classify",
+                                     util::TraceScope::kNone);
+        stats::StageTimer flush(stats::Stage::kClassify);
         classifier_->Flush();
         flushing_ = true;
         return true;
       }
       if (!data_left && flushing_) {
         flushing_ = false;
+        if (warm_up_) {
+          warm_up_ = 0;
+          warm_up_done_();
+        }
         return false;
       }
     }
   }
-  if (!chunk.GetData().empty() || !chunk.GetRefToWrite().empty()) {
+  if (stalled) {
+    // Wait outside of the lock, other threads may still hand out chunks
+    guard.unlock();
+    budget_->WaitForSpace();
+    return true;
+  }
+  if (!warm_up_) {
+    guard.unlock();
+  }
+  if (!chunk.Empty() || !chunk.GetRefToWrite().empty()) {
     FlowOut(std::move(chunk), sec);
+    if (guard.owns_lock() && --warm_up_ == 0) {
+      warm_up_done_();
+    }
   }
   return true;
 }
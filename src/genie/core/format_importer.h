@@ -10,10 +10,12 @@
 
 // -----------------------------------------------------------------------------
 
+#include <functional>
 #include <mutex>  //NOLINT
 
 #include "genie/core/access_unit.h"
 #include "genie/core/classifier.h"
+#include "genie/util/memory_budget.h"
 #include "genie/util/original_source.h"
 #include "genie/util/source.h"
 
@@ -27,8 +29,11 @@ namespace genie::core {
  */
 class FormatImporter : public util::OriginalSource,
                        public util::Source<record::Chunk> {
-  Classifier* classifier_ = nullptr;  //!< @brief
-  bool flushing_{false};              //!< @brief
+  Classifier* classifier_ = nullptr;      //!< @brief
+  bool flushing_{false};                  //!< @brief
+  util::MemoryBudget* budget_ = nullptr;  //!< @brief
+  size_t warm_up_ = 0;                    //!< @brief Sections left in order
+  std::function<void()> warm_up_done_;    //!< @brief Called at their end
 
  protected:
   /**
@@ -38,6 +43,13 @@ class FormatImporter : public util::OriginalSource,
    */
   virtual bool PumpRetrieve(Classifier* classifier) = 0;
 
+  /**
+   * @brief Called by Pump() before the importer lock is taken, so it runs on
+   * several threads at once. Importers that can read input concurrently
+   * parse it here and only hand it to the classifier in PumpRetrieve().
+   */
+  virtual void PrepareRetrieve();
+
  public:
   /**
    * @brief
@@ -45,6 +57,23 @@ class FormatImporter : public util::OriginalSource,
    */
   void SetClassifier(Classifier* classifier);
 
+  /**
+   * @brief Sets the budget to respect. Once it is exhausted, no further
+   * records are imported until the pipeline has released memory.
+   * @param budget Budget, nullptr for no limit.
+   */
+  void SetMemoryBudget(util::MemoryBudget* budget);
+
+  /**
+   * @brief Passes the first sections through the pipeline one at a time and
+   * in section order, before importing in parallel. Coders learning from the
+   * data they see then produce the same output with any thread count.
+   * @param sections Number of sections to pass in order.
+   * @param done Called once after the last of them left the pipeline, or when
+   * the input ended before.
+   */
+  void SetWarmUp(size_t sections, std::function<void()> done);
+
   /**
    * @brief
    * @param id
@@ -33,7 +33,11 @@ AccessUnit::AccessUnit(const nlohmann::json& obj)
     : access_unit_id_(obj["access_unit_ID"]) {
   au_information_value_ = obj.at("AU_information_value");
   au_protection_value_ = obj.at("AU_protection_value");
-  UTILS_DIE_IF(au_information_value_.empty() && au_protection_value_.empty(),
+  if (obj.contains("AU_statistics")) {
+    statistics_ = stats::AuStatistics(obj["AU_statistics"]);
+  }
+  UTILS_DIE_IF(au_information_value_.empty() && au_protection_value_.empty() &&
+                   !statistics_,
                "Empty AU metadata");
 }
 
@@ -44,6 +48,9 @@ nlohmann::json AccessUnit::ToJson() const {
   ret["access_unit_ID"] = access_unit_id_;
   ret["AU_information_value"] = au_information_value_;
   ret["AU_protection_value"] = au_protection_value_;
+  if (statistics_) {
+    ret["AU_statistics"] = statistics_->ToJson();
+  }
   return ret;
 }
 
@@ -89,6 +96,18 @@ std::string& AccessUnit::GetProtection() { return au_protection_value_; }
 
 // -----------------------------------------------------------------------------
 
+void AccessUnit::SetStatistics(stats::AuStatistics statistics) {
+  statistics_ = std::move(statistics);
+}
+
+// -----------------------------------------------------------------------------
+
+const std::optional<stats::AuStatistics>& AccessUnit::GetStatistics() const {
+  return statistics_;
+}
+
+// -----------------------------------------------------------------------------
+
 }  // namespace genie::core::meta
 
 // -----------------------------------------------------------------------------
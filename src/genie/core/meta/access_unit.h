@@ -10,8 +10,10 @@
 
 // -----------------------------------------------------------------------------
 
+#include <optional>
 #include <string>
 
+#include "genie/core/stats/au_statistics.h"
 #include "nlohmann/json.hpp"
 
 // -----------------------------------------------------------------------------
@@ -26,6 +28,9 @@ class AccessUnit {
   std::string au_information_value_;  //!< @brief MPEG-G Part 3 metadata
   std::string au_protection_value_;   //!< @brief MPEG-G Part 3 protection data
 
+  /// Record statistics computed by the encoder
+  std::optional<stats::AuStatistics> statistics_;
+
  public:
   /**
    * @brief Construct from raw data
@@ -94,6 +99,19 @@ class AccessUnit {
    * @return
    */
   std::string& GetProtection();
+
+  /**
+   * @brief
+   * @param statistics Record statistics computed by the encoder
+   */
+  void SetStatistics(stats::AuStatistics statistics);
+
+  /**
+   * @brief
+   * @return Record statistics, if the encoder computed them
+   */
+  [[nodiscard]] const std::optional<stats::AuStatistics>& GetStatistics()
+      const;
 };
 
 // -----------------------------------------------------------------------------
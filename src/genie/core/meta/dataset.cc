@@ -146,6 +146,21 @@ const std::vector<AccessUnit>& Dataset::GetAUs() const { return access_units_; }
 
 // -----------------------------------------------------------------------------
 
+stats::AuStatistics Dataset::GetStatistics(const uint16_t seq_id,
+                                           const uint64_t start_pos,
+                                           const uint64_t end_pos) const {
+  stats::AuStatistics ret;
+  for (const auto& au : access_units_) {
+    if (au.GetStatistics() &&
+        au.GetStatistics()->Overlaps(seq_id, start_pos, end_pos)) {
+      ret.Merge(*au.GetStatistics());
+    }
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
 const std::vector<DescriptorStream>& Dataset::GetDSs() const {
   return descriptor_streams_;
 }
@@ -176,6 +176,18 @@ class Dataset {
    */
   std::vector<AccessUnit>& GetAUs();
 
+  /**
+   * @brief Merge the record statistics of all access units with mapped
+   * records in a range. Nothing is decoded.
+   * @param seq_id Reference sequence
+   * @param start_pos First position of the range
+   * @param end_pos Last position of the range
+   * @return Statistics of the range, empty if no access unit has statistics
+   */
+  [[nodiscard]] stats::AuStatistics GetStatistics(uint16_t seq_id,
+                                                  uint64_t start_pos,
+                                                  uint64_t end_pos) const;
+
   /**
    * @brief Return list of descriptor stream meta information blocks
    * @return Descriptor stream blocks
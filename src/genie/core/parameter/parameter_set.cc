@@ -253,6 +253,10 @@ bool EncodingSet::IsComputedReference() const {
 
 // -----------------------------------------------------------------------------
 
+bool EncodingSet::IsSplicedReads() const { return spliced_reads_flag_; }
+
+// -----------------------------------------------------------------------------
+
 void EncodingSet::SetComputedRef(const ComputedRef& computed_reference) {
   computed_reference_ = computed_reference;
 }
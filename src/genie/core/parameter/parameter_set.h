@@ -93,6 +93,12 @@ class EncodingSet {
    */
   [[nodiscard]] bool IsComputedReference() const;
 
+  /**
+   * @brief
+   * @return True if the msar descriptor carries spliced alignments.
+   */
+  [[nodiscard]] bool IsSplicedReads() const;
+
   /**
    * @brief
    * @return
@@ -9,6 +9,9 @@
 
 #include <utility>
 
+#include "genie/core/stats/stage_timer.h"
+#include "genie/util/trace.h"
+
 // -----------------------------------------------------------------------------
 
 namespace genie::core {
@@ -31,8 +34,10 @@ void ReadDecoder::SetEntropyCoder(entropy_selector* coder) {
 
 AccessUnit ReadDecoder::EntropyCodeAu(entropy_selector* select, AccessUnit&& a,
                                       const bool mm_coder_enabled) {
+  stats::StageTimer timer(stats::Stage::kEntropy);
   AccessUnit au = std::move(a);
   for (auto& d : au) {
+    util::TraceScope trace(GetDescriptor(d.GetId()).name.c_str(), "entropy");
     auto enc = select->Process(au.GetParameters().GetDescriptor(d.GetId()), d,
                                mm_coder_enabled);
     au.Set(d.GetId(), std::move(std::get<0>(enc)));
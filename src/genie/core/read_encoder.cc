@@ -11,6 +11,9 @@
 #include <fstream>
 #include <utility>
 
+#include "genie/core/stats/stage_timer.h"
+#include "genie/util/trace.h"
+
 // -----------------------------------------------------------------------------
 
 namespace genie::core {
@@ -36,6 +39,7 @@ void ReadEncoder::SetEntropyCoder(entropy_selector* coder) {
 
 AccessUnit ReadEncoder::EntropyCodeAu(entropy_selector* entropycoder,
                                       AccessUnit&& a, bool write_raw) {
+  stats::StageTimer timer(stats::Stage::kEntropy);
   AccessUnit au = std::move(a);
   if (write_raw) {
     static std::atomic<uint64_t> id(0);
@@ -56,6 +60,7 @@ AccessUnit ReadEncoder::EntropyCodeAu(entropy_selector* entropycoder,
     }
   }
   for (auto& d : au) {
+    util::TraceScope trace(GetDescriptor(d.GetId()).name.c_str(), "entropy");
     auto encoded = entropycoder->Process(d);
     au.GetParameters().SetDescriptor(d.GetId(),
                                      std::move(std::get<0>(encoded)));
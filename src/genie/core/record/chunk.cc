@@ -10,6 +10,8 @@
 #include <utility>
 #include <vector>
 
+#include "genie/util/runtime_exception.h"
+
 // -----------------------------------------------------------------------------
 
 namespace genie::core::record {
@@ -46,11 +48,46 @@ size_t Chunk::GetRefId() const { return ref_id_; }
 
 // -----------------------------------------------------------------------------
 
-std::vector<Record>& Chunk::GetData() { return data_; }
+void Chunk::MaterializeRecords() {
+  if (!batch_.Empty()) {
+    batch_.MoveTo(data_);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+std::vector<Record>& Chunk::GetData() {
+  MaterializeRecords();
+  return data_;
+}
+
+// -----------------------------------------------------------------------------
+
+const std::vector<Record>& Chunk::GetData() const {
+  UTILS_DIE_IF(!batch_.Empty(),
+               "Chunk records are batched, materialize them first");
+  return data_;
+}
+
+// -----------------------------------------------------------------------------
+
+RecordBatch& Chunk::GetBatch() { return batch_; }
 
 // -----------------------------------------------------------------------------
 
-const std::vector<Record>& Chunk::GetData() const { return data_; }
+const RecordBatch& Chunk::GetBatch() const { return batch_; }
+
+// -----------------------------------------------------------------------------
+
+bool Chunk::IsBatched() const { return data_.empty() && !batch_.Empty(); }
+
+// -----------------------------------------------------------------------------
+
+size_t Chunk::Size() const { return data_.size() + batch_.Size(); }
+
+// -----------------------------------------------------------------------------
+
+bool Chunk::Empty() const { return data_.empty() && batch_.Empty(); }
 
 // -----------------------------------------------------------------------------
 
@@ -70,6 +107,10 @@ void Chunk::SetReferenceOnly(const bool ref) { reference_only_ = ref; }
 
 // -----------------------------------------------------------------------------
 
+util::MemoryBudget::Reservation& Chunk::GetMemory() { return memory_; }
+
+// -----------------------------------------------------------------------------
+
 }  // namespace genie::core::record
 
 // -----------------------------------------------------------------------------
@@ -14,8 +14,10 @@
 #include <vector>
 
 #include "genie/core/record/record.h"
+#include "genie/core/record/record_batch.h"
 #include "genie/core/reference_manager.h"
 #include "genie/core/stats/perf_stats.h"
+#include "genie/util/memory_budget.h"
 
 // -----------------------------------------------------------------------------
 
@@ -26,19 +28,60 @@ namespace genie::core::record {
  */
 class Chunk {
   std::vector<Record> data_;                             //!< @brief
+  RecordBatch batch_;                                    //!< @brief
   ReferenceManager::ReferenceExcerpt reference_;         //!< @brief
   std::vector<std::pair<size_t, size_t>> ref_to_write_;  //!< @brief
   size_t ref_id_{};                                      //!< @brief
   stats::PerfStats stats_;                               //!< @brief
   bool reference_only_{false};                           //!< @brief
+  util::MemoryBudget::Reservation memory_;               //!< @brief
 
  public:
   /**
-   * @brief
+   * @brief Converts the records still held in the columnar batch to record
+   * objects, appended to GetData(). Leaves the batch empty.
+   */
+  void MaterializeRecords();
+
+  /**
+   * @brief Records of the chunk. Records still held in the columnar batch
+   * are converted to record objects first, see MaterializeRecords().
    * @return
    */
   std::vector<Record>& GetData();
 
+  /**
+   * @brief Columnar records of the chunk, for producers and consumers that
+   * work without record objects. Emptied by MaterializeRecords().
+   * @return
+   */
+  RecordBatch& GetBatch();
+
+  /**
+   * @brief
+   * @return
+   */
+  [[nodiscard]] const RecordBatch& GetBatch() const;
+
+  /**
+   * @brief
+   * @return True if all records are held in the batch. Consumers can then
+   * read the batch instead of calling GetData().
+   */
+  [[nodiscard]] bool IsBatched() const;
+
+  /**
+   * @brief
+   * @return Number of records, counted without converting the batch
+   */
+  [[nodiscard]] size_t Size() const;
+
+  /**
+   * @brief
+   * @return True if there are no records
+   */
+  [[nodiscard]] bool Empty() const;
+
   /**
    * @brief
    * @return
@@ -78,7 +121,9 @@ class Chunk {
   [[nodiscard]] size_t GetRefId() const;
 
   /**
-   * @brief
+   * @brief Records of the chunk, without converting the batch. Dies if
+   * records are still batched, read GetBatch() or call MaterializeRecords()
+   * on a mutable chunk instead.
    * @return
    */
   [[nodiscard]] const std::vector<Record>& GetData() const;
@@ -106,6 +151,13 @@ class Chunk {
    * @param ref
    */
   void SetReferenceOnly(bool ref);
+
+  /**
+   * @brief
+   * @return Reservation covering the memory held by the records. Passed on to
+   * the access unit encoded from this chunk.
+   */
+  util::MemoryBudget::Reservation& GetMemory();
 };
 
 // -----------------------------------------------------------------------------
@@ -357,6 +357,22 @@ void Record::SetMoreAlignmentInfo(
 
 // -----------------------------------------------------------------------------
 
+size_t Record::GetMemoryUsage() const {
+  size_t ret = sizeof(Record) + read_name_.capacity() + read_group_.capacity();
+  for (const auto& r : reads_) {
+    ret += sizeof(Segment) + r.GetSequence().capacity();
+    for (const auto& q : r.GetQualities()) {
+      ret += sizeof(std::string) + q.capacity();
+    }
+  }
+  for (const auto& a : alignment_info_) {
+    ret += sizeof(AlignmentBox) + a.GetAlignment().GetECigar().capacity();
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
 }  // namespace genie::core::record
 
 // -----------------------------------------------------------------------------
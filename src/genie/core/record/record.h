@@ -302,6 +302,13 @@ class Record {
    */
   void SetMoreAlignmentInfo(
       std::unique_ptr<AlignmentExternal> more_alignment_info);
+
+  /**
+   * @brief Estimates the memory held by the record, including sequences,
+   * qualities, names and CIGARs. Used for memory accounting in the pipeline.
+   * @return Approximate size in bytes.
+   */
+  [[nodiscard]] size_t GetMemoryUsage() const;
 };
 
 // -----------------------------------------------------------------------------
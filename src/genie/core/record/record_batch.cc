@@ -0,0 +1,385 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/core/record/record_batch.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "genie/util/runtime_exception.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::core::record {
+
+// -----------------------------------------------------------------------------
+
+std::string_view RecordBatch::Get(const std::string& buffer,
+                                  const std::vector<uint64_t>& offsets,
+                                  const size_t index) {
+  return std::string_view(buffer).substr(
+      offsets[index], offsets[index + 1] - offsets[index]);
+}
+
+// -----------------------------------------------------------------------------
+
+RecordBatch::RecordBatch(RecordBatch&& other) noexcept { Swap(other); }
+
+// -----------------------------------------------------------------------------
+
+RecordBatch& RecordBatch::operator=(RecordBatch&& other) noexcept {
+  Swap(other);
+  other.Clear();
+  return *this;
+}
+
+// -----------------------------------------------------------------------------
+
+void RecordBatch::Swap(RecordBatch& other) noexcept {
+  name_offsets_.swap(other.name_offsets_);
+  names_.swap(other.names_);
+  group_offsets_.swap(other.group_offsets_);
+  groups_.swap(other.groups_);
+  segment_offsets_.swap(other.segment_offsets_);
+  num_template_segments_.swap(other.num_template_segments_);
+  class_ids_.swap(other.class_ids_);
+  flags_.swap(other.flags_);
+  read_1_first_.swap(other.read_1_first_);
+  seq_ids_.swap(other.seq_ids_);
+  positions_.swap(other.positions_);
+  reverse_comp_.swap(other.reverse_comp_);
+  mapping_scores_.swap(other.mapping_scores_);
+  ecigar_offsets_.swap(other.ecigar_offsets_);
+  ecigars_.swap(other.ecigars_);
+  sequence_offsets_.swap(other.sequence_offsets_);
+  sequences_.swap(other.sequences_);
+  quality_offsets_.swap(other.quality_offsets_);
+  qualities_.swap(other.qualities_);
+}
+
+// -----------------------------------------------------------------------------
+
+void RecordBatch::AddRecord(const std::string_view name,
+                            const std::string_view group,
+                            const uint8_t num_template_segments,
+                            const ClassType class_id, const uint8_t flags,
+                            const bool read_1_first) {
+  names_ += name;
+  name_offsets_.push_back(names_.size());
+  groups_ += group;
+  group_offsets_.push_back(groups_.size());
+  segment_offsets_.push_back(segment_offsets_.back());
+  num_template_segments_.push_back(num_template_segments);
+  class_ids_.push_back(class_id);
+  flags_.push_back(flags);
+  read_1_first_.push_back(read_1_first);
+  seq_ids_.push_back(0);
+  positions_.push_back(kUnmapped);
+  reverse_comp_.push_back(0);
+  mapping_scores_.push_back(kNoScore);
+  ecigar_offsets_.push_back(ecigars_.size());
+}
+
+// -----------------------------------------------------------------------------
+
+char* RecordBatch::AddSegment(const size_t length) {
+  UTILS_DIE_IF(Empty(), "Segment added before its record");
+  segment_offsets_.back() += 1;
+  const auto start = sequences_.size();
+  sequences_.resize(start + length);
+  sequence_offsets_.push_back(sequences_.size());
+  return sequences_.data() + start;
+}
+
+// -----------------------------------------------------------------------------
+
+void RecordBatch::AddQualities(const size_t segment,
+                               const std::string_view qualities) {
+  UTILS_DIE_IF(segment >= GetNumSegments(),
+               "Quality values added without segment");
+  UTILS_DIE_IF(segment + 1 < quality_offsets_.size(),
+               "Quality values added out of order");
+  quality_offsets_.resize(segment + 1, qualities_.size());
+  qualities_ += qualities;
+  quality_offsets_.push_back(qualities_.size());
+}
+
+// -----------------------------------------------------------------------------
+
+void RecordBatch::SetAlignment(const uint16_t seq_id, const uint64_t position,
+                               const std::string_view ecigar,
+                               const uint8_t reverse_comp,
+                               const int32_t mapping_score) {
+  UTILS_DIE_IF(Empty(), "Alignment added before its record");
+  UTILS_DIE_IF(positions_.back() != kUnmapped, "Record already aligned");
+  seq_ids_.back() = seq_id;
+  positions_.back() = position;
+  reverse_comp_.back() = reverse_comp;
+  mapping_scores_.back() = mapping_score;
+  ecigars_ += ecigar;
+  ecigar_offsets_.back() = ecigars_.size();
+}
+
+// -----------------------------------------------------------------------------
+
+void RecordBatch::Add(const Record& rec) {
+  UTILS_DIE_IF(rec.GetAlignments().size() > 1 ||
+                   (!rec.GetAlignments().empty() &&
+                    !rec.GetAlignments().front().GetAlignmentSplits().empty()),
+               "Record batches hold one alignment per record");
+  AddRecord(rec.GetName(), rec.GetGroup(), rec.GetNumberOfTemplateSegments(),
+            rec.GetClassId(), rec.GetFlags(), rec.IsRead1First());
+  for (const auto& s : rec.GetSegments()) {
+    const auto& seq = s.GetSequence();
+    seq.copy(AddSegment(seq.size()), seq.size());
+    if (!s.GetQualities().empty()) {
+      AddQualities(GetNumSegments() - 1, s.GetQualities().front());
+    }
+  }
+  if (!rec.GetAlignments().empty()) {
+    const auto& box = rec.GetAlignments().front();
+    const auto& scores = box.GetAlignment().GetMappingScores();
+    SetAlignment(rec.GetAlignmentSharedData().GetSeqId(), box.GetPosition(),
+                 box.GetAlignment().GetECigar(),
+                 box.GetAlignment().GetRComp(),
+                 scores.empty() ? kNoScore : scores.front());
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void RecordBatch::Append(const RecordBatch& other, const size_t rec) {
+  AddRecord(other.GetName(rec), other.GetGroup(rec),
+            other.GetNumberOfTemplateSegments(rec), other.GetClassId(rec),
+            other.GetFlags(rec), other.IsRead1First(rec));
+  for (size_t s = other.GetFirstSegment(rec);
+       s < other.segment_offsets_[rec + 1]; ++s) {
+    const auto seq = other.GetSequence(s);
+    seq.copy(AddSegment(seq.size()), seq.size());
+    if (const auto qualities = other.GetQualities(s); !qualities.empty()) {
+      AddQualities(GetNumSegments() - 1, qualities);
+    }
+  }
+  if (other.GetPosition(rec) != kUnmapped) {
+    SetAlignment(other.GetSeqId(rec), other.GetPosition(rec),
+                 other.GetECigar(rec), other.GetRComp(rec),
+                 other.GetMappingScore(rec));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+size_t RecordBatch::Size() const { return class_ids_.size(); }
+
+// -----------------------------------------------------------------------------
+
+bool RecordBatch::Empty() const { return class_ids_.empty(); }
+
+// -----------------------------------------------------------------------------
+
+size_t RecordBatch::GetNumSegments() const {
+  return sequence_offsets_.size() - 1;
+}
+
+// -----------------------------------------------------------------------------
+
+size_t RecordBatch::GetFirstSegment(const size_t rec) const {
+  return segment_offsets_[rec];
+}
+
+// -----------------------------------------------------------------------------
+
+size_t RecordBatch::GetNumSegments(const size_t rec) const {
+  return segment_offsets_[rec + 1] - segment_offsets_[rec];
+}
+
+// -----------------------------------------------------------------------------
+
+std::string_view RecordBatch::GetName(const size_t rec) const {
+  return Get(names_, name_offsets_, rec);
+}
+
+// -----------------------------------------------------------------------------
+
+std::string_view RecordBatch::GetGroup(const size_t rec) const {
+  return Get(groups_, group_offsets_, rec);
+}
+
+// -----------------------------------------------------------------------------
+
+uint8_t RecordBatch::GetNumberOfTemplateSegments(const size_t rec) const {
+  return num_template_segments_[rec];
+}
+
+// -----------------------------------------------------------------------------
+
+ClassType RecordBatch::GetClassId(const size_t rec) const {
+  return class_ids_[rec];
+}
+
+// -----------------------------------------------------------------------------
+
+uint8_t RecordBatch::GetFlags(const size_t rec) const { return flags_[rec]; }
+
+// -----------------------------------------------------------------------------
+
+bool RecordBatch::IsRead1First(const size_t rec) const {
+  return read_1_first_[rec];
+}
+
+// -----------------------------------------------------------------------------
+
+uint16_t RecordBatch::GetSeqId(const size_t rec) const {
+  return seq_ids_[rec];
+}
+
+// -----------------------------------------------------------------------------
+
+uint64_t RecordBatch::GetPosition(const size_t rec) const {
+  return positions_[rec];
+}
+
+// -----------------------------------------------------------------------------
+
+std::string_view RecordBatch::GetECigar(const size_t rec) const {
+  return Get(ecigars_, ecigar_offsets_, rec);
+}
+
+// -----------------------------------------------------------------------------
+
+uint8_t RecordBatch::GetRComp(const size_t rec) const {
+  return reverse_comp_[rec];
+}
+
+// -----------------------------------------------------------------------------
+
+int32_t RecordBatch::GetMappingScore(const size_t rec) const {
+  return mapping_scores_[rec];
+}
+
+// -----------------------------------------------------------------------------
+
+std::string_view RecordBatch::GetSequence(const size_t segment) const {
+  return Get(sequences_, sequence_offsets_, segment);
+}
+
+// -----------------------------------------------------------------------------
+
+std::string_view RecordBatch::GetQualities(const size_t segment) const {
+  if (segment + 1 >= quality_offsets_.size()) {
+    return {};
+  }
+  return Get(qualities_, quality_offsets_, segment);
+}
+
+// -----------------------------------------------------------------------------
+
+Record RecordBatch::GetRecord(const size_t rec) const {
+  Record ret(GetNumberOfTemplateSegments(rec), GetClassId(rec),
+             std::string(GetName(rec)), std::string(GetGroup(rec)),
+             GetFlags(rec), IsRead1First(rec));
+  uint8_t qv_depth = 0;
+  for (size_t s = GetFirstSegment(rec); s < segment_offsets_[rec + 1]; ++s) {
+    Segment seg{std::string(GetSequence(s))};
+    if (const auto qualities = GetQualities(s); !qualities.empty()) {
+      seg.AddQualities(std::string(qualities));
+      qv_depth = 1;
+    }
+    ret.AddSegment(std::move(seg));
+  }
+  ret.SetQvDepth(qv_depth);
+  if (GetPosition(rec) != kUnmapped) {
+    Alignment alignment(std::string(GetECigar(rec)), GetRComp(rec));
+    if (GetMappingScore(rec) != kNoScore) {
+      alignment.AddMappingScore(GetMappingScore(rec));
+    }
+    ret.AddAlignment(GetSeqId(rec),
+                     AlignmentBox(GetPosition(rec), std::move(alignment)));
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+void RecordBatch::MoveTo(std::vector<Record>& records) {
+  records.reserve(records.size() + Size());
+  for (size_t i = 0; i < Size(); ++i) {
+    records.emplace_back(GetRecord(i));
+  }
+  Clear();
+}
+
+// -----------------------------------------------------------------------------
+
+void RecordBatch::Clear() {
+  for (auto* offsets :
+       {&name_offsets_, &group_offsets_, &segment_offsets_, &ecigar_offsets_,
+        &sequence_offsets_, &quality_offsets_}) {
+    offsets->resize(1);
+  }
+  for (auto* buffer : {&names_, &groups_, &ecigars_, &sequences_,
+                       &qualities_}) {
+    buffer->clear();
+  }
+  num_template_segments_.clear();
+  class_ids_.clear();
+  flags_.clear();
+  read_1_first_.clear();
+  seq_ids_.clear();
+  positions_.clear();
+  reverse_comp_.clear();
+  mapping_scores_.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+size_t RecordBatch::GetMemoryUsage() const {
+  size_t ret = sizeof(RecordBatch);
+  for (const auto* offsets :
+       {&name_offsets_, &group_offsets_, &segment_offsets_, &ecigar_offsets_,
+        &sequence_offsets_, &quality_offsets_, &positions_}) {
+    ret += offsets->capacity() * sizeof(uint64_t);
+  }
+  for (const auto* buffer : {&names_, &groups_, &ecigars_, &sequences_,
+                             &qualities_}) {
+    ret += buffer->capacity();
+  }
+  ret += num_template_segments_.capacity() + flags_.capacity() +
+         read_1_first_.capacity() + reverse_comp_.capacity() +
+         class_ids_.capacity() * sizeof(ClassType) +
+         seq_ids_.capacity() * sizeof(uint16_t) +
+         mapping_scores_.capacity() * sizeof(int32_t);
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+size_t RecordBatch::GetMemoryUsage(const size_t rec) const {
+  const auto first = segment_offsets_[rec];
+  const auto last = segment_offsets_[rec + 1];
+  size_t ret = name_offsets_[rec + 1] - name_offsets_[rec] +
+               group_offsets_[rec + 1] - group_offsets_[rec] +
+               ecigar_offsets_[rec + 1] - ecigar_offsets_[rec] +
+               sequence_offsets_[last] - sequence_offsets_[first];
+  if (first + 1 < quality_offsets_.size()) {
+    const auto end = std::min<uint64_t>(last, quality_offsets_.size() - 1);
+    ret += quality_offsets_[end] - quality_offsets_[first];
+  }
+  // Offsets and scalar columns
+  ret += 5 * sizeof(uint64_t) + sizeof(ClassType) + sizeof(int32_t) +
+         sizeof(uint16_t) + 4 + (last - first) * 2 * sizeof(uint64_t);
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::core::record
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
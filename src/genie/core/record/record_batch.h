@@ -0,0 +1,352 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#ifndef SRC_GENIE_CORE_RECORD_RECORD_BATCH_H_
+#define SRC_GENIE_CORE_RECORD_RECORD_BATCH_H_
+
+// -----------------------------------------------------------------------------
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "genie/core/record/class_type.h"
+#include "genie/core/record/record.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::core::record {
+
+/**
+ * @brief Columnar alternative to a vector of records.
+ *
+ * All names, sequences and quality values live in one buffer per field with
+ * an offset array next to it, like Arrow string columns: entry i spans
+ * [offsets[i], offsets[i + 1]). Scalar fields are plain columns. Filling or
+ * reading a batch allocates per column, never per record.
+ *
+ * Each record holds at most one alignment of its first segment; split and
+ * secondary alignments are not represented. Decoders of unaligned data fill
+ * batches directly, all other data stays in Record objects.
+ */
+class RecordBatch {
+  /// Offsets into names_, one entry per record plus one
+  std::vector<uint64_t> name_offsets_{0};
+  std::string names_;  //!< @brief Concatenated read names
+
+  /// Offsets into groups_, one entry per record plus one
+  std::vector<uint64_t> group_offsets_{0};
+  std::string groups_;  //!< @brief Concatenated read groups
+
+  /// First segment of each record, one entry per record plus one
+  std::vector<uint64_t> segment_offsets_{0};
+
+  std::vector<uint8_t> num_template_segments_;  //!< @brief Per record
+  std::vector<ClassType> class_ids_;            //!< @brief Per record
+  std::vector<uint8_t> flags_;                  //!< @brief Per record
+  std::vector<uint8_t> read_1_first_;           //!< @brief Per record
+
+  std::vector<uint16_t> seq_ids_;        //!< @brief Per record
+  std::vector<uint64_t> positions_;      //!< @brief Per record
+  std::vector<uint8_t> reverse_comp_;    //!< @brief Per record
+  std::vector<int32_t> mapping_scores_;  //!< @brief Per record
+
+  /// Offsets into ecigars_, one entry per record plus one
+  std::vector<uint64_t> ecigar_offsets_{0};
+  std::string ecigars_;  //!< @brief Concatenated extended CIGARs
+
+  /// Offsets into sequences_, one entry per segment plus one
+  std::vector<uint64_t> sequence_offsets_{0};
+  std::string sequences_;  //!< @brief Concatenated sequences
+
+  /// Offsets into qualities_, one entry per segment up to the last one with
+  /// quality values plus one
+  std::vector<uint64_t> quality_offsets_{0};
+  std::string qualities_;  //!< @brief Concatenated quality values
+
+  /**
+   * @brief
+   * @param buffer
+   * @param offsets
+   * @param index
+   * @return Entry of a string column
+   */
+  static std::string_view Get(const std::string& buffer,
+                              const std::vector<uint64_t>& offsets,
+                              size_t index);
+
+ public:
+  /// Position of a record without alignment
+  static constexpr uint64_t kUnmapped = std::numeric_limits<uint64_t>::max();
+
+  /// Mapping score of an alignment without score
+  static constexpr int32_t kNoScore = std::numeric_limits<int32_t>::min();
+
+  /**
+   * @brief
+   */
+  RecordBatch() = default;
+
+  /**
+   * @brief
+   * @param other
+   */
+  RecordBatch(const RecordBatch& other) = default;
+
+  /**
+   * @brief Takes over the columns, other is left empty and usable
+   * @param other
+   */
+  RecordBatch(RecordBatch&& other) noexcept;
+
+  /**
+   * @brief
+   * @param other
+   * @return
+   */
+  RecordBatch& operator=(const RecordBatch& other) = default;
+
+  /**
+   * @brief Takes over the columns, other is left empty and usable
+   * @param other
+   * @return
+   */
+  RecordBatch& operator=(RecordBatch&& other) noexcept;
+
+  /**
+   * @brief
+   */
+  ~RecordBatch() = default;
+
+  /**
+   * @brief Exchange the contents of two batches
+   * @param other
+   */
+  void Swap(RecordBatch& other) noexcept;
+
+  /**
+   * @brief Start a new record, unmapped until SetAlignment() is called
+   * @param name Read name
+   * @param group Read group
+   * @param num_template_segments Number of segments of the template
+   * @param class_id Class
+   * @param flags Flags as in Record::Flags
+   * @param read_1_first Read 1 comes first
+   */
+  void AddRecord(std::string_view name, std::string_view group,
+                 uint8_t num_template_segments, ClassType class_id,
+                 uint8_t flags, bool read_1_first);
+
+  /**
+   * @brief Add a segment to the last record
+   * @param length Number of bases
+   * @return Buffer to write the bases to, valid until the next segment is
+   * added
+   */
+  char* AddSegment(size_t length);
+
+  /**
+   * @brief Set the quality values of a segment. Segments must be given in
+   * order; skipped segments get empty quality values.
+   * @param segment Segment index
+   * @param qualities Quality values
+   */
+  void AddQualities(size_t segment, std::string_view qualities);
+
+  /**
+   * @brief Set the alignment of the first segment of the last record
+   * @param seq_id Reference sequence
+   * @param position Mapping position
+   * @param ecigar Extended CIGAR
+   * @param reverse_comp Reverse complemented
+   * @param mapping_score Mapping score or kNoScore
+   */
+  void SetAlignment(uint16_t seq_id, uint64_t position,
+                    std::string_view ecigar, uint8_t reverse_comp,
+                    int32_t mapping_score);
+
+  /**
+   * @brief Append a record. Dies if it holds more than one alignment or
+   * split alignments.
+   * @param rec Record
+   */
+  void Add(const Record& rec);
+
+  /**
+   * @brief Append a copy of a record of another batch
+   * @param other Batch to copy from
+   * @param rec Record index in other
+   */
+  void Append(const RecordBatch& other, size_t rec);
+
+  /**
+   * @brief
+   * @return Number of records
+   */
+  [[nodiscard]] size_t Size() const;
+
+  /**
+   * @brief
+   * @return True if there are no records
+   */
+  [[nodiscard]] bool Empty() const;
+
+  /**
+   * @brief
+   * @return Number of segments of all records
+   */
+  [[nodiscard]] size_t GetNumSegments() const;
+
+  /**
+   * @brief
+   * @param rec Record index
+   * @return Index of the first segment of the record
+   */
+  [[nodiscard]] size_t GetFirstSegment(size_t rec) const;
+
+  /**
+   * @brief
+   * @param rec Record index
+   * @return Number of segments of the record
+   */
+  [[nodiscard]] size_t GetNumSegments(size_t rec) const;
+
+  /**
+   * @brief
+   * @param rec Record index
+   * @return Read name
+   */
+  [[nodiscard]] std::string_view GetName(size_t rec) const;
+
+  /**
+   * @brief
+   * @param rec Record index
+   * @return Read group
+   */
+  [[nodiscard]] std::string_view GetGroup(size_t rec) const;
+
+  /**
+   * @brief
+   * @param rec Record index
+   * @return Number of segments of the template
+   */
+  [[nodiscard]] uint8_t GetNumberOfTemplateSegments(size_t rec) const;
+
+  /**
+   * @brief
+   * @param rec Record index
+   * @return Class
+   */
+  [[nodiscard]] ClassType GetClassId(size_t rec) const;
+
+  /**
+   * @brief
+   * @param rec Record index
+   * @return Flags as in Record::Flags
+   */
+  [[nodiscard]] uint8_t GetFlags(size_t rec) const;
+
+  /**
+   * @brief
+   * @param rec Record index
+   * @return True if read 1 comes first
+   */
+  [[nodiscard]] bool IsRead1First(size_t rec) const;
+
+  /**
+   * @brief
+   * @param rec Record index
+   * @return Reference sequence, 0 if unmapped
+   */
+  [[nodiscard]] uint16_t GetSeqId(size_t rec) const;
+
+  /**
+   * @brief
+   * @param rec Record index
+   * @return Mapping position, kUnmapped if unmapped
+   */
+  [[nodiscard]] uint64_t GetPosition(size_t rec) const;
+
+  /**
+   * @brief
+   * @param rec Record index
+   * @return Extended CIGAR, empty if unmapped
+   */
+  [[nodiscard]] std::string_view GetECigar(size_t rec) const;
+
+  /**
+   * @brief
+   * @param rec Record index
+   * @return Reverse complement flag
+   */
+  [[nodiscard]] uint8_t GetRComp(size_t rec) const;
+
+  /**
+   * @brief
+   * @param rec Record index
+   * @return Mapping score, kNoScore if there is none
+   */
+  [[nodiscard]] int32_t GetMappingScore(size_t rec) const;
+
+  /**
+   * @brief
+   * @param segment Segment index
+   * @return Bases
+   */
+  [[nodiscard]] std::string_view GetSequence(size_t segment) const;
+
+  /**
+   * @brief
+   * @param segment Segment index
+   * @return Quality values, empty if the batch has none
+   */
+  [[nodiscard]] std::string_view GetQualities(size_t segment) const;
+
+  /**
+   * @brief Build a record object, for consumers that need one
+   * @param rec Record index
+   * @return Record
+   */
+  [[nodiscard]] Record GetRecord(size_t rec) const;
+
+  /**
+   * @brief Append all records as record objects and clear the batch
+   * @param records Vector to append to
+   */
+  void MoveTo(std::vector<Record>& records);
+
+  /**
+   * @brief Remove all records, keeping the allocated memory
+   */
+  void Clear();
+
+  /**
+   * @brief
+   * @return Bytes held by the batch
+   */
+  [[nodiscard]] size_t GetMemoryUsage() const;
+
+  /**
+   * @brief
+   * @param rec Record index
+   * @return Bytes taken up by one record in the columns
+   */
+  [[nodiscard]] size_t GetMemoryUsage(size_t rec) const;
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::core::record
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_CORE_RECORD_RECORD_BATCH_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -182,8 +182,8 @@ void ReferenceManager::ReferenceExcerpt::Extend(const size_t new_end) {
   if (new_end < global_end_) {
     return;
   }
-  const size_t id = (new_end - 1) / chunk_size_;
-  for (size_t i = data_.size() - 1; i < id; ++i) {
+  const size_t id = (new_end - 1) / chunk_size_ - global_start_ / chunk_size_;
+  while (data_.size() <= id) {
     data_.push_back(UndefPage());
   }
   global_end_ = new_end;
@@ -349,6 +349,21 @@ ReferenceManager::ReferenceExcerpt ReferenceManager::Load(
 
 // -----------------------------------------------------------------------------
 
+void ReferenceManager::LoadInto(ReferenceExcerpt& excerpt, const size_t start,
+                                const size_t end) {
+  UTILS_DIE_IF(start < excerpt.GetGlobalStart(),
+               "Reference excerpt can't grow to the left");
+  excerpt.Extend(end);
+  for (size_t i = start / chunk_size_; i <= (end - 1) / chunk_size_; i++) {
+    if (!excerpt.IsMapped(i * chunk_size_)) {
+      excerpt.MapChunkAt(i * chunk_size_,
+                         LoadAt(excerpt.GetRefName(), i * chunk_size_));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 std::vector<std::pair<size_t, size_t>> ReferenceManager::GetCoverage(
     const std::string& name) const {
   return mgr_.GetCoverage(name);
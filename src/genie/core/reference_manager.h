@@ -411,6 +411,19 @@ class ReferenceManager {
    * @return A `ReferenceExcerpt` containing the loaded range.
    */
   ReferenceExcerpt Load(const std::string& name, size_t start, size_t end);
+
+  /**
+   * @brief Extends an excerpt so that it covers a range.
+   *
+   * Only the chunks of the range that are not mapped in the excerpt yet are
+   * loaded, so growing an excerpt record by record takes the cache lock only
+   * when a new chunk is entered.
+   *
+   * @param excerpt The excerpt to extend. Must start at or before `start`.
+   * @param start The start position.
+   * @param end The end position.
+   */
+  void LoadInto(ReferenceExcerpt& excerpt, size_t start, size_t end);
 };
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,516 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/core/stats/au_statistics.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "genie/core/cigar_tokenizer.h"
+#include "genie/core/record/alignment_split/other_rec.h"
+#include "genie/core/record/alignment_split/same_rec.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::core::stats {
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/**
+ * @brief Increment a histogram entry, growing the histogram if needed
+ * @param histogram Histogram
+ * @param index Entry
+ */
+void Increment(std::vector<uint64_t>& histogram, const size_t index) {
+  if (histogram.size() <= index) {
+    histogram.resize(index + 1, 0);
+  }
+  histogram[index] += 1;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Add a histogram to another one, growing it if needed
+ * @param dst Histogram to add to
+ * @param src Histogram to add
+ */
+void AddHistogram(std::vector<uint64_t>& dst,
+                  const std::vector<uint64_t>& src) {
+  if (dst.size() < src.size()) {
+    dst.resize(src.size(), 0);
+  }
+  for (size_t i = 0; i < src.size(); ++i) {
+    dst[i] += src[i];
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief
+ * @param s
+ * @return Json representation of a summary
+ */
+nlohmann::json SummaryToJson(const AuStatistics::Summary& s) {
+  return nlohmann::json::array({s.min, s.max, s.sum, s.count});
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief
+ * @param obj
+ * @return Summary from its json representation
+ */
+AuStatistics::Summary SummaryFromJson(const nlohmann::json& obj) {
+  AuStatistics::Summary ret;
+  ret.min = obj.at(0);
+  ret.max = obj.at(1);
+  ret.sum = obj.at(2);
+  ret.count = obj.at(3);
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Find the alignment of a segment in the same record
+ * @param box Alignment of the record
+ * @param segment Segment index
+ * @return The alignment, nullptr if the segment is not mapped here
+ */
+const record::Alignment* GetSegmentAlignment(const record::AlignmentBox& box,
+                                             const size_t segment) {
+  if (segment == 0) {
+    return &box.GetAlignment();
+  }
+  const auto& splits = box.GetAlignmentSplits();
+  if (splits.size() < segment ||
+      splits[segment - 1]->GetType() !=
+          record::AlignmentSplit::Type::kSameRec) {
+    return nullptr;
+  }
+  return &dynamic_cast<const record::alignment_split::SameRec&>(
+              *splits[segment - 1])
+              .GetAlignment();
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+void AuStatistics::Summary::Add(const uint64_t value) {
+  min = std::min(min, value);
+  max = std::max(max, value);
+  sum += value;
+  count += 1;
+}
+
+// -----------------------------------------------------------------------------
+
+void AuStatistics::Summary::Merge(const Summary& other) {
+  min = std::min(min, other.min);
+  max = std::max(max, other.max);
+  sum += other.sum;
+  count += other.count;
+}
+
+// -----------------------------------------------------------------------------
+
+std::array<uint64_t, static_cast<uint8_t>(api::StatisticsIndex::kCount)>
+AuStatistics::Summary::ToArray() const {
+  if (count == 0) {
+    return {0, 0, 0};
+  }
+  return {min, max, sum / count};
+}
+
+// -----------------------------------------------------------------------------
+
+AuStatistics::AuStatistics(const std::vector<record::Record>& records) {
+  for (const auto& r : records) {
+    Add(r);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+AuStatistics::AuStatistics(const record::RecordBatch& batch) {
+  for (size_t r = 0; r < batch.Size(); ++r) {
+    if (batch.GetPosition(r) != record::RecordBatch::kUnmapped) {
+      Add(batch.GetRecord(r));
+      continue;
+    }
+    // Unmapped reads only contribute counts and lengths, taken from the
+    // columns without building a record
+    const size_t num_segments = batch.GetNumSegments(r);
+    AddRead(num_segments, 0, batch.GetFlags(r), batch.GetClassId(r));
+    for (size_t s = 0; s < num_segments; ++s) {
+      segment_length_.Add(
+          batch.GetSequence(batch.GetFirstSegment(r) + s).length());
+    }
+    AddStrands(std::vector(num_segments, api::Strand::kUnmappedUnknown));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+api::ClipTypeCombination AuStatistics::AddECigar(const std::string& ecigar) {
+  uint64_t substitutions = 0;
+  uint64_t insertions = 0;
+  uint64_t insertions_length = 0;
+  uint64_t deletions = 0;
+  uint64_t deletions_length = 0;
+  uint64_t splices = 0;
+  uint64_t splices_length = 0;
+  bool soft_clip = false;
+  bool hard_clip = false;
+  CigarTokenizer::Tokenize(
+      ecigar, GetECigarInfo(),
+      [&](const char token, const std::pair<size_t, size_t>& bases,
+          const std::pair<size_t, size_t>& ref) -> bool {
+        switch (token) {
+          case '=':
+            break;
+          case '+':
+            insertions += 1;
+            insertions_length += bases.second;
+            break;
+          case '-':
+            deletions += 1;
+            deletions_length += ref.second;
+            break;
+          case '*':
+          case '/':
+          case '%':
+            splices += 1;
+            splices_length += ref.second;
+            break;
+          case ')':
+            soft_clip = true;
+            break;
+          case ']':
+            hard_clip = true;
+            break;
+          default:
+            // Substituted bases are spelled out one by one
+            substitutions += 1;
+            break;
+        }
+        return true;
+      });
+  substitutions_.Add(substitutions);
+  insertions_.Add(insertions);
+  insertions_length_.Add(insertions_length);
+  deletions_.Add(deletions);
+  deletions_length_.Add(deletions_length);
+  splices_.Add(splices);
+  splices_length_.Add(splices_length);
+  errors_.Add(substitutions + insertions + deletions);
+  if (hard_clip) {
+    return api::ClipTypeCombination::kSoftHard;
+  }
+  return soft_clip ? api::ClipTypeCombination::kSoft
+                   : api::ClipTypeCombination::kNone;
+}
+
+// -----------------------------------------------------------------------------
+
+void AuStatistics::AddRead(const size_t num_segments,
+                           const size_t num_alignments, const uint8_t flags,
+                           const record::ClassType class_id) {
+  reads_ += 1;
+  Increment(segments_, num_segments);
+  Increment(alignments_, num_alignments);
+
+  const record::Record::Flags f(flags);
+  qc_failed_ += f.quality_check_fail ? 1 : 0;
+  properly_paired_ += f.proper_mapped_pair ? 1 : 0;
+  duplicates_ += f.duplicate ? 1 : 0;
+
+  if (class_id != record::ClassType::kNone) {
+    classes_[static_cast<uint8_t>(class_id) - 1] += num_segments;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void AuStatistics::AddStrands(const std::vector<api::Strand>& strands) {
+  // Index into api::StrandPaired by the strands of both mates
+  static constexpr uint8_t kPairStrand[3][3] = {
+      {0, 1, 2}, {3, 5, 6}, {4, 7, 8}};
+
+  for (const auto& s : strands) {
+    strand_[static_cast<uint8_t>(s)] += 1;
+  }
+  if (strands.size() == 2) {
+    pair_strand_[kPairStrand[static_cast<uint8_t>(strands[0])]
+                            [static_cast<uint8_t>(strands[1])]] += 1;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void AuStatistics::Add(const record::Record& rec) {
+  const auto strand = AddRecord(rec);
+  if (strand == api::Strand::kUnmappedUnknown) {
+    return;
+  }
+  if (strands_.empty()) {
+    strands_.resize(static_cast<uint8_t>(api::StrandStrict::kCount));
+  }
+  // api::Strand counts unmapped segments first
+  strands_[static_cast<uint8_t>(strand) - 1].AddRecord(rec);
+}
+
+// -----------------------------------------------------------------------------
+
+api::Strand AuStatistics::AddRecord(const record::Record& rec) {
+  const size_t num_segments = rec.GetSegments().size();
+  AddRead(num_segments, rec.GetAlignments().size(), rec.GetFlags(),
+          rec.GetClassId());
+
+  std::vector<api::Strand> strands(num_segments,
+                                   api::Strand::kUnmappedUnknown);
+  for (const auto& s : rec.GetSegments()) {
+    segment_length_.Add(s.GetSequence().length());
+  }
+
+  if (!rec.GetAlignments().empty()) {
+    const auto& box = rec.GetAlignments().front();
+    const uint16_t seq_id = rec.GetAlignmentSharedData().GetSeqId();
+    const uint64_t start = box.GetPosition();
+    const uint64_t end =
+        start + std::max<uint64_t>(rec.GetMappedLength(0, 0), 1) - 1;
+    if (!mapped_) {
+      mapped_ = true;
+      seq_id_ = seq_id;
+      start_pos_ = start;
+      end_pos_ = end;
+    } else {
+      start_pos_ = std::min(start_pos_, start);
+      end_pos_ = std::max(end_pos_, end);
+    }
+
+    for (size_t i = 0; i < num_segments; ++i) {
+      const auto* alignment = GetSegmentAlignment(box, i);
+      if (alignment == nullptr) {
+        continue;
+      }
+      strands[i] = alignment->GetRComp() ? api::Strand::kReverse
+                                         : api::Strand::kForward;
+      clips_[static_cast<uint8_t>(AddECigar(alignment->GetECigar()))] += 1;
+      const auto& scores = alignment->GetMappingScores();
+      if (!scores.empty() && scores.front() >= 0) {
+        alignment_score_.Add(static_cast<uint64_t>(scores.front()));
+      }
+    }
+
+    for (const auto& split : box.GetAlignmentSplits()) {
+      if (split->GetType() == record::AlignmentSplit::Type::kOtherRec &&
+          dynamic_cast<const record::alignment_split::OtherRec&>(*split)
+                  .GetNextSeq() != seq_id) {
+        chimeras_ += 1;
+        break;
+      }
+    }
+  }
+
+  AddStrands(strands);
+  return strands.empty() ? api::Strand::kUnmappedUnknown : strands.front();
+}
+
+// -----------------------------------------------------------------------------
+
+void AuStatistics::Merge(const AuStatistics& other) {
+  if (other.mapped_) {
+    if (!mapped_) {
+      mapped_ = true;
+      seq_id_ = other.seq_id_;
+      start_pos_ = other.start_pos_;
+      end_pos_ = other.end_pos_;
+    } else {
+      start_pos_ = std::min(start_pos_, other.start_pos_);
+      end_pos_ = std::max(end_pos_, other.end_pos_);
+    }
+  }
+
+  reads_ += other.reads_;
+  AddHistogram(segments_, other.segments_);
+  qc_failed_ += other.qc_failed_;
+  properly_paired_ += other.properly_paired_;
+  duplicates_ += other.duplicates_;
+  chimeras_ += other.chimeras_;
+  AddHistogram(alignments_, other.alignments_);
+  segment_length_.Merge(other.segment_length_);
+  errors_.Merge(other.errors_);
+  substitutions_.Merge(other.substitutions_);
+  insertions_.Merge(other.insertions_);
+  insertions_length_.Merge(other.insertions_length_);
+  deletions_.Merge(other.deletions_);
+  deletions_length_.Merge(other.deletions_length_);
+  splices_.Merge(other.splices_);
+  splices_length_.Merge(other.splices_length_);
+  alignment_score_.Merge(other.alignment_score_);
+  for (size_t i = 0; i < strand_.size(); ++i) {
+    strand_[i] += other.strand_[i];
+  }
+  for (size_t i = 0; i < pair_strand_.size(); ++i) {
+    pair_strand_[i] += other.pair_strand_[i];
+  }
+  for (size_t i = 0; i < classes_.size(); ++i) {
+    classes_[i] += other.classes_[i];
+  }
+  for (size_t i = 0; i < clips_.size(); ++i) {
+    clips_[i] += other.clips_[i];
+  }
+  if (!other.strands_.empty()) {
+    strands_.resize(other.strands_.size());
+    for (size_t i = 0; i < strands_.size(); ++i) {
+      strands_[i].Merge(other.strands_[i]);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+bool AuStatistics::Overlaps(const uint16_t seq_id, const uint64_t start_pos,
+                            const uint64_t end_pos) const {
+  return mapped_ && seq_id_ == seq_id && start_pos_ <= end_pos &&
+         start_pos <= end_pos_;
+}
+
+// -----------------------------------------------------------------------------
+
+uint64_t AuStatistics::GetNumReads() const { return reads_; }
+
+// -----------------------------------------------------------------------------
+
+api::SimpleSegmentStatistics AuStatistics::ToSimpleStatistics() const {
+  api::SimpleSegmentStatistics ret{};
+  ret.reads_number = reads_;
+  ret.segments_number_reads_distribution = segments_;
+  ret.quality_check_failed_reads_number = qc_failed_;
+  ret.segment_length = segment_length_.ToArray();
+  ret.mapped_strand_segment_distribution = strand_;
+  ret.properly_paired_number = properly_paired_;
+  ret.mapped_strand_pair_distribution = pair_strand_;
+  ret.max_alignments = alignments_.empty() ? 0 : alignments_.size() - 1;
+  ret.multiple_alignment_segment_distribution = alignments_;
+  ret.errors_number = errors_.ToArray();
+  ret.substitutions_number = substitutions_.ToArray();
+  ret.insertions_number = insertions_.ToArray();
+  ret.insertions_length = insertions_length_.ToArray();
+  ret.deletions_number = deletions_.ToArray();
+  ret.deletions_length = deletions_length_.ToArray();
+  ret.splices_number = splices_.ToArray();
+  ret.splices_length = splices_length_.ToArray();
+  ret.alignment_score = alignment_score_.ToArray();
+  ret.class_segment_distribution = classes_;
+  ret.clipped_segment_distribution = clips_;
+  ret.optical_duplicates_number = duplicates_;
+  ret.chimeras_number = chimeras_;
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+api::AdvancedSegmentStatistics AuStatistics::ToAdvancedStatistics() const {
+  api::AdvancedSegmentStatistics ret{};
+  for (size_t i = 0; i < strands_.size(); ++i) {
+    ret.simple_statistics[i] = strands_[i].ToSimpleStatistics();
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+nlohmann::json AuStatistics::ToJson() const {
+  nlohmann::json ret;
+  if (mapped_) {
+    ret["seq_ID"] = seq_id_;
+    ret["start_pos"] = start_pos_;
+    ret["end_pos"] = end_pos_;
+  }
+  ret["reads"] = reads_;
+  ret["segments"] = segments_;
+  ret["qc_failed"] = qc_failed_;
+  ret["properly_paired"] = properly_paired_;
+  ret["duplicates"] = duplicates_;
+  ret["chimeras"] = chimeras_;
+  ret["alignments"] = alignments_;
+  ret["segment_length"] = SummaryToJson(segment_length_);
+  ret["errors"] = SummaryToJson(errors_);
+  ret["substitutions"] = SummaryToJson(substitutions_);
+  ret["insertions"] = SummaryToJson(insertions_);
+  ret["insertions_length"] = SummaryToJson(insertions_length_);
+  ret["deletions"] = SummaryToJson(deletions_);
+  ret["deletions_length"] = SummaryToJson(deletions_length_);
+  ret["splices"] = SummaryToJson(splices_);
+  ret["splices_length"] = SummaryToJson(splices_length_);
+  ret["alignment_score"] = SummaryToJson(alignment_score_);
+  ret["strand"] = strand_;
+  ret["pair_strand"] = pair_strand_;
+  ret["classes"] = classes_;
+  ret["clips"] = clips_;
+  if (!strands_.empty()) {
+    auto& strands = ret["strands"] = nlohmann::json::array();
+    for (const auto& s : strands_) {
+      strands.push_back(s.ToJson());
+    }
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+AuStatistics::AuStatistics(const nlohmann::json& obj)
+    : mapped_(obj.contains("seq_ID")),
+      reads_(obj.at("reads")),
+      segments_(obj.at("segments").get<std::vector<uint64_t>>()),
+      qc_failed_(obj.at("qc_failed")),
+      properly_paired_(obj.at("properly_paired")),
+      duplicates_(obj.at("duplicates")),
+      chimeras_(obj.at("chimeras")),
+      alignments_(obj.at("alignments").get<std::vector<uint64_t>>()),
+      segment_length_(SummaryFromJson(obj.at("segment_length"))),
+      errors_(SummaryFromJson(obj.at("errors"))),
+      substitutions_(SummaryFromJson(obj.at("substitutions"))),
+      insertions_(SummaryFromJson(obj.at("insertions"))),
+      insertions_length_(SummaryFromJson(obj.at("insertions_length"))),
+      deletions_(SummaryFromJson(obj.at("deletions"))),
+      deletions_length_(SummaryFromJson(obj.at("deletions_length"))),
+      splices_(SummaryFromJson(obj.at("splices"))),
+      splices_length_(SummaryFromJson(obj.at("splices_length"))),
+      alignment_score_(SummaryFromJson(obj.at("alignment_score"))),
+      strand_(obj.at("strand")),
+      pair_strand_(obj.at("pair_strand")),
+      classes_(obj.at("classes")),
+      clips_(obj.at("clips")) {
+  if (mapped_) {
+    seq_id_ = obj.at("seq_ID");
+    start_pos_ = obj.at("start_pos");
+    end_pos_ = obj.at("end_pos");
+  }
+  if (obj.contains("strands")) {
+    for (const auto& s : obj["strands"]) {
+      strands_.emplace_back(s);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::core::stats
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
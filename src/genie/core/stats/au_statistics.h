@@ -0,0 +1,234 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ *
+ * @brief Record statistics of an access unit, computed while encoding.
+ */
+
+#ifndef SRC_GENIE_CORE_STATS_AU_STATISTICS_H_
+#define SRC_GENIE_CORE_STATS_AU_STATISTICS_H_
+
+// -----------------------------------------------------------------------------
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "genie/core/api.h"
+#include "genie/core/record/record.h"
+#include "genie/core/record/record_batch.h"
+#include "nlohmann/json.hpp"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::core::stats {
+
+/**
+ * @brief Summary of the records of one access unit, in the shape of
+ * api::SimpleSegmentStatistics.
+ *
+ * The encoder fills it while it has the records in hand, so statistics
+ * queries only merge the summaries of the matching access units and never
+ * decode a descriptor. All fields are counts or sums, so merging is exact,
+ * averages included.
+ */
+class AuStatistics {
+ public:
+  /**
+   * @brief Minimum, maximum and sum of a per segment value
+   */
+  struct Summary {
+    /// Smallest value added
+    uint64_t min = std::numeric_limits<uint64_t>::max();
+
+    uint64_t max = 0;    //!< @brief Largest value added
+    uint64_t sum = 0;    //!< @brief Sum of all values
+    uint64_t count = 0;  //!< @brief Number of values
+
+    /**
+     * @brief
+     * @param value
+     */
+    void Add(uint64_t value);
+
+    /**
+     * @brief
+     * @param other
+     */
+    void Merge(const Summary& other);
+
+    /**
+     * @brief
+     * @return Minimum, maximum and average as indexed by
+     * api::StatisticsIndex, all zero if nothing was added
+     */
+    [[nodiscard]] std::array<uint64_t,
+                             static_cast<uint8_t>(api::StatisticsIndex::kCount)>
+    ToArray() const;
+  };
+
+ private:
+  /// Number of class indices, class P to class U
+  static constexpr size_t kNumClasses =
+      static_cast<size_t>(record::ClassType::kClassU);
+
+  bool mapped_ = false;     //!< @brief Any mapped record was added
+  uint16_t seq_id_ = 0;     //!< @brief Reference sequence of mapped records
+  uint64_t start_pos_ = 0;  //!< @brief Lowest mapping position
+  uint64_t end_pos_ = 0;    //!< @brief Highest mapping position
+
+  uint64_t reads_ = 0;                //!< @brief Number of records
+  std::vector<uint64_t> segments_;    //!< @brief Records by segment count
+  uint64_t qc_failed_ = 0;            //!< @brief Records failing QC
+  uint64_t properly_paired_ = 0;      //!< @brief Properly paired records
+  uint64_t duplicates_ = 0;           //!< @brief Duplicate records
+  uint64_t chimeras_ = 0;             //!< @brief Mates on other sequences
+  std::vector<uint64_t> alignments_;  //!< @brief Records by alignments
+  Summary segment_length_;            //!< @brief Segment lengths
+  Summary errors_;                    //!< @brief Errors per segment
+  Summary substitutions_;             //!< @brief Substitutions per segment
+  Summary insertions_;                //!< @brief Insertions per segment
+  Summary insertions_length_;         //!< @brief Inserted bases
+  Summary deletions_;                 //!< @brief Deletions per segment
+  Summary deletions_length_;          //!< @brief Deleted bases
+  Summary splices_;                   //!< @brief Splices per segment
+  Summary splices_length_;            //!< @brief Spliced bases
+  Summary alignment_score_;           //!< @brief Mapping scores
+
+  /// Segments by api::Strand
+  std::array<uint64_t, static_cast<uint8_t>(api::Strand::kCount)> strand_{};
+
+  /// Records holding both mates by api::StrandPaired
+  std::array<uint64_t, static_cast<uint8_t>(api::StrandPaired::kCount)>
+      pair_strand_{};
+
+  /// Segments by class, class P at index 0
+  std::array<uint64_t, kNumClasses> classes_{};
+
+  /// Segments by api::ClipTypeCombination
+  std::array<uint64_t,
+             static_cast<uint8_t>(api::ClipTypeCombination::kCount)>
+      clips_{};
+
+  /// Records split by api::StrandStrict of their first segment, empty until
+  /// a mapped record was added
+  std::vector<AuStatistics> strands_;
+
+  /**
+   * @brief Count a record, without splitting it by strand
+   * @param rec Record
+   * @return Strand of the first segment
+   */
+  api::Strand AddRecord(const record::Record& rec);
+
+  /**
+   * @brief Count the events in the ECIGAR of a mapped segment
+   * @param ecigar Extended CIGAR string
+   * @return Clip combination of the segment
+   */
+  api::ClipTypeCombination AddECigar(const std::string& ecigar);
+
+  /**
+   * @brief Count a read and its flags and class
+   * @param num_segments Number of segments
+   * @param num_alignments Number of alignments
+   * @param flags Flags as in record::Record::Flags
+   * @param class_id Class
+   */
+  void AddRead(size_t num_segments, size_t num_alignments, uint8_t flags,
+               record::ClassType class_id);
+
+  /**
+   * @brief Count the strands of the segments of a read
+   * @param strands One strand per segment
+   */
+  void AddStrands(const std::vector<api::Strand>& strands);
+
+ public:
+  /**
+   * @brief Empty statistics
+   */
+  AuStatistics() = default;
+
+  /**
+   * @brief Statistics of a set of records
+   * @param records Records of an access unit
+   */
+  explicit AuStatistics(const std::vector<record::Record>& records);
+
+  /**
+   * @brief Statistics of a columnar batch of records
+   * @param batch Records of an access unit
+   */
+  explicit AuStatistics(const record::RecordBatch& batch);
+
+  /**
+   * @brief Construct from json
+   * @param obj Json representation
+   */
+  explicit AuStatistics(const nlohmann::json& obj);
+
+  /**
+   * @brief Convert to json
+   * @return Json representation
+   */
+  [[nodiscard]] nlohmann::json ToJson() const;
+
+  /**
+   * @brief Add one record
+   * @param rec Record
+   */
+  void Add(const record::Record& rec);
+
+  /**
+   * @brief Add the statistics of another access unit
+   * @param other Statistics to add
+   */
+  void Merge(const AuStatistics& other);
+
+  /**
+   * @brief Check if mapped records of this access unit may fall into a range
+   * @param seq_id Reference sequence
+   * @param start_pos First position of the range
+   * @param end_pos Last position of the range
+   * @return True if the access unit holds mapped records in the range
+   */
+  [[nodiscard]] bool Overlaps(uint16_t seq_id, uint64_t start_pos,
+                              uint64_t end_pos) const;
+
+  /**
+   * @brief
+   * @return Number of records
+   */
+  [[nodiscard]] uint64_t GetNumReads() const;
+
+  /**
+   * @brief Convert to the API representation. Coverage needs a per base
+   * depth and is left zero.
+   * @return Statistics
+   */
+  [[nodiscard]] api::SimpleSegmentStatistics ToSimpleStatistics() const;
+
+  /**
+   * @brief Convert to the API representation, split by the strand of the
+   * first segment. Unmapped records are left out. The extended statistics
+   * need per base histograms and are left empty.
+   * @return Statistics
+   */
+  [[nodiscard]] api::AdvancedSegmentStatistics ToAdvancedStatistics() const;
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::core::stats
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_CORE_STATS_AU_STATISTICS_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
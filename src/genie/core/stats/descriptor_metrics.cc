@@ -0,0 +1,106 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/core/stats/descriptor_metrics.h"
+
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <utility>
+
+#include "genie/util/runtime_exception.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::core::stats {
+
+// -----------------------------------------------------------------------------
+
+DescriptorMetrics::DescriptorMetrics(const std::string& codec)
+    : total_(Intern("size-" + codec + "-total-raw"),
+             Intern("size-" + codec + "-total-comp")),
+      time_(Intern("time-" + codec)) {
+  for (const auto& desc : GetDescriptors()) {
+    const auto index = static_cast<size_t>(desc.id);
+    if (sizes_.size() <= index) {
+      sizes_.resize(index + 1);
+    }
+    const std::string prefix = "size-" + codec + "-" + desc.name;
+    if (desc.token_type) {
+      sizes_[index].emplace_back(Intern(prefix + "-raw"),
+                                 Intern(prefix + "-comp"));
+      continue;
+    }
+    for (const auto& sub : desc.sub_seqs) {
+      const auto sub_index = static_cast<size_t>(sub.id.second);
+      if (sizes_[index].size() <= sub_index) {
+        sizes_[index].resize(sub_index + 1);
+      }
+      sizes_[index][sub_index] = {Intern(prefix + "-" + sub.name + "-raw"),
+                                  Intern(prefix + "-" + sub.name + "-comp")};
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+const DescriptorMetrics& DescriptorMetrics::Get(const std::string& codec) {
+  static std::mutex lock;
+  static std::map<std::string, std::unique_ptr<DescriptorMetrics>> codecs;
+  std::lock_guard guard(lock);
+  auto& metrics = codecs[codec];
+  if (!metrics) {
+    metrics = std::make_unique<DescriptorMetrics>(codec);
+  }
+  return *metrics;
+}
+
+// -----------------------------------------------------------------------------
+
+const std::pair<MetricId, MetricId>& DescriptorMetrics::Lookup(
+    const GenSubIndex& id) const {
+  const auto index = static_cast<size_t>(id.first);
+  UTILS_DIE_IF(index >= sizes_.size() || sizes_[index].empty(),
+               "Unknown descriptor");
+  if (GetDescriptor(id.first).token_type) {
+    return sizes_[index].front();
+  }
+  UTILS_DIE_IF(id.second >= sizes_[index].size(), "Unknown subsequence");
+  return sizes_[index][id.second];
+}
+
+// -----------------------------------------------------------------------------
+
+MetricId DescriptorMetrics::Raw(const GenSubIndex& id) const {
+  return Lookup(id).first;
+}
+
+// -----------------------------------------------------------------------------
+
+MetricId DescriptorMetrics::Comp(const GenSubIndex& id) const {
+  return Lookup(id).second;
+}
+
+// -----------------------------------------------------------------------------
+
+MetricId DescriptorMetrics::TotalRaw() const { return total_.first; }
+
+// -----------------------------------------------------------------------------
+
+MetricId DescriptorMetrics::TotalComp() const { return total_.second; }
+
+// -----------------------------------------------------------------------------
+
+MetricId DescriptorMetrics::Time() const { return time_; }
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::core::stats
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ *
+ * @brief Pre-interned size and time metrics of an entropy codec.
+ */
+
+#ifndef SRC_GENIE_CORE_STATS_DESCRIPTOR_METRICS_H_
+#define SRC_GENIE_CORE_STATS_DESCRIPTOR_METRICS_H_
+
+// -----------------------------------------------------------------------------
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "genie/core/constants.h"
+#include "genie/core/stats/metric_registry.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::core::stats {
+
+/**
+ * @brief Metric IDs "size-<codec>-[total|<desc>[-<subseq>]]-[raw|comp]" and
+ * "time-<codec>" for all descriptors.
+ *
+ * All names are interned on construction, so looking up the metric of a
+ * subsequence is a table access. Token type descriptors are reported per
+ * descriptor, all other descriptors per subsequence.
+ */
+class DescriptorMetrics {
+  /// Metrics (raw, comp), indexed by [descriptor][subsequence].
+  std::vector<std::vector<std::pair<MetricId, MetricId>>> sizes_;
+
+  /// Sum over all descriptors (raw, comp).
+  std::pair<MetricId, MetricId> total_;
+
+  /// Processing time.
+  MetricId time_;
+
+  /**
+   * @brief Looks up the metrics of a subsequence.
+   * @param id Subsequence.
+   * @return (raw, comp) metric IDs.
+   */
+  [[nodiscard]] const std::pair<MetricId, MetricId>& Lookup(
+      const GenSubIndex& id) const;
+
+ public:
+  /**
+   * @brief Interns all metrics of a codec.
+   * @param codec Codec name used in the metric names, e.g. "gabac".
+   */
+  explicit DescriptorMetrics(const std::string& codec);
+
+  /**
+   * @brief Metrics of a codec, interned on the first call for that codec and
+   * shared afterwards. Safe to call from several threads.
+   * @param codec Codec name used in the metric names, e.g. "gabac".
+   * @return Metric IDs.
+   */
+  static const DescriptorMetrics& Get(const std::string& codec);
+
+  /**
+   * @brief
+   * @param id Subsequence.
+   * @return Metric of the uncompressed subsequence size.
+   */
+  [[nodiscard]] MetricId Raw(const GenSubIndex& id) const;
+
+  /**
+   * @brief
+   * @param id Subsequence.
+   * @return Metric of the compressed subsequence size.
+   */
+  [[nodiscard]] MetricId Comp(const GenSubIndex& id) const;
+
+  /**
+   * @brief
+   * @return Metric of the uncompressed size of all descriptors.
+   */
+  [[nodiscard]] MetricId TotalRaw() const;
+
+  /**
+   * @brief
+   * @return Metric of the compressed size of all descriptors.
+   */
+  [[nodiscard]] MetricId TotalComp() const;
+
+  /**
+   * @brief
+   * @return Metric of the processing time.
+   */
+  [[nodiscard]] MetricId Time() const;
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::core::stats
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_CORE_STATS_DESCRIPTOR_METRICS_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
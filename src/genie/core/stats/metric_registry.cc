@@ -0,0 +1,62 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/core/stats/metric_registry.h"
+
+#include <limits>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "genie/util/runtime_exception.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::core::stats {
+
+// -----------------------------------------------------------------------------
+
+MetricRegistry& MetricRegistry::Instance() {
+  static MetricRegistry registry;
+  return registry;
+}
+
+// -----------------------------------------------------------------------------
+
+MetricId MetricRegistry::Intern(const std::string_view name) {
+  std::lock_guard lock(mutex_);
+  if (const auto it = ids_.find(name); it != ids_.end()) {
+    return it->second;
+  }
+  UTILS_DIE_IF(names_.size() >= std::numeric_limits<MetricId>::max(),
+               "Too many performance metrics");
+  const auto id = static_cast<MetricId>(names_.size());
+  names_.emplace_back(name);
+  ids_.emplace(names_.back(), id);
+  return id;
+}
+
+// -----------------------------------------------------------------------------
+
+const std::string& MetricRegistry::GetName(const MetricId id) const {
+  std::lock_guard lock(mutex_);
+  UTILS_DIE_IF(id >= names_.size(), "Unknown performance metric");
+  return names_[id];
+}
+
+// -----------------------------------------------------------------------------
+
+MetricId Intern(const std::string_view name) {
+  return MetricRegistry::Instance().Intern(name);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::core::stats
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
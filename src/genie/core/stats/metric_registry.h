@@ -0,0 +1,95 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ *
+ * @brief Process wide registry of interned performance metric names.
+ *
+ * Metric names are interned once into dense integer IDs. Statistics are then
+ * recorded by ID, so hot paths neither build nor compare strings. Names are
+ * only resolved again when a report is written.
+ */
+
+#ifndef SRC_GENIE_CORE_STATS_METRIC_REGISTRY_H_
+#define SRC_GENIE_CORE_STATS_METRIC_REGISTRY_H_
+
+// -----------------------------------------------------------------------------
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// -----------------------------------------------------------------------------
+
+namespace genie::core::stats {
+
+/**
+ * @brief Dense ID of an interned metric name.
+ */
+using MetricId = uint32_t;
+
+/**
+ * @brief Maps metric names to dense IDs and back.
+ */
+class MetricRegistry {
+  /// Guards both tables. Only taken when interning or resolving names.
+  mutable std::mutex mutex_;
+
+  /// Interned names, indexed by ID. A deque keeps references stable.
+  std::deque<std::string> names_;
+
+  /// Lookup from name to ID.
+  std::unordered_map<std::string_view, MetricId> ids_;
+
+  /**
+   * @brief Only the global instance exists.
+   */
+  MetricRegistry() = default;
+
+ public:
+  /**
+   * @brief Access to the global registry.
+   * @return The registry.
+   */
+  static MetricRegistry& Instance();
+
+  /**
+   * @brief Returns the ID of a metric name, registering it if necessary.
+   *
+   * This takes a lock, so callers on hot paths should intern their names once
+   * and keep the ID.
+   *
+   * @param name Metric name.
+   * @return ID of the metric.
+   */
+  MetricId Intern(std::string_view name);
+
+  /**
+   * @brief Resolves the name of an interned metric.
+   * @param id ID returned by Intern().
+   * @return Name of the metric. The reference stays valid forever.
+   */
+  [[nodiscard]] const std::string& GetName(MetricId id) const;
+};
+
+/**
+ * @brief Shorthand for MetricRegistry::Instance().Intern(name).
+ * @param name Metric name.
+ * @return ID of the metric.
+ */
+MetricId Intern(std::string_view name);
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::core::stats
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_CORE_STATS_METRIC_REGISTRY_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
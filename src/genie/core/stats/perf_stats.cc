@@ -8,10 +8,15 @@
 #include "genie/core/stats/perf_stats.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
 #include <iomanip>
-#include <map>
 #include <ostream>
+#include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "genie/util/log.h"
 #include "genie/util/runtime_exception.h"
@@ -24,6 +29,65 @@ namespace genie::core::stats {
 
 // -----------------------------------------------------------------------------
 
+namespace {
+
+/// Global collection switch.
+std::atomic<bool> collection_enabled{true};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Computes the histogram bucket of a value.
+ * @param value Value, already scaled to integer units.
+ * @return Bucket index.
+ */
+size_t Bucket(const uint64_t value) {
+  size_t bucket = 0;
+  for (uint64_t v = value; v != 0 && bucket + 1 < PerfStats::kHistogramBuckets;
+       v >>= 1) {
+    ++bucket;
+  }
+  return bucket;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Collects all entries with their names, sorted by name.
+ * @param stats Statistics to sort.
+ * @return Pairs of name and statistic.
+ */
+std::vector<std::pair<std::string, const PerfStats::Stat*>> Sorted(
+    const PerfStats& stats) {
+  std::vector<std::pair<std::string, const PerfStats::Stat*>> ret;
+  for (const auto& [id, stat] : stats) {
+    ret.emplace_back(MetricRegistry::Instance().GetName(id), &stat);
+  }
+  std::sort(ret.begin(), ret.end(), [](const auto& a, const auto& b) {
+    return a.first < b.first;
+  });
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Converts a metric name into a valid Prometheus metric name.
+ * @param name Metric name.
+ * @return Name prefixed with "genie_" and restricted to [a-zA-Z0-9_].
+ */
+std::string PrometheusName(const std::string& name) {
+  std::string ret = "genie_";
+  for (const auto c : name) {
+    ret += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+  }
+  return ret;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
 double PerfStats::Stat::Avg() const {
   if (is_integer) {
     return static_cast<double>(sum.i_data) / static_cast<double>(ctr);
@@ -33,72 +97,161 @@ double PerfStats::Stat::Avg() const {
 
 // -----------------------------------------------------------------------------
 
+double PerfStats::Stat::BucketBound(const size_t bucket) const {
+  const double bound = std::ldexp(1.0, static_cast<int>(bucket));
+  return is_integer ? bound : bound / 1e6;
+}
+
+// -----------------------------------------------------------------------------
+
+void PerfStats::SetEnabled(const bool enabled) {
+  collection_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+
+bool PerfStats::IsEnabled() {
+  return collection_enabled.load(std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+
+PerfStats::Entry& PerfStats::GetEntry(const MetricId id,
+                                      const bool is_integer) {
+  if (slots_.size() <= id) {
+    slots_.resize(id + 1, 0);
+  }
+  if (slots_[id] == 0) {
+    entries_.push_back({id, Stat()});
+    entries_.back().stat.is_integer = is_integer;
+    slots_[id] = static_cast<uint32_t>(entries_.size());
+  }
+  auto& entry = entries_[slots_[id] - 1];
+  UTILS_DIE_IF(entry.stat.is_integer != is_integer,
+               "Tried to combine integer and floating point numbers in "
+               "statistics");
+  return entry;
+}
+
+// -----------------------------------------------------------------------------
+
+void PerfStats::AddDouble(const MetricId id, const double dat) {
+  if (!active_ || !IsEnabled()) {
+    return;
+  }
+  auto& s = GetEntry(id, false).stat;
+  if (s.ctr == 0) {
+    s.min.f_data = dat;
+    s.max.f_data = dat;
+    s.sum.f_data = 0;
+  }
+  s.min.f_data = std::min(s.min.f_data, dat);
+  s.max.f_data = std::max(s.max.f_data, dat);
+  s.sum.f_data += dat;
+  s.ctr++;
+  s.histogram[Bucket(
+      dat > 0 ? static_cast<uint64_t>(std::llround(dat * 1e6)) : 0)]++;
+}
+
+// -----------------------------------------------------------------------------
+
+void PerfStats::AddInteger(const MetricId id, const int64_t dat) {
+  if (!active_ || !IsEnabled()) {
+    return;
+  }
+  auto& s = GetEntry(id, true).stat;
+  if (s.ctr == 0) {
+    s.min.i_data = dat;
+    s.max.i_data = dat;
+    s.sum.i_data = 0;
+  }
+  s.min.i_data = std::min(s.min.i_data, dat);
+  s.max.i_data = std::max(s.max.i_data, dat);
+  s.sum.i_data += dat;
+  s.ctr++;
+  s.histogram[Bucket(dat > 0 ? static_cast<uint64_t>(dat) : 0)]++;
+}
+
+// -----------------------------------------------------------------------------
+
 void PerfStats::AddDouble(const std::string& name, const double dat) {
-  Stat s;
-  s.is_integer = false;
-  s.min.f_data = dat;
-  s.sum.f_data = dat;
-  s.max.f_data = dat;
-  s.ctr = 1;
-  Add(name, s);
+  if (!active_ || !IsEnabled()) {
+    return;
+  }
+  AddDouble(Intern(name), dat);
 }
 
 // -----------------------------------------------------------------------------
 
 void PerfStats::AddInteger(const std::string& name, const int64_t dat) {
-  Stat s;
-  s.is_integer = true;
-  s.min.i_data = dat;
-  s.sum.i_data = dat;
-  s.max.i_data = dat;
-  s.ctr = 1;
-  Add(name, s);
+  if (!active_ || !IsEnabled()) {
+    return;
+  }
+  AddInteger(Intern(name), dat);
 }
 
 // -----------------------------------------------------------------------------
 
-void PerfStats::Add(const std::string& name, const Stat& s) {
-  if (!active_) {
+void PerfStats::Add(const MetricId id, const Stat& s) {
+  if (!active_ || !IsEnabled() || s.ctr == 0) {
+    return;
+  }
+  auto& stat = GetEntry(id, s.is_integer).stat;
+  if (stat.ctr == 0) {
+    stat = s;
     return;
   }
-  if (const auto it = data_.find(name); it == data_.end()) {
-    data_[name] = s;
+  stat.ctr += s.ctr;
+  if (stat.is_integer) {
+    stat.min.i_data = std::min(stat.min.i_data, s.min.i_data);
+    stat.max.i_data = std::max(stat.max.i_data, s.max.i_data);
+    stat.sum.i_data += s.sum.i_data;
   } else {
-    it->second.ctr += s.ctr;
-    UTILS_DIE_IF(it->second.is_integer != s.is_integer,
-                 "Tried to combine integer and floating point numbers in "
-                 "statistics");
-    if (it->second.is_integer) {
-      it->second.min.i_data = std::min(it->second.min.i_data, s.min.i_data);
-      it->second.max.i_data = std::max(it->second.max.i_data, s.max.i_data);
-      it->second.sum.i_data += s.sum.i_data;
-    } else {
-      it->second.min.f_data = std::min(it->second.min.f_data, s.min.f_data);
-      it->second.max.f_data = std::max(it->second.max.f_data, s.max.f_data);
-      it->second.sum.f_data += s.sum.f_data;
-    }
+    stat.min.f_data = std::min(stat.min.f_data, s.min.f_data);
+    stat.max.f_data = std::max(stat.max.f_data, s.max.f_data);
+    stat.sum.f_data += s.sum.f_data;
+  }
+  for (size_t i = 0; i < kHistogramBuckets; ++i) {
+    stat.histogram[i] += s.histogram[i];
   }
 }
 
 // -----------------------------------------------------------------------------
 
+void PerfStats::Add(const std::string& name, const Stat& s) {
+  if (!active_ || !IsEnabled()) {
+    return;
+  }
+  Add(Intern(name), s);
+}
+
+// -----------------------------------------------------------------------------
+
 void PerfStats::Add(const PerfStats& stats) {
-  for (const auto& [fst, snd] : stats.data_) {
-    Add(fst, snd);
+  for (const auto& [id, stat] : stats.entries_) {
+    Add(id, stat);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+const PerfStats::Stat* PerfStats::Get(const MetricId id) const {
+  if (id >= slots_.size() || slots_[id] == 0) {
+    return nullptr;
   }
+  return &entries_[slots_[id] - 1].stat;
 }
 
 // -----------------------------------------------------------------------------
 
-std::map<std::string, PerfStats::Stat>::const_iterator PerfStats::begin()
-    const {
-  return data_.begin();
+std::vector<PerfStats::Entry>::const_iterator PerfStats::begin() const {
+  return entries_.begin();
 }
 
 // -----------------------------------------------------------------------------
 
-std::map<std::string, PerfStats::Stat>::const_iterator PerfStats::end() const {
-  return data_.end();
+std::vector<PerfStats::Entry>::const_iterator PerfStats::end() const {
+  return entries_.end();
 }
 
 // -----------------------------------------------------------------------------
@@ -109,33 +262,92 @@ void PerfStats::SetActive(const bool active) { active_ = active; }
 
 bool PerfStats::IsActive() const { return active_; }
 
+// -----------------------------------------------------------------------------
+
 void PerfStats::print() const {
-  for (const auto& [fst, snd] : *this) {
+  for (const auto& [name, stat] : Sorted(*this)) {
     std::stringstream stream;
-    stream << std::setw(40) << std::left << fst;
-    if (snd.is_integer) {
+    stream << std::setw(40) << std::left << name;
+    if (stat->is_integer) {
       stream << "sum: " << std::setw(16) << std::left << std::fixed
-             << snd.sum.i_data;
+             << stat->sum.i_data;
     } else {
       stream << "sum: " << std::setw(16) << std::left << std::fixed
-             << snd.sum.f_data;
+             << stat->sum.f_data;
     }
     UTILS_LOG(genie::util::Logger::Severity::INFO, stream.str());
   }
 }
 
+// -----------------------------------------------------------------------------
+
+nlohmann::json PerfStats::ToJson() const {
+  nlohmann::json ret = nlohmann::json::object();
+  for (const auto& [name, stat] : Sorted(*this)) {
+    nlohmann::json entry;
+    entry["type"] = stat->is_integer ? "integer" : "double";
+    entry["count"] = stat->ctr;
+    if (stat->is_integer) {
+      entry["sum"] = stat->sum.i_data;
+      entry["min"] = stat->min.i_data;
+      entry["max"] = stat->max.i_data;
+    } else {
+      entry["sum"] = stat->sum.f_data;
+      entry["min"] = stat->min.f_data;
+      entry["max"] = stat->max.f_data;
+    }
+    entry["avg"] = stat->Avg();
+    nlohmann::json histogram = nlohmann::json::array();
+    for (size_t i = 0; i < kHistogramBuckets; ++i) {
+      if (stat->histogram[i]) {
+        histogram.push_back(
+            {{"le", stat->BucketBound(i)}, {"count", stat->histogram[i]}});
+      }
+    }
+    entry["histogram"] = std::move(histogram);
+    ret[name] = std::move(entry);
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+void PerfStats::WritePrometheus(std::ostream& stream) const {
+  for (const auto& [name, stat] : Sorted(*this)) {
+    const auto metric = PrometheusName(name);
+    stream << "# TYPE " << metric << " histogram\n";
+    uint64_t cumulative = 0;
+    size_t last = kHistogramBuckets;
+    while (last > 0 && stat->histogram[last - 1] == 0) {
+      --last;
+    }
+    for (size_t i = 0; i < last; ++i) {
+      cumulative += stat->histogram[i];
+      stream << metric << "_bucket{le=\"" << stat->BucketBound(i) << "\"} "
+             << cumulative << "\n";
+    }
+    stream << metric << "_bucket{le=\"+Inf\"} " << stat->ctr << "\n";
+    stream << metric << "_sum ";
+    if (stat->is_integer) {
+      stream << stat->sum.i_data;
+    } else {
+      stream << stat->sum.f_data;
+    }
+    stream << "\n" << metric << "_count " << stat->ctr << "\n";
+  }
+}
 
 // -----------------------------------------------------------------------------
 
 std::ostream& operator<<(std::ostream& stream, const PerfStats& stats) {
-  for (const auto& [fst, snd] : stats) {
-    stream << std::setw(40) << std::left << fst;
-    if (snd.is_integer) {
+  for (const auto& [name, stat] : Sorted(stats)) {
+    stream << std::setw(40) << std::left << name;
+    if (stat->is_integer) {
       stream << "sum: " << std::setw(16) << std::left << std::fixed
-             << snd.sum.i_data << std::endl;
+             << stat->sum.i_data << std::endl;
     } else {
       stream << "sum: " << std::setw(16) << std::left << std::fixed
-             << snd.sum.f_data << std::endl;
+             << stat->sum.f_data << std::endl;
     }
   }
   return stream;
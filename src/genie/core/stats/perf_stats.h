@@ -3,6 +3,15 @@
  * @file
  * @copyright This file is part of Genie. See LICENSE and/or
  * https://github.com/MueFab/genie for more details.
+ *
+ * @brief Collection of performance statistics.
+ *
+ * Statistics are recorded by interned metric ID (see metric_registry.h) into
+ * `PerfStats` objects, which are owned by a single thread at a time (they
+ * travel with chunks and access units through the flow graph). They are
+ * merged only when a report is produced, so recording never needs locks.
+ * Collection can be switched off globally, reducing every recording call to a
+ * single flag check.
  */
 
 #ifndef SRC_GENIE_CORE_STATS_PERF_STATS_H_
@@ -10,9 +19,14 @@
 
 // -----------------------------------------------------------------------------
 
+#include <array>
 #include <cstdint>
-#include <map>
+#include <ostream>
 #include <string>
+#include <vector>
+
+#include "genie/core/stats/metric_registry.h"
+#include "nlohmann/json.hpp"
 
 // -----------------------------------------------------------------------------
 
@@ -23,6 +37,13 @@ namespace genie::core::stats {
  */
 class PerfStats {
  public:
+  /**
+   * @brief Number of histogram buckets. Bucket i counts values in
+   * [2^(i-1), 2^i), bucket 0 counts values below 1. Floating point values
+   * (times in seconds) are bucketed in microseconds.
+   */
+  static constexpr size_t kHistogramBuckets = 64;
+
   /**
    * @brief
    */
@@ -43,27 +64,80 @@ class PerfStats {
     Data max{};         //!< @brief
     uint64_t ctr{};     //!< @brief
 
+    /// @brief Number of recorded values per logarithmic bucket.
+    std::array<uint32_t, kHistogramBuckets> histogram{};
+
     /**
      * @brief
      * @return
      */
     [[nodiscard]] double Avg() const;
+
+    /**
+     * @brief Upper bound of a histogram bucket, in the unit of the metric.
+     * @param bucket Bucket index.
+     * @return Exclusive upper bound.
+     */
+    [[nodiscard]] double BucketBound(size_t bucket) const;
   };
 
   /**
-   * @brief
+   * @brief Recorded statistic of one metric.
+   */
+  struct Entry {
+    MetricId id;  //!< @brief Interned metric name.
+    Stat stat;    //!< @brief Aggregated values.
+  };
+
+  /**
+   * @brief Enables or disables collection in all `PerfStats` objects.
+   * @param enabled New state. Collection is enabled by default.
+   */
+  static void SetEnabled(bool enabled);
+
+  /**
+   * @brief Checks if collection is globally enabled.
+   * @return True if values are recorded.
+   */
+  static bool IsEnabled();
+
+  /**
+   * @brief Records a floating point value.
+   * @param id Interned metric name.
+   * @param dat Value.
+   */
+  void AddDouble(MetricId id, double dat);
+
+  /**
+   * @brief Records an integer value.
+   * @param id Interned metric name.
+   * @param dat Value.
+   */
+  void AddInteger(MetricId id, int64_t dat);
+
+  /**
+   * @brief Records a floating point value. Interns the name first, prefer
+   * the `MetricId` overload on hot paths.
    * @param name
    * @param dat
    */
   void AddDouble(const std::string& name, double dat);
 
   /**
-   * @brief
+   * @brief Records an integer value. Interns the name first, prefer the
+   * `MetricId` overload on hot paths.
    * @param name
    * @param dat
    */
   void AddInteger(const std::string& name, int64_t dat);
 
+  /**
+   * @brief Merges an aggregated statistic into this collection.
+   * @param id
+   * @param s
+   */
+  void Add(MetricId id, const Stat& s);
+
   /**
    * @brief
    * @param name
@@ -78,16 +152,23 @@ class PerfStats {
   void Add(const PerfStats& stats);
 
   /**
-   * @brief
+   * @brief Looks up the statistic of a metric.
+   * @param id Interned metric name.
+   * @return The statistic, or nullptr if nothing was recorded.
+   */
+  [[nodiscard]] const Stat* Get(MetricId id) const;
+
+  /**
+   * @brief Iterates the recorded metrics in order of first recording.
    * @return
    */
-  [[nodiscard]] std::map<std::string, Stat>::const_iterator begin() const;
+  [[nodiscard]] std::vector<Entry>::const_iterator begin() const;
 
   /**
    * @brief
    * @return
    */
-  [[nodiscard]] std::map<std::string, Stat>::const_iterator end() const;
+  [[nodiscard]] std::vector<Entry>::const_iterator end() const;
 
   /**
    * @brief
@@ -101,11 +182,37 @@ class PerfStats {
    */
   [[nodiscard]] bool IsActive() const;
 
+  /**
+   * @brief Writes the sums of all metrics to the log.
+   */
   void print() const;
 
+  /**
+   * @brief Converts all metrics into a JSON object keyed by metric name.
+   * @return JSON representation including histograms.
+   */
+  [[nodiscard]] nlohmann::json ToJson() const;
+
+  /**
+   * @brief Writes all metrics in the Prometheus text exposition format.
+   * @param stream Output stream.
+   */
+  void WritePrometheus(std::ostream& stream) const;
+
  private:
-  bool active_{true};                 //!< @brief
-  std::map<std::string, Stat> data_;  //!< @brief
+  /**
+   * @brief Returns the entry of a metric, creating it if necessary.
+   * @param id
+   * @param is_integer Type of the metric, if it has to be created.
+   * @return
+   */
+  Entry& GetEntry(MetricId id, bool is_integer);
+
+  bool active_{true};           //!< @brief
+  std::vector<Entry> entries_;  //!< @brief Recorded metrics.
+
+  /// @brief Position + 1 of each metric in `entries_`, 0 if not recorded.
+  std::vector<uint32_t> slots_;
 };
 
 /**
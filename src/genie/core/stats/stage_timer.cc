@@ -0,0 +1,114 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/core/stats/stage_timer.h"
+
+#include <atomic>
+#include <string>
+
+#include "genie/core/stats/perf_stats.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::core::stats {
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/// Busy nanoseconds per stage, summed over all threads.
+std::array<std::atomic<int64_t>, kNumStages> busy_ns;
+
+/// Finished timers per stage.
+std::array<std::atomic<uint64_t>, kNumStages> calls;
+
+/// Innermost running timer of this thread.
+thread_local StageTimer* current = nullptr;
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+const std::string& GetStageName(const Stage stage) {
+  static const std::array<std::string, kNumStages> names = {
+      "import", "classify", "read-coding", "qv", "name", "entropy", "export"};
+  return names[static_cast<size_t>(stage)];
+}
+
+// -----------------------------------------------------------------------------
+
+void StageTimer::Charge(const Clock::time_point now) {
+  busy_ns[static_cast<size_t>(stage_)].fetch_add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_)
+          .count(),
+      std::memory_order_relaxed);
+  start_ = now;
+}
+
+// -----------------------------------------------------------------------------
+
+StageTimer::StageTimer(const Stage stage)
+    : stage_(stage), running_(PerfStats::IsEnabled()) {
+  if (!running_) {
+    return;
+  }
+  start_ = Clock::now();
+  parent_ = current;
+  if (parent_) {
+    parent_->Charge(start_);
+  }
+  current = this;
+}
+
+// -----------------------------------------------------------------------------
+
+StageTimer::~StageTimer() { Stop(); }
+
+// -----------------------------------------------------------------------------
+
+void StageTimer::Stop() {
+  if (!running_) {
+    return;
+  }
+  running_ = false;
+  const auto now = Clock::now();
+  Charge(now);
+  calls[static_cast<size_t>(stage_)].fetch_add(1, std::memory_order_relaxed);
+  current = parent_;
+  if (parent_) {
+    // The enclosing stage was paused while this one ran
+    parent_->start_ = now;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+std::array<StageTime, kNumStages> StageTimer::Collect() {
+  std::array<StageTime, kNumStages> ret;
+  for (size_t i = 0; i < kNumStages; ++i) {
+    ret[i].busy =
+        static_cast<double>(busy_ns[i].load(std::memory_order_relaxed)) / 1e9;
+    ret[i].calls = calls[i].load(std::memory_order_relaxed);
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+void StageTimer::Reset() {
+  for (size_t i = 0; i < kNumStages; ++i) {
+    busy_ns[i].store(0, std::memory_order_relaxed);
+    calls[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::core::stats
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
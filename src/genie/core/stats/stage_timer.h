@@ -0,0 +1,128 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ *
+ * @brief Busy time of the flow graph stages.
+ *
+ * Stages call each other on the same thread (a read coder calls the entropy
+ * coder, which hands its access unit on to the exporter). Timers therefore
+ * form a per thread stack, and a stage is only charged while it is on top of
+ * that stack. Summed over all threads this gives exclusive thread-seconds per
+ * stage, independent of how the stages are nested.
+ */
+
+#ifndef SRC_GENIE_CORE_STATS_STAGE_TIMER_H_
+#define SRC_GENIE_CORE_STATS_STAGE_TIMER_H_
+
+// -----------------------------------------------------------------------------
+
+#include <array>
+#include <chrono>  // NOLINT
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// -----------------------------------------------------------------------------
+
+namespace genie::core::stats {
+
+/**
+ * @brief Pipeline stages of encoding and decoding.
+ */
+enum class Stage : uint8_t {
+  kImport = 0,      //!< @brief Parsing input files.
+  kClassify = 1,    //!< @brief Sorting records into access unit classes.
+  kReadCoding = 2,  //!< @brief Records <-> descriptor streams.
+  kQv = 3,          //!< @brief Quality value coding.
+  kName = 4,        //!< @brief Read name coding.
+  kEntropy = 5,     //!< @brief Entropy coding of descriptor streams.
+  kExport = 6,      //!< @brief Formatting and writing output files.
+  kCount = 7
+};
+
+/// Number of stages.
+constexpr size_t kNumStages = static_cast<size_t>(Stage::kCount);
+
+/**
+ * @brief Name of a stage, used as key in reports.
+ * @param stage The stage.
+ * @return E.g. "read-coding".
+ */
+const std::string& GetStageName(Stage stage);
+
+/**
+ * @brief Time accumulated by a stage.
+ */
+struct StageTime {
+  double busy{};     //!< @brief Exclusive thread-seconds.
+  uint64_t calls{};  //!< @brief Number of finished timers.
+};
+
+/**
+ * @brief Charges the time of its scope to a stage.
+ *
+ * Timers nest on each thread: starting a timer pauses the enclosing one, so
+ * time spent in a nested stage is not counted twice. Timers must be stopped in
+ * reverse order of their creation. Nothing is recorded while statistics are
+ * disabled (see PerfStats::SetEnabled()).
+ */
+class StageTimer {
+  using Clock = std::chrono::steady_clock;  //!< @brief
+
+  Stage stage_;              //!< @brief Stage charged.
+  StageTimer* parent_{};     //!< @brief Enclosing timer on this thread.
+  Clock::time_point start_;  //!< @brief Begin of the uncharged period.
+  bool running_;             //!< @brief False once stopped or if disabled.
+
+  /**
+   * @brief Charges the time since the last charge to the stage.
+   * @param now Current time.
+   */
+  void Charge(Clock::time_point now);
+
+ public:
+  /**
+   * @brief Starts timing and pauses the enclosing timer of this thread.
+   * @param stage Stage to charge.
+   */
+  explicit StageTimer(Stage stage);
+
+  /**
+   * @brief Stops timing if not already done.
+   */
+  ~StageTimer();
+
+  /**
+   * @brief Stops timing and resumes the enclosing timer. Use this to hand
+   * data on to the next stage without charging the call to this one.
+   */
+  void Stop();
+
+  StageTimer(const StageTimer&) = delete;             //!< @brief
+  StageTimer& operator=(const StageTimer&) = delete;  //!< @brief
+
+  /**
+   * @brief Reads the time accumulated by all threads since the last Reset().
+   * Timers still running are not included.
+   * @return Time per stage, indexed by Stage.
+   */
+  static std::array<StageTime, kNumStages> Collect();
+
+  /**
+   * @brief Clears the accumulated time of all stages.
+   */
+  static void Reset();
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::core::stats
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_CORE_STATS_STAGE_TIMER_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -13,6 +13,7 @@
 #include <tuple>
 #include <utility>
 
+#include "genie/core/stats/descriptor_metrics.h"
 #include "genie/util/runtime_exception.h"
 #include "genie/util/stop_watch.h"
 
@@ -22,17 +23,29 @@ namespace genie::entropy::bsc {
 
 // -----------------------------------------------------------------------------
 
+namespace {
+
+/**
+ * @brief Initializes the global state of libbsc once per process.
+ */
+void InitializeBsc() {
+  static const int result = bsc_init(0);
+  UTILS_DIE_IF(result != LIBBSC_NO_ERROR, "bsc initialization failed");
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
 core::AccessUnit::Subsequence Decompress(core::AccessUnit::Subsequence&& data) {
   const auto id = data.GetId();
 
   uint8_t bytes = core::Range2Bytes(GetSubsequence(id).range);
-  if (id.first == core::GenDesc::kReadName) {
+  if (GetDescriptor(id.first).token_type) {
     bytes = 1;
   }
   util::DataBlock in = data.Move();
 
-  UTILS_DIE_IF(bsc_init(0) != LIBBSC_NO_ERROR, "bsc initialization failed");
-
   int original_size = 0;
   int compressed_size = 0;
   UTILS_DIE_IF(bsc_block_info(static_cast<const unsigned char*>(in.GetData()),
@@ -40,7 +53,8 @@ core::AccessUnit::Subsequence Decompress(core::AccessUnit::Subsequence&& data) {
                               &original_size, 0) != LIBBSC_NO_ERROR,
                "bsc block info failed");
 
-  util::DataBlock out(original_size, bytes);
+  // The block info reports bytes, the data block is sized in symbols
+  util::DataBlock out(original_size / bytes, bytes);
 
   UTILS_DIE_IF(bsc_decompress(static_cast<const unsigned char*>(in.GetData()),
                               in.GetRawSize(),
@@ -59,6 +73,8 @@ Decoder::Process(const core::parameter::DescriptorSubSequenceCfg& param,
   (void)param;
   (void)mm_coder_enabled;
   const util::Watch watch;
+  const auto& metrics = core::stats::DescriptorMetrics::Get("bsc");
+  InitializeBsc();
   std::tuple<core::AccessUnit::Descriptor, core::stats::PerfStats> desc;
   std::get<0>(desc) = std::move(d);
   for (auto& sub_sequence : std::get<0>(desc)) {
@@ -67,20 +83,11 @@ Decoder::Process(const core::parameter::DescriptorSubSequenceCfg& param,
     }
     const auto [kFst, kSnd] = sub_sequence.GetId();
 
-    auto sub_sequence_name = std::string();
-    if (GetDescriptor(std::get<0>(desc).GetId()).token_type) {
-      sub_sequence_name = GetDescriptor(std::get<0>(desc).GetId()).name;
-    } else {
-      sub_sequence_name =
-          GetDescriptor(std::get<0>(desc).GetId()).name + "-" +
-          GetDescriptor(std::get<0>(desc).GetId()).sub_seqs[kSnd].name;
-    }
     if (!sub_sequence.IsEmpty()) {
       std::get<1>(desc).AddInteger(
-          "size-bsc-total-comp",
-          static_cast<int64_t>(sub_sequence.GetRawSize()));
+          metrics.TotalComp(), static_cast<int64_t>(sub_sequence.GetRawSize()));
       std::get<1>(desc).AddInteger(
-          "size-bsc-" + sub_sequence_name + "-comp",
+          metrics.Comp({kFst, kSnd}),
           static_cast<int64_t>(sub_sequence.GetRawSize()));
     }
 
@@ -88,14 +95,14 @@ Decoder::Process(const core::parameter::DescriptorSubSequenceCfg& param,
 
     if (!std::get<0>(desc).Get(kSnd).IsEmpty()) {
       std::get<1>(desc).AddInteger(
-          "size-bsc-total-raw",
+          metrics.TotalRaw(),
           static_cast<int64_t>(std::get<0>(desc).Get(kSnd).GetRawSize()));
       std::get<1>(desc).AddInteger(
-          "size-bsc-" + sub_sequence_name + "-raw",
+          metrics.Raw({kFst, kSnd}),
           static_cast<int64_t>(std::get<0>(desc).Get(kSnd).GetRawSize()));
     }
   }
-  std::get<1>(desc).AddDouble("time-bsc", watch.Check());
+  std::get<1>(desc).AddDouble(metrics.Time(), watch.Check());
   return desc;
 }
 
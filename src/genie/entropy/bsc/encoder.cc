@@ -15,7 +15,9 @@
 #include <utility>
 
 #include "genie/core/parameter/descriptor_present/descriptor_present.h"
+#include "genie/core/stats/descriptor_metrics.h"
 #include "genie/entropy/bsc/param_decoder.h"
+#include "genie/util/runtime_exception.h"
 #include "genie/util/stop_watch.h"
 
 // -----------------------------------------------------------------------------
@@ -24,6 +26,20 @@ namespace genie::entropy::bsc {
 
 // -----------------------------------------------------------------------------
 
+namespace {
+
+/**
+ * @brief Initializes the global state of libbsc once per process.
+ */
+void InitializeBsc() {
+  static const int result = bsc_init(0);
+  UTILS_DIE_IF(result != LIBBSC_NO_ERROR, "bsc initialization failed");
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
 template <typename T>
 void FillDecoder(const core::GenomicDescriptorProperties& desc,
                  T& decoder_config) {
@@ -53,26 +69,25 @@ void StoreParameters(core::GenDesc desc,
 
 // -----------------------------------------------------------------------------
 
-core::AccessUnit::Subsequence Compress(core::AccessUnit::Subsequence&& in) {
+core::AccessUnit::Subsequence Compress(core::AccessUnit::Subsequence&& in,
+                                       core::EntropyCodecContext& context) {
   const size_t num_symbols = in.GetNumSymbols();
   util::DataBlock input_buffer = in.Move();
-  util::DataBlock output_buffer(input_buffer.GetRawSize() + LIBBSC_HEADER_SIZE,
-                                1);
+  uint8_t* scratch =
+      context.GetScratch(input_buffer.GetRawSize() + LIBBSC_HEADER_SIZE);
 
-  UTILS_DIE_IF(bsc_init(0) != LIBBSC_NO_ERROR, "bsc initialization failed");
   const int compressed_size =
       bsc_compress(static_cast<const unsigned char*>(input_buffer.GetData()),
-                   static_cast<unsigned char*>(output_buffer.GetData()),
+                   scratch,
                    static_cast<int>(input_buffer.GetRawSize()),
                    LIBBSC_DEFAULT_LZPHASHSIZE, LIBBSC_DEFAULT_LZPMINLEN,
                    LIBBSC_DEFAULT_BLOCKSORTER, LIBBSC_DEFAULT_CODER, 0);
   UTILS_DIE_IF(compressed_size < 0,
                "bsc compression failed: " + std::to_string(compressed_size));
-  output_buffer.Resize(compressed_size);
 
   core::AccessUnit::Subsequence out(in.GetId());
   out.AnnotateNumSymbols(num_symbols);
-  out.Set(std::move(output_buffer));
+  out.Set(util::DataBlock(scratch, compressed_size, 1));
   return out;
 }
 
@@ -82,6 +97,9 @@ core::EntropyEncoder::entropy_coded Encoder::Process(
     core::AccessUnit::Descriptor& desc) {
   entropy_coded ret;
   const util::Watch watch;
+  const auto& metrics = core::stats::DescriptorMetrics::Get("bsc");
+  InitializeBsc();
+  const auto lease = AcquireContext();
   std::get<1>(ret) = std::move(desc);
   for (auto& sub_descriptor : std::get<1>(ret)) {
     if (!sub_descriptor.IsEmpty()) {
@@ -89,28 +107,20 @@ core::EntropyEncoder::entropy_coded Encoder::Process(
       const auto [kFst, kSnd] = sub_descriptor.GetId();
 
       std::get<2>(ret).AddInteger(
-          "size-bsc-total-raw",
+          metrics.TotalRaw(),
           static_cast<int64_t>(sub_descriptor.GetRawSize()));
-      auto sub_seq_name = std::string();
-      if (GetDescriptor(std::get<1>(ret).GetId()).token_type) {
-        sub_seq_name = GetDescriptor(std::get<1>(ret).GetId()).name;
-      } else {
-        sub_seq_name =
-            GetDescriptor(std::get<1>(ret).GetId()).name + "-" +
-            GetDescriptor(std::get<1>(ret).GetId()).sub_seqs[kSnd].name;
-      }
       std::get<2>(ret).AddInteger(
-          "size-bsc-" + sub_seq_name + "-raw",
+          metrics.Raw({kFst, kSnd}),
           static_cast<int64_t>(sub_descriptor.GetRawSize()));
 
-      std::get<1>(ret).Set(kSnd, Compress(std::move(sub_descriptor)));
+      std::get<1>(ret).Set(kSnd, Compress(std::move(sub_descriptor), *lease));
 
       if (!std::get<1>(ret).Get(kSnd).IsEmpty()) {
         std::get<2>(ret).AddInteger(
-            "size-bsc-total-comp",
+            metrics.TotalComp(),
             static_cast<int64_t>(std::get<1>(ret).Get(kSnd).GetRawSize()));
         std::get<2>(ret).AddInteger(
-            "size-bsc-" + sub_seq_name + "-comp",
+            metrics.Comp({kFst, kSnd}),
             static_cast<int64_t>(std::get<1>(ret).Get(kSnd).GetRawSize()));
       }
     } else {
@@ -121,7 +131,7 @@ core::EntropyEncoder::entropy_coded Encoder::Process(
     }
   }
   StoreParameters(std::get<1>(ret).GetId(), std::get<0>(ret));
-  std::get<2>(ret).AddDouble("time-bsc", watch.Check());
+  std::get<2>(ret).AddDouble(metrics.Time(), watch.Check());
   return ret;
 }
 
@@ -14,6 +14,7 @@
 #include <utility>
 #include <vector>
 
+#include "genie/core/stats/descriptor_metrics.h"
 #include "genie/entropy/gabac/decode_desc_sub_seq.h"
 #include "genie/entropy/gabac/decode_transformed_sub_seq.h"
 #include "genie/entropy/gabac/mismatch_decoder.h"
@@ -120,12 +121,12 @@ core::AccessUnit::Descriptor DecompressTokens(
 
     while (ret.GetSize() < mapped_type_id) {
       ret.Add(core::AccessUnit::Subsequence(
-          1, core::GenSubIndex{core::GenDesc::kReadName,
+          1, core::GenSubIndex{ret.GetId(),
                                static_cast<uint16_t>(ret.GetSize())}));
     }
     ret.Add(core::AccessUnit::Subsequence(
         std::move(transformed_seqs.front()),
-        core::GenSubIndex{core::GenDesc::kReadName,
+        core::GenSubIndex{ret.GetId(),
                           static_cast<uint16_t>(mapped_type_id)}));
   }
   return ret;
@@ -183,6 +184,7 @@ std::tuple<core::AccessUnit::Descriptor, core::stats::PerfStats>
 Decoder::Process(const core::parameter::DescriptorSubSequenceCfg& param,
                  core::AccessUnit::Descriptor& d, bool mm_coder_enabled) {
   util::Watch watch;
+  const auto& metrics = core::stats::DescriptorMetrics::Get("gabac");
   std::tuple<core::AccessUnit::Descriptor, core::stats::PerfStats> desc;
   std::get<0>(desc) = std::move(d);
   const auto& param_desc =
@@ -195,11 +197,10 @@ Decoder::Process(const core::parameter::DescriptorSubSequenceCfg& param,
     }
 
     if (size) {
-      std::get<1>(desc).AddInteger("size-gabac-total-comp",
+      std::get<1>(desc).AddInteger(metrics.TotalComp(),
                                    static_cast<int64_t>(size));
       std::get<1>(desc).AddInteger(
-          "size-gabac-" + GetDescriptor(std::get<0>(desc).GetId()).name +
-              "-comp",
+          metrics.Comp({std::get<0>(desc).GetId(), 0}),
           static_cast<int64_t>(size));
     }
 
@@ -214,11 +215,10 @@ Decoder::Process(const core::parameter::DescriptorSubSequenceCfg& param,
 
     if (size) {
       std::get<1>(desc).AddInteger(
-          "size-gabac-total-raw",
+          metrics.TotalRaw(),
           static_cast<int64_t>(std::get<0>(desc).begin()->GetRawSize()));
       std::get<1>(desc).AddInteger(
-          "size-gabac-" + GetDescriptor(std::get<0>(desc).GetId()).name +
-              "-raw",
+          metrics.Raw({std::get<0>(desc).GetId(), 0}),
           static_cast<int64_t>(std::get<0>(desc).begin()->GetRawSize()));
     }
   } else {
@@ -234,13 +234,10 @@ Decoder::Process(const core::parameter::DescriptorSubSequenceCfg& param,
 
       if (!sub_sequence.IsEmpty()) {
         std::get<1>(desc).AddInteger(
-            "size-gabac-total-comp",
+            metrics.TotalComp(),
             static_cast<int64_t>(sub_sequence.GetRawSize()));
         std::get<1>(desc).AddInteger(
-            "size-gabac-" + GetDescriptor(std::get<0>(desc).GetId()).name +
-                "-" +
-                GetDescriptor(std::get<0>(desc).GetId()).sub_seqs[snd].name +
-                "-comp",
+            metrics.Comp({fst, snd}),
             static_cast<int64_t>(sub_sequence.GetRawSize()));
       }
 
@@ -250,18 +247,15 @@ Decoder::Process(const core::parameter::DescriptorSubSequenceCfg& param,
 
       if (!std::get<0>(desc).Get(snd).IsEmpty()) {
         std::get<1>(desc).AddInteger(
-            "size-gabac-total-raw",
+            metrics.TotalRaw(),
             static_cast<int64_t>(std::get<0>(desc).Get(snd).GetRawSize()));
         std::get<1>(desc).AddInteger(
-            "size-gabac-" + GetDescriptor(std::get<0>(desc).GetId()).name +
-                "-" +
-                GetDescriptor(std::get<0>(desc).GetId()).sub_seqs[snd].name +
-                "-raw",
+            metrics.Raw({fst, snd}),
             static_cast<int64_t>(std::get<0>(desc).Get(snd).GetRawSize()));
       }
     }
   }
-  std::get<1>(desc).AddDouble("time-gabac", watch.Check());
+  std::get<1>(desc).AddDouble(metrics.Time(), watch.Check());
   return desc;
 }
 
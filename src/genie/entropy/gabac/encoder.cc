@@ -11,6 +11,7 @@
 #include <string>
 #include <utility>
 
+#include "genie/core/stats/descriptor_metrics.h"
 #include "genie/util/stop_watch.h"
 
 // -----------------------------------------------------------------------------
@@ -124,6 +125,7 @@ core::EntropyEncoder::entropy_coded Encoder::Process(
 
   entropy_coded ret;
   const util::Watch watch;
+  const auto& metrics = core::stats::DescriptorMetrics::Get("gabac");
   std::get<1>(ret) = std::move(desc);
   if (!GetDescriptor(std::get<1>(ret).GetId()).token_type) {
     for (auto& subdesc : std::get<1>(ret)) {
@@ -132,25 +134,19 @@ core::EntropyEncoder::entropy_coded Encoder::Process(
         // add compressed payload
         const auto [kFst, kSnd] = subdesc.GetId();
 
-        std::get<2>(ret).AddInteger("size-gabac-total-raw",
+        std::get<2>(ret).AddInteger(metrics.TotalRaw(),
+                                    static_cast<int64_t>(subdesc.GetRawSize()));
+        std::get<2>(ret).AddInteger(metrics.Raw({kFst, kSnd}),
                                     static_cast<int64_t>(subdesc.GetRawSize()));
-        std::get<2>(ret).AddInteger(
-            "size-gabac-" + GetDescriptor(std::get<1>(ret).GetId()).name + "-" +
-                GetDescriptor(std::get<1>(ret).GetId()).sub_seqs[kSnd].name +
-                "-raw",
-            static_cast<int64_t>(subdesc.GetRawSize()));
 
         std::get<1>(ret).Set(kSnd, Compress(conf, std::move(subdesc)));
 
         if (!std::get<1>(ret).Get(kSnd).IsEmpty()) {
           std::get<2>(ret).AddInteger(
-              "size-gabac-total-comp",
+              metrics.TotalComp(),
               static_cast<int64_t>(std::get<1>(ret).Get(kSnd).GetRawSize()));
           std::get<2>(ret).AddInteger(
-              "size-gabac-" + GetDescriptor(std::get<1>(ret).GetId()).name +
-                  "-" +
-                  GetDescriptor(std::get<1>(ret).GetId()).sub_seqs[kSnd].name +
-                  "-comp",
+              metrics.Comp({kFst, kSnd}),
               static_cast<int64_t>(std::get<1>(ret).Get(kSnd).GetRawSize()));
         }
       } else {
@@ -172,21 +168,20 @@ core::EntropyEncoder::entropy_coded Encoder::Process(
     config_set_.StoreParameters(std::get<1>(ret).GetId(), std::get<0>(ret));
 
     if (size) {
-      std::get<2>(ret).AddInteger("size-gabac-total-raw",
+      std::get<2>(ret).AddInteger(metrics.TotalRaw(),
                                   static_cast<int64_t>(size));
       std::get<2>(ret).AddInteger(
-          "size-gabac-" + GetDescriptor(std::get<1>(ret).GetId()).name + "-raw",
+          metrics.Raw({std::get<1>(ret).GetId(), 0}),
           static_cast<int64_t>(size));
       std::get<2>(ret).AddInteger(
-          "size-gabac-total-comp",
+          metrics.TotalComp(),
           static_cast<int64_t>(std::get<1>(ret).begin()->GetRawSize()));
       std::get<2>(ret).AddInteger(
-          "size-gabac-" + GetDescriptor(std::get<1>(ret).GetId()).name +
-              "-comp",
+          metrics.Comp({std::get<1>(ret).GetId(), 0}),
           static_cast<int64_t>(std::get<1>(ret).begin()->GetRawSize()));
     }
   }
-  std::get<2>(ret).AddDouble("time-gabac", watch.Check());
+  std::get<2>(ret).AddDouble(metrics.Time(), watch.Check());
   return ret;
 }
 
@@ -244,8 +244,8 @@ size_t Reader::Close() { return m_dec_bin_cabac_.Close(); }
 
 void Reader::Reset() {
   m_dec_bin_cabac_.Reset();
-  m_context_models_.clear();
-  m_context_models_ = contexttables::BuildContextTable(m_num_contexts_);
+  // Reinitialize in place, the table keeps its storage
+  m_context_models_.assign(m_num_contexts_, ContextModel());
 }
 
 // -----------------------------------------------------------------------------
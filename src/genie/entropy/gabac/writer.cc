@@ -51,8 +51,8 @@ void Writer::Close() { binary_arithmetic_encoder_.Flush(); }
 
 void Writer::Reset() {
   binary_arithmetic_encoder_.Flush();
-  context_models_.clear();
-  context_models_ = contexttables::BuildContextTable(num_contexts_);
+  // Reinitialize in place, the table keeps its storage
+  context_models_.assign(num_contexts_, ContextModel());
 }
 
 // -----------------------------------------------------------------------------
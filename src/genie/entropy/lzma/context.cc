@@ -0,0 +1,31 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/entropy/lzma/context.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::entropy::lzma {
+
+// -----------------------------------------------------------------------------
+
+Context::Context() : stream_(LZMA_STREAM_INIT) {}
+
+// -----------------------------------------------------------------------------
+
+Context::~Context() { lzma_end(&stream_); }
+
+// -----------------------------------------------------------------------------
+
+lzma_stream& Context::GetStream() { return stream_; }
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::entropy::lzma
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#ifndef SRC_GENIE_ENTROPY_LZMA_CONTEXT_H_
+#define SRC_GENIE_ENTROPY_LZMA_CONTEXT_H_
+
+// -----------------------------------------------------------------------------
+
+#include <lzma.h>
+
+#include "genie/core/entropy_codec_context.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::entropy::lzma {
+
+/**
+ * @brief Lzma state of one codec context.
+ * @details The stream is ended only when the context is destroyed.
+ * Initializing a coder on a stream that was used before reuses the memory of
+ * the previous coder of the same type, so the dictionary and match finder
+ * buffers are allocated once instead of once per subsequence.
+ */
+class Context final : public core::EntropyCodecContext {
+ public:
+  /**
+   * @brief
+   */
+  Context();
+
+  /**
+   * @brief Frees the coder memory.
+   */
+  ~Context() override;
+
+  Context(const Context&) = delete;
+  Context& operator=(const Context&) = delete;
+
+  /**
+   * @brief
+   * @return The reusable stream.
+   */
+  lzma_stream& GetStream();
+
+ private:
+  lzma_stream stream_;  //!< @brief Reusable stream.
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::entropy::lzma
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_ENTROPY_LZMA_CONTEXT_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
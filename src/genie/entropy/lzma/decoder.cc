@@ -11,10 +11,13 @@
 
 #include <algorithm>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
 
+#include "genie/core/stats/descriptor_metrics.h"
+#include "genie/entropy/lzma/context.h"
 #include "genie/util/runtime_exception.h"
 #include "genie/util/stop_watch.h"
 
@@ -24,16 +27,18 @@ namespace genie::entropy::lzma {
 
 // -----------------------------------------------------------------------------
 
-core::AccessUnit::Subsequence decompress(core::AccessUnit::Subsequence&& data) {
+core::AccessUnit::Subsequence decompress(core::AccessUnit::Subsequence&& data,
+                                         Context& context) {
   const auto id = data.GetId();
 
   uint8_t bytes = core::Range2Bytes(GetSubsequence(id).range);
-  if (id.first == core::GenDesc::kReadName) {
+  if (GetDescriptor(id.first).token_type) {
     bytes = 1;
   }
   util::DataBlock in = data.Move();
 
-  lzma_stream strm = LZMA_STREAM_INIT;
+  // Reuses the decoder memory of the previous subsequence
+  lzma_stream& strm = context.GetStream();
   UTILS_DIE_IF(
       lzma_stream_decoder(&strm, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK,
       "lzma initialization failed");
@@ -43,19 +48,16 @@ core::AccessUnit::Subsequence decompress(core::AccessUnit::Subsequence&& data) {
   size_t out_capacity =
       in.GetRawSize() * 2;  // Initial guess; typically this would be adjusted
                             // based on expected compression ratio
-  util::DataBlock out(out_capacity, bytes);
+  uint8_t* scratch = context.GetScratch(out_capacity);
 
-  // Decompress in a loop, expanding the output buffer as needed
+  // Decompress in a loop, expanding the scratch buffer as needed
   while (true) {
-    strm.next_out = static_cast<uint8_t*>(out.GetData()) + strm.total_out;
+    strm.next_out = scratch + strm.total_out;
     strm.avail_out = out_capacity - strm.total_out;
 
     const auto ret = lzma_code(&strm, LZMA_FINISH);
 
     if (ret == LZMA_STREAM_END) {
-      // Finished decompressing
-      out.Resize(
-          strm.total_out);  // Resize to the actual Size of decompressed data
       break;
     }
 
@@ -65,24 +67,30 @@ core::AccessUnit::Subsequence decompress(core::AccessUnit::Subsequence&& data) {
     if (strm.avail_out == 0) {
       // Output buffer is full, so expand it
       out_capacity *= 2;
-      out.Resize(out_capacity);
+      scratch = context.GetScratch(out_capacity);
     }
   }
 
-  // Clean up
-  lzma_end(&strm);
-
-  return {std::move(out), data.GetId()};
+  return {util::DataBlock(scratch, strm.total_out / bytes, bytes),
+          data.GetId()};
 }
 
 // -----------------------------------------------------------------------------
 
+Decoder::Decoder()
+    : core::EntropyDecoder([] { return std::make_unique<Context>(); }) {}
+
+// -----------------------------------------------------------------------------
+
 std::tuple<core::AccessUnit::Descriptor, core::stats::PerfStats>
 Decoder::Process(const core::parameter::DescriptorSubSequenceCfg& param,
                  core::AccessUnit::Descriptor& d, const bool mm_coder_enabled) {
   (void)param;
   (void)mm_coder_enabled;
   const util::Watch watch;
+  const auto& metrics = core::stats::DescriptorMetrics::Get("lzma");
+  const auto lease = AcquireContext();
+  auto& context = static_cast<Context&>(*lease);
   std::tuple<core::AccessUnit::Descriptor, core::stats::PerfStats> desc;
   std::get<0>(desc) = std::move(d);
   for (auto& subseq : std::get<0>(desc)) {
@@ -91,32 +99,25 @@ Decoder::Process(const core::parameter::DescriptorSubSequenceCfg& param,
     }
     const auto [fst, snd] = subseq.GetId();
 
-    auto subseq_name = std::string();
-    if (GetDescriptor(std::get<0>(desc).GetId()).token_type) {
-      subseq_name = GetDescriptor(std::get<0>(desc).GetId()).name;
-    } else {
-      subseq_name = GetDescriptor(std::get<0>(desc).GetId()).name + "-" +
-                    GetDescriptor(std::get<0>(desc).GetId()).sub_seqs[snd].name;
-    }
     if (!subseq.IsEmpty()) {
-      std::get<1>(desc).AddInteger("size-lzma-total-comp",
+      std::get<1>(desc).AddInteger(metrics.TotalComp(),
                                    static_cast<int64_t>(subseq.GetRawSize()));
-      std::get<1>(desc).AddInteger("size-lzma-" + subseq_name + "-comp",
+      std::get<1>(desc).AddInteger(metrics.Comp({fst, snd}),
                                    static_cast<int64_t>(subseq.GetRawSize()));
     }
 
-    std::get<0>(desc).Set(snd, decompress(std::move(subseq)));
+    std::get<0>(desc).Set(snd, decompress(std::move(subseq), context));
 
     if (!std::get<0>(desc).Get(snd).IsEmpty()) {
       std::get<1>(desc).AddInteger(
-          "size-lzma-total-raw",
+          metrics.TotalRaw(),
           static_cast<int64_t>(std::get<0>(desc).Get(snd).GetRawSize()));
       std::get<1>(desc).AddInteger(
-          "size-lzma-" + subseq_name + "-raw",
+          metrics.Raw({fst, snd}),
           static_cast<int64_t>(std::get<0>(desc).Get(snd).GetRawSize()));
     }
   }
-  std::get<1>(desc).AddDouble("time-lzma", watch.Check());
+  std::get<1>(desc).AddDouble(metrics.Time(), watch.Check());
   return desc;
 }
 
@@ -38,6 +38,11 @@ namespace genie::entropy::lzma {
  */
 class Decoder final : public core::EntropyDecoder {
  public:
+  /**
+   * @brief Construct a new Decoder object.
+   */
+  Decoder();
+
   /**
    * @brief Decompress a given descriptor using the LZMA algorithm.
    * @param param Configuration of the descriptor subsequence.
@@ -15,6 +15,8 @@
 #include <utility>
 
 #include "genie/core/parameter/descriptor_present/descriptor_present.h"
+#include "genie/core/stats/descriptor_metrics.h"
+#include "genie/entropy/lzma/context.h"
 #include "genie/entropy/lzma/param_decoder.h"
 #include "genie/util/stop_watch.h"
 
@@ -52,12 +54,13 @@ void StoreParameters(core::GenDesc desc,
 
 // -----------------------------------------------------------------------------
 
-core::AccessUnit::Subsequence Compress(core::AccessUnit::Subsequence&& in) {
+core::AccessUnit::Subsequence Compress(core::AccessUnit::Subsequence&& in,
+                                       Context& context) {
   const size_t num_symbols = in.GetNumSymbols();
   util::DataBlock input_buffer = in.Move();
 
-  lzma_stream strm = LZMA_STREAM_INIT;  // Initialize the lzma_stream structure
-
+  // Reuses the encoder memory of the previous subsequence
+  lzma_stream& strm = context.GetStream();
   UTILS_DIE_IF(lzma_easy_encoder(&strm, LZMA_PRESET_DEFAULT,
                                  LZMA_CHECK_CRC64) != LZMA_OK,
                "lzma initialization failed");
@@ -66,10 +69,10 @@ core::AccessUnit::Subsequence Compress(core::AccessUnit::Subsequence&& in) {
   strm.avail_in = input_buffer.GetRawSize();
 
   const size_t out_size = lzma_stream_buffer_bound(input_buffer.GetRawSize());
-  util::DataBlock output_buffer(out_size, 1);
+  uint8_t* scratch = context.GetScratch(out_size);
 
-  strm.next_out = static_cast<unsigned char*>(output_buffer.GetData());
-  strm.avail_out = output_buffer.GetRawSize();
+  strm.next_out = scratch;
+  strm.avail_out = out_size;
   lzma_ret ret = LZMA_OK;
   while (ret == LZMA_OK) {
     ret = lzma_code(&strm, LZMA_FINISH);
@@ -77,13 +80,9 @@ core::AccessUnit::Subsequence Compress(core::AccessUnit::Subsequence&& in) {
                  "lzma compression failed: " + std::to_string(ret));
   }
 
-  lzma_end(&strm);
-
-  output_buffer.Resize(strm.total_out);
-
   core::AccessUnit::Subsequence out(in.GetId());
   out.AnnotateNumSymbols(num_symbols);
-  out.Set(std::move(output_buffer));
+  out.Set(util::DataBlock(scratch, strm.total_out, 1));
   return out;
 }
 
@@ -93,33 +92,28 @@ core::EntropyEncoder::entropy_coded Encoder::Process(
     core::AccessUnit::Descriptor& desc) {
   entropy_coded ret;
   const util::Watch watch;
+  const auto& metrics = core::stats::DescriptorMetrics::Get("lzma");
+  const auto lease = AcquireContext();
+  auto& context = static_cast<Context&>(*lease);
   std::get<1>(ret) = std::move(desc);
   for (auto& sub_seq : std::get<1>(ret)) {
     if (!sub_seq.IsEmpty()) {
       // add compressed payload
       const auto [kFst, kSnd] = sub_seq.GetId();
 
-      std::get<2>(ret).AddInteger("size-lzma-total-raw",
+      std::get<2>(ret).AddInteger(metrics.TotalRaw(),
                                   static_cast<int64_t>(sub_seq.GetRawSize()));
-      auto sub_seq_name = std::string();
-      if (GetDescriptor(std::get<1>(ret).GetId()).token_type) {
-        sub_seq_name = GetDescriptor(std::get<1>(ret).GetId()).name;
-      } else {
-        sub_seq_name =
-            GetDescriptor(std::get<1>(ret).GetId()).name + "-" +
-            GetDescriptor(std::get<1>(ret).GetId()).sub_seqs[kSnd].name;
-      }
-      std::get<2>(ret).AddInteger("size-lzma-" + sub_seq_name + "-raw",
+      std::get<2>(ret).AddInteger(metrics.Raw({kFst, kSnd}),
                                   static_cast<int64_t>(sub_seq.GetRawSize()));
 
-      std::get<1>(ret).Set(kSnd, Compress(std::move(sub_seq)));
+      std::get<1>(ret).Set(kSnd, Compress(std::move(sub_seq), context));
 
       if (!std::get<1>(ret).Get(kSnd).IsEmpty()) {
         std::get<2>(ret).AddInteger(
-            "size-lzma-total-comp",
+            metrics.TotalComp(),
             static_cast<int64_t>(std::get<1>(ret).Get(kSnd).GetRawSize()));
         std::get<2>(ret).AddInteger(
-            "size-lzma-" + sub_seq_name + "-comp",
+            metrics.Comp({kFst, kSnd}),
             static_cast<int64_t>(std::get<1>(ret).Get(kSnd).GetRawSize()));
       }
     } else {
@@ -130,14 +124,15 @@ core::EntropyEncoder::entropy_coded Encoder::Process(
     }
   }
   StoreParameters(std::get<1>(ret).GetId(), std::get<0>(ret));
-  std::get<2>(ret).AddDouble("time-lzma", watch.Check());
+  std::get<2>(ret).AddDouble(metrics.Time(), watch.Check());
   return ret;
 }
 
 // -----------------------------------------------------------------------------
 
 Encoder::Encoder(const bool write_out_streams)
-    : write_out_streams_(write_out_streams) {}
+    : core::EntropyEncoder([] { return std::make_unique<Context>(); }),
+      write_out_streams_(write_out_streams) {}
 
 // -----------------------------------------------------------------------------
 
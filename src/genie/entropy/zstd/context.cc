@@ -0,0 +1,120 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file context.cc
+ * @brief Implementation of the reusable zstd contexts and dictionaries.
+ *
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/entropy/zstd/context.h"
+
+#include <zdict.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "genie/util/runtime_exception.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::entropy::zstd {
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/// Number of digested dictionaries kept per context.
+constexpr size_t kDictionaryCacheSize = 64;
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+ZSTD_CCtx* Context::GetCompression() {
+  if (!compression_) {
+    compression_.reset(ZSTD_createCCtx());
+    UTILS_DIE_IF(!compression_, "ZSTD_createCCtx failed");
+  }
+  return compression_.get();
+}
+
+// -----------------------------------------------------------------------------
+
+ZSTD_DCtx* Context::GetDecompression() {
+  if (!decompression_) {
+    decompression_.reset(ZSTD_createDCtx());
+    UTILS_DIE_IF(!decompression_, "ZSTD_createDCtx failed");
+  }
+  return decompression_.get();
+}
+
+// -----------------------------------------------------------------------------
+
+const ZSTD_DDict* Context::GetDictionary(
+    const Subsequence::Dictionary& dictionary) {
+  for (auto it = dictionaries_.begin(); it != dictionaries_.end(); ++it) {
+    if (it->first == dictionary || *it->first == *dictionary) {
+      // Keep recently used dictionaries at the back
+      std::rotate(it, it + 1, dictionaries_.end());
+      return dictionaries_.back().second.get();
+    }
+  }
+  if (dictionaries_.size() == kDictionaryCacheSize) {
+    dictionaries_.erase(dictionaries_.begin());
+  }
+  std::unique_ptr<ZSTD_DDict, DDictDeleter> digested(
+      ZSTD_createDDict(dictionary->data(), dictionary->size()));
+  UTILS_DIE_IF(!digested, "ZSTD_createDDict failed");
+  dictionaries_.emplace_back(dictionary, std::move(digested));
+  return dictionaries_.back().second.get();
+}
+
+// -----------------------------------------------------------------------------
+
+Subsequence::Dictionary TrainDictionary(const std::vector<uint8_t>& samples,
+                                        const std::vector<size_t>& sample_sizes,
+                                        const size_t max_size) {
+  std::vector<uint8_t> dictionary(max_size);
+  const size_t size = ZDICT_trainFromBuffer(
+      dictionary.data(), dictionary.size(), samples.data(), sample_sizes.data(),
+      static_cast<unsigned>(sample_sizes.size()));
+  if (ZDICT_isError(size)) {
+    // Too few or too uniform samples, compress without dictionary
+    return nullptr;
+  }
+  dictionary.resize(size);
+  return std::make_shared<const std::vector<uint8_t>>(std::move(dictionary));
+}
+
+// -----------------------------------------------------------------------------
+
+CompressionDictionary::CompressionDictionary(Subsequence::Dictionary raw,
+                                             const int level)
+    : raw_(std::move(raw)),
+      digested_(ZSTD_createCDict(raw_->data(), raw_->size(), level)) {
+  UTILS_DIE_IF(!digested_, "ZSTD_createCDict failed");
+}
+
+// -----------------------------------------------------------------------------
+
+CompressionDictionary::~CompressionDictionary() { ZSTD_freeCDict(digested_); }
+
+// -----------------------------------------------------------------------------
+
+const Subsequence::Dictionary& CompressionDictionary::GetRaw() const {
+  return raw_;
+}
+
+// -----------------------------------------------------------------------------
+
+const ZSTD_CDict* CompressionDictionary::Get() const { return digested_; }
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::entropy::zstd
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
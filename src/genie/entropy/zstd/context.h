@@ -0,0 +1,144 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file context.h
+ * @brief Reusable zstd contexts and dictionaries for the ZSTD entropy coding
+ * module.
+ * @details Creating a zstd context allocates and initializes several hundred
+ * kilobytes of tables. The codec contexts are therefore pooled by the
+ * entropy coders and keep their zstd contexts alive for all subsequences they
+ * code. Dictionaries are digested once and shared the same way.
+ * @copyright This file is part of Genie
+ *            See LICENSE and/or https://github.com/MueFab/genie for more
+ * details.
+ */
+
+#ifndef SRC_GENIE_ENTROPY_ZSTD_CONTEXT_H_
+#define SRC_GENIE_ENTROPY_ZSTD_CONTEXT_H_
+
+// -----------------------------------------------------------------------------
+
+#include <zstd.h>
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "genie/core/entropy_codec_context.h"
+#include "genie/entropy/zstd/subsequence.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::entropy::zstd {
+
+/**
+ * @brief Zstd state of one codec context. The zstd contexts are created on
+ * first use, so encoders never allocate a decompression context and vice
+ * versa.
+ */
+class Context final : public core::EntropyCodecContext {
+ public:
+  /**
+   * @brief
+   * @return Compression context.
+   */
+  ZSTD_CCtx* GetCompression();
+
+  /**
+   * @brief
+   * @return Decompression context.
+   */
+  ZSTD_DCtx* GetDecompression();
+
+  /**
+   * @brief Get a digested decompression dictionary. Dictionaries are cached
+   * by content, so the copies of a parameter set in consecutive access units
+   * are digested only once.
+   * @param dictionary Raw dictionary.
+   * @return Digested dictionary, valid as long as the context.
+   */
+  const ZSTD_DDict* GetDictionary(const Subsequence::Dictionary& dictionary);
+
+ private:
+  /// Frees a compression context.
+  struct CCtxDeleter {
+    void operator()(ZSTD_CCtx* ctx) const { ZSTD_freeCCtx(ctx); }
+  };
+
+  /// Frees a decompression context.
+  struct DCtxDeleter {
+    void operator()(ZSTD_DCtx* ctx) const { ZSTD_freeDCtx(ctx); }
+  };
+
+  /// Frees a digested decompression dictionary.
+  struct DDictDeleter {
+    void operator()(ZSTD_DDict* dict) const { ZSTD_freeDDict(dict); }
+  };
+
+  std::unique_ptr<ZSTD_CCtx, CCtxDeleter> compression_;  //!< @brief
+  std::unique_ptr<ZSTD_DCtx, DCtxDeleter> decompression_;  //!< @brief
+
+  /// Recently used dictionaries, most recent last.
+  std::vector<std::pair<Subsequence::Dictionary,
+                        std::unique_ptr<ZSTD_DDict, DDictDeleter>>>
+      dictionaries_;
+};
+
+/**
+ * @brief Train a dictionary on sample data.
+ * @param samples Concatenated samples.
+ * @param sample_sizes Size of each sample in `samples`.
+ * @param max_size Maximum size of the dictionary in bytes.
+ * @return The dictionary or nullptr if the samples are not suitable.
+ */
+Subsequence::Dictionary TrainDictionary(const std::vector<uint8_t>& samples,
+                                        const std::vector<size_t>& sample_sizes,
+                                        size_t max_size);
+
+/**
+ * @brief Dictionary digested for compression at a fixed level.
+ */
+class CompressionDictionary {
+ public:
+  /**
+   * @brief Digest a dictionary.
+   * @param raw Raw dictionary.
+   * @param level Compression level.
+   */
+  CompressionDictionary(Subsequence::Dictionary raw, int level);
+
+  /**
+   * @brief Free the digested dictionary.
+   */
+  ~CompressionDictionary();
+
+  CompressionDictionary(const CompressionDictionary&) = delete;
+  CompressionDictionary& operator=(const CompressionDictionary&) = delete;
+
+  /**
+   * @brief
+   * @return Raw dictionary to store in the parameter set.
+   */
+  [[nodiscard]] const Subsequence::Dictionary& GetRaw() const;
+
+  /**
+   * @brief
+   * @return Digested dictionary.
+   */
+  [[nodiscard]] const ZSTD_CDict* Get() const;
+
+ private:
+  Subsequence::Dictionary raw_;  //!< @brief Raw dictionary.
+  ZSTD_CDict* digested_;         //!< @brief Digested dictionary.
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::entropy::zstd
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_ENTROPY_ZSTD_CONTEXT_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
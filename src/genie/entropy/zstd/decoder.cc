@@ -16,10 +16,15 @@
 
 #include <algorithm>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
 
+#include "genie/core/parameter/descriptor_present/descriptor_present.h"
+#include "genie/core/stats/descriptor_metrics.h"
+#include "genie/entropy/zstd/context.h"
+#include "genie/entropy/zstd/param_decoder.h"
 #include "genie/util/runtime_exception.h"
 #include "genie/util/stop_watch.h"
 
@@ -29,11 +34,13 @@ namespace genie::entropy::zstd {
 
 // -----------------------------------------------------------------------------
 
-core::AccessUnit::Subsequence decompress(core::AccessUnit::Subsequence&& data) {
+core::AccessUnit::Subsequence decompress(
+    core::AccessUnit::Subsequence&& data,
+    const Subsequence::Dictionary& dictionary, Context& context) {
   const auto id = data.GetId();
 
   uint8_t bytes = core::Range2Bytes(GetSubsequence(id).range);
-  if (id.first == core::GenDesc::kReadName) {
+  if (GetDescriptor(id.first).token_type) {
     bytes = 1;
   }
   util::DataBlock in = data.Move();
@@ -45,10 +52,15 @@ core::AccessUnit::Subsequence decompress(core::AccessUnit::Subsequence&& data) {
   UTILS_DIE_IF(original_size == ZSTD_CONTENTSIZE_UNKNOWN,
                "ZSTD_getFrameContentSize unknown");
 
-  util::DataBlock out(original_size, bytes);
+  util::DataBlock out(original_size / bytes, bytes);
 
-  const size_t decompressed_size = ZSTD_decompress(
-      out.GetData(), out.GetRawSize(), in.GetData(), in.GetRawSize());
+  ZSTD_DCtx* ctx = context.GetDecompression();
+  const size_t decompressed_size =
+      dictionary ? ZSTD_decompress_usingDDict(
+                       ctx, out.GetData(), out.GetRawSize(), in.GetData(),
+                       in.GetRawSize(), context.GetDictionary(dictionary))
+                 : ZSTD_decompressDCtx(ctx, out.GetData(), out.GetRawSize(),
+                                       in.GetData(), in.GetRawSize());
 
   UTILS_DIE_IF(ZSTD_isError(decompressed_size),
                "ZSTD decompression failed: " +
@@ -59,12 +71,25 @@ core::AccessUnit::Subsequence decompress(core::AccessUnit::Subsequence&& data) {
 
 // -----------------------------------------------------------------------------
 
+Decoder::Decoder()
+    : core::EntropyDecoder([] { return std::make_unique<Context>(); }) {}
+
+// -----------------------------------------------------------------------------
+
 std::tuple<core::AccessUnit::Descriptor, core::stats::PerfStats>
 Decoder::Process(const core::parameter::DescriptorSubSequenceCfg& param,
                  core::AccessUnit::Descriptor& d, const bool mm_coder_enabled) {
-  (void)param;
   (void)mm_coder_enabled;
   const util::Watch watch;
+  const auto& metrics = core::stats::DescriptorMetrics::Get("zstd");
+  const auto lease = AcquireContext();
+  auto& context = static_cast<Context&>(*lease);
+  const auto* param_desc =
+      dynamic_cast<const core::parameter::desc_pres::DescriptorPresent*>(
+          &param.Get());
+  UTILS_DIE_IF(param_desc == nullptr, "Decoder configuration not present");
+  const auto* zstd_param =
+      dynamic_cast<const DecoderRegular*>(&param_desc->GetDecoder());
   std::tuple<core::AccessUnit::Descriptor, core::stats::PerfStats> desc;
   std::get<0>(desc) = std::move(d);
   for (auto& sub_sequence : std::get<0>(desc)) {
@@ -73,35 +98,34 @@ Decoder::Process(const core::parameter::DescriptorSubSequenceCfg& param,
     }
     const auto [fst, snd] = sub_sequence.GetId();
 
-    auto sub_seq_name = std::string();
-    if (GetDescriptor(std::get<0>(desc).GetId()).token_type) {
-      sub_seq_name = GetDescriptor(std::get<0>(desc).GetId()).name;
-    } else {
-      sub_seq_name =
-          GetDescriptor(std::get<0>(desc).GetId()).name + "-" +
-          GetDescriptor(std::get<0>(desc).GetId()).sub_seqs[snd].name;
-    }
     if (!sub_sequence.IsEmpty()) {
       std::get<1>(desc).AddInteger(
-          "size-zstd-total-comp",
-          static_cast<int64_t>(sub_sequence.GetRawSize()));
+          metrics.TotalComp(), static_cast<int64_t>(sub_sequence.GetRawSize()));
       std::get<1>(desc).AddInteger(
-          "size-zstd-" + sub_seq_name + "-comp",
+          metrics.Comp({fst, snd}),
           static_cast<int64_t>(sub_sequence.GetRawSize()));
     }
 
-    std::get<0>(desc).Set(snd, decompress(std::move(sub_sequence)));
+    static const Subsequence::Dictionary kNoDictionary;
+    const auto& dictionary =
+        zstd_param && snd < GetDescriptor(fst).sub_seqs.size()
+            ? zstd_param->GetSubsequenceCfg(static_cast<uint8_t>(snd))
+                  .GetDictionary()
+            : kNoDictionary;
+    std::get<0>(desc).Set(snd,
+                          decompress(std::move(sub_sequence), dictionary,
+                                     context));
 
     if (!std::get<0>(desc).Get(snd).IsEmpty()) {
       std::get<1>(desc).AddInteger(
-          "size-zstd-total-raw",
+          metrics.TotalRaw(),
           static_cast<int64_t>(std::get<0>(desc).Get(snd).GetRawSize()));
       std::get<1>(desc).AddInteger(
-          "size-zstd-" + sub_seq_name + "-raw",
+          metrics.Raw({fst, snd}),
           static_cast<int64_t>(std::get<0>(desc).Get(snd).GetRawSize()));
     }
   }
-  std::get<1>(desc).AddDouble("time-zstd", watch.Check());
+  std::get<1>(desc).AddDouble(metrics.Time(), watch.Check());
   return desc;
 }
 
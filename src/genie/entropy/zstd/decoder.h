@@ -35,6 +35,11 @@ namespace genie::entropy::zstd {
  */
 class Decoder final : public core::EntropyDecoder {
  public:
+  /**
+   * @brief Construct a new Decoder object.
+   */
+  Decoder();
+
   /**
    * @brief Decompress a block payload into a raw access unit.
    * @param param Descriptor configuration parameters for subsequence
@@ -14,14 +14,17 @@
 
 #include <zstd.h>
 
+#include <algorithm>
 #include <atomic>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "genie/core/parameter/descriptor_present/descriptor_present.h"
+#include "genie/core/stats/descriptor_metrics.h"
 #include "genie/entropy/zstd/param_decoder.h"
 #include "genie/util/stop_watch.h"
 
@@ -31,27 +34,58 @@ namespace genie::entropy::zstd {
 
 // -----------------------------------------------------------------------------
 
+namespace {
+
+/// Maximum size of one training sample, larger subsequences are split.
+constexpr size_t kMaxSampleSize = 1024;
+
+/// Maximum number of bytes sampled per subsequence.
+constexpr size_t kMaxSampledBytes = 4 * 1024 * 1024;
+
+/// Maximum size of a dictionary.
+constexpr size_t kMaxDictionarySize = 16 * 1024;
+
+/// Smallest useful dictionary, as required by the trainer.
+constexpr size_t kMinDictionarySize = 256;
+
+/// The dictionary is kept well below the size of the samples.
+constexpr size_t kSamplesPerDictionaryByte = 16;
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
 template <typename T>
-void FillDecoder(const core::GenomicDescriptorProperties& desc,
-                 T& decoder_config) {
+void FillDecoder(
+    const core::GenomicDescriptorProperties& desc,
+    const std::vector<std::shared_ptr<const CompressionDictionary>>&
+        dictionaries,
+    T& decoder_config) {
   for (const auto& sub_sequence : desc.sub_seqs) {
     const auto bits_p2 = core::Range2Bytes(sub_sequence.range) * 8;
-    auto sub_sequence_cfg = Subsequence(bits_p2);
-    decoder_config.SetSubsequenceCfg(
-        static_cast<uint8_t>(sub_sequence.id.second),
-        std::move(sub_sequence_cfg));
+    const auto index = sub_sequence.id.second;
+    Subsequence::Dictionary dictionary;
+    if (index < dictionaries.size() && dictionaries[index]) {
+      dictionary = dictionaries[index]->GetRaw();
+    }
+    auto sub_sequence_cfg = Subsequence(bits_p2, std::move(dictionary));
+    decoder_config.SetSubsequenceCfg(static_cast<uint8_t>(index),
+                                     std::move(sub_sequence_cfg));
   }
 }
 
 // -----------------------------------------------------------------------------
 
-void StoreParameters(core::GenDesc desc,
-                     core::parameter::DescriptorSubSequenceCfg& parameter_set) {
+void StoreParameters(
+    core::GenDesc desc,
+    const std::vector<std::shared_ptr<const CompressionDictionary>>&
+        dictionaries,
+    core::parameter::DescriptorSubSequenceCfg& parameter_set) {
   auto descriptor_configuration =
       std::make_unique<core::parameter::desc_pres::DescriptorPresent>();
 
   auto decoder_config = std::make_unique<DecoderRegular>(desc);
-  FillDecoder(GetDescriptor(desc), *decoder_config);
+  FillDecoder(GetDescriptor(desc), dictionaries, *decoder_config);
   descriptor_configuration->SetDecoder(std::move(decoder_config));
 
   parameter_set = core::parameter::DescriptorSubSequenceCfg();
@@ -60,22 +94,28 @@ void StoreParameters(core::GenDesc desc,
 
 // -----------------------------------------------------------------------------
 
-core::AccessUnit::Subsequence compress(core::AccessUnit::Subsequence&& in) {
+core::AccessUnit::Subsequence compress(
+    core::AccessUnit::Subsequence&& in, const int level,
+    const CompressionDictionary* dictionary, Context& context) {
   const size_t num_symbols = in.GetNumSymbols();
   util::DataBlock input_buffer = in.Move();
-  util::DataBlock output_buffer(ZSTD_compressBound(input_buffer.GetRawSize()),
-                                1);
+  const size_t bound = ZSTD_compressBound(input_buffer.GetRawSize());
+  uint8_t* scratch = context.GetScratch(bound);
+  ZSTD_CCtx* ctx = context.GetCompression();
   const size_t compressed_size =
-      ZSTD_compress(output_buffer.GetData(), output_buffer.GetRawSize(),
-                    input_buffer.GetData(), input_buffer.GetRawSize(), 3);
+      dictionary ? ZSTD_compress_usingCDict(
+                       ctx, scratch, bound, input_buffer.GetData(),
+                       input_buffer.GetRawSize(), dictionary->Get())
+                 : ZSTD_compressCCtx(ctx, scratch, bound,
+                                     input_buffer.GetData(),
+                                     input_buffer.GetRawSize(), level);
   UTILS_DIE_IF(ZSTD_isError(compressed_size),
                "ZSTD compression failed: " +
                    std::string(ZSTD_getErrorName(compressed_size)));
-  output_buffer.Resize(compressed_size);
 
   core::AccessUnit::Subsequence out(in.GetId());
   out.AnnotateNumSymbols(num_symbols);
-  out.Set(std::move(output_buffer));
+  out.Set(util::DataBlock(scratch, compressed_size, 1));
   return out;
 }
 
@@ -85,35 +125,36 @@ core::EntropyEncoder::entropy_coded Encoder::Process(
     core::AccessUnit::Descriptor& desc) {
   entropy_coded ret;
   const util::Watch watch;
+  const auto& metrics = core::stats::DescriptorMetrics::Get("zstd");
   std::get<1>(ret) = std::move(desc);
+  const auto lease = AcquireContext();
+  auto& context = static_cast<Context&>(*lease);
+  std::vector<std::shared_ptr<const CompressionDictionary>> dictionaries;
+  if (dictionary_access_units_) {
+    dictionaries = UpdateDictionaries(std::get<1>(ret));
+  }
   for (auto& sub_sequence : std::get<1>(ret)) {
     if (!sub_sequence.IsEmpty()) {
       // add compressed payload
       const auto [fst, snd] = sub_sequence.GetId();
 
       std::get<2>(ret).AddInteger(
-          "size-zstd-total-raw",
-          static_cast<int64_t>(sub_sequence.GetRawSize()));
-      auto sub_seq_name = std::string();
-      if (GetDescriptor(std::get<1>(ret).GetId()).token_type) {
-        sub_seq_name = GetDescriptor(std::get<1>(ret).GetId()).name;
-      } else {
-        sub_seq_name =
-            GetDescriptor(std::get<1>(ret).GetId()).name + "-" +
-            GetDescriptor(std::get<1>(ret).GetId()).sub_seqs[snd].name;
-      }
+          metrics.TotalRaw(), static_cast<int64_t>(sub_sequence.GetRawSize()));
       std::get<2>(ret).AddInteger(
-          "size-zstd-" + sub_seq_name + "-raw",
+          metrics.Raw({fst, snd}),
           static_cast<int64_t>(sub_sequence.GetRawSize()));
 
-      std::get<1>(ret).Set(snd, compress(std::move(sub_sequence)));
+      const CompressionDictionary* dictionary =
+          snd < dictionaries.size() ? dictionaries[snd].get() : nullptr;
+      std::get<1>(ret).Set(
+          snd, compress(std::move(sub_sequence), level_, dictionary, context));
 
       if (!std::get<1>(ret).Get(snd).IsEmpty()) {
         std::get<2>(ret).AddInteger(
-            "size-zstd-total-comp",
+            metrics.TotalComp(),
             static_cast<int64_t>(std::get<1>(ret).Get(snd).GetRawSize()));
         std::get<2>(ret).AddInteger(
-            "size-zstd-" + sub_seq_name + "-comp",
+            metrics.Comp({fst, snd}),
             static_cast<int64_t>(std::get<1>(ret).Get(snd).GetRawSize()));
       }
     } else {
@@ -123,15 +164,103 @@ core::EntropyEncoder::entropy_coded Encoder::Process(
                                sub_sequence.GetId(), util::DataBlock(0, 1)));
     }
   }
-  StoreParameters(std::get<1>(ret).GetId(), std::get<0>(ret));
-  std::get<2>(ret).AddDouble("time-zstd", watch.Check());
+  StoreParameters(std::get<1>(ret).GetId(), dictionaries, std::get<0>(ret));
+  std::get<2>(ret).AddDouble(metrics.Time(), watch.Check());
   return ret;
 }
 
 // -----------------------------------------------------------------------------
 
-Encoder::Encoder(const bool write_out_streams)
-    : write_out_streams_(write_out_streams) {}
+std::vector<std::shared_ptr<const CompressionDictionary>>
+Encoder::UpdateDictionaries(core::AccessUnit::Descriptor& desc) {
+  auto& state = *dictionary_states_[static_cast<uint8_t>(desc.GetId())];
+  std::lock_guard guard(state.lock);
+  if (state.trained) {
+    return state.dictionaries;
+  }
+
+  const size_t num_subsequences = GetDescriptor(desc.GetId()).sub_seqs.size();
+  state.samples.resize(num_subsequences);
+  state.sample_sizes.resize(num_subsequences);
+  for (auto& sub_sequence : desc) {
+    const auto index = sub_sequence.GetId().second;
+    if (sub_sequence.IsEmpty() || index >= num_subsequences) {
+      continue;
+    }
+    auto& samples = state.samples[index];
+    const auto* data =
+        static_cast<const uint8_t*>(sub_sequence.GetData().GetData());
+    size_t size = std::min(sub_sequence.GetData().GetRawSize(),
+                           kMaxSampledBytes - samples.size());
+    while (size) {
+      const size_t sample_size = std::min(size, kMaxSampleSize);
+      samples.insert(samples.end(), data, data + sample_size);
+      state.sample_sizes[index].push_back(sample_size);
+      data += sample_size;
+      size -= sample_size;
+    }
+  }
+
+  if (++state.access_units < dictionary_access_units_) {
+    return {};
+  }
+  Train(state, num_subsequences);
+  return state.dictionaries;
+}
+
+// -----------------------------------------------------------------------------
+
+void Encoder::Train(DictionaryState& state,
+                    const size_t num_subsequences) const {
+  state.samples.resize(num_subsequences);
+  state.sample_sizes.resize(num_subsequences);
+  state.dictionaries.resize(num_subsequences);
+  for (size_t i = 0; i < num_subsequences; ++i) {
+    const size_t dictionary_size = std::min(
+        kMaxDictionarySize, state.samples[i].size() / kSamplesPerDictionaryByte);
+    if (dictionary_size < kMinDictionarySize) {
+      continue;
+    }
+    if (auto raw = TrainDictionary(state.samples[i], state.sample_sizes[i],
+                                   dictionary_size)) {
+      state.dictionaries[i] =
+          std::make_shared<const CompressionDictionary>(std::move(raw), level_);
+    }
+  }
+  state.trained = true;
+  state.samples = {};
+  state.sample_sizes = {};
+}
+
+// -----------------------------------------------------------------------------
+
+size_t Encoder::GetWarmUp() const { return dictionary_access_units_; }
+
+// -----------------------------------------------------------------------------
+
+void Encoder::FinishWarmUp() {
+  for (size_t i = 0; i < dictionary_states_.size(); ++i) {
+    auto& state = *dictionary_states_[i];
+    std::lock_guard guard(state.lock);
+    if (!state.trained) {
+      Train(state,
+            GetDescriptor(static_cast<core::GenDesc>(i)).sub_seqs.size());
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+Encoder::Encoder(const bool write_out_streams, const int level,
+                 const size_t dictionary_access_units)
+    : core::EntropyEncoder([] { return std::make_unique<Context>(); }),
+      write_out_streams_(write_out_streams),
+      level_(level),
+      dictionary_access_units_(dictionary_access_units) {
+  for (size_t i = 0; i < core::GetDescriptors().size(); ++i) {
+    dictionary_states_.emplace_back(std::make_unique<DictionaryState>());
+  }
+}
 
 // -----------------------------------------------------------------------------
 
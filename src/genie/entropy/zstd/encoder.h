@@ -17,15 +17,23 @@
 
 // -----------------------------------------------------------------------------
 
+#include <memory>
+#include <mutex>  // NOLINT
+#include <vector>
+
 #include "genie/core/access_unit.h"
 #include "genie/core/entropy_encoder.h"
 #include "genie/core/parameter/descriptor_present/decoder_regular.h"
+#include "genie/entropy/zstd/context.h"
 #include "genie/util/stop_watch.h"
 
 // -----------------------------------------------------------------------------
 
 namespace genie::entropy::zstd {
 
+/// Compression level used if none is configured.
+constexpr int kDefaultLevel = 3;
+
 /**
  * @brief Encoder class for the ZSTD compression algorithm.
  * @details This class handles the compression of raw access units into block
@@ -46,12 +54,69 @@ class Encoder final : public core::EntropyEncoder {
    */
   entropy_coded Process(core::AccessUnit::Descriptor& desc) override;
 
+  /**
+   * @brief Access units sampled before the dictionaries are trained.
+   * @return Training length, 0 if dictionaries are disabled.
+   */
+  [[nodiscard]] size_t GetWarmUp() const override;
+
+  /**
+   * @brief Train the dictionaries of all descriptors that have not reached
+   * the training length, on the samples collected so far.
+   */
+  void FinishWarmUp() override;
+
   /**
    * @brief Construct a new Encoder object.
    * @param write_out_streams Flag to enable or disable writing out streams for
    * debugging.
+   * @param level Zstd compression level.
+   * @param dictionary_access_units Number of access units per descriptor to
+   * train dictionaries on before they are used, 0 to disable dictionaries.
+   */
+  explicit Encoder(bool write_out_streams, int level = kDefaultLevel,
+                   size_t dictionary_access_units = 0);
+
+ private:
+  /**
+   * @brief Dictionary training state of one descriptor.
+   * @details The subsequences of the first access units are collected as
+   * samples. Once enough access units were seen, one dictionary per
+   * subsequence is trained and used for all following access units. Samples
+   * are taken in the order the access units reach the encoder. The flow graph
+   * passes them in section order (see GetWarmUp()), so the dictionaries do
+   * not depend on the thread count.
+   */
+  struct DictionaryState {
+    std::mutex lock;            //!< @brief Protects the other members.
+    size_t access_units = 0;    //!< @brief Access units sampled so far.
+    bool trained = false;       //!< @brief Training is finished.
+    std::vector<std::vector<uint8_t>> samples;  //!< @brief Per subsequence.
+    std::vector<std::vector<size_t>> sample_sizes;  //!< @brief Per subsequence.
+    std::vector<std::shared_ptr<const CompressionDictionary>>
+        dictionaries;  //!< @brief Per subsequence, nullptr if untrained.
+  };
+
+  /**
+   * @brief Sample a descriptor and train its dictionaries if enough access
+   * units were seen.
+   * @param desc Descriptor about to be compressed.
+   * @return Dictionaries to use for the subsequences of the descriptor.
    */
-  explicit Encoder(bool write_out_streams);
+  std::vector<std::shared_ptr<const CompressionDictionary>> UpdateDictionaries(
+      core::AccessUnit::Descriptor& desc);
+
+  /**
+   * @brief Train the dictionaries of one descriptor and drop its samples.
+   * @param state Training state, locked by the caller.
+   * @param num_subsequences Number of subsequences of the descriptor.
+   */
+  void Train(DictionaryState& state, size_t num_subsequences) const;
+
+  int level_;                      //!< @brief Zstd compression level.
+  size_t dictionary_access_units_;  //!< @brief Training length, 0: disabled.
+  std::vector<std::unique_ptr<DictionaryState>>
+      dictionary_states_;  //!< @brief Per descriptor.
 };
 
 // -----------------------------------------------------------------------------
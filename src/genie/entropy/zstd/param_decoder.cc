@@ -13,6 +13,7 @@
 
 #include "genie/entropy/zstd/param_decoder.h"
 
+#include <algorithm>
 #include <memory>
 
 namespace genie::entropy::zstd {
@@ -37,9 +38,12 @@ DecoderRegular::DecoderRegular(core::GenDesc desc)
 
 DecoderRegular::DecoderRegular(core::GenDesc, util::BitReader& reader)
     : core::parameter::desc_pres::DecoderRegular(kModeZstd) {
-  const uint8_t num_descriptor_subsequence_configs = reader.Read<uint8_t>() + 1;
+  const auto num_configs = reader.Read<uint8_t>();
+  const bool with_dictionaries = num_configs & kDictionaryFlag;
+  const uint8_t num_descriptor_subsequence_configs =
+      (num_configs & ~kDictionaryFlag) + 1;
   for (size_t i = 0; i < num_descriptor_subsequence_configs; ++i) {
-    descriptor_subsequence_configs_.emplace_back(reader.Read<uint8_t>(6));
+    descriptor_subsequence_configs_.emplace_back(reader, with_dictionaries);
   }
 }
 
@@ -80,9 +84,15 @@ DecoderRegular::create(core::GenDesc desc, util::BitReader& reader) {
 
 void DecoderRegular::Write(util::BitWriter& writer) const {
   Decoder::Write(writer);
-  writer.WriteBits(descriptor_subsequence_configs_.size() - 1, 8);
+  const bool with_dictionaries =
+      std::any_of(descriptor_subsequence_configs_.begin(),
+                  descriptor_subsequence_configs_.end(),
+                  [](const Subsequence& s) { return s.GetDictionary(); });
+  writer.WriteBits((descriptor_subsequence_configs_.size() - 1) |
+                       (with_dictionaries ? kDictionaryFlag : 0),
+                   8);
   for (auto& i : descriptor_subsequence_configs_) {
-    i.write(writer);
+    i.write(writer, with_dictionaries);
   }
 }
 
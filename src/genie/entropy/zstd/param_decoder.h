@@ -30,6 +30,10 @@ namespace genie::entropy::zstd {
 
 constexpr uint8_t kModeZstd = 2;
 
+/// Set in the subsequence count if the subsequence configurations carry
+/// dictionaries. Descriptors have far fewer than 128 subsequences.
+constexpr uint8_t kDictionaryFlag = 0x80;
+
 /**
  * @brief Class representing a ZSTD-specific descriptor parameter configuration
  * for a decoder.
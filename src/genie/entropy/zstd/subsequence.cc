@@ -12,14 +12,35 @@
 
 #include "genie/entropy/zstd/subsequence.h"
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 // -----------------------------------------------------------------------------
 
 namespace genie::entropy::zstd {
 
 // -----------------------------------------------------------------------------
 
-Subsequence::Subsequence(const uint8_t output_symbol_size)
-    : output_symbol_size_(output_symbol_size) {}
+Subsequence::Subsequence(const uint8_t output_symbol_size,
+                         Dictionary dictionary)
+    : output_symbol_size_(output_symbol_size),
+      dictionary_(std::move(dictionary)) {}
+
+// -----------------------------------------------------------------------------
+
+Subsequence::Subsequence(util::BitReader& reader, const bool with_dictionary)
+    : output_symbol_size_(reader.Read<uint8_t>(6)) {
+  if (!with_dictionary || !reader.Read<bool>(1)) {
+    return;
+  }
+  std::vector<uint8_t> dictionary(reader.Read<uint32_t>(32));
+  for (auto& byte : dictionary) {
+    byte = reader.Read<uint8_t>(8);
+  }
+  dictionary_ = std::make_shared<const std::vector<uint8_t>>(
+      std::move(dictionary));
+}
 
 // -----------------------------------------------------------------------------
 
@@ -27,14 +48,37 @@ uint8_t Subsequence::GetOutputSymbolSize() const { return output_symbol_size_; }
 
 // -----------------------------------------------------------------------------
 
-void Subsequence::write(util::BitWriter& writer) const {
+const Subsequence::Dictionary& Subsequence::GetDictionary() const {
+  return dictionary_;
+}
+
+// -----------------------------------------------------------------------------
+
+void Subsequence::write(util::BitWriter& writer,
+                        const bool with_dictionary) const {
   writer.WriteBits(output_symbol_size_, 6);
+  if (!with_dictionary) {
+    return;
+  }
+  writer.WriteBits(dictionary_ != nullptr, 1);
+  if (dictionary_) {
+    writer.WriteBits(dictionary_->size(), 32);
+    for (const auto byte : *dictionary_) {
+      writer.WriteBits(byte, 8);
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
 
 bool Subsequence::operator==(const Subsequence& rhs) const {
-  return output_symbol_size_ == rhs.output_symbol_size_;
+  if (output_symbol_size_ != rhs.output_symbol_size_) {
+    return false;
+  }
+  if (dictionary_ == rhs.dictionary_) {
+    return true;
+  }
+  return dictionary_ && rhs.dictionary_ && *dictionary_ == *rhs.dictionary_;
 }
 
 // -----------------------------------------------------------------------------
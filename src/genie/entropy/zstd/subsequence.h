@@ -19,7 +19,10 @@
 // -----------------------------------------------------------------------------
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
+#include "genie/util/bit_reader.h"
 #include "genie/util/bit_writer.h"
 
 // -----------------------------------------------------------------------------
@@ -35,12 +38,25 @@ namespace genie::entropy::zstd {
  */
 class Subsequence {
  public:
+  /// Raw zstd dictionary shared between the copies of a parameter set.
+  using Dictionary = std::shared_ptr<const std::vector<uint8_t>>;
+
   /**
    * @brief Construct a new Subsequence object with a specified output symbol
    * Size.
    * @param output_symbol_size Size of the output symbols in bytes.
+   * @param dictionary Dictionary the payload was compressed with, if any.
+   */
+  explicit Subsequence(uint8_t output_symbol_size,
+                       Dictionary dictionary = nullptr);
+
+  /**
+   * @brief Deserialize a subsequence configuration.
+   * @param reader BitReader to extract the parameters.
+   * @param with_dictionary True if the configuration carries the dictionary
+   * flag, see write().
    */
-  explicit Subsequence(uint8_t output_symbol_size);
+  Subsequence(util::BitReader& reader, bool with_dictionary);
 
   /**
    * @brief Get the output symbol Size of the subsequence.
@@ -48,12 +64,21 @@ class Subsequence {
    */
   [[nodiscard]] uint8_t GetOutputSymbolSize() const;
 
+  /**
+   * @brief Get the dictionary of the subsequence.
+   * @return The dictionary or nullptr if the payload was compressed without.
+   */
+  [[nodiscard]] const Dictionary& GetDictionary() const;
+
   /**
    * @brief Serialize the subsequence configuration to a BitWriter.
    * @param writer Reference to the BitWriter object to store the serialized
    * data.
+   * @param with_dictionary Append a flag and, if set, the dictionary. Only
+   * written if any subsequence of the descriptor has a dictionary, so that
+   * configurations without dictionaries keep their original layout.
    */
-  void write(util::BitWriter& writer) const;
+  void write(util::BitWriter& writer, bool with_dictionary = false) const;
 
   /**
    * @brief Compare this subsequence configuration with another for equality.
@@ -64,6 +89,7 @@ class Subsequence {
 
  private:
   uint8_t output_symbol_size_;  //!< @brief Size of the output symbols in bytes.
+  Dictionary dictionary_;       //!< @brief Optional zstd dictionary.
 };
 
 // -----------------------------------------------------------------------------
@@ -8,14 +8,24 @@
 #include "genie/format/fasta/reader.h"
 
 #include <algorithm>
+#include <cstring>
+#include <exception>
+#include <filesystem>  // NOLINT
+#include <fstream>
 #include <istream>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
+#include <numeric>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
+#include "genie/util/dynamic_scheduler.h"
+#include "genie/util/mapped_file.h"
 #include "genie/util/runtime_exception.h"
+#include "genie/util/sha256.h"
 #include "genie/util/string_helpers.h"
 
 // -----------------------------------------------------------------------------
@@ -24,6 +34,77 @@ namespace genie::format::fasta {
 
 // -----------------------------------------------------------------------------
 
+namespace {
+
+/**
+ * @brief Finds the next line break.
+ * @param pos Start of the search.
+ * @param end End of the data.
+ * @return Position of the line break or `end` if there is none.
+ */
+const char* FindLineEnd(const char* pos, const char* end) {
+  const auto* ret = static_cast<const char*>(
+      std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+  return ret ? ret : end;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Indexes and hashes one sequence, following the same rules as
+ * FastaReader::index() and FastaReader::hash().
+ * @param file Start of the FASTA file.
+ * @param begin Position of the '>' starting the sequence.
+ * @param end End of the sequence (next header or end of file).
+ * @param seq Index entry output.
+ * @param sha Hash output, not computed if nullptr.
+ */
+void ScanSequence(const char* file, const char* begin, const char* end,
+                  FaiFile::FaiSequence& seq, std::string* sha) {
+  const char* header_end = FindLineEnd(begin, end);
+  const std::string header(begin + 1, header_end);
+  seq.name = header.substr(0, header.find_first_of(' '));
+  UTILS_DIE_IF(header_end == end || header_end + 1 == end,
+               "Missing line in fasta");
+
+  util::Sha256 hash_computer;
+  bool first_line = true;
+  bool last_line = false;
+  seq.offset = static_cast<uint64_t>(header_end + 1 - file);
+  seq.length = 0;
+  seq.line_bases = 0;
+  seq.line_width = 1;
+  for (const char* pos = header_end + 1; pos < end;) {
+    const char* line_end = FindLineEnd(pos, end);
+    const auto size = static_cast<uint64_t>(line_end - pos);
+    if (size != 0) {
+      if (first_line) {
+        seq.offset = static_cast<uint64_t>(pos - file);
+        seq.line_bases = size;
+        seq.line_width = size + 1;
+        first_line = false;
+      } else {
+        UTILS_DIE_IF(last_line, "Invalid fasta line length");
+      }
+      seq.length += size;
+      if (size != seq.line_bases) {
+        last_line = true;
+      }
+      if (sha) {
+        hash_computer.Update(pos, size);
+      }
+    }
+    pos = line_end + 1;
+  }
+  if (sha) {
+    *sha = hash_computer.FinishHex();
+  }
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
 FastaReader::FastaReader(std::istream& fasta_file, std::istream& fai_file,
                          std::istream& sha256_file, std::string path)
     : hash_file_(sha256_file),
@@ -124,6 +205,89 @@ void FastaReader::hash(const FaiFile& fai, std::istream& fasta,
 
 // -----------------------------------------------------------------------------
 
+void FastaReader::IndexAndHash(const std::string& fasta_path,
+                               const std::string& fai_path,
+                               const std::string& sha_path,
+                               const size_t threads) {
+  const bool write_fai = !std::filesystem::exists(fai_path);
+  const bool write_sha = !std::filesystem::exists(sha_path);
+  if (!write_fai && !write_sha) {
+    return;
+  }
+
+  const util::MappedFile fasta(fasta_path);
+  const char* const file = fasta.GetData();
+  const char* const file_end = file + fasta.GetSize();
+
+  // Sequence boundaries are the '>' at the start of a line
+  std::vector<const char*> starts;
+  for (const char* pos = file; pos < file_end;
+       pos = FindLineEnd(pos, file_end) + 1) {
+    if (*pos == '>') {
+      starts.push_back(pos);
+    } else {
+      UTILS_DIE_IF(starts.empty() && *pos != '\n' && *pos != '\r',
+                   "Fasta file does not start with a header");
+    }
+  }
+  UTILS_DIE_IF(starts.empty(), "No sequence in fasta file " + fasta_path);
+  starts.push_back(file_end);
+
+  // Start with the largest sequences so that a long chromosome at the end of
+  // the file does not leave the other threads idle
+  const size_t num_sequences = starts.size() - 1;
+  std::vector<size_t> order(num_sequences);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return starts[a + 1] - starts[a] > starts[b + 1] - starts[b];
+  });
+
+  std::vector<FaiFile::FaiSequence> sequences(num_sequences);
+  std::vector<std::string> hashes(num_sequences);
+  std::exception_ptr error;
+  std::mutex error_lock;
+  util::DynamicScheduler scheduler(std::min(
+      threads ? threads : std::thread::hardware_concurrency(), num_sequences));
+  scheduler.run(num_sequences, [&](const util::DynamicScheduler::SchedulerInfo&
+                                       info) {
+    const size_t index = order[info.task_id];
+    try {
+      ScanSequence(file, starts[index], starts[index + 1], sequences[index],
+                   write_sha ? &hashes[index] : nullptr);
+    } catch (...) {
+      std::lock_guard guard(error_lock);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  });
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  if (write_fai) {
+    FaiFile fai_file;
+    for (const auto& seq : sequences) {
+      fai_file.AddSequence(seq);
+    }
+    std::ofstream fai(fai_path);
+    UTILS_DIE_IF(!fai, "Cannot open file to write: " + fai_path);
+    fai << fai_file;
+  }
+  if (write_sha) {
+    std::vector<std::pair<std::string, std::string>> named_hashes;
+    named_hashes.reserve(num_sequences);
+    for (size_t i = 0; i < num_sequences; ++i) {
+      named_hashes.emplace_back(sequences[i].name, std::move(hashes[i]));
+    }
+    std::ofstream sha(sha_path);
+    UTILS_DIE_IF(!sha, "Cannot open file to write: " + sha_path);
+    Sha256File::Write(sha, named_hashes);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 core::meta::Reference FastaReader::GetMeta() const {
   const std::string basename =
       path_.substr(path_.find_last_of('/') + 1,
@@ -153,6 +153,25 @@ class FastaReader {
    * @param hash Output stream for storing the computed SHA256 hashes.
    */
   static void hash(const FaiFile& fai, std::istream& fasta, std::ostream& hash);
+
+  /**
+   * @brief Creates the missing .fai index and SHA256 hash files of a FASTA
+   * file in a single pass.
+   *
+   * The FASTA file is memory mapped and split at its sequence headers. The
+   * index entry and hash of each sequence are computed in parallel, so
+   * large references with many sequences are prepared in a fraction of the
+   * time the stream based index() and hash() need. Existing files are left
+   * untouched.
+   *
+   * @param fasta_path Path of the FASTA file.
+   * @param fai_path Path of the index file to create if missing.
+   * @param sha_path Path of the hash file to create if missing.
+   * @param threads Number of threads, 0 to use all cores.
+   */
+  static void IndexAndHash(const std::string& fasta_path,
+                           const std::string& fai_path,
+                           const std::string& sha_path, size_t threads = 0);
 };
 
 // -----------------------------------------------------------------------------
@@ -8,10 +8,14 @@
 #include "genie/format/fasta/sha256File.h"
 
 #include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
 #include <string>
 #include <vector>
 
-#include "picosha2/picosha2.h"
+#include "genie/util/runtime_exception.h"
+#include "genie/util/sha256.h"
 
 // -----------------------------------------------------------------------------
 
@@ -68,18 +72,27 @@ std::string Sha256File::hash(std::istream& file, const size_t pos_start,
                              size_t length) {
   file.seekg(static_cast<std::streamoff>(pos_start));
   constexpr size_t chunk_size = 1 * 1024 * 1024;
-  picosha2::hash256_one_by_one hash_computer;
-  hash_computer.init();
+  util::Sha256 hash_computer;
+  std::vector<char> buffer(std::min(chunk_size, length));
   while (length) {
     const size_t this_size = std::min(chunk_size, length);
-    std::string buffer(this_size, 0);
-    file.read(&buffer[0], static_cast<std::streamsize>(this_size));
-    buffer.erase(std::remove(buffer.begin(), buffer.end(), '\n'), buffer.end());
-    hash_computer.process(buffer.begin(), buffer.end());
-    length -= buffer.size();
+    file.read(buffer.data(), static_cast<std::streamsize>(this_size));
+    UTILS_DIE_IF(static_cast<size_t>(file.gcount()) != this_size,
+                 "Unexpected end of fasta file");
+
+    // Hash the runs between line breaks in place
+    const char* pos = buffer.data();
+    const char* const end = pos + this_size;
+    while (pos < end) {
+      const auto* line_end = static_cast<const char*>(
+          std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+      const char* run_end = line_end ? line_end : end;
+      hash_computer.Update(pos, static_cast<size_t>(run_end - pos));
+      length -= static_cast<size_t>(run_end - pos);
+      pos = line_end ? line_end + 1 : end;
+    }
   }
-  hash_computer.finish();
-  return get_hash_hex_string(hash_computer);
+  return hash_computer.FinishHex();
 }
 
 // -----------------------------------------------------------------------------
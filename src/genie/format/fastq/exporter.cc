@@ -7,11 +7,14 @@
 
 #include "genie/format/fastq/exporter.h"
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <utility>
 
-#include "genie/util/ordered_section.h"
+#include "genie/core/stats/stage_timer.h"
 #include "genie/util/stop_watch.h"
+#include "genie/util/zlib/bgzf.h"
 
 // -----------------------------------------------------------------------------
 
@@ -19,24 +22,28 @@ namespace genie::format::fastq {
 
 // -----------------------------------------------------------------------------
 
-Exporter::Exporter(std::ostream& file_1) : file_{&file_1} {}
+Exporter::Exporter(std::ostream& file_1, const bool bgzf)
+    : file_{&file_1},
+      bgzf_(bgzf),
+      output_([this](Output&& output) { Write(std::move(output)); }) {}
 
 // -----------------------------------------------------------------------------
 
-Exporter::Exporter(std::ostream& file_1, std::ostream& file_2)
-    : file_{&file_1, &file_2} {}
+Exporter::Exporter(std::ostream& file_1, std::ostream& file_2, const bool bgzf)
+    : file_{&file_1, &file_2},
+      bgzf_(bgzf),
+      output_([this](Output&& output) { Write(std::move(output)); }) {}
 
 // -----------------------------------------------------------------------------
 
-void Exporter::SkipIn(const util::Section& id) {
-  [[maybe_unused]] util::OrderedSection sec(&lock_, id);
-}
+void Exporter::SkipIn(const util::Section& id) { output_.Skip(id); }
+
+// -----------------------------------------------------------------------------
 
 void Exporter::FlowIn(core::record::Chunk&& records, const util::Section& id) {
   core::record::Chunk data = std::move(records);
-  GetStats().Add(data.GetStats());
+  core::stats::StageTimer timer(core::stats::Stage::kExport);
   const util::Watch watch;
-  [[maybe_unused]] util::OrderedSection section(&lock_, id);
   size_t size_seq = 0;
   size_t size_qualities = 0;
   size_t size_name = 0;
@@ -45,71 +52,145 @@ void Exporter::FlowIn(core::record::Chunk&& records, const util::Section& id) {
   // ideally should be 2 for paired end, but we can handle 1 as well
   constexpr char read_name_suffix[2][3] = {"/1", "/2"};
   // suffix attached when paired end data but only one output fastq file
-  bool second_read_flag = false;  // true when we are handling second read
-
-  for (const auto& i : data.GetData()) {
-    auto file_ptr = file_.data();
-    second_read_flag = false;
-    if (!i.IsRead1First()) {
-      second_read_flag = true;
-      if (num_files == 2) file_ptr = &file_.back();
-    }
-    for (const auto& rec : i.GetSegments()) {
-      // ID
-      size_name += i.GetName().size();
-      constexpr auto id_token = "@";
-      (*file_ptr)->write(id_token, 1);
-      (*file_ptr)->write(i.GetName().c_str(),
-                         static_cast<std::streamsize>(i.GetName().length()));
-      if (i.GetNumberOfTemplateSegments() == 2 && num_files == 1)
-        (*file_ptr)->write(read_name_suffix[second_read_flag], 2);
-      (*file_ptr)->write("\n", 1);
-
-      // Sequence
-      size_seq += rec.GetSequence().size();
-      (*file_ptr)->write(
-          rec.GetSequence().c_str(),
-          static_cast<std::streamsize>(rec.GetSequence().length()));
-      (*file_ptr)->write("\n", 1);
-
-      // Reserved Line
-      constexpr auto reserved_token = "+";
-      (*file_ptr)->write(reserved_token, 1);
-      (*file_ptr)->write("\n", 1);
-
-      // Qualities
-      if (!rec.GetQualities().empty()) {
-        size_qualities += rec.GetQualities().front().size();
-        (*file_ptr)->write(
-            rec.GetQualities().front().c_str(),
-            static_cast<std::streamsize>(rec.GetQualities().front().length()));
-      } else {
-        // Make up default quality values
-        size_qualities += rec.GetSequence().length();
-        std::string qualities(rec.GetSequence().length(), '#');
-        (*file_ptr)->write(qualities.c_str(),
-                           static_cast<std::streamsize>(qualities.length()));
-      }
-      (*file_ptr)->write("\n", 1);
-      second_read_flag = !second_read_flag;
-      if (num_files == 2) {
-        if (i.IsRead1First()) {
-          file_ptr++;
-        } else {
-          file_ptr--;
+  const bool add_suffix = num_files == 1;
+
+  // Calls fun(file index, name, paired, sequence, qualities, second read flag)
+  // for every segment. Chunks decoded into a columnar batch are rendered
+  // from the columns without building record objects.
+  auto for_each_segment = [&](const auto& fun) {
+    auto visit = [&](const std::string_view name, const bool paired,
+                     const bool read_1_first, const size_t num_segments,
+                     const auto& segment) {
+      // true when we are handling second read
+      bool second_read_flag = !read_1_first;
+      size_t file_idx = num_files == 2 && second_read_flag ? 1 : 0;
+      for (size_t s = 0; s < num_segments; ++s) {
+        const auto [sequence, qualities] = segment(s);
+        fun(file_idx, name, paired, sequence, qualities, second_read_flag);
+        second_read_flag = !second_read_flag;
+        if (num_files == 2) {
+          file_idx ^= 1;
         }
       }
+    };
+    if (const auto& batch = data.GetBatch(); !batch.Empty()) {
+      for (size_t r = 0; r < batch.Size(); ++r) {
+        const auto first = batch.GetFirstSegment(r);
+        visit(batch.GetName(r), batch.GetNumberOfTemplateSegments(r) == 2,
+              batch.IsRead1First(r), batch.GetNumSegments(r),
+              [&](const size_t s) {
+                return std::make_pair(batch.GetSequence(first + s),
+                                      batch.GetQualities(first + s));
+              });
+      }
+      return;
+    }
+    for (const auto& i : data.GetData()) {
+      const auto& segments = i.GetSegments();
+      visit(i.GetName(), i.GetNumberOfTemplateSegments() == 2,
+            i.IsRead1First(), segments.size(), [&](const size_t s) {
+              const auto& qualities = segments[s].GetQualities();
+              return std::make_pair(
+                  std::string_view(segments[s].GetSequence()),
+                  qualities.empty() ? std::string_view()
+                                    : std::string_view(qualities.front()));
+            });
+    }
+  };
+
+  // Render the chunk into one contiguous buffer per file
+  std::array<size_t, 2> buffer_size{};
+  for_each_segment([&](const size_t f, const std::string_view name, bool,
+                       const std::string_view sequence, std::string_view,
+                       bool) {
+    buffer_size[f] += name.size() + 3 * sequence.size() + 8;
+  });
+  Output output;
+  auto& buffer = output.buffer;
+  for (size_t f = 0; f < num_files; ++f) {
+    buffer[f].reserve(buffer_size[f]);
+  }
+
+  for_each_segment([&](const size_t f, const std::string_view name,
+                       const bool paired, const std::string_view sequence,
+                       const std::string_view qualities,
+                       const bool second_read_flag) {
+    auto& out = buffer[f];
+
+    // ID
+    size_name += name.size();
+    out += '@';
+    out += name;
+    if (paired && add_suffix) {
+      out.append(read_name_suffix[second_read_flag], 2);
+    }
+    out += '\n';
+
+    // Sequence
+    size_seq += sequence.size();
+    out += sequence;
+
+    // Reserved Line
+    out += "\n+\n";
+
+    // Qualities
+    if (!qualities.empty()) {
+      size_qualities += qualities.size();
+      out += qualities;
+    } else {
+      // Make up default quality values
+      size_qualities += sequence.length();
+      out.append(sequence.length(), '#');
+    }
+    out += '\n';
+  });
+
+  if (bgzf_) {
+    for (size_t f = 0; f < num_files; ++f) {
+      std::string compressed;
+      util::zlib::CompressBgzf(buffer[f], compressed);
+      buffer[f] = std::move(compressed);
     }
   }
 
-  GetStats().AddInteger("size-fastq-sequence", static_cast<int64_t>(size_seq));
-  GetStats().AddInteger("size-fastq-name", static_cast<int64_t>(size_name));
-  GetStats().AddInteger("size-fastq-quality",
-                        static_cast<int64_t>(size_qualities));
-  GetStats().AddInteger(
+  output.stats = std::move(data.GetStats());
+  output.stats.AddInteger("size-fastq-sequence",
+                          static_cast<int64_t>(size_seq));
+  output.stats.AddInteger("size-fastq-name", static_cast<int64_t>(size_name));
+  output.stats.AddInteger("size-fastq-quality",
+                          static_cast<int64_t>(size_qualities));
+  output.stats.AddInteger(
       "size-fastq-total",
       static_cast<int64_t>(size_qualities + size_name + size_seq));
-  GetStats().AddDouble("time-fastq-export", watch.Check());
+  output.stats.AddDouble("time-fastq-export", watch.Check());
+  timer.Stop();
+
+  output_.Push(std::move(output), id);
+}
+
+// -----------------------------------------------------------------------------
+
+void Exporter::Write(Output&& output) {
+  core::stats::StageTimer timer(core::stats::Stage::kExport);
+  for (size_t f = 0; f < file_.size(); ++f) {
+    file_[f]->write(output.buffer[f].data(),
+                    static_cast<std::streamsize>(output.buffer[f].size()));
+  }
+  GetStats().Add(output.stats);
+}
+
+// -----------------------------------------------------------------------------
+
+void Exporter::FlushIn(uint64_t& pos) {
+  output_.Flush();
+  for (auto* file : file_) {
+    if (bgzf_) {
+      const auto eof = util::zlib::BgzfEofBlock();
+      file->write(eof.data(), static_cast<std::streamsize>(eof.size()));
+    }
+    file->flush();
+  }
+  FormatExporter::FlushIn(pos);
 }
 
 // -----------------------------------------------------------------------------
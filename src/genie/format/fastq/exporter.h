@@ -17,12 +17,15 @@
 
 // -----------------------------------------------------------------------------
 
+#include <array>
+#include <string>
 #include <vector>
 
 #include "genie/core/format_exporter.h"
 #include "genie/core/record/chunk.h"
+#include "genie/core/stats/perf_stats.h"
 #include "genie/util/drain.h"
-#include "genie/util/ordered_lock.h"
+#include "genie/util/reorder_buffer.h"
 
 // -----------------------------------------------------------------------------
 
@@ -38,10 +41,27 @@ namespace genie::format::fastq {
  * operating in a multithreaded environment.
  */
 class Exporter final : public core::FormatExporter {
+  /**
+   * @brief A formatted chunk, waiting to be written.
+   */
+  struct Output {
+    std::array<std::string, 2> buffer;  //!< @brief Data per output file.
+    core::stats::PerfStats stats;       //!< @brief Statistics of the chunk.
+  };
+
   std::vector<std::ostream*> file_;  //!< @brief Vector of output files (Size 1
                                      //!< for single-end, 2 for paired-end).
-  util::OrderedLock lock_;  //!< @brief Lock to ensure ordered execution in a
-                            //!< multithreaded setup.
+  bool bgzf_;  //!< @brief Compress the output into BGZF blocks.
+
+  /// @brief Writes formatted chunks in order on a dedicated thread. Declared
+  /// last, so it is stopped before the output files are released.
+  util::ReorderBuffer<Output> output_;
+
+  /**
+   * @brief Writes one formatted chunk, called in order by `output_`.
+   * @param output The formatted chunk.
+   */
+  void Write(Output&& output);
 
  public:
   /**
@@ -52,8 +72,9 @@ class Exporter final : public core::FormatExporter {
    * sequentially to the specified output stream.
    *
    * @param file_1 Output stream for unpaired reads.
+   * @param bgzf If true, the output is written BGZF (gzip) compressed.
    */
-  explicit Exporter(std::ostream& file_1);
+  explicit Exporter(std::ostream& file_1, bool bgzf = false);
 
   /**
    * @brief Constructor for paired FASTQ export.
@@ -66,8 +87,9 @@ class Exporter final : public core::FormatExporter {
    * (typically named `R1`).
    * @param file_2 Output stream for the second read in a paired-end read
    * (typically named `R2`).
+   * @param bgzf If true, the output is written BGZF (gzip) compressed.
    */
-  Exporter(std::ostream& file_1, std::ostream& file_2);
+  Exporter(std::ostream& file_1, std::ostream& file_2, bool bgzf = false);
 
   /**
    * @brief Skip a specific section during FASTQ export.
@@ -88,13 +110,26 @@ class Exporter final : public core::FormatExporter {
    * into the FASTQ format and writes them to the appropriate output file(s).
    * For paired-end reads, it writes each read pair to its respective output
    * file. The `flowIn` function is invoked by the framework's multithreaded
-   * processing pipeline.
+   * processing pipeline. Records are formatted (and compressed) into a
+   * private buffer by the calling thread, which is then handed over to a
+   * writer thread that writes the buffers in order. The calling thread does
+   * not wait for earlier chunks.
    *
    * @param records Input records in MPEG-G format.
    * @param id Block identifier to ensure ordered output in multithreaded
    * contexts.
    */
   void FlowIn(core::record::Chunk&& records, const util::Section& id) override;
+
+  /**
+   * @brief Finish the output files.
+   *
+   * Waits until all chunks have been written, then writes the BGZF end of
+   * file marker if compression is enabled and flushes the output streams.
+   *
+   * @param pos Current section position (unused).
+   */
+  void FlushIn(uint64_t& pos) override;
 };
 
 // -----------------------------------------------------------------------------
@@ -7,11 +7,15 @@
 
 #include "genie/format/fastq/importer.h"
 
+#include <memory>
+#include <mutex>  // NOLINT
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include "genie/core/record/class_type.h"
+#include "genie/core/stats/stage_timer.h"
 #include "genie/util/log.h"
 #include "genie/util/stop_watch.h"
 
@@ -24,29 +28,32 @@ namespace genie::format::fastq {
 // -----------------------------------------------------------------------------
 
 Importer::Importer(const size_t block_size, std::istream& file_1)
-    : block_size_(block_size), file_list_{&file_1} {
- /* const auto pos = this->file_list_.front()->tellg();
-  file_list_.front()->seekg(0, std::ios::end);
-  this->last_pos_ = this->file_list_.front()->tellg();
-  this->file_list_.front()->seekg(pos); */
-}
+    : Importer(block_size, {{&file_1}}) {}
 
 // -----------------------------------------------------------------------------
 
 Importer::Importer(const size_t block_size, std::istream& file_1,
                    std::istream& file_2)
-    : block_size_(block_size), file_list_{&file_1, &file_2} {
- /* const auto pos = this->file_list_.front()->tellg();
-  file_list_.front()->seekg(0, std::ios::end);
-  this->last_pos_ = this->file_list_.front()->tellg();
-  this->file_list_.front()->seekg(pos);*/
+    : Importer(block_size, {{&file_1, &file_2}}) {}
+
+// -----------------------------------------------------------------------------
+
+Importer::Importer(const size_t block_size,
+                   const std::vector<std::vector<std::istream*>>& lanes)
+    : block_size_(block_size) {
+  UTILS_DIE_IF(lanes.empty(), "No fastq input");
+  for (const auto& files : lanes) {
+    UTILS_DIE_IF(files.size() != lanes.front().size(),
+                 "All fastq lanes must be either single-end or paired");
+    lanes_.emplace_back(std::make_unique<Lane>());
+    lanes_.back()->file_list = files;
+  }
 }
 
 // -----------------------------------------------------------------------------
 
-bool Importer::PumpRetrieve(core::Classifier* classifier) {
+bool Importer::ReadBlock(Lane& lane, core::record::Chunk& chunk) const {
   util::Watch watch;
-  core::record::Chunk chunk;
   size_t size_seq = 0;
   size_t size_quality = 0;
   size_t size_name = 0;
@@ -54,26 +61,23 @@ bool Importer::PumpRetrieve(core::Classifier* classifier) {
   size_t size_comments = 0;
   bool eof = false;
   {
+    // Reads go straight into the columns of the chunk's batch, the line
+    // buffers are reused for all records
+    auto& batch = chunk.GetBatch();
     for (size_t cur_record = 0; cur_record < block_size_; ++cur_record) {
-      auto data = ReadData(file_list_);
-      if (data.empty()) {
+      if (!ReadData(lane.file_list, lane.lines)) {
         eof = true;
         break;
       }
-      for (const auto& file : data) {
+      for (const auto& file : lane.lines) {
         size_comments += file[RESERVED].size();
         size_file_struct += kLinesPerRecord;  // Newlines
         size_file_struct += 1;                // Comment @ char
+        size_seq += file[SEQUENCE].size();
+        size_quality += file[QUALITY].size();
       }
-      auto record = BuildRecord(data);
-      for (const auto& seg : record.GetSegments()) {
-        size_seq += seg.GetSequence().size();
-        for (const auto& q : seg.GetQualities()) {
-          size_quality += q.size();
-        }
-      }
-      size_name += record.GetName().size() * this->file_list_.size();
-      chunk.GetData().push_back(std::move(record));
+      size_name += (lane.lines[FIRST][ID].size() - 1) * lane.file_list.size();
+      AddRecord(lane.lines, batch);
     }
   }
 
@@ -81,18 +85,6 @@ bool Importer::PumpRetrieve(core::Classifier* classifier) {
                               static_cast<int64_t>(size_comments));
   chunk.GetStats().AddInteger("size-fastq-filestruct",
                               static_cast<int64_t>(size_file_struct));
-
-  /*float progress =
-      static_cast<float>(file_list_.front()->tellg()) / static_cast<float>
-      (last_pos_);
-
-  while (progress - last_progress_ > 0.05) {  // NOLINT
-    last_progress_ += 0.05;
-    UTILS_LOG(util::Logger::Severity::INFO,
-              "Progress reading files: " +
-                  std::to_string(static_cast<int>(last_progress_ * 100)) + "%");
-  }*/
-
   chunk.GetStats().AddInteger("size-fastq-sequence",
                               static_cast<int64_t>(size_seq));
   chunk.GetStats().AddInteger("size-fastq-quality",
@@ -104,33 +96,119 @@ bool Importer::PumpRetrieve(core::Classifier* classifier) {
       static_cast<int64_t>(size_name + size_quality + size_seq +
                            size_file_struct + size_comments));
   chunk.GetStats().AddDouble("time-fastq-import", watch.Check());
-  classifier->Add(std::move(chunk));
   return !eof;
 }
 
 // -----------------------------------------------------------------------------
 
-core::record::Record Importer::BuildRecord(
-    std::vector<std::array<std::string, kLinesPerRecord>> data) {
-  auto ret = core::record::Record(static_cast<uint8_t>(data.size()),
-                                  core::record::ClassType::kClassU,
-                                  data[FIRST][ID].substr(1), "", 0);
+void Importer::ReadAhead(Lane& lane) {
+  core::record::Chunk chunk;
+  const bool data_left = ReadBlock(lane, chunk);
+  std::lock_guard guard(ready_mutex_);
+  if (!chunk.Empty()) {
+    lane.ready = std::move(chunk);
+  }
+  lane.done = !data_left;
+}
+
+// -----------------------------------------------------------------------------
+
+void Importer::PrepareRetrieve() {
+  Lane* lane = nullptr;
+  std::unique_lock<std::mutex> lane_guard;
+  {
+    std::lock_guard guard(ready_mutex_);
+    // One block per lane in flight is enough to keep the classifier busy
+    for (size_t i = 0; i < lanes_.size(); ++i) {
+      auto& candidate = *lanes_[(next_lane_ + i) % lanes_.size()];
+      if (candidate.done || candidate.ready) {
+        continue;
+      }
+      if (std::unique_lock try_guard(candidate.mutex, std::try_to_lock);
+          try_guard.owns_lock()) {
+        lane = &candidate;
+        lane_guard = std::move(try_guard);
+        break;
+      }
+    }
+  }
+  if (lane) {
+    ReadAhead(*lane);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+bool Importer::PumpRetrieve(core::Classifier* classifier) {
+  core::record::Chunk chunk;
+  {
+    std::unique_lock guard(ready_mutex_);
+    while (true) {
+      // Lanes are marked done together with handing over their last block
+      size_t skipped = 0;
+      while (lanes_[next_lane_]->done && !lanes_[next_lane_]->ready) {
+        if (++skipped == lanes_.size()) {
+          return false;
+        }
+        next_lane_ = (next_lane_ + 1) % lanes_.size();
+      }
+      auto& lane = *lanes_[next_lane_];
+      if (lane.ready) {
+        chunk = std::move(*lane.ready);
+        lane.ready.reset();
+        next_lane_ = (next_lane_ + 1) % lanes_.size();
+        break;
+      }
+
+      // The block is not ready yet. The lane mutex must not be awaited while
+      // holding ready_mutex_, the reading thread takes ready_mutex_ to hand
+      // over its block.
+      guard.unlock();
+      {
+        std::lock_guard lane_guard(lane.mutex);
+        bool read = false;
+        {
+          std::lock_guard check(ready_mutex_);
+          read = !lane.done && !lane.ready;
+        }
+        if (read) {
+          ReadAhead(lane);
+        }
+      }
+      guard.lock();
+    }
+  }
+  {
+    core::stats::StageTimer classify(core::stats::Stage::kClassify);
+    classifier->Add(std::move(chunk));
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void Importer::AddRecord(
+    const std::vector<std::array<std::string, kLinesPerRecord>>& data,
+    core::record::RecordBatch& batch) {
+  batch.AddRecord(std::string_view(data[FIRST][ID]).substr(1), "",
+                  static_cast<uint8_t>(data.size()),
+                  core::record::ClassType::kClassU, 0, true);
 
-  for (auto& cur_rec : data) {
-    auto seg = core::record::Segment(std::move(cur_rec[SEQUENCE]));
+  for (const auto& cur_rec : data) {
+    const auto& seq = cur_rec[SEQUENCE];
+    seq.copy(batch.AddSegment(seq.size()), seq.size());
     if (!cur_rec[QUALITY].empty()) {
-      seg.AddQualities(std::move(cur_rec[QUALITY]));
+      batch.AddQualities(batch.GetNumSegments() - 1, cur_rec[QUALITY]);
     }
-    ret.AddSegment(std::move(seg));
   }
-  return ret;
 }
 
 // -----------------------------------------------------------------------------
 
-std::vector<std::array<std::string, kLinesPerRecord>> Importer::ReadData(
-    const std::vector<std::istream*>& file_list) {
-  std::vector<std::array<std::string, kLinesPerRecord>> data(file_list.size());
+bool Importer::ReadData(
+    const std::vector<std::istream*>& file_list,
+    std::vector<std::array<std::string, kLinesPerRecord>>& data) {
+  data.resize(file_list.size());
   for (size_t cur_file = 0; cur_file < file_list.size(); ++cur_file) {
     for (size_t cur_line = 0; cur_line < kLinesPerRecord; ++cur_line) {
       if (!std::getline(*file_list[cur_file], data[cur_file][cur_line])) {
@@ -138,14 +216,13 @@ std::vector<std::array<std::string, kLinesPerRecord>> Importer::ReadData(
           UTILS_LOG(util::Logger::Severity::WARNING,
                     "Unexpected end of file in fastq");
         }
-        data.clear();
-        return data;
+        return false;
       }
     }
 
     SanityCheck(data[cur_file]);
   }
-  return data;
+  return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -11,7 +11,8 @@
  * The `Importer` class reads FASTQ-formatted files, either as single-end or
  * paired-end read files, and converts the reads into MPEG-G format. It handles
  * typical FASTQ file structures with 4 lines per record and performs basic
- * sanity checks on the data before conversion.
+ * sanity checks on the data before conversion. Several lanes of one sample
+ * can be imported at once, each lane is read and parsed on its own thread.
  */
 
 #ifndef SRC_GENIE_FORMAT_FASTQ_IMPORTER_H_
@@ -20,11 +21,14 @@
 // -----------------------------------------------------------------------------
 
 #include <array>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "genie/core/format_importer.h"
-#include "genie/core/record/record.h"
+#include "genie/core/record/record_batch.h"
 #include "genie/util/ordered_lock.h"
 
 // -----------------------------------------------------------------------------
@@ -40,16 +44,36 @@ static constexpr size_t kLinesPerRecord = 4;
  * ensure that the FASTQ records are valid.
  */
 class Importer final : public core::FormatImporter {
+  /**
+   * @brief One input lane, a single file or a pair of files. Only the thread
+   * holding the mutex reads from it.
+   */
+  struct Lane {
+    std::vector<std::istream*> file_list;  //!< @brief Input streams.
+    /// Line buffers of the record being read, reused to avoid allocations
+    std::vector<std::array<std::string, kLinesPerRecord>> lines;
+    std::mutex mutex;  //!< @brief Held while a block is parsed.
+    /// Parsed block waiting for the classifier, guarded by ready_mutex_
+    std::optional<core::record::Chunk> ready;
+    bool done = false;  //!< @brief End of input, guarded by ready_mutex_.
+  };
+
   //!< @brief Defines how many lines in a FASTQ file make up one record.
   size_t
       block_size_;  //!< @brief Number of records to read in one `pump()` run.
-  std::vector<std::istream*>
-      file_list_;           //!< @brief Input streams, supports paired files.
+  std::vector<std::unique_ptr<Lane>> lanes_;  //!< @brief Input lanes.
   util::OrderedLock lock_;  //!< @brief Lock to ensure ordered processing in
                             //!< multithreaded contexts.
   float last_progress_ = 0.0f;  //!< @brief Last progress value for logging.
   uint64_t last_pos_ = 0;       //!< @brief Last file position for progress.
 
+  /// Guards next_lane_ and the ready blocks and end flags of the lanes.
+  std::mutex ready_mutex_;
+  /// Lane whose block goes to the classifier next. Blocks are handed out
+  /// round robin, the n-th block of every lane before the n+1-th of any, so
+  /// the record order does not depend on thread timing.
+  size_t next_lane_ = 0;
+
   /**
    * @brief Enumerations for the different lines in a FASTQ record.
    */
@@ -75,10 +99,13 @@ class Importer final : public core::FormatImporter {
    *
    * @param file_list Input file streams for the FASTQ files (2 streams for
    * paired-end mode).
-   * @return A vector of arrays representing the FASTQ records.
+   * @param data Receives one array of lines per file. Existing strings are
+   * overwritten, keeping their capacity.
+   * @return False at the end of the input.
    */
-  static std::vector<std::array<std::string, kLinesPerRecord>> ReadData(
-      const std::vector<std::istream*>& file_list);
+  static bool ReadData(
+      const std::vector<std::istream*>& file_list,
+      std::vector<std::array<std::string, kLinesPerRecord>>& data);
 
   /**
    * @brief Validates the structure of a FASTQ record.
@@ -94,17 +121,43 @@ class Importer final : public core::FormatImporter {
   static void SanityCheck(const std::array<std::string, kLinesPerRecord>& data);
 
   /**
-   * @brief Converts the raw FASTQ data into MPEG-G formatted records.
+   * @brief Converts the raw FASTQ data into an MPEG-G record.
    *
-   * This function takes the raw FASTQ data (as read from the input files),
-   * processes it, and converts it into MPEG-G formatted records, which can be
-   * used for downstream MPEG-G processing and storage.
+   * This function takes the raw FASTQ data (as read from the input files) and
+   * appends it as one record to a columnar batch. No per-record memory is
+   * allocated.
    *
    * @param data Raw FASTQ data read from the input streams.
-   * @return A fully constructed MPEG-G `Record`.
+   * @param batch Batch receiving the record.
    */
-  static core::record::Record BuildRecord(
-      std::vector<std::array<std::string, kLinesPerRecord>> data);
+  static void AddRecord(
+      const std::vector<std::array<std::string, kLinesPerRecord>>& data,
+      core::record::RecordBatch& batch);
+
+  /**
+   * @brief Reads up to one block of records from a lane into a chunk and
+   * records the FASTQ size statistics. The caller must hold the lane mutex.
+   *
+   * @param lane Lane to read from.
+   * @param chunk Chunk receiving the records.
+   * @return False at the end of the lane.
+   */
+  bool ReadBlock(Lane& lane, core::record::Chunk& chunk) const;
+
+  /**
+   * @brief Reads the next block of a lane and stores it as the ready block.
+   * The caller must hold the lane mutex, but not ready_mutex_.
+   *
+   * @param lane Lane to read from, with no ready block.
+   */
+  void ReadAhead(Lane& lane);
+
+  /**
+   * @brief Parses the next block of a lane that has none ready and no other
+   * thread is reading, starting with the lane due next. Returns right away
+   * if there is no such lane.
+   */
+  void PrepareRetrieve() override;
 
  public:
   /**
@@ -132,18 +185,32 @@ class Importer final : public core::FormatImporter {
   Importer(size_t block_size, std::istream& file_1, std::istream& file_2);
 
   /**
-   * @brief Reads and processes a chunk of FASTQ data, converting it to MPEG-G
-   * records.
+   * @brief Constructor for multi-lane FASTQ import.
+   *
+   * Initializes the importer for several lanes of one sample. All lanes are
+   * read in parallel and end up in the same output, every lane is either a
+   * single-end file or a pair of files. The output interleaves the blocks of
+   * the lanes round robin, so it is the same for every run.
+   *
+   * @param block_size Number of records to read per `pump()` call.
+   * @param lanes Input streams of each lane, all with the same number of
+   * files.
+   */
+  Importer(size_t block_size,
+           const std::vector<std::vector<std::istream*>>& lanes);
+
+  /**
+   * @brief Passes one block of FASTQ data, converted to MPEG-G records, to the
+   * classifier.
    *
-   * This method reads a chunk of data from the input streams and converts it to
-   * MPEG-G format. It ensures that the output data is compatible with the
-   * MPEG-G format and structure, and passes the resulting records to the
-   * appropriate downstream classifiers.
+   * Blocks are handed out round robin over the lanes. If the block of the
+   * lane due next is not ready yet, the call waits for the thread parsing it
+   * or parses it itself.
    *
    * @param classifier The classifier responsible for receiving the converted
    * MPEG-G records.
-   * @return True if records were successfully processed and output, false
-   * otherwise.
+   * @return False once all lanes are exhausted and all blocks were handed
+   * out.
    */
   bool PumpRetrieve(core::Classifier* classifier) override;
 };
@@ -11,6 +11,7 @@
 #include <string>
 #include <utility>
 
+#include "genie/core/stats/stage_timer.h"
 #include "genie/format/mgb/raw_reference.h"
 #include "genie/util/log.h"
 #include "genie/util/stop_watch.h"
@@ -24,14 +25,22 @@ namespace genie::format::mgb {
 
 // -----------------------------------------------------------------------------
 
-Exporter::Exporter(std::ostream* file) : writer(*file), id_ctr(0) {}
+Exporter::Exporter(std::ostream* file)
+    : writer(*file),
+      id_ctr(0),
+      output_([this](core::AccessUnit&& data) { Write(std::move(data)); }) {}
 
 // -----------------------------------------------------------------------------
 
 void Exporter::FlowIn(core::AccessUnit&& t, const util::Section& id) {
+  output_.Push(std::move(t), id);
+}
+
+// -----------------------------------------------------------------------------
+
+void Exporter::Write(core::AccessUnit&& data) {
+  core::stats::StageTimer timer(core::stats::Stage::kExport);
   util::Watch watch;
-  core::AccessUnit data = std::move(t);
-  [[maybe_unused]] util::OrderedSection section(&lock, id);
   GetStats().Add(data.GetStats());
   auto parameter_id = static_cast<uint8_t>(parameter_stash.size());
   core::parameter::ParameterSet out_set(parameter_id, parameter_id,
@@ -110,14 +119,20 @@ void Exporter::FlowIn(core::AccessUnit&& t, const util::Section& id) {
       parameter_stash[au.GetHeader().GetParameterId()].GetEncodingSet()));
 
   au.Write(writer);
+  AddAccessUnitMeta(id_ctr, data);
   id_ctr++;
   GetStats().AddDouble("time-mgb-export", watch.Check());
 }
 
 // -----------------------------------------------------------------------------
 
-void Exporter::SkipIn(const util::Section& id) {
-  [[maybe_unused]] util::OrderedSection sec(&lock, id);
+void Exporter::SkipIn(const util::Section& id) { output_.Skip(id); }
+
+// -----------------------------------------------------------------------------
+
+void Exporter::FlushIn(uint64_t& pos) {
+  output_.Flush();
+  FormatExporterCompressed::FlushIn(pos);
 }
 
 // -----------------------------------------------------------------------------
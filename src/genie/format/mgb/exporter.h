@@ -19,8 +19,7 @@
 #include "genie/core/stats/perf_stats.h"
 #include "genie/format/mgb/access_unit.h"
 #include "genie/util/drain.h"
-#include "genie/util/ordered_lock.h"
-#include "genie/util/ordered_section.h"
+#include "genie/util/reorder_buffer.h"
 
 // -----------------------------------------------------------------------------
 
@@ -32,10 +31,19 @@ namespace genie::format::mgb {
 class Exporter : public core::FormatExporterCompressed {
  private:
   util::BitWriter writer;                                      //!< @brief
-  util::OrderedLock lock;                                      //!< @brief
   size_t id_ctr;                                               //!< @brief
   std::vector<core::parameter::ParameterSet> parameter_stash;  //!< @brief
 
+  /// @brief Writes access units in order on a dedicated thread. Declared
+  /// last, so it is stopped before the output state is destroyed.
+  util::ReorderBuffer<core::AccessUnit> output_;
+
+  /**
+   * @brief Writes one access unit, called in order by `output_`.
+   * @param data Access unit.
+   */
+  void Write(core::AccessUnit&& data);
+
  public:
   /**
    * @brief
@@ -44,7 +52,8 @@ class Exporter : public core::FormatExporterCompressed {
   explicit Exporter(std::ostream* file);
 
   /**
-   * @brief
+   * @brief Hands an access unit over to the writer thread. Only blocks if
+   * too many access units are waiting for an earlier one.
    * @param t
    * @param id
    */
@@ -55,6 +64,12 @@ class Exporter : public core::FormatExporterCompressed {
    * @param id
    */
   void SkipIn(const genie::util::Section& id) override;
+
+  /**
+   * @brief Waits until all access units have been written.
+   * @param pos
+   */
+  void FlushIn(uint64_t& pos) override;
 };
 
 // -----------------------------------------------------------------------------
@@ -10,8 +10,10 @@
 #include <string>
 #include <utility>
 
+#include "genie/core/stats/stage_timer.h"
 #include "genie/format/mgb/access_unit.h"
 #include "genie/util/log.h"
+#include "genie/util/trace.h"
 
 // -----------------------------------------------------------------------------
 
@@ -40,10 +42,16 @@ Importer::Importer(std::istream& file, core::ReferenceManager* manager,
 
 bool Importer::Pump(uint64_t& id, std::mutex&) {
   // util::Watch watch; TODO(fabian): Statistics
+  core::stats::StageTimer timer(core::stats::Stage::kImport);
   std::optional<AccessUnit> unit;
   util::Section sec{};
   {
-    std::unique_lock lock_guard(lock_);
+    std::unique_lock lock_guard(lock_, std::defer_lock);
+    {
+      util::TraceScope wait("importer-lock", "wait", util::TraceScope::kNone);
+      lock_guard.lock();
+    }
+    util::TraceScope trace("pump", "import", util::TraceScope::kNone);
     unit = factory_.read(reader_);
     if (!unit) {
       return false;
@@ -63,7 +71,11 @@ bool Importer::Pump(uint64_t& id, std::mutex&) {
                     "% of file read");
     }
   }
-  FlowOut(ConvertAu(std::move(unit.value())), sec);
+  util::TraceScope trace("convert", "import", static_cast<int64_t>(sec.start));
+  auto converted = ConvertAu(std::move(unit.value()));
+  trace.Stop();
+  timer.Stop();
+  FlowOut(std::move(converted), sec);
   return true;
 }
 
@@ -24,7 +24,8 @@ bool AccessUnit::operator==(const GenInfo& info) const {
   }
   const auto& other = dynamic_cast<const AccessUnit&>(info);
   return header_ == other.header_ && au_information_ == other.au_information_ &&
-         au_protection_ == other.au_protection_ && blocks_ == other.blocks_;
+         au_protection_ == other.au_protection_ &&
+         au_statistics_ == other.au_statistics_ && blocks_ == other.blocks_;
 }
 
 // -----------------------------------------------------------------------------
@@ -54,10 +55,17 @@ AccessUnit::AccessUnit(
       UTILS_DIE_IF(au_information_ != std::nullopt, "AU-Inf already present");
       UTILS_DIE_IF(au_protection_ != std::nullopt,
                    "AU-Inf must be before AU-PR");
+      UTILS_DIE_IF(au_statistics_ != std::nullopt,
+                   "AU-Inf must be before AU-ST");
       au_information_ = AuInformation(reader, version_);
     } else if (tmp_str == "aupr") {
       UTILS_DIE_IF(au_protection_ != std::nullopt, "AU-Pr already present");
+      UTILS_DIE_IF(au_statistics_ != std::nullopt,
+                   "AU-Pr must be before AU-ST");
       au_protection_ = AuProtection(reader, version_);
+    } else if (tmp_str == "aust") {
+      UTILS_DIE_IF(au_statistics_ != std::nullopt, "AU-St already present");
+      au_statistics_ = AuStatistics(reader);
     } else {
       reader.SetStreamPosition(tmp_pos);
       break;
@@ -122,6 +130,22 @@ void AccessUnit::SetProtection(AuProtection au) {
 
 // -----------------------------------------------------------------------------
 
+bool AccessUnit::HasStatistics() const {
+  return au_statistics_ != std::nullopt;
+}
+
+// -----------------------------------------------------------------------------
+
+AuStatistics& AccessUnit::GetStatistics() { return *au_statistics_; }
+
+// -----------------------------------------------------------------------------
+
+void AccessUnit::SetStatistics(AuStatistics au) {
+  au_statistics_ = std::move(au);
+}
+
+// -----------------------------------------------------------------------------
+
 void AccessUnit::BoxWrite(util::BitWriter& bit_writer) const {
   header_.Write(bit_writer);
   if (au_information_ != std::nullopt) {
@@ -130,6 +154,9 @@ void AccessUnit::BoxWrite(util::BitWriter& bit_writer) const {
   if (au_protection_ != std::nullopt) {
     au_protection_->Write(bit_writer);
   }
+  if (au_statistics_ != std::nullopt) {
+    au_statistics_->Write(bit_writer);
+  }
   for (const auto& b : blocks_) {
     b.Write(bit_writer);
   }
@@ -27,6 +27,7 @@
 #include "genie/format/mgg/access_unit_header.h"
 #include "genie/format/mgg/au_information.h"
 #include "genie/format/mgg/au_protection.h"
+#include "genie/format/mgg/au_statistics.h"
 #include "genie/format/mgg/block.h"
 #include "genie/format/mgg/gen_info.h"
 #include "genie/util/bit_reader.h"
@@ -48,6 +49,8 @@ class AccessUnit final : public GenInfo {
       au_information_;  //!< @brief Optional AU information data.
   std::optional<AuProtection>
       au_protection_;  //!< @brief Optional AU protection data.
+  std::optional<AuStatistics>
+      au_statistics_;  //!< @brief Optional record statistics, private box.
   std::vector<Block>
       blocks_;  //!< @brief List of blocks associated with this access unit.
 
@@ -177,6 +180,24 @@ class AccessUnit final : public GenInfo {
    */
   void SetProtection(AuProtection au);
 
+  /**
+   * @brief Checks if record statistics are available.
+   * @return True if record statistics are available, otherwise false.
+   */
+  [[nodiscard]] bool HasStatistics() const;
+
+  /**
+   * @brief Retrieves a mutable reference to the record statistics.
+   * @return The mutable record statistics.
+   */
+  AuStatistics& GetStatistics();
+
+  /**
+   * @brief Sets the record statistics for the access unit.
+   * @param au The AuStatistics object to set.
+   */
+  void SetStatistics(AuStatistics au);
+
   /**
    * @brief Writes the access unit data to a BitWriter stream.
    * @param bit_writer The BitWriter object to write the serialized data to.
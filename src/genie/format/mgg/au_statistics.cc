@@ -0,0 +1,77 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/format/mgg/au_statistics.h"
+
+#include <string>
+#include <utility>
+
+#include "genie/util/runtime_exception.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::format::mgg {
+
+// -----------------------------------------------------------------------------
+
+const std::string& AuStatistics::GetKey() const {
+  static const std::string key = "aust";
+  return key;
+}
+
+// -----------------------------------------------------------------------------
+
+AuStatistics::AuStatistics(util::BitReader& bitreader) {
+  const auto start_pos = bitreader.GetStreamPosition() - 4;
+  const auto length = bitreader.ReadAlignedInt<uint64_t>();
+  std::string json(length - GetHeaderLength(), '\0');
+  bitreader.ReadAlignedBytes(json.data(), json.length());
+  statistics_ = core::stats::AuStatistics(nlohmann::json::parse(json));
+  UTILS_DIE_IF(start_pos + length != bitreader.GetStreamPosition(),
+               "Invalid length");
+}
+
+// -----------------------------------------------------------------------------
+
+AuStatistics::AuStatistics(core::stats::AuStatistics statistics)
+    : statistics_(std::move(statistics)) {}
+
+// -----------------------------------------------------------------------------
+
+void AuStatistics::BoxWrite(util::BitWriter& bit_writer) const {
+  const auto json = statistics_.ToJson().dump();
+  bit_writer.WriteAlignedBytes(json.data(), json.length());
+}
+
+// -----------------------------------------------------------------------------
+
+const core::stats::AuStatistics& AuStatistics::GetStatistics() const {
+  return statistics_;
+}
+
+// -----------------------------------------------------------------------------
+
+bool AuStatistics::operator==(const GenInfo& info) const {
+  if (!GenInfo::operator==(info)) {
+    return false;
+  }
+  const auto& other = dynamic_cast<const AuStatistics&>(info);
+  return statistics_.ToJson() == other.statistics_.ToJson();
+}
+
+// -----------------------------------------------------------------------------
+
+core::stats::AuStatistics AuStatistics::decapsulate() {
+  return std::move(statistics_);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::format::mgg
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,93 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @brief Defines the `AuStatistics` box holding the record statistics the
+ * encoder computed for an access unit.
+ * @details MPEG-G has no box for such statistics. This private box is only
+ * written after the AU information and protection boxes when the capsulator
+ * is asked for it, so statistics queries can merge the summaries of an MGG
+ * file without decoding any descriptor. Other readers cannot parse it.
+ * @copyright This file is part of Genie.
+ *            See LICENSE and/or https://github.com/MueFab/genie for more
+ * details.
+ */
+
+#ifndef SRC_GENIE_FORMAT_MGG_AU_STATISTICS_H_
+#define SRC_GENIE_FORMAT_MGG_AU_STATISTICS_H_
+
+// -----------------------------------------------------------------------------
+
+#include <string>
+
+#include "genie/core/stats/au_statistics.h"
+#include "genie/format/mgg/gen_info.h"
+#include "genie/util/bit_reader.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::format::mgg {
+
+/**
+ * @brief Private box holding the record statistics of an access unit.
+ * @details The statistics are stored in their json representation, the same
+ * that is used for the json sidecar of MGB files.
+ */
+class AuStatistics final : public GenInfo {
+ public:
+  /**
+   * @brief Retrieves the key identifier for this statistics box.
+   * @return A reference to the string representing the key.
+   */
+  [[nodiscard]] const std::string& GetKey() const override;
+
+  /**
+   * @brief Constructor for reading statistics from a BitReader stream.
+   * @param bitreader The BitReader to extract data from.
+   */
+  explicit AuStatistics(util::BitReader& bitreader);
+
+  /**
+   * @brief Constructor for initializing the box with statistics.
+   * @param statistics Record statistics computed by the encoder.
+   */
+  explicit AuStatistics(core::stats::AuStatistics statistics);
+
+  /**
+   * @brief Writes the statistics to a BitWriter stream.
+   * @param bit_writer The BitWriter to write the data to.
+   */
+  void BoxWrite(util::BitWriter& bit_writer) const override;
+
+  /**
+   * @brief Retrieves the statistics.
+   * @return A constant reference to the statistics.
+   */
+  [[nodiscard]] const core::stats::AuStatistics& GetStatistics() const;
+
+  /**
+   * @brief Compares the equality of two `AuStatistics` objects.
+   * @param info Reference to another `GenInfo` object for comparison.
+   * @return True if both objects have identical values, otherwise false.
+   */
+  bool operator==(const GenInfo& info) const override;
+
+  /**
+   * @brief Decapsulates and retrieves the statistics.
+   * @return The statistics of the access unit.
+   */
+  core::stats::AuStatistics decapsulate();
+
+ private:
+  core::stats::AuStatistics statistics_;  //!< @brief Record statistics.
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::format::mgg
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_FORMAT_MGG_AU_STATISTICS_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -107,7 +107,8 @@ std::vector<DatasetParameterSet>& Dataset::GetParameterSets() {
 
 Dataset::Dataset(mgb::MgbFile& file, core::meta::Dataset& meta,
                  const core::MpegMinorVersion version,
-                 const std::vector<uint8_t>& param_ids)
+                 const std::vector<uint8_t>& param_ids,
+                 const bool au_statistics)
     : version_(version) {
   bool mit_flag = false;
   bool cc_mode = false;
@@ -173,12 +174,19 @@ Dataset::Dataset(mgb::MgbFile& file, core::meta::Dataset& meta,
   for (auto& a : access_units_p2) {
     access_units_.emplace_back(std::move(*a), mit_flag, version_);
     for (auto& b : meta.GetAUs()) {
-      if (b.GetId() == access_units_.back().GetHeader().GetHeader().GetId()) {
+      if (b.GetId() != access_units_.back().GetHeader().GetHeader().GetId()) {
+        continue;
+      }
+      // Metadata holding only encoder statistics has no MPEG-G boxes
+      if (!b.GetInformation().empty() || !b.GetProtection().empty()) {
         access_units_.back().SetInformation(
             AuInformation(0, 0, std::move(b.GetInformation()), version));
         access_units_.back().SetProtection(
             AuProtection(0, 0, std::move(b.GetProtection()), version));
       }
+      if (au_statistics && b.GetStatistics()) {
+        access_units_.back().SetStatistics(AuStatistics(*b.GetStatistics()));
+      }
     }
   }
 
@@ -132,10 +132,12 @@ class Dataset final : public GenInfo {
    * @param meta Metadata of the dataset.
    * @param version MPEG minor version to use for the dataset.
    * @param param_ids List of parameter set IDs.
+   * @param au_statistics Whether to keep the encoder statistics of each access
+   * unit in a private `aust` box. Files carrying it are not MPEG-G conformant.
    */
   Dataset(mgb::MgbFile& file, core::meta::Dataset& meta,
           core::MpegMinorVersion version,
-          const std::vector<uint8_t>& param_ids);
+          const std::vector<uint8_t>& param_ids, bool au_statistics = false);
 
   /**
    * @brief Patches the group ID and set ID within the dataset.
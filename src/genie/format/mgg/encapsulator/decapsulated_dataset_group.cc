@@ -129,6 +129,10 @@ DecapsulatedDatasetGroup::DecapsulateAu(AccessUnit& au) {
     has_meta = true;
     meta_au.SetProtection(au.GetProtection().decapsulate());
   }
+  if (au.HasStatistics()) {
+    has_meta = true;
+    meta_au.SetStatistics(au.GetStatistics().decapsulate());
+  }
   std::pair<mgb::AccessUnit, std::optional<core::meta::AccessUnit>> ret(
       au.Decapsulate(), std::nullopt);
   if (has_meta) {
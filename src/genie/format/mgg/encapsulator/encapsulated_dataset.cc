@@ -18,7 +18,8 @@ namespace genie::format::mgg::encapsulator {
 // -----------------------------------------------------------------------------
 
 EncapsulatedDataset::EncapsulatedDataset(const std::string& input_file,
-                                         core::MpegMinorVersion version)
+                                         core::MpegMinorVersion version,
+                                         const bool au_statistics)
     : reader(input_file), mgb_file(&reader) {
   UTILS_DIE_IF(!reader, "Cannot open file to read: " + input_file);
   if (std::filesystem::exists(input_file + ".json") &&
@@ -46,7 +47,7 @@ EncapsulatedDataset::EncapsulatedDataset(const std::string& input_file,
           if (param_ids.empty()) {
             continue;
           }
-          auto dataset = Dataset(mgb_file, meta, version, param_ids);
+          auto dataset = Dataset(mgb_file, meta, version, param_ids, au_statistics);
           datasets.emplace_back(std::move(dataset));
         }
       }
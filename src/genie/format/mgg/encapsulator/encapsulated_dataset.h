@@ -61,10 +61,13 @@ struct EncapsulatedDataset {
    *
    * @param input_file Path to the input dataset file.
    * @param version MPEG-G minor version used for the encapsulated file.
+   * @param au_statistics Whether to keep the access unit statistics of the
+   * json sidecar in private `aust` boxes.
    * @throws `std::runtime_error` if the file cannot be opened or parsed.
    */
-  explicit EncapsulatedDataset(const std::string& input_file,
-                               genie::core::MpegMinorVersion version);
+  EncapsulatedDataset(const std::string& input_file,
+                      genie::core::MpegMinorVersion version,
+                      bool au_statistics = false);
 };
 
 // -----------------------------------------------------------------------------
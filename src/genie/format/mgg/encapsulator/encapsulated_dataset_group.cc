@@ -180,10 +180,10 @@ void EncapsulatedDatasetGroup::MergeLabels() {
 
 EncapsulatedDatasetGroup::EncapsulatedDatasetGroup(
     const std::vector<std::string>& input_files,
-    core::MpegMinorVersion version) {
+    core::MpegMinorVersion version, const bool au_statistics) {
   datasets.reserve(input_files.size());
   for (const auto& i : input_files) {
-    datasets.emplace_back(std::make_unique<EncapsulatedDataset>(i, version));
+    datasets.emplace_back(std::make_unique<EncapsulatedDataset>(i, version, au_statistics));
   }
   size_t index = 0;
   for (const auto& d : datasets) {
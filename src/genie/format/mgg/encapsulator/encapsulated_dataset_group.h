@@ -109,11 +109,14 @@ struct EncapsulatedDatasetGroup {
    * @param input_files A vector of paths to input files representing the
    * datasets to be grouped.
    * @param version The MPEG-G minor version for the encapsulated format.
+   * @param au_statistics Whether to keep the access unit statistics of the
+   * json sidecars in private `aust` boxes.
    * @throws `std::runtime_error` if any of the files cannot be opened or
    * processed.
    */
   EncapsulatedDatasetGroup(const std::vector<std::string>& input_files,
-                           core::MpegMinorVersion version);
+                           core::MpegMinorVersion version,
+                           bool au_statistics = false);
 
   /**
    * @brief Assembles a complete `DatasetGroup` object from the encapsulated
@@ -65,12 +65,13 @@ std::map<uint8_t, std::vector<std::string>> EncapsulatedFile::GroupInputFiles(
 // -----------------------------------------------------------------------------
 
 EncapsulatedFile::EncapsulatedFile(const std::vector<std::string>& input_files,
-                                   const core::MpegMinorVersion version) {
+                                   const core::MpegMinorVersion version,
+                                   const bool au_statistics) {
   const std::map<uint8_t, std::vector<std::string>> file_groups =
       GroupInputFiles(input_files);
 
   for (const auto& [fst, snd] : file_groups) {
-    auto group = EncapsulatedDatasetGroup(snd, version);
+    auto group = EncapsulatedDatasetGroup(snd, version, au_statistics);
     group.PatchId(fst);
     groups.emplace_back(std::move(group));
   }
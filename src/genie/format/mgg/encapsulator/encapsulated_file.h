@@ -68,11 +68,14 @@ struct EncapsulatedFile {
    * @param input_files A vector of file paths representing the input datasets
    * to be encapsulated.
    * @param version The MPEG-G minor version for the encapsulated format.
+   * @param au_statistics Whether to keep the access unit statistics of the
+   * json sidecars in private `aust` boxes.
    * @throws `std::runtime_error` if any file cannot be read or if the group
    * organization fails.
    */
   EncapsulatedFile(const std::vector<std::string>& input_files,
-                   genie::core::MpegMinorVersion version);
+                   genie::core::MpegMinorVersion version,
+                   bool au_statistics = false);
 
   /**
    * @brief Assembles all encapsulated dataset groups into a complete MPEG-G
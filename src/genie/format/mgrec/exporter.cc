@@ -11,7 +11,7 @@
 
 #include <utility>
 
-#include "genie/util/ordered_section.h"
+#include "genie/core/stats/stage_timer.h"
 
 // -----------------------------------------------------------------------------
 
@@ -19,13 +19,21 @@ namespace genie::format::mgrec {
 
 // -----------------------------------------------------------------------------
 
-Exporter::Exporter(std::ostream& file_1) : writer_(file_1) {}
+Exporter::Exporter(std::ostream& file_1)
+    : writer_(file_1),
+      output_([this](core::record::Chunk&& data) { Write(std::move(data)); }) {
+}
 
 // -----------------------------------------------------------------------------
 
 void Exporter::FlowIn(core::record::Chunk&& t, const util::Section& id) {
-  core::record::Chunk data = std::move(t);
-  [[maybe_unused]] util::OrderedSection section(&lock_, id);
+  output_.Push(std::move(t), id);
+}
+
+// -----------------------------------------------------------------------------
+
+void Exporter::Write(core::record::Chunk&& data) {
+  core::stats::StageTimer timer(core::stats::Stage::kExport);
   const util::Watch watch;
   const auto bits = writer_.GetTotalBitsWritten();
   for (auto& i : data.GetData()) {
@@ -38,8 +46,15 @@ void Exporter::FlowIn(core::record::Chunk&& t, const util::Section& id) {
   GetStats().Add(data.GetStats());
 }
 
-void Exporter::SkipIn(const util::Section& id) {
-  [[maybe_unused]] util::OrderedSection sec(&lock_, id);
+// -----------------------------------------------------------------------------
+
+void Exporter::SkipIn(const util::Section& id) { output_.Skip(id); }
+
+// -----------------------------------------------------------------------------
+
+void Exporter::FlushIn(uint64_t& pos) {
+  output_.Flush();
+  FormatExporter::FlushIn(pos);
 }
 
 // -----------------------------------------------------------------------------
@@ -5,7 +5,7 @@
  *
  * This file defines the `Exporter` class used for writing records into the
  * MGREC format. The exporter handles record formatting, manages the writing
- * process, and maintains thread safety through an ordered lock mechanism.
+ * process, and writes chunks in order on a dedicated writer thread.
  *
  * @copyright This file is part of Genie.
  * See LICENSE and/or visit https://github.com/MueFab/genie for more details.
@@ -20,7 +20,7 @@
 #include "genie/core/record/chunk.h"
 #include "genie/util/bit_writer.h"
 #include "genie/util/drain.h"
-#include "genie/util/ordered_lock.h"
+#include "genie/util/reorder_buffer.h"
 
 // -----------------------------------------------------------------------------
 
@@ -31,13 +31,22 @@ namespace genie::format::mgrec {
  * @brief MGREC format exporter for writing records to a file.
  *
  * The `Exporter` class is designed to handle the export of records into the
- * MGREC format, utilizing a bit-wise writer to serialize and output data. It
- * ensures thread safety through an ordered lock mechanism, allowing parallel
- * processing and synchronized record writing.
+ * MGREC format, utilizing a bit-wise writer to serialize and output data.
+ * Chunks are handed over to a writer thread, which serializes them in order,
+ * so the calling threads never wait for earlier chunks.
  */
 class Exporter final : public core::FormatExporter {
   util::BitWriter writer_;  //!< Bit writer for serializing records
-  util::OrderedLock lock_;  //!< Ordered lock for thread-safe writing
+
+  /// Writes chunks in order on a dedicated thread. Declared last, so it is
+  /// stopped before the bit writer is destroyed.
+  util::ReorderBuffer<core::record::Chunk> output_;
+
+  /**
+   * @brief Serialize one chunk, called in order by `output_`.
+   * @param data Chunk of records to be written.
+   */
+  void Write(core::record::Chunk&& data);
 
  public:
   /**
@@ -58,6 +67,12 @@ class Exporter final : public core::FormatExporter {
    * @param id Section identifier to be skipped.
    */
   void SkipIn(const util::Section& id) override;
+
+  /**
+   * @brief Wait until all chunks have been written.
+   * @param pos Current section position.
+   */
+  void FlushIn(uint64_t& pos) override;
 };
 
 // -----------------------------------------------------------------------------
@@ -13,6 +13,7 @@
 #include <string>
 #include <utility>
 
+#include "genie/core/stats/stage_timer.h"
 #include "genie/util/log.h"
 #include "genie/util/ordered_section.h"
 #include "genie/util/stop_watch.h"
@@ -42,18 +43,6 @@ Importer::Importer(const size_t block_size, std::istream& file_1,
 
 // -----------------------------------------------------------------------------
 
-bool IsECigarSupported(const std::string& e_cigar) {
-  // Splices not supported
-  if (e_cigar.find_first_of('*') != std::string::npos ||
-      e_cigar.find_first_of('/') != std::string::npos ||
-      e_cigar.find_first_of('%') != std::string::npos) {
-    return false;
-  }
-  return true;
-}
-
-// -----------------------------------------------------------------------------
-
 bool Importer::IsRecordSupported(const core::record::Record& rec) {
   if (!check_support_) {
     return true;
@@ -68,19 +57,8 @@ bool Importer::IsRecordSupported(const core::record::Record& rec) {
       discarded_hm_++;
       return false;
     }
-    if (!IsECigarSupported(a.GetAlignment().GetECigar())) {
-      discarded_splices_++;
-      return false;
-    }
     for (const auto& s : a.GetAlignmentSplits()) {
       if (s->GetType() == core::record::AlignmentSplit::Type::kSameRec) {
-        if (!IsECigarSupported(
-                dynamic_cast<core::record::alignment_split::SameRec&>(*s)
-                    .GetAlignment()
-                    .GetECigar())) {
-          discarded_splices_++;
-          return false;
-        }
         // Splits with more than 32767 delta must be encoded in separate
         // records, which is not yet supported
         if (std::abs(dynamic_cast<core::record::alignment_split::SameRec&>(*s)
@@ -151,15 +129,17 @@ bool Importer::PumpRetrieve(core::Classifier* classifier) {
     missing_additional_alignments_ +=
         c.GetAlignments().empty() ? 0 : c.GetAlignments().size() - 1;
   }
-  classifier->Add(std::move(chunk));
+  {
+    core::stats::StageTimer classify(core::stats::Stage::kClassify);
+    classifier->Add(std::move(chunk));
+  }
   return reader_.IsStreamGood() || buffered_record_;
 }
 
 // -----------------------------------------------------------------------------
 
 void Importer::PrintStats() const {
-  if (discarded_splices_ + discarded_hm_ + discarded_long_distance_ +
-          discarded_missing_pair_u_ ==
+  if (discarded_hm_ + discarded_long_distance_ + discarded_missing_pair_u_ ==
       0) {
     UTILS_LOG(util::Logger::Severity::INFO, "No reads were dropped");
     return;
@@ -167,8 +147,6 @@ void Importer::PrintStats() const {
 
   UTILS_LOG(util::Logger::Severity::WARNING,
             "The following number of reads were dropped:");
-  UTILS_LOG(util::Logger::Severity::WARNING,
-            std::to_string(discarded_splices_) + " containing splices");
   UTILS_LOG(util::Logger::Severity::WARNING,
             std::to_string(discarded_hm_) + " class HM reads");
   UTILS_LOG(util::Logger::Severity::WARNING,
@@ -179,8 +157,8 @@ void Importer::PrintStats() const {
                 " unaligned reads with missing pair");
   UTILS_LOG(
       util::Logger::Severity::WARNING,
-      std::to_string(discarded_splices_ + discarded_hm_ +
-                     discarded_long_distance_ + discarded_missing_pair_u_) +
+      std::to_string(discarded_hm_ + discarded_long_distance_ +
+                     discarded_missing_pair_u_) +
           " in total");
   UTILS_LOG(util::Logger::Severity::WARNING,
             std::to_string(missing_additional_alignments_) +
@@ -40,7 +40,6 @@ class Importer final : public core::FormatImporter {
   util::BitReader reader_;  //!< Bit reader for the input stream
   util::BitWriter writer_;  //!< Bit writer for unsupported record output
 
-  size_t discarded_splices_{};        //!< Number of discarded spliced records
   size_t discarded_long_distance_{};  //!< Number of discarded long distance
                                       //!< records
   size_t discarded_hm_{};             //!< Number of discarded hard mask records
@@ -0,0 +1,238 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/format/sam/coordinate_sorter.h"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "genie/util/runtime_exception.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::format::sam {
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/// Bases in the order of their 4 bit code in BAM
+constexpr std::string_view kBamBases = "=ACMGRSVTWYHKDBN";
+
+/// 4 bit code of every character, -1 if it has none
+constexpr std::array<int8_t, 256> kBamCodes = [] {
+  std::array<int8_t, 256> codes{};
+  for (auto& c : codes) {
+    c = -1;
+  }
+  for (size_t i = 0; i < kBamBases.size(); ++i) {
+    codes[static_cast<uint8_t>(kBamBases[i])] = static_cast<int8_t>(i);
+  }
+  return codes;
+}();
+
+// -----------------------------------------------------------------------------
+
+template <typename Int>
+void WriteInt(std::ofstream& file, const Int value) {
+  file.write(reinterpret_cast<const char*>(&value), sizeof(Int));
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Int>
+Int ReadInt(std::ifstream& file) {
+  Int value = 0;
+  file.read(reinterpret_cast<char*>(&value), sizeof(Int));
+  return value;
+}
+
+// -----------------------------------------------------------------------------
+
+void WriteString(std::ofstream& file, const std::string& value) {
+  WriteInt(file, static_cast<uint32_t>(value.size()));
+  file.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+// -----------------------------------------------------------------------------
+
+std::string ReadString(std::ifstream& file) {
+  std::string value(ReadInt<uint32_t>(file), '\0');
+  file.read(value.data(), static_cast<std::streamsize>(value.size()));
+  return value;
+}
+
+// -----------------------------------------------------------------------------
+
+void WriteSequence(std::ofstream& file, const std::string& seq) {
+  const bool packed = std::all_of(seq.begin(), seq.end(), [](const char c) {
+    return kBamCodes[static_cast<uint8_t>(c)] >= 0;
+  });
+  WriteInt(file, static_cast<uint8_t>(packed));
+  if (!packed) {
+    WriteString(file, seq);
+    return;
+  }
+  WriteInt(file, static_cast<uint32_t>(seq.size()));
+  std::string bytes((seq.size() + 1) / 2, '\0');
+  for (size_t i = 0; i < seq.size(); ++i) {
+    const auto code = kBamCodes[static_cast<uint8_t>(seq[i])];
+    bytes[i / 2] = static_cast<char>(bytes[i / 2] | code << (i % 2 ? 0 : 4));
+  }
+  file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// -----------------------------------------------------------------------------
+
+std::string ReadSequence(std::ifstream& file) {
+  if (!ReadInt<uint8_t>(file)) {
+    return ReadString(file);
+  }
+  std::string seq(ReadInt<uint32_t>(file), '\0');
+  std::string bytes((seq.size() + 1) / 2, '\0');
+  file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  for (size_t i = 0; i < seq.size(); ++i) {
+    const auto byte = static_cast<uint8_t>(bytes[i / 2]);
+    seq[i] = kBamBases[i % 2 ? byte & 0xf : byte >> 4];
+  }
+  return seq;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+std::optional<SamRecord> CoordinateSorter::ReadRecord::operator()(
+    std::ifstream& file) const {
+  if (file.peek() == std::ifstream::traits_type::eof()) {
+    return std::nullopt;
+  }
+  SamRecord rec;
+  rec.qname_ = ReadString(file);
+  rec.flag_ = ReadInt<uint16_t>(file);
+  rec.rid_ = ReadInt<int32_t>(file);
+  rec.pos_ = ReadInt<uint32_t>(file);
+  rec.mapq_ = ReadInt<uint8_t>(file);
+  rec.cigar_.resize(ReadInt<uint32_t>(file));
+  file.read(reinterpret_cast<char*>(rec.cigar_.data()),
+            static_cast<std::streamsize>(rec.cigar_.size() * sizeof(uint32_t)));
+  rec.mate_rid_ = ReadInt<int32_t>(file);
+  rec.mate_pos_ = ReadInt<uint32_t>(file);
+  rec.seq_ = ReadSequence(file);
+  rec.qual_ = ReadString(file);
+  rec.optional_fields_.resize(ReadInt<uint32_t>(file));
+  for (auto& [tag, value] : rec.optional_fields_) {
+    tag = ReadString(file);
+    value = ReadString(file);
+  }
+  UTILS_DIE_IF(!file, "Truncated record in sorted run");
+  return rec;
+}
+
+// -----------------------------------------------------------------------------
+
+void CoordinateSorter::WriteRecord::operator()(std::ofstream& file,
+                                               const SamRecord& rec) const {
+  WriteString(file, rec.qname_);
+  WriteInt(file, rec.flag_);
+  WriteInt(file, rec.rid_);
+  WriteInt(file, rec.pos_);
+  WriteInt(file, rec.mapq_);
+  WriteInt(file, static_cast<uint32_t>(rec.cigar_.size()));
+  file.write(
+      reinterpret_cast<const char*>(rec.cigar_.data()),
+      static_cast<std::streamsize>(rec.cigar_.size() * sizeof(uint32_t)));
+  WriteInt(file, rec.mate_rid_);
+  WriteInt(file, rec.mate_pos_);
+  WriteSequence(file, rec.seq_);
+  WriteString(file, rec.qual_);
+  WriteInt(file, static_cast<uint32_t>(rec.optional_fields_.size()));
+  for (const auto& [tag, value] : rec.optional_fields_) {
+    WriteString(file, tag);
+    WriteString(file, value);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+bool CoordinateSorter::Less::operator()(const SamRecord& a,
+                                        const SamRecord& b) const {
+  // Unmapped reads without a reference have id -1, the cast moves them last
+  return std::forward_as_tuple(static_cast<uint32_t>(a.rid_), a.pos_,
+                               a.qname_, a.flag_) <
+         std::forward_as_tuple(static_cast<uint32_t>(b.rid_), b.pos_,
+                               b.qname_, b.flag_);
+}
+
+// -----------------------------------------------------------------------------
+
+CoordinateSorter::CoordinateSorter(const std::string& temp_base,
+                                   const size_t memory, const size_t threads,
+                                   const size_t max_fan_in)
+    : cur_bytes_(0) {
+  // One run is filled while the others are spilled
+  const size_t runs = std::max<size_t>(threads, 1) + 1;
+  run_bytes_ = (memory == 0 ? kDefaultMemory : memory) / runs;
+  builder_.emplace(0, temp_base, ReadRecord(), WriteRecord(), Less(),
+                   std::max<size_t>(threads, 1), max_fan_in);
+}
+
+// -----------------------------------------------------------------------------
+
+void CoordinateSorter::Add(SamRecord rec) {
+  UTILS_DIE_IF(!builder_, "CoordinateSorter already finished");
+  cur_bytes_ += GetMemorySize(rec);
+  builder_->AddRecord(std::move(rec));
+  if (cur_bytes_ >= run_bytes_) {
+    builder_->NewChunk();
+    cur_bytes_ = 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void CoordinateSorter::Finish() {
+  UTILS_DIE_IF(!builder_, "CoordinateSorter already finished");
+  merger_.emplace(builder_->Finish(false));
+  builder_.reset();
+}
+
+// -----------------------------------------------------------------------------
+
+const SamRecord* CoordinateSorter::Peek() const {
+  if (!merger_ || merger_->IsEmpty()) {
+    return nullptr;
+  }
+  return &merger_->Top();
+}
+
+// -----------------------------------------------------------------------------
+
+SamRecord CoordinateSorter::Get() { return merger_->Get(); }
+
+// -----------------------------------------------------------------------------
+
+size_t CoordinateSorter::GetMemorySize(const SamRecord& rec) {
+  size_t ret = sizeof(SamRecord) + rec.qname_.capacity() +
+               rec.seq_.capacity() + rec.qual_.capacity() +
+               rec.cigar_.capacity() * sizeof(uint32_t);
+  for (const auto& [tag, value] : rec.optional_fields_) {
+    ret += sizeof(SamRecord::Tag) + tag.capacity() + value.capacity();
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::format::sam
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,155 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#ifndef SRC_GENIE_FORMAT_SAM_COORDINATE_SORTER_H_
+#define SRC_GENIE_FORMAT_SAM_COORDINATE_SORTER_H_
+
+// -----------------------------------------------------------------------------
+
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include "genie/format/sam/sam_record.h"
+#include "genie/util/merge_sort/builder.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::format::sam {
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief External sort of SAM records by coordinate, for input that is
+ * unsorted or sorted by read name.
+ *
+ * Records are collected into runs that fit the memory budget. Full runs are
+ * sorted and spilled to temporary files in the background, then the runs are
+ * merged while the records are read back. Runs are written in a compact
+ * binary form, and at most `max_fan_in` of them are merged at once.
+ */
+class CoordinateSorter {
+  /**
+   * @brief Reads a record spilled by WriteRecord
+   */
+  struct ReadRecord {
+    /**
+     * @brief
+     * @param file
+     * @return The record or nothing at the end of the file
+     */
+    std::optional<SamRecord> operator()(std::ifstream& file) const;
+  };
+
+  /**
+   * @brief Spills a record in binary form. Integers are written in host byte
+   * order, as the file is read back by the same process. Bases are packed two
+   * per byte if they all belong to the BAM alphabet.
+   */
+  struct WriteRecord {
+    /**
+     * @brief
+     * @param file
+     * @param rec
+     */
+    void operator()(std::ofstream& file, const SamRecord& rec) const;
+  };
+
+  /**
+   * @brief Order of a coordinate-sorted file: reference, position, unmapped
+   * reads last. Ties are broken by read name so that the mates of unmapped
+   * pairs end up next to each other.
+   */
+  struct Less {
+    /**
+     * @brief
+     * @param a
+     * @param b
+     * @return True if a comes before b
+     */
+    bool operator()(const SamRecord& a, const SamRecord& b) const;
+  };
+
+  /// Collects runs and spills them
+  using Builder =
+      util::merge_sort::Builder<SamRecord, ReadRecord, WriteRecord, Less>;
+
+  /// Merges the spilled runs
+  using Merger = util::merge_sort::Merger<SamRecord, Less>;
+
+  /// Bytes of records in one run
+  size_t run_bytes_;
+
+  /// Bytes of records in the run currently filled
+  size_t cur_bytes_;
+
+  /// Set until Finish() is called
+  std::optional<Builder> builder_;
+
+  /// Set after Finish() was called
+  std::optional<Merger> merger_;
+
+ public:
+  /// Memory used if no budget is given
+  static constexpr size_t kDefaultMemory = 512 * 1024 * 1024;
+
+  /**
+   * @brief Create a sorter
+   * @param temp_base Path prefix for the temporary run files
+   * @param memory Budget for all records held in memory, 0 for the default
+   * @param threads Number of runs sorted and spilled in parallel
+   * @param max_fan_in Maximum number of runs merged at once, which bounds the
+   * number of open temporary files
+   */
+  CoordinateSorter(const std::string& temp_base, size_t memory,
+                   size_t threads,
+                   size_t max_fan_in = Builder::kDefaultMaxFanIn);
+
+  /**
+   * @brief Add a record. Must not be called after Finish().
+   * @param rec Record
+   */
+  void Add(SamRecord rec);
+
+  /**
+   * @brief Signal that all records were added. Waits for the runs still
+   * being spilled.
+   */
+  void Finish();
+
+  /**
+   * @brief Look at the next record in coordinate order. Only valid after
+   * Finish().
+   * @return The next record, nullptr if all records were taken
+   */
+  [[nodiscard]] const SamRecord* Peek() const;
+
+  /**
+   * @brief Take the next record in coordinate order. Only valid after
+   * Finish() and if Peek() returned a record.
+   * @return The next record
+   */
+  SamRecord Get();
+
+  /**
+   * @brief Approximate memory held by a record
+   * @param rec Record
+   * @return Bytes
+   */
+  static size_t GetMemorySize(const SamRecord& rec);
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::format::sam
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_FORMAT_SAM_COORDINATE_SORTER_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 #include "genie/format/sam/exporter.h"
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,8 +16,8 @@
 #include "genie/core/record/alignment_split/other_rec.h"
 #include "genie/core/record/alignment_split/same_rec.h"
 #include "genie/core/record/record.h"
+#include "genie/core/stats/stage_timer.h"
 #include "genie/format/sam/importer.h"
-#include "genie/util/ordered_section.h"
 #include "genie/util/stop_watch.h"
 
 // -----------------------------------------------------------------------------
@@ -25,9 +26,14 @@ namespace genie::format::sam {
 
 // -----------------------------------------------------------------------------
 
-Exporter::Exporter(std::string ref_file, std::string output_file)
-    : fasta_file_path_(std::move(ref_file)),
-      output_file_path_(std::move(output_file)) {}
+Exporter::Exporter(const std::string& ref_file, std::string output_file)
+    : output_file_path_(std::move(output_file)),
+      ref_info_(std::make_unique<const RefInfo>(ref_file)),
+      output_([this](Output&& output) { Write(std::move(output)); }) {}
+
+// -----------------------------------------------------------------------------
+
+Exporter::~Exporter() = default;
 
 // -----------------------------------------------------------------------------
 
@@ -294,34 +300,50 @@ void ProcessFirstMappedSegment(const size_t s, const size_t a,
 
 // -----------------------------------------------------------------------------
 
-void Exporter::SkipIn(const util::Section& id) {
-  [[maybe_unused]] util::OrderedSection sec(&lock_, id);
-}
-
-void Exporter::FlowIn(core::record::Chunk&& records, const util::Section& id) {
-  core::record::Chunk data = std::move(records);
-  GetStats().Add(data.GetStats());
-  util::Watch watch;
-  [[maybe_unused]] util::OrderedSection section(&lock_, id);
-  size_t size_seq = 0;
-  size_t size_qual = 0;
-  size_t size_name = 0;
+void Exporter::SkipIn(const util::Section& id) { output_.Skip(id); }
 
-  RefInfo refinf(fasta_file_path_);
+// -----------------------------------------------------------------------------
 
+void Exporter::Write(Output&& output) {
+  core::stats::StageTimer timer(core::stats::Stage::kExport);
   if (!output_set_ && output_file_path_.substr(0, 2) != "-.") {
     output_stream_ = std::ofstream(output_file_path_);
     output_file_ = &output_stream_.value();
   }
   if (!output_set_) {
     *output_file_ << "@HD\tVN:1.6" << std::endl;
-    for (const auto& s : refinf.GetMgr()->GetSequences()) {
-      *output_file_ << "@SQ\tSN:" << s
-                    << "\tLN:" << std::to_string(refinf.GetMgr()->GetLength(s))
+    for (const auto& s : ref_info_->GetMgr()->GetSequences()) {
+      *output_file_ << "@SQ\tSN:" << s << "\tLN:"
+                    << std::to_string(ref_info_->GetMgr()->GetLength(s))
                     << std::endl;
     }
     output_set_ = true;
   }
+  output_file_->write(output.lines.data(),
+                      static_cast<std::streamsize>(output.lines.size()));
+  GetStats().Add(output.stats);
+}
+
+// -----------------------------------------------------------------------------
+
+void Exporter::FlushIn(uint64_t& pos) {
+  output_.Flush();
+  output_file_->flush();
+  FormatExporter::FlushIn(pos);
+}
+
+// -----------------------------------------------------------------------------
+
+void Exporter::FlowIn(core::record::Chunk&& records, const util::Section& id) {
+  core::record::Chunk data = std::move(records);
+  core::stats::StageTimer timer(core::stats::Stage::kExport);
+  util::Watch watch;
+  size_t size_seq = 0;
+  size_t size_qual = 0;
+  size_t size_name = 0;
+
+  const RefInfo& refinf = *ref_info_;
+  Output output;
 
   for (auto& record : data.GetData()) {
     // One line per segment and alignment
@@ -393,18 +415,21 @@ void Exporter::FlowIn(core::record::Chunk&& records, const util::Section& id) {
           sam_record += record.GetSegments()[s].GetQualities()[0] + "\n";
         }
 
-        output_file_->write(sam_record.c_str(),
-                            static_cast<std::streamsize>(sam_record.length()));
+        output.lines += sam_record;
       }
     }
   }
 
-  GetStats().AddInteger("size-sam-seq", static_cast<int64_t>(size_seq));
-  GetStats().AddInteger("size-sam-name", static_cast<int64_t>(size_name));
-  GetStats().AddInteger("size-sam-qual", static_cast<int64_t>(size_qual));
-  GetStats().AddInteger("size-sam-total",
-                        static_cast<int64_t>(size_qual + size_name + size_seq));
-  GetStats().AddDouble("time-sam-export", watch.Check());
+  output.stats = std::move(data.GetStats());
+  output.stats.AddInteger("size-sam-seq", static_cast<int64_t>(size_seq));
+  output.stats.AddInteger("size-sam-name", static_cast<int64_t>(size_name));
+  output.stats.AddInteger("size-sam-qual", static_cast<int64_t>(size_qual));
+  output.stats.AddInteger(
+      "size-sam-total", static_cast<int64_t>(size_qual + size_name + size_seq));
+  output.stats.AddDouble("time-sam-export", watch.Check());
+  timer.Stop();
+
+  output_.Push(std::move(output), id);
 }
 
 // -----------------------------------------------------------------------------
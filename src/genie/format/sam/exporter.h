@@ -12,35 +12,65 @@
 
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 
 #include "genie/core/format_exporter.h"
 #include "genie/core/record/chunk.h"
+#include "genie/core/stats/perf_stats.h"
 #include "genie/util/drain.h"
-#include "genie/util/ordered_lock.h"
+#include "genie/util/reorder_buffer.h"
 
 // -----------------------------------------------------------------------------
 
 namespace genie::format::sam {
 
+class RefInfo;
+
 /**
  * @brief Module to export MPEG-G record to sam files
  */
 class Exporter final : public core::FormatExporter {
-  util::OrderedLock lock_;  //!< @brief Lock to ensure in order execution
-  std::string fasta_file_path_;
+  /**
+   * @brief A formatted chunk, waiting to be written.
+   */
+  struct Output {
+    std::string lines;             //!< @brief SAM records of the chunk.
+    core::stats::PerfStats stats;  //!< @brief Statistics of the chunk.
+  };
+
   std::string output_file_path_;
+
+  /// @brief Reference names and lengths, loaded once and then only read by
+  /// the formatting threads and the writer thread.
+  std::unique_ptr<const RefInfo> ref_info_;
   std::optional<std::ofstream> output_stream_;
   std::ostream* output_file_ = &std::cout;
   bool output_set_ = false;
 
+  /// @brief Writes formatted chunks in order on a dedicated thread. Declared
+  /// last, so it is stopped before the output file is closed.
+  util::ReorderBuffer<Output> output_;
+
+  /**
+   * @brief Writes the header (before the first chunk) and one formatted
+   * chunk, called in order by `output_`.
+   * @param output The formatted chunk.
+   */
+  void Write(Output&& output);
+
  public:
   /**
    * @brief
    * @param ref_file
    * @param output_file
    */
-  explicit Exporter(std::string ref_file, std::string output_file);
+  explicit Exporter(const std::string& ref_file, std::string output_file);
+
+  /**
+   * @brief Stops the writer thread.
+   */
+  ~Exporter() override;
 
   /**
    * @brief
@@ -49,11 +79,18 @@ class Exporter final : public core::FormatExporter {
   void SkipIn(const util::Section& id) override;
 
   /**
-   * @brief Process one chunk of MPEGG records
+   * @brief Process one chunk of MPEGG records. The records are formatted by
+   * the calling thread and written in order by a writer thread.
    * @param records Input records
    * @param id Block identifier (for multithreading)
    */
   void FlowIn(core::record::Chunk&& records, const util::Section& id) override;
+
+  /**
+   * @brief Waits until all chunks have been written.
+   * @param pos Current section position
+   */
+  void FlushIn(uint64_t& pos) override;
 };
 
 // -----------------------------------------------------------------------------
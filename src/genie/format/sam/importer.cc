@@ -17,9 +17,11 @@
 #include "genie/format/sam/importer.h"
 
 #include <algorithm>
+#include <filesystem>  // NOLINT
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -28,11 +30,13 @@
 #include "genie/core/record/alignment_split/other_rec.h"
 #include "genie/core/record/alignment_split/same_rec.h"
 #include "genie/core/record/class_type.h"
+#include "genie/core/stats/stage_timer.h"
 #include "genie/format/sam/pair_matcher.h"
 #include "genie/format/sam/sam_reader.h"
 #include "genie/format/sam/sam_sorter.h"
 #include "genie/util/ordered_section.h"
 #include "genie/util/stop_watch.h"
+#include "genie/util/trace.h"
 
 // -----------------------------------------------------------------------------
 
@@ -40,6 +44,10 @@ constexpr auto kLogModuleName = "TranscoderSam";
 
 namespace genie::format::sam {
 
+/// Upper bound of the htslib threads decompressing the input. They run next
+/// to the pipeline threads, and one parsing thread does not keep more busy.
+constexpr size_t kMaxReaderThreads = 2;
+
 RefInfo::RefInfo(const std::string& fasta_name)
     : ref_mgr_(std::make_unique<core::ReferenceManager>(4)), valid_(false) {
   if (!std::filesystem::exists(fasta_name)) {
@@ -50,21 +58,7 @@ RefInfo::RefInfo(const std::string& fasta_name)
       fasta_name.substr(0, fasta_name.find_last_of('.')) + ".fai";
   std::string sha_name =
       fasta_name.substr(0, fasta_name.find_last_of('.')) + ".sha256";
-  if (!std::filesystem::exists(fai_name)) {
-    std::ifstream fasta_in(fasta_name);
-    UTILS_DIE_IF(!fasta_in, "Cannot open file to read: " + fasta_name);
-    std::ofstream fai_out(fai_name);
-    fasta::FastaReader::index(fasta_in, fai_out);
-  }
-  if (!std::filesystem::exists(sha_name)) {
-    std::ifstream fasta_in(fasta_name);
-    UTILS_DIE_IF(!fasta_in, "Cannot open file to read: " + fasta_name);
-    std::ifstream fai_in(fai_name);
-    UTILS_DIE_IF(!fai_in, "Cannot open file to read: " + fai_name);
-    fasta::FaiFile faifile(fai_in);
-    std::ofstream sha_out(sha_name);
-    fasta::FastaReader::hash(faifile, fasta_in, sha_out);
-  }
+  fasta::FastaReader::IndexAndHash(fasta_name, fai_name, sha_name);
 
   fasta_file_ = std::make_unique<std::ifstream>(fasta_name);
   UTILS_DIE_IF(!fasta_file_, "Cannot open file to read: " + fasta_name);
@@ -86,29 +80,76 @@ bool RefInfo::IsValid() const { return valid_; }
 
 core::ReferenceManager* RefInfo::GetMgr() const { return ref_mgr_.get(); }
 
+// -----------------------------------------------------------------------------
+
+void Importer::SortInputIfNeeded() {
+  if (coordinate_sorter_ || sam_reader_.GetSortOrder() == "coordinate") {
+    return;
+  }
+  UTILS_LOG(util::Logger::Severity::INFO,
+            "Input is not sorted by coordinate, sorting it");
+  util::TraceScope trace("sort-input", "import", util::TraceScope::kNone);
+  auto temp_base = std::filesystem::path(tmp_dir_.empty() ? "." : tmp_dir_) /
+                   ("genie_sam_sort_" + std::to_string(std::random_device()()) +
+                    "_");
+  coordinate_sorter_ = std::make_unique<CoordinateSorter>(
+      temp_base.string(), sort_memory_, threads_);
+  while (sam_reader_.Peek() != std::nullopt) {
+    coordinate_sorter_->Add(*sam_reader_.Move());
+    sam_reader_.Read();
+  }
+  coordinate_sorter_->Finish();
+}
+
+// -----------------------------------------------------------------------------
+
+const SamRecord* Importer::PeekRecord() {
+  if (coordinate_sorter_) {
+    return coordinate_sorter_->Peek();
+  }
+  const auto& next = sam_reader_.Peek();
+  return next ? &*next : nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+SamRecord Importer::NextRecord() {
+  if (coordinate_sorter_) {
+    return coordinate_sorter_->Get();
+  }
+  auto ret = std::move(*sam_reader_.Move());
+  sam_reader_.Read();
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
 std::pair<std::vector<SamRecord>, std::optional<int>> Importer::ReadSamChunk() {
   RefIdWatcher watcher;
   std::vector<SamRecord> sam_records;
   std::optional<uint64_t> last_pos = std::nullopt;
   if (eof_) {
-    return {sam_records, watcher.get()};
+    return {std::move(sam_records), watcher.get()};
   }
+  SortInputIfNeeded();
   for (int i = 0; i < PHASE2_BUFFER_SIZE; ++i) {
-    if (sam_reader_.Peek() == std::nullopt) {
+    const auto* next = PeekRecord();
+    if (next == nullptr) {
       eof_ = true;
-      return {sam_records, watcher.get()};
+      return {std::move(sam_records), watcher.get()};
     }
-    if (watcher.watch(sam_reader_.Peek()->rid_)) {
-      return {sam_records, watcher.get()};
+    if (watcher.watch(next->rid_)) {
+      return {std::move(sam_records), watcher.get()};
     }
-    sam_records.emplace_back(*sam_reader_.Move());
+    sam_records.emplace_back(NextRecord());
 
     if (!sam_records.back().IsUnmapped()) {
       if (!last_pos.has_value()) {
         last_pos = sam_records.back().pos_;
       }
       UTILS_DIE_IF(last_pos > sam_records.back().pos_,
-                   "SAM file is not sorted");
+                   "SAM file is not sorted although its header says "
+                   "SO:coordinate");
       last_pos = sam_records.back().pos_;
     }
 
@@ -133,15 +174,14 @@ std::pair<std::vector<SamRecord>, std::optional<int>> Importer::ReadSamChunk() {
       sam_records.back().mate_rid_ =
           sam_hdr_to_fasta_lut_.at(sam_records.back().mate_rid_);
     }
-    sam_reader_.Read();
   }
-  return {sam_records, watcher.get()};
+  return {std::move(sam_records), watcher.get()};
 }
 
 std::vector<SamRecordPair> Importer::MatchPairs(
     std::vector<SamRecord>&& records) {
   for (auto& r : records) {
-    sorter_.AddSamRead(r);
+    sorter_.AddSamRead(std::move(r));
   }
   records.clear();
   if (eof_) {
@@ -225,7 +265,9 @@ core::record::Record::Flags GetFlags(const SamRecord& rec) {
   return flags;
 }
 
-Importer::Importer(const size_t block_size, std::string input, std::string ref)
+Importer::Importer(const size_t block_size, std::string input, std::string ref,
+                   const size_t threads, std::string tmp_dir,
+                   const size_t sort_memory)
     : block_size_(block_size),
       input_sam_file_(std::move(input)),
       input_ref_file_(std::move(ref)),
@@ -233,8 +275,11 @@ Importer::Importer(const size_t block_size, std::string input, std::string ref)
       phase1_complete_(false),
       refinf_(input_ref_file_),
       eof_(false),
-      sam_reader_(this->input_sam_file_),
-      sorter_(100000) {
+      sam_reader_(this->input_sam_file_, std::min(threads, kMaxReaderThreads)),
+      sorter_(100000),
+      threads_(threads),
+      tmp_dir_(std::move(tmp_dir)),
+      sort_memory_(sort_memory) {
   refs_ = sam_reader_.GetRefs();
   if (!input_ref_file_.empty()) {
     for (const auto& [fst, snd] : refs_) {
@@ -392,7 +437,10 @@ bool Importer::PumpRetrieve(core::Classifier* classifier) {
       "size-sam-importer-total",
       stats.size_name + stats.size_seq + stats.size_qual);
 
-  classifier->Add(std::move(chunk));
+  {
+    core::stats::StageTimer classify(core::stats::Stage::kClassify);
+    classifier->Add(std::move(chunk));
+  }
   return !eof_;
 }
 
@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "genie/core/format_importer.h"
+#include "genie/format/sam/coordinate_sorter.h"
 #include "genie/format/sam/sam_record.h"
 #include "genie/format/sam/sam_reader.h"
 #include "genie/format/sam/sam_sorter.h"
@@ -143,6 +144,36 @@ class Importer final : public core::FormatImporter {
   /// Sorter for sam records
   SamSorter sorter_;
 
+  /// Threads for decoding and sorting the input
+  size_t threads_;
+
+  /// Directory for the temporary files of the coordinate sort
+  std::string tmp_dir_;
+
+  /// Memory budget of the coordinate sort in bytes, 0 for the default
+  size_t sort_memory_;
+
+  /// Input in coordinate order if the file is not sorted by coordinate
+  std::unique_ptr<CoordinateSorter> coordinate_sorter_;
+
+  /**
+   * @brief Sort the whole input by coordinate through temporary files,
+   * unless the header declares it as coordinate-sorted already
+   */
+  void SortInputIfNeeded();
+
+  /**
+   * @brief Look at the next input record in coordinate order
+   * @return The record, nullptr at the end of the input
+   */
+  const SamRecord* PeekRecord();
+
+  /**
+   * @brief Take the next input record in coordinate order
+   * @return The record
+   */
+  SamRecord NextRecord();
+
   /**
    * Matches all possible sam records into pairs using the sam sorter
    * @param records Unmatched records
@@ -156,8 +187,16 @@ class Importer final : public core::FormatImporter {
    * @param block_size How many records to read in one pump() run
    * @param input Path to the input SAM file
    * @param ref Path to the reference FASTA file
+   * @param threads Pipeline threads, used to sort unsorted input. htslib
+   * decompresses the input on a small pool of its own, at most two threads
+   * @param tmp_dir Directory for temporary files if the input must be sorted,
+   * empty for the current directory
+   * @param sort_memory Memory budget in bytes for sorting the input, 0 for the
+   * default
    */
-  Importer(size_t block_size, std::string input, std::string ref);
+  Importer(size_t block_size, std::string input, std::string ref,
+           size_t threads = 1, std::string tmp_dir = "",
+           size_t sort_memory = 0);
 
   /**
    * @brief Execute phase 1 of the transcoding process which is the conversion
@@ -7,7 +7,9 @@
 
 #include "genie/format/sam/pair_matcher.h"
 
+#include <functional>
 #include <limits>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -19,8 +21,26 @@ namespace genie::format::sam {
 
 // -----------------------------------------------------------------------------
 
-bool CmpMatePos::operator()(const SamRecord& a, const SamRecord& b) const {
-  return a.mate_pos_ > b.mate_pos_;
+bool PairMatcher::Key::operator==(const Key& other) const {
+  return pos == other.pos && mate_pos == other.mate_pos &&
+         name_hash == other.name_hash;
+}
+
+// -----------------------------------------------------------------------------
+
+size_t PairMatcher::KeyHash::operator()(const Key& key) const {
+  size_t ret = key.name_hash;
+  ret ^= std::hash<uint64_t>{}(key.pos) + 0x9e3779b97f4a7c15ULL + (ret << 6) +
+         (ret >> 2);
+  ret ^= std::hash<uint64_t>{}(key.mate_pos) + 0x9e3779b97f4a7c15ULL +
+         (ret << 6) + (ret >> 2);
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+PairMatcher::Key PairMatcher::GetKey(const SamRecord& rec) {
+  return {rec.pos_, rec.mate_pos_, std::hash<std::string>{}(rec.qname_)};
 }
 
 // -----------------------------------------------------------------------------
@@ -36,9 +56,31 @@ void PairMatcher::RemovePosition(const uint64_t pos) {
 
 // -----------------------------------------------------------------------------
 
-void PairMatcher::AddUnmatchedRead(const SamRecord& rec) {
+SamRecord PairMatcher::Release(const size_t slot) {
+  auto& pending = *arena_[slot];
+  by_mate_pos_.erase(pending.by_mate_pos);
+  RemovePosition(pending.record.pos_);
+  SamRecord ret = std::move(pending.record);
+  arena_[slot].reset();
+  free_slots_.push_back(slot);
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+void PairMatcher::AddUnmatchedRead(SamRecord rec) {
+  size_t slot;
+  if (free_slots_.empty()) {
+    slot = arena_.size();
+    arena_.emplace_back();
+  } else {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+  }
   unmatched_positions_[rec.pos_] += 1;
-  unmatched_pairs_.emplace(rec);
+  pending_.emplace(GetKey(rec), slot);
+  const auto by_mate_pos = by_mate_pos_.emplace(rec.mate_pos_, slot);
+  arena_[slot] = Pending{std::move(rec), by_mate_pos};
 }
 
 // -----------------------------------------------------------------------------
@@ -54,10 +96,16 @@ void PairMatcher::AddUnmatchedRead(const SamRecord& rec) {
 
 [[nodiscard]] std::vector<SamRecord> PairMatcher::Abandon(const uint64_t pos) {
   std::vector<SamRecord> abandoned;
-  while (!unmatched_pairs_.empty() && unmatched_pairs_.top().mate_pos_ < pos) {
-    RemovePosition(unmatched_pairs_.top().pos_);
-    abandoned.emplace_back(unmatched_pairs_.top());
-    unmatched_pairs_.pop();
+  while (!by_mate_pos_.empty() && by_mate_pos_.begin()->first < pos) {
+    const auto slot = by_mate_pos_.begin()->second;
+    auto [begin, end] = pending_.equal_range(GetKey(arena_[slot]->record));
+    for (auto it = begin; it != end; ++it) {
+      if (it->second == slot) {
+        pending_.erase(it);
+        break;
+      }
+    }
+    abandoned.emplace_back(Release(slot));
   }
   return abandoned;
 }
@@ -66,29 +114,19 @@ void PairMatcher::AddUnmatchedRead(const SamRecord& rec) {
 
 [[nodiscard]] std::optional<SamRecord> PairMatcher::Match(
     const SamRecord& record) {
-  std::vector<SamRecord> candidate_reads;
-  std::optional<SamRecord> mate = std::nullopt;
-  while (!unmatched_pairs_.empty() &&
-         unmatched_pairs_.top().mate_pos_ == record.pos_) {
-    if (unmatched_pairs_.top().qname_ == record.qname_) {
-      mate = unmatched_pairs_.top();
-      unmatched_pairs_.pop();
-      break;
+  // The mate waits with swapped positions
+  const Key key{record.mate_pos_, record.pos_,
+                std::hash<std::string>{}(record.qname_)};
+  auto [begin, end] = pending_.equal_range(key);
+  for (auto it = begin; it != end; ++it) {
+    // Guard against hash collisions
+    if (arena_[it->second]->record.qname_ == record.qname_) {
+      const auto slot = it->second;
+      pending_.erase(it);
+      return Release(slot);
     }
-    candidate_reads.emplace_back(unmatched_pairs_.top());
-    unmatched_pairs_.pop();
   }
-
-  // Put back any non-matching candidates
-  for (auto& c : candidate_reads) {
-    unmatched_pairs_.emplace(std::move(c));
-  }
-
-  if (mate) {
-    RemovePosition(mate->pos_);
-  }
-
-  return mate;
+  return std::nullopt;
 }
 
 // -----------------------------------------------------------------------------
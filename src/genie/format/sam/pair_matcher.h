@@ -12,7 +12,7 @@
 
 #include <map>
 #include <optional>
-#include <queue>
+#include <unordered_map>
 #include <vector>
 
 #include "genie/format/sam/sam_record.h"
@@ -23,17 +23,65 @@ namespace genie::format::sam {
 
 // -----------------------------------------------------------------------------
 
-struct CmpMatePos {
-  bool operator()(const SamRecord& a, const SamRecord& b) const;
-};
-
 /**
  * @brief Class to match pairs of reads
+ *
+ * Waiting reads are stored in an arena and looked up through a hash table
+ * keyed by position, mate position and read name hash, so matching a read
+ * costs the same no matter how many other reads wait at the same locus.
+ * Records are moved in and out, never copied.
  */
 class PairMatcher {
-  /// Reads waiting for their mate
-  std::priority_queue<SamRecord, std::vector<SamRecord>, CmpMatePos>
-      unmatched_pairs_;
+  /**
+   * @brief Lookup key of a waiting read
+   */
+  struct Key {
+    uint64_t pos;       //!< @brief Position of the waiting read
+    uint64_t mate_pos;  //!< @brief Position of its mate
+    size_t name_hash;   //!< @brief Hash of the read name
+
+    /**
+     * @brief
+     * @param other
+     * @return
+     */
+    bool operator==(const Key& other) const;
+  };
+
+  /**
+   * @brief Hash function for Key
+   */
+  struct KeyHash {
+    /**
+     * @brief
+     * @param key
+     * @return
+     */
+    size_t operator()(const Key& key) const;
+  };
+
+  /// Index of waiting reads by mate position, used to abandon them
+  using MatePosIndex = std::multimap<uint64_t, size_t>;
+
+  /**
+   * @brief A waiting read
+   */
+  struct Pending {
+    SamRecord record;                   //!< @brief The read
+    MatePosIndex::iterator by_mate_pos;  //!< @brief Entry in by_mate_pos_
+  };
+
+  /// Waiting reads. Empty slots are listed in free_slots_ and reused.
+  std::vector<std::optional<Pending>> arena_;
+
+  /// Empty slots of the arena
+  std::vector<size_t> free_slots_;
+
+  /// Arena slots of the waiting reads by key
+  std::unordered_multimap<Key, size_t, KeyHash> pending_;
+
+  /// Arena slots of the waiting reads by mate position
+  MatePosIndex by_mate_pos_;
 
   /// Positions of the incomplete pairs that are waiting
   std::map<uint64_t, uint64_t> unmatched_positions_;
@@ -44,12 +92,26 @@ class PairMatcher {
    */
   void RemovePosition(uint64_t pos);
 
+  /**
+   * @brief Build the lookup key of a waiting read
+   * @param rec Read
+   * @return Key
+   */
+  static Key GetKey(const SamRecord& rec);
+
+  /**
+   * @brief Remove a read from the arena and all indices except pending_
+   * @param slot Arena slot of the read
+   * @return The read
+   */
+  SamRecord Release(size_t slot);
+
  public:
   /**
    * @brief Add a read to the set of unmatched reads
    * @param rec Read to add
    */
-  void AddUnmatchedRead(const SamRecord& rec);
+  void AddUnmatchedRead(SamRecord rec);
 
   /**
    * @brief Get the lowest mapping position of all unmatched reads
@@ -61,7 +123,7 @@ class PairMatcher {
    * @brief Abandon all reads whose mate is mapped before a certain position,
    * i.e. give up on matching them
    * @param pos Position to abandon reads before
-   * @return The abandoned reads
+   * @return The abandoned reads, ordered by mate position
    */
   [[nodiscard]] std::vector<SamRecord> Abandon(uint64_t pos);
 
@@ -10,7 +10,6 @@
 
 // -----------------------------------------------------------------------------
 
-#include <queue>
 #include <vector>
 
 // -----------------------------------------------------------------------------
@@ -28,16 +27,16 @@ namespace genie::format::sam {
  */
 template <typename RecordType, typename CompareFun, typename CompleteFun>
 class RecordQueue {
-  /// A priority queue holding the record objects
-  std::priority_queue<RecordType, std::vector<RecordType>, CompareFun>
-      waiting_records_;
+  /// A binary heap holding the record objects. Kept as a plain vector so
+  /// completed records can be moved out instead of copied.
+  std::vector<RecordType> waiting_records_;
 
  public:
   /**
    * @brief Add a record to the queue.
    * @param rec Record to add
    */
-  void Add(const RecordType& rec);
+  void Add(RecordType rec);
 
   /**
    * @brief Return the records at the beginning of the queue that are already
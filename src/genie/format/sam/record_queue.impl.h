@@ -10,7 +10,10 @@
 
 // -----------------------------------------------------------------------------
 
+#include <algorithm>
+#include <utility>
 #include <vector>
+
 #include "genie/format/sam/record_queue.h"
 
 // -----------------------------------------------------------------------------
@@ -21,8 +24,10 @@ namespace genie::format::sam {
 
 template <typename RecordType, typename CompareFun, typename CompleteFun>
 void RecordQueue<RecordType, CompareFun, CompleteFun>::Add(
-    const RecordType& rec) {
-  waiting_records_.push(rec);
+    RecordType rec) {
+  waiting_records_.push_back(std::move(rec));
+  std::push_heap(waiting_records_.begin(), waiting_records_.end(),
+                 CompareFun());
 }
 
 // -----------------------------------------------------------------------------
@@ -32,9 +37,11 @@ std::vector<RecordType>
 RecordQueue<RecordType, CompareFun, CompleteFun>::CompleteUntil(
     CompleteFun fun) {
   std::vector<RecordType> ret;
-  while (!waiting_records_.empty() && fun(waiting_records_.top())) {
-    ret.push_back(waiting_records_.top());
-    waiting_records_.pop();
+  while (!waiting_records_.empty() && fun(waiting_records_.front())) {
+    std::pop_heap(waiting_records_.begin(), waiting_records_.end(),
+                  CompareFun());
+    ret.push_back(std::move(waiting_records_.back()));
+    waiting_records_.pop_back();
   }
   return ret;
 }
@@ -30,7 +30,7 @@ void SamReader::InternalRead() {
   }
 }
 
-SamReader::SamReader(const std::string& fpath)
+SamReader::SamReader(const std::string& fpath, const size_t threads)
     : sam_file_(nullptr),           // open bam file
       sam_header(nullptr),          // read header
       sam_alignment_(bam_init1()),  // initialize an alignment
@@ -41,6 +41,10 @@ SamReader::SamReader(const std::string& fpath)
     sam_file_ = hts_open(fpath.c_str(), "r");
   }
   UTILS_DIE_IF(!sam_file_, "Could not open file: " + fpath);
+  if (threads > 1) {
+    UTILS_DIE_IF(hts_set_threads(sam_file_, static_cast<int>(threads)) < 0,
+                 "Could not start decoding threads for " + fpath);
+  }
   sam_header = sam_hdr_read(sam_file_);
   UTILS_DIE_IF(!sam_header, "Could not read header from file: " + fpath);
   InternalRead();
@@ -97,6 +101,15 @@ bool SamReader::IsValid() {
 
 // -----------------------------------------------------------------------------
 
+std::string SamReader::GetSortOrder() {
+  if (sam_hdr_find_tag_hd(sam_header, "SO", &header_info) != 0) {
+    return "unknown";
+  }
+  return header_info.s;
+}
+
+// -----------------------------------------------------------------------------
+
 void SamReader::Read() {
   if (buffer_) {
     InternalRead();
@@ -38,10 +38,12 @@ class SamReader {
 
  public:
   /**
-   * @brief
-   * @param fpath
+   * @brief Opens a SAM, BAM or CRAM file.
+   * @param fpath Path, "-.<ext>" for stdin.
+   * @param threads Threads htslib may use to decompress and parse the input,
+   * in addition to the calling thread.
    */
-  explicit SamReader(const std::string& fpath);
+  explicit SamReader(const std::string& fpath, size_t threads = 1);
 
   /**
    * @brief
@@ -66,6 +68,13 @@ class SamReader {
    */
   bool IsValid();
 
+  /**
+   * @brief Sort order declared in the SO tag of the @HD header line
+   * @return "coordinate", "queryname", "unsorted" or "unknown" if no order
+   * is declared
+   */
+  std::string GetSortOrder();
+
   /**
    * @brief
    * @param sr
@@ -10,6 +10,8 @@
 #include "genie/format/sam/sam_record.h"
 
 #include <algorithm>
+#include <array>
+#include <cctype>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -45,27 +47,71 @@ char SamRecord::FourBitBase2Char(const uint8_t int_base) {
 
 // -----------------------------------------------------------------------------
 
-std::string SamRecord::GetCigarString(const bam1_t* sam_alignment) {
-  const auto n_cigar = sam_alignment->core.n_cigar;
+std::vector<uint32_t> SamRecord::GetCigarOps(const bam1_t* sam_alignment) {
   const auto cigar_ptr = bam_get_cigar(sam_alignment);
+  return {cigar_ptr, cigar_ptr + sam_alignment->core.n_cigar};
+}
+
+// -----------------------------------------------------------------------------
 
-  std::string cigar;
-  for (uint32_t i = 0; i < n_cigar; i++) {
-    const char cigar_op = bam_cigar_opchr(bam_cigar_op(cigar_ptr[i]));
-    const auto cigar_op_len = bam_cigar_oplen(cigar_ptr[i]);
-    cigar += std::to_string(cigar_op_len) + cigar_op;
+std::string SamRecord::CigarToString(const std::vector<uint32_t>& cigar) {
+  std::string ret;
+  for (const auto op : cigar) {
+    ret += std::to_string(bam_cigar_oplen(op));
+    ret += bam_cigar_opchr(op);
   }
-  return cigar;
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+std::vector<uint32_t> SamRecord::ParseCigar(const std::string& cigar) {
+  std::vector<uint32_t> ret;
+  if (cigar == "*") {
+    return ret;
+  }
+  static const std::string kOps = BAM_CIGAR_STR;
+  uint32_t length = 0;
+  bool has_length = false;
+  for (const char c : cigar) {
+    if (std::isdigit(c)) {
+      length = length * 10 + static_cast<uint32_t>(c - '0');
+      has_length = true;
+      continue;
+    }
+    const auto op = kOps.find(c);
+    UTILS_DIE_IF(!has_length || op == std::string::npos,
+                 "Invalid CIGAR " + cigar);
+    ret.push_back(bam_cigar_gen(length, static_cast<uint32_t>(op)));
+    length = 0;
+    has_length = false;
+  }
+  UTILS_DIE_IF(has_length, "Invalid CIGAR " + cigar);
+  return ret;
 }
 
 // -----------------------------------------------------------------------------
 
 std::string SamRecord::GetSeqString(const bam1_t* sam_alignment) {
-  const auto seq_len = sam_alignment->core.l_qseq;
+  // Each byte of the packed sequence holds two bases, decode both at once
+  static const auto lut = []() {
+    std::array<std::array<char, 2>, 256> ret{};
+    for (size_t i = 0; i < ret.size(); ++i) {
+      ret[i] = {FourBitBase2Char(static_cast<uint8_t>(i >> 4)),
+                FourBitBase2Char(static_cast<uint8_t>(i & 0xf))};
+    }
+    return ret;
+  }();
+  const auto seq_len = static_cast<size_t>(sam_alignment->core.l_qseq);
   const auto seq_ptr = bam_get_seq(sam_alignment);
   std::string tmp_seq(seq_len, ' ');
-  for (auto i = 0; i < seq_len; i++) {
-    tmp_seq[i] = FourBitBase2Char(bam_seqi(seq_ptr, i));
+  for (size_t i = 0; i + 1 < seq_len; i += 2) {
+    const auto& bases = lut[seq_ptr[i / 2]];
+    tmp_seq[i] = bases[0];
+    tmp_seq[i + 1] = bases[1];
+  }
+  if (seq_len % 2) {
+    tmp_seq[seq_len - 1] = lut[seq_ptr[seq_len / 2]][0];
   }
 
   return tmp_seq;
@@ -127,21 +173,18 @@ int SamRecord::StepSequence(const char token) {
 
 // -----------------------------------------------------------------------------
 
-std::string SamRecord::ConvertCigar2ECigar(const std::string& cigar,
+std::string SamRecord::ConvertCigar2ECigar(const std::vector<uint32_t>& cigar,
                                            const std::string& seq) {
   std::string ecigar;
   constexpr size_t expected_elongation =
       4;  // Additional braces for softclips + hardclips
-  ecigar.reserve(cigar.length() + expected_elongation);
+  ecigar.reserve(cigar.size() * 4 + expected_elongation);
   size_t seq_pos = 0;
-  std::string digits;
-  for (const auto& a : cigar) {
-    if (std::isdigit(a)) {
-      digits += a;
-      continue;
-    }
+  for (const auto op : cigar) {
+    const char a = bam_cigar_opchr(op);
+    const size_t length = bam_cigar_oplen(op);
     if (a == 'X') {
-      const size_t end = std::stoi(digits) + seq_pos;
+      const size_t end = length + seq_pos;
       UTILS_DIE_IF(end > seq.length(), "CIGAR not valid for seq");
       for (; seq_pos < end; ++seq_pos) {
         ecigar += static_cast<char>(std::toupper(seq[seq_pos]));
@@ -153,17 +196,23 @@ std::string SamRecord::ConvertCigar2ECigar(const std::string& cigar,
         ecigar += '[';
       }
       const char token = ConvertCigar2ECigarChar(a);
-      seq_pos += StepSequence(a) * std::stoi(digits);
-      ecigar += digits;
+      seq_pos += StepSequence(a) * length;
+      ecigar += std::to_string(length);
       ecigar += token;
     }
-    digits.clear();
   }
   return ecigar;
 }
 
 // -----------------------------------------------------------------------------
 
+std::string SamRecord::ConvertCigar2ECigar(const std::string& cigar,
+                                           const std::string& seq) {
+  return ConvertCigar2ECigar(ParseCigar(cigar), seq);
+}
+
+// -----------------------------------------------------------------------------
+
 SamRecord::SamRecord()
     : flag_(0), rid_(0), pos_(0), mapq_(0), mate_rid_(0), mate_pos_(0) {}
 
@@ -175,7 +224,7 @@ SamRecord::SamRecord(const bam1_t* sam_alignment)
       rid_(sam_alignment->core.tid),
       pos_(static_cast<uint32_t>(sam_alignment->core.pos)),
       mapq_(sam_alignment->core.qual),
-      cigar_(GetCigarString(sam_alignment)),
+      cigar_(GetCigarOps(sam_alignment)),
       mate_rid_(sam_alignment->core.mtid),
       mate_pos_(static_cast<uint32_t>(sam_alignment->core.mpos)),
       //      tlen(sam_alignment->core.isize),
@@ -211,11 +260,7 @@ uint8_t SamRecord::GetMapq() const { return mapq_; }
 
 // -----------------------------------------------------------------------------
 
-const std::string& SamRecord::GetCigar() const { return cigar_; }
-
-// -----------------------------------------------------------------------------
-
-std::string&& SamRecord::MoveCigar() { return std::move(cigar_); }
+std::string SamRecord::GetCigar() const { return CigarToString(cigar_); }
 
 // -----------------------------------------------------------------------------
 
@@ -361,8 +406,10 @@ bool SamRecord::IsPairOf(const SamRecord& r) const {
 
 void SamRecord::write(std::ostream& os) const {
   os << qname_ << '\t' << flag_ << '\t' << rid_ << '\t' << pos_ << '\t'
-     << static_cast<int>(mapq_) << '\t' << cigar_ << '\t' << mate_rid_ << '\t'
-     << mate_pos_ << '\t' << seq_ << '\t' << qual_;
+     << static_cast<int>(mapq_) << '\t'
+     << (cigar_.empty() ? "*" : CigarToString(cigar_)) << '\t' << mate_rid_
+     << '\t' << mate_pos_ << "\t0\t" << (seq_.empty() ? "*" : seq_) << '\t'
+     << (qual_.empty() ? "*" : qual_);
 
   for (const auto& [tag, value] : optional_fields_) {
     os << '\t' << tag << ':' << value;
@@ -406,11 +453,12 @@ SamRecord::SamRecord(std::ifstream& is)
   rid_ = std::stoi(fields[2]);
   pos_ = static_cast<uint32_t>(std::stoul(fields[3]));
   mapq_ = static_cast<uint8_t>(std::stoi(fields[4]));
-  cigar_ = fields[5];
+  cigar_ = ParseCigar(fields[5]);
   mate_rid_ = std::stoi(fields[6]);
   mate_pos_ = static_cast<uint32_t>(std::stoul(fields[7]));
-  seq_ = fields[9];
-  qual_ = fields[10];
+  // fields[8] is the template length, which is not kept
+  seq_ = fields[9] == "*" ? "" : fields[9];
+  qual_ = fields[10] == "*" ? "" : fields[10];
 
   // Parse optional fields
   for (size_t i = 11; i < fields.size(); ++i) {
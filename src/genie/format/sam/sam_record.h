@@ -36,7 +36,7 @@ class SamRecord {
   int32_t rid_;        //!< @brief Reference sequence ID
   uint32_t pos_;       //!< @brief Position
   uint8_t mapq_;       //!< @brief Mapping Quality
-  std::string cigar_;  //!< @brief CIGAR
+  std::vector<uint32_t> cigar_;  //!< @brief CIGAR in the BAM encoding
   int32_t mate_rid_;   //!< @brief Mate reference sequence ID
   uint32_t mate_pos_;  //!< @brief Mate position
   std::string seq_;    //!< @brief Read sequence
@@ -63,11 +63,25 @@ class SamRecord {
   static char FourBitBase2Char(uint8_t int_base);
 
   /**
-   * @brief
-   * @param sam_alignment
-   * @return
+   * @brief Copies the CIGAR operations of an alignment.
+   * @param sam_alignment Alignment.
+   * @return Operations in the BAM encoding (length << 4 | operation).
+   */
+  static std::vector<uint32_t> GetCigarOps(const bam1_t* sam_alignment);
+
+  /**
+   * @brief Formats CIGAR operations as text, e.g. "10M2I".
+   * @param cigar Operations in the BAM encoding.
+   * @return Text CIGAR, empty if there are no operations.
    */
-  static std::string GetCigarString(const bam1_t* sam_alignment);
+  static std::string CigarToString(const std::vector<uint32_t>& cigar);
+
+  /**
+   * @brief Parses a text CIGAR.
+   * @param cigar Text CIGAR, "*" for none.
+   * @return Operations in the BAM encoding.
+   */
+  static std::vector<uint32_t> ParseCigar(const std::string& cigar);
 
   /**
    * @brief
@@ -97,6 +111,16 @@ class SamRecord {
    */
   static int StepSequence(char token);
 
+  /**
+   * @brief Converts CIGAR operations straight into an MPEG-G extended CIGAR,
+   * without formatting them as text first.
+   * @param cigar Operations in the BAM encoding.
+   * @param seq Read sequence, mismatching bases are copied from it.
+   * @return Extended CIGAR.
+   */
+  static std::string ConvertCigar2ECigar(const std::vector<uint32_t>& cigar,
+                                         const std::string& seq);
+
   /**
    * @brief
    * @param cigar
@@ -155,15 +179,9 @@ class SamRecord {
 
   /**
    * @brief
-   * @return
+   * @return Text CIGAR, formatted on demand.
    */
-  [[nodiscard]] const std::string& GetCigar() const;
-
-  /**
-   * @brief
-   * @return
-   */
-  std::string&& MoveCigar();
+  [[nodiscard]] std::string GetCigar() const;
 
   /**
    * @brief
@@ -328,8 +346,17 @@ class SamRecord {
    */
   [[nodiscard]] bool IsPairOf(const SamRecord& r) const;
 
+  /**
+   * @brief Write the record as one SAM-like text line. Reference ids are
+   * written as numbers and the template length as 0.
+   * @param os Output stream
+   */
   void write(std::ostream& os) const;
 
+  /**
+   * @brief Read a record written by write()
+   * @param is Input stream
+   */
   explicit SamRecord(std::ifstream& is);
 
   void ParseOptionalField(const std::string& field);
@@ -63,13 +63,13 @@ class SamSorter {
    * @brief Process a record that is part of a completely unmapped pair
    * @param rec Record to process
    */
-  void AddUnmappedPair(const SamRecord& rec);
+  void AddUnmappedPair(SamRecord rec);
 
   /**
    * @brief Add a matched pair to the queue and finally output buffer
    * @param cur_query Pair to finish
    */
-  void FinishPair(const SamRecordPair& cur_query);
+  void FinishPair(SamRecordPair cur_query);
 
  public:
   /**
@@ -82,7 +82,7 @@ class SamSorter {
   /**
    * @brief Function for sorting one Record.
    */
-  void AddSamRead(const SamRecord&);
+  void AddSamRead(SamRecord);
 
   /**
    * @brief Function for getting already sorted queries.
@@ -23,21 +23,20 @@ class UnmappedRecordMatcher {
   std::optional<SamRecord> last_record_;
 
  public:
-  [[nodiscard]] std::optional<SamRecordPair> AddSamRead(
-      const SamRecord& record) {
+  [[nodiscard]] std::optional<SamRecordPair> AddSamRead(SamRecord record) {
     constexpr auto kLogModuleName = "SamImporter";
     if (!last_record_) {
-      last_record_ = record;
+      last_record_ = std::move(record);
       return std::nullopt;
     }
     if (last_record_->qname_ == record.qname_) {
-      auto ret = std::pair(std::move(*last_record_), record);
+      auto ret = std::pair(std::move(*last_record_), std::move(record));
       last_record_.reset();
       return ret;
     }
     UTILS_LOG(util::Logger::Severity::WARNING,
               "Unmapped, unsorted record dropped");
-    last_record_ = record;
+    last_record_ = std::move(record);
     return std::nullopt;
   }
 
@@ -38,8 +38,10 @@
 #include "genie/entropy/zstd/encoder.h"
 #include "genie/name/tokenizer/decoder.h"
 #include "genie/name/tokenizer/encoder.h"
-#include "genie/quality/calq//decoder.h"
+#include "genie/quality/calq/decoder.h"
+#include "genie/quality/calq/encoder.h"
 #include "genie/quality/qvwriteout/encoder.h"
+#include "genie/quality/qvwriteout/encoder_none.h"
 #include "genie/read/localassembly/decoder.h"
 #include "genie/read/localassembly/encoder.h"
 #include "genie/read/lowlatency/decoder.h"
@@ -58,7 +60,9 @@ namespace genie::module {
 std::unique_ptr<core::FlowGraphEncode> build_default_encoder(
     size_t threads, const std::string& working_dir, size_t block_size,
     core::ClassifierRegroup::RefMode external_ref, bool raw_ref,
-    bool write_raw_streams, const std::string& entropy_mode) {
+    bool write_raw_streams, const std::string& entropy_mode,
+    const std::string& qv_mode, const int zstd_level,
+    const size_t zstd_dictionary_aus) {
   auto ret = std::make_unique<core::FlowGraphEncode>(threads);
 
   ret->SetClassifier(std::make_unique<core::ClassifierRegroup>(
@@ -75,17 +79,25 @@ std::unique_ptr<core::FlowGraphEncode> build_default_encoder(
   ret->AddReadCoder(std::make_unique<read::spring::Encoder>(
       working_dir, threads, true, write_raw_streams));
   ret->SetReadCoderSelector([](const core::record::Chunk& chunk) -> size_t {
-    if (chunk.GetData().empty()) {
+    if (chunk.Empty()) {
       return 2;
     }
-    if (chunk.GetData().front().GetClassId() ==
-        core::record::ClassType::kClassU) {
-      if (chunk.IsReferenceOnly() ||
-          chunk.GetData().front().GetNumberOfTemplateSegments() !=
-              chunk.GetData().front().GetSegments().size()) {
+    // Look at the batch directly, GetData() would convert it to records
+    const auto& batch = chunk.GetBatch();
+    const bool batched = chunk.IsBatched();
+    const auto class_id = batched ? batch.GetClassId(0)
+                                  : chunk.GetData().front().GetClassId();
+    if (class_id == core::record::ClassType::kClassU) {
+      const auto num_template_segments =
+          batched ? batch.GetNumberOfTemplateSegments(0)
+                  : chunk.GetData().front().GetNumberOfTemplateSegments();
+      const auto num_segments =
+          batched ? batch.GetNumSegments(0)
+                  : chunk.GetData().front().GetSegments().size();
+      if (chunk.IsReferenceOnly() || num_template_segments != num_segments) {
         return 2;
       }
-      if (chunk.GetData().front().GetNumberOfTemplateSegments() > 1) {
+      if (num_template_segments > 1) {
         return 4;
       }
       return 3;
@@ -97,8 +109,20 @@ std::unique_ptr<core::FlowGraphEncode> build_default_encoder(
   });
 
   ret->AddQvCoder(std::make_unique<quality::qvwriteout::Encoder>());
-  ret->SetQvSelector([](const core::record::Chunk&) -> size_t { return 0; });
+  ret->AddQvCoder(std::make_unique<quality::calq::Encoder>());
+  ret->AddQvCoder(std::make_unique<quality::qvwriteout::NoneEncoder>());
+  ret->SetQvSelector([qv_mode](const core::record::Chunk& chunk) -> size_t {
+    if (qv_mode == "none") {
+      return 2;
+    }
+    if (qv_mode == "calq" && quality::calq::Encoder::IsSupported(chunk)) {
+      return 1;
+    }
+    return 0;
+  });
 
+  // Access units are coded in parallel already, so the names of one are
+  // tokenized as a single block on one thread
   ret->AddNameCoder(std::make_unique<name::tokenizer::Encoder>());
   ret->AddNameCoder(std::make_unique<name::write_out::Encoder>());
   ret->SetNameSelector([entropy_mode](const core::record::Chunk&) -> size_t {
@@ -112,8 +136,8 @@ std::unique_ptr<core::FlowGraphEncode> build_default_encoder(
       std::make_unique<entropy::gabac::Encoder>(write_raw_streams));
   ret->AddEntropyCoder(
       std::make_unique<entropy::lzma::Encoder>(write_raw_streams));
-  ret->AddEntropyCoder(
-      std::make_unique<entropy::zstd::Encoder>(write_raw_streams));
+  ret->AddEntropyCoder(std::make_unique<entropy::zstd::Encoder>(
+      write_raw_streams, zstd_level, zstd_dictionary_aus));
   ret->AddEntropyCoder(
       std::make_unique<entropy::bsc::Encoder>(write_raw_streams));
   ret->SetEntropyCoderSelector(
@@ -187,6 +211,7 @@ std::unique_ptr<core::FlowGraphDecode> build_default_decoder(
     return 0;
   });
 
+  // Access units are decoded in parallel already, names within one are not
   ret->AddNameCoder(std::make_unique<name::tokenizer::Decoder>());
   ret->AddNameCoder(std::make_unique<name::write_out::Decoder>());
   ret->SetNameSelector([](const core::AccessUnit::Descriptor& d) -> size_t {
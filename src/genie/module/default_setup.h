@@ -51,12 +51,18 @@ namespace genie::module {
  * @param write_raw_streams Flag indicating if raw streams should be written to
  * output.
  * @param entropy_mode Which entropy mode to use.
+ * @param qv_mode Which quality value mode to use ("lossless", "calq" or
+ * "none"). Access units CALQ cannot handle fall back to lossless coding.
+ * @param zstd_level Compression level of the zstd entropy coder.
+ * @param zstd_dictionary_aus Number of access units per descriptor the zstd
+ * entropy coder trains dictionaries on, 0 to disable dictionaries.
  * @return A unique pointer to the configured `FlowGraphEncode` object.
  */
 std::unique_ptr<core::FlowGraphEncode> build_default_encoder(
     size_t threads, const std::string& working_dir, size_t block_size,
     core::ClassifierRegroup::RefMode external_ref, bool raw_ref,
-    bool write_raw_streams, const std::string& entropy_mode);
+    bool write_raw_streams, const std::string& entropy_mode,
+    const std::string& qv_mode, int zstd_level, size_t zstd_dictionary_aus);
 
 /**
  * @brief Constructs and configures the default decoder setup for Genie
@@ -15,10 +15,14 @@
 
 #include "genie/name/tokenizer/decoder.h"
 
+#include <algorithm>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#include "genie/name/tokenizer/tokenizer.h"
+#include "genie/util/dynamic_scheduler.h"
 #include "genie/util/stop_watch.h"
 
 // -----------------------------------------------------------------------------
@@ -64,72 +68,203 @@ std::string Decoder::inflate(const std::vector<SingleToken>& rec) {
 
 // -----------------------------------------------------------------------------
 
-uint32_t Pull32BigEndian(core::AccessUnit::Subsequence& seq) {
-  uint32_t ret = 0;
-  ret |= seq.Pull() << 24;
-  ret |= seq.Pull() << 16;
-  ret |= seq.Pull() << 8;
-  ret |= seq.Pull();
-  return ret;
+/**
+ * @brief Read position in the tokenizer streams of a descriptor.
+ *
+ * Only reads the subsequences, so several cursors can be used concurrently on
+ * the same descriptor.
+ */
+class TokenCursor {
+  /// Subsequences, indexed by [token position][subsequence].
+  const std::vector<const core::AccessUnit::Subsequence*>* streams_;
+
+  /// Read offsets, indexed by [token position * kSubseqsPerToken + type].
+  std::vector<size_t> offsets_;
+
+ public:
+  /**
+   * @brief Creates a cursor at the start of all streams.
+   * @param streams Subsequences of the descriptor.
+   */
+  explicit TokenCursor(
+      const std::vector<const core::AccessUnit::Subsequence*>& streams)
+      : streams_(&streams), offsets_(streams.size(), 0) {}
+
+  /**
+   * @brief Checks if all names have been read.
+   * @return True if the type stream of the first token position is exhausted.
+   */
+  [[nodiscard]] bool end() const {
+    return streams_->empty() || (*streams_)[kTypeSeq] == nullptr ||
+           offsets_[kTypeSeq] >= (*streams_)[kTypeSeq]->GetNumSymbols();
+  }
+
+  /**
+   * @brief Reads the next symbol of a stream.
+   * @param pos Token position.
+   * @param type Subsequence (kTypeSeq or token type).
+   * @return The symbol.
+   */
+  uint32_t Pull(const uint16_t pos, const uint8_t type) {
+    const size_t index = pos * kSubseqsPerToken + type;
+    UTILS_DIE_IF(index >= streams_->size() || (*streams_)[index] == nullptr ||
+                     offsets_[index] >= (*streams_)[index]->GetNumSymbols(),
+                 "Tried to read token stream that has already ended");
+    return static_cast<uint32_t>((*streams_)[index]->Get(offsets_[index]++));
+  }
+
+  /**
+   * @brief Reads a big endian 32 bit parameter.
+   * @param pos Token position.
+   * @param type Subsequence (token type).
+   * @return The parameter.
+   */
+  uint32_t Pull32BigEndian(const uint16_t pos, const uint8_t type) {
+    uint32_t ret = 0;
+    ret |= (Pull(pos, type) & 0xff) << 24;
+    ret |= (Pull(pos, type) & 0xff) << 16;
+    ret |= (Pull(pos, type) & 0xff) << 8;
+    ret |= Pull(pos, type) & 0xff;
+    return ret;
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Reads the coded tokens of one name.
+ * @param cursor Read position, advanced past the name.
+ * @param rec Receives the tokens, or nullptr to only skip the name.
+ * @return True if the name starts a block, i.e. begins with DIFF 0.
+ */
+bool ReadTokens(TokenCursor& cursor, std::vector<SingleToken>* rec) {
+  if (rec) {
+    rec->clear();
+  }
+  uint16_t cur_pos = 0;
+  bool block_start = false;
+  auto type = static_cast<Tokens>(cursor.Pull(cur_pos, kTypeSeq));
+  while (type != Tokens::END) {
+    uint32_t param = 0;
+    std::string param_string;
+    const auto type_id = static_cast<uint8_t>(type);
+
+    if (type == Tokens::STRING) {
+      auto c = static_cast<char>(cursor.Pull(cur_pos, type_id));
+      while (c != '\0') {
+        if (rec) {
+          param_string += c;
+        }
+        c = static_cast<char>(cursor.Pull(cur_pos, type_id));
+      }
+    } else if (type == Tokens::DIGITS || type == Tokens::DIGITS0 ||
+               type == Tokens::DIFF || type == Tokens::DUP) {
+      param = cursor.Pull32BigEndian(cur_pos, type_id);
+    } else if (type_id < static_cast<uint8_t>(Tokens::MATCH)) {
+      param = cursor.Pull(cur_pos, type_id);
+    }
+
+    if (cur_pos == 0) {
+      // A leading DUP refers to an earlier name as well
+      block_start = type == Tokens::DIFF && param == 0;
+    }
+    if (rec) {
+      rec->emplace_back(type, param, std::move(param_string));
+    }
+
+    cur_pos++;
+    type = static_cast<Tokens>(cursor.Pull(cur_pos, kTypeSeq));
+  }
+  if (rec) {
+    rec->emplace_back(Tokens::END, 0, "");
+  }
+  return block_start;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Decodes a consecutive run of names.
+ * @param cursor Read position of the first name.
+ * @param count Number of names to decode, decodes until the end if zero.
+ * @param inflate Function converting resolved tokens into a name.
+ * @param out Receives the names.
+ */
+template <typename Inflate>
+void DecodeNames(TokenCursor& cursor, const size_t count, Inflate inflate,
+                 std::string* out) {
+  std::vector<SingleToken> old_rec;
+  std::vector<SingleToken> rec;
+  for (size_t i = 0; (count == 0 || i < count) && !cursor.end(); ++i) {
+    if (ReadTokens(cursor, &rec)) {
+      // DIFF 0: no reference to the previous name
+      old_rec.clear();
+    }
+    patch(old_rec, rec);
+    out[i] = inflate(rec);
+    std::swap(old_rec, rec);
+  }
 }
 
 // -----------------------------------------------------------------------------
 
+Decoder::Decoder(const size_t num_threads) : num_threads_(num_threads) {}
+
+// -----------------------------------------------------------------------------
+
 std::tuple<std::vector<std::string>, core::stats::PerfStats> Decoder::Process(
     core::AccessUnit::Descriptor& desc) {
   std::tuple<std::vector<std::string>, core::stats::PerfStats> ret;
-  std::vector<SingleToken> old_rec;
   const util::Watch watch;
-  while (!desc.GetTokenType(0, kTypeSeq).end()) {
-    uint16_t cur_pos = 0;
-
-    std::vector<SingleToken> rec;
-
-    if (std::get<0>(ret).empty()) {
-      UTILS_DIE_IF(static_cast<Tokens>(desc.GetTokenType(0, kTypeSeq).Get()) !=
-                       Tokens::DIFF,
-                   "First token in AU must be DIFF");
-      UTILS_DIE_IF(
-          desc.GetTokenType(0, static_cast<uint8_t>(Tokens::DIFF)).Get() != 0,
-          "First DIFF in AU must be 0");
-    }
+  auto& names = std::get<0>(ret);
 
-    auto type =
-        static_cast<Tokens>(desc.GetTokenType(cur_pos, kTypeSeq).Pull());
-
-    while (type != Tokens::END) {
-      SingleToken t(type, 0, "");
-
-      if (type == Tokens::STRING) {
-        auto c = static_cast<char>(
-            desc.GetTokenType(cur_pos, static_cast<uint8_t>(Tokens::STRING))
-                .Pull());
-        while (c != '\0') {
-          t.param_string += c;
-          c = static_cast<char>(
-              desc.GetTokenType(cur_pos, static_cast<uint8_t>(Tokens::STRING))
-                  .Pull());
-        }
-      } else if (type == Tokens::DIGITS || type == Tokens::DIGITS0) {
-        t.param = Pull32BigEndian(
-            desc.GetTokenType(cur_pos, static_cast<uint8_t>(type)));
-      } else if (static_cast<uint8_t>(type) <
-                 static_cast<uint8_t>(Tokens::MATCH)) {
-        t.param = static_cast<uint32_t>(
-            desc.GetTokenType(cur_pos, static_cast<uint8_t>(type)).Pull());
-      }
+  std::vector<const core::AccessUnit::Subsequence*> streams(desc.GetSize());
+  for (size_t i = 0; i < desc.GetSize(); ++i) {
+    streams[i] = &desc.Get(static_cast<uint16_t>(i));
+  }
 
-      rec.push_back(t);
+  TokenCursor cursor(streams);
+  if (!cursor.end()) {
+    UTILS_DIE_IF(static_cast<Tokens>(desc.GetTokenType(0, kTypeSeq).Get()) !=
+                     Tokens::DIFF,
+                 "First token in AU must be DIFF");
+    UTILS_DIE_IF(
+        desc.GetTokenType(0, static_cast<uint8_t>(Tokens::DIFF)).Get() != 0,
+        "First DIFF in AU must be 0");
+  }
 
-      cur_pos++;
-      type = static_cast<Tokens>(desc.GetTokenType(cur_pos, kTypeSeq).Pull());
+  // Locate the names starting a block (DIFF 0) and count all names
+  std::vector<std::pair<size_t, TokenCursor>> blocks;
+  size_t num_names = 0;
+  while (!cursor.end()) {
+    const TokenCursor start = cursor;
+    if (ReadTokens(cursor, nullptr)) {
+      blocks.emplace_back(num_names, start);
     }
+    ++num_names;
+  }
+  names.resize(num_names);
 
-    rec = patch(old_rec, rec);
-    old_rec = rec;
+  auto decode_block = [&](const size_t block) {
+    const size_t first = blocks[block].first;
+    const size_t last =
+        block + 1 < blocks.size() ? blocks[block + 1].first : num_names;
+    TokenCursor block_cursor = blocks[block].second;
+    DecodeNames(block_cursor, last - first, inflate, names.data() + first);
+  };
 
-    std::get<0>(ret).emplace_back(inflate(rec));
+  if (num_threads_ > 1 && blocks.size() > 1) {
+    util::DynamicScheduler scheduler(std::min(num_threads_, blocks.size()));
+    scheduler.run(blocks.size(),
+                  [&](const util::DynamicScheduler::SchedulerInfo& info) {
+                    decode_block(info.task_id);
+                  });
+  } else {
+    for (size_t block = 0; block < blocks.size(); ++block) {
+      decode_block(block);
+    }
   }
+
   std::get<1>(ret).AddDouble("time-nametokenize", watch.Check());
   return ret;
 }
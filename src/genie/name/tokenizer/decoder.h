@@ -24,6 +24,7 @@
 
 // -----------------------------------------------------------------------------
 
+#include <cstddef>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -45,6 +46,9 @@ namespace genie::name::tokenizer {
  * GENIE library.
  */
 class Decoder final : public core::NameDecoder {
+  /// Number of threads decoding the blocks of one access unit.
+  size_t num_threads_;
+
   /**
    * @brief Converts a list of tokens into a readable string format.
    *
@@ -59,6 +63,18 @@ class Decoder final : public core::NameDecoder {
   static std::string inflate(const std::vector<SingleToken>& rec);
 
  public:
+  /**
+   * @brief Constructs a name decoder.
+   *
+   * Names are tokenized in blocks which start without reference to the
+   * previous name (DIFF 0). With more than one thread, the block boundaries are
+   * located in a first pass over the token streams and the blocks are then
+   * decoded in parallel.
+   *
+   * @param num_threads Number of threads decoding one access unit.
+   */
+  explicit Decoder(size_t num_threads = 1);
+
   /**
    * @brief Processes an encoded descriptor and decodes the names of the
    * records.
@@ -16,9 +16,12 @@
 
 #include "genie/name/tokenizer/encoder.h"
 
+#include <algorithm>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
+#include "genie/util/dynamic_scheduler.h"
 #include "genie/util/stop_watch.h"
 
 // -----------------------------------------------------------------------------
@@ -27,20 +30,57 @@ namespace genie::name::tokenizer {
 
 // -----------------------------------------------------------------------------
 
+Encoder::Encoder(const size_t num_threads, const size_t block_size)
+    : num_threads_(num_threads),
+      block_size_(block_size == 0 && num_threads > 1 ? kDefaultBlockSize
+                                                     : block_size) {}
+
+// -----------------------------------------------------------------------------
+
 std::tuple<core::AccessUnit::Descriptor, core::stats::PerfStats>
 Encoder::Process(const core::record::Chunk& recs) {
   const util::Watch watch;
   std::tuple<core::AccessUnit::Descriptor, core::stats::PerfStats> ret =
       std::make_tuple(core::AccessUnit::Descriptor(core::GenDesc::kReadName),
                       core::stats::PerfStats());
-  std::vector<SingleToken> old;
 
-  for (const auto& r : recs.GetData()) {
-    TokenState state(old, r.GetName());
-    auto new_tok = state.run();
-    TokenState::encode(new_tok, std::get<0>(ret));
-    old = patch(old, new_tok);
+  // Names of a batch are read from its column, GetData() would build records
+  const auto* data = recs.IsBatched() ? nullptr : &recs.GetData();
+  const size_t num_records = recs.Size();
+  auto name = [&](const size_t i) -> std::string_view {
+    return data ? (*data)[i].GetName() : recs.GetBatch().GetName(i);
+  };
+  const size_t block_size =
+      block_size_ ? block_size_ : std::max<size_t>(1, num_records);
+  const size_t num_blocks =
+      std::max<size_t>(1, (num_records + block_size - 1) / block_size);
+  std::vector<TokenColumns> blocks(num_blocks);
+
+  auto tokenize_block = [&](const size_t block) {
+    TokenState state(blocks[block]);
+    const size_t end = std::min(num_records, (block + 1) * block_size);
+    for (size_t i = block * block_size; i < end; ++i) {
+      state.Tokenize(name(i));
+    }
+  };
+
+  if (num_threads_ > 1 && num_blocks > 1) {
+    util::DynamicScheduler scheduler(std::min(num_threads_, num_blocks));
+    scheduler.run(num_blocks,
+                  [&](const util::DynamicScheduler::SchedulerInfo& info) {
+                    tokenize_block(info.task_id);
+                  });
+  } else {
+    for (size_t block = 0; block < num_blocks; ++block) {
+      tokenize_block(block);
+    }
+  }
+
+  for (size_t block = 1; block < num_blocks; ++block) {
+    blocks.front().Append(blocks[block]);
   }
+  blocks.front().Flush(std::get<0>(ret));
+
   std::get<1>(ret).AddDouble("time-nametokenizer", watch.Check());
   return ret;
 }
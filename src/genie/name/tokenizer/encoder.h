@@ -24,6 +24,7 @@
 
 // -----------------------------------------------------------------------------
 
+#include <cstddef>
 #include <tuple>
 
 #include "genie/core/name_encoder.h"
@@ -43,7 +44,34 @@ namespace genie::name::tokenizer {
  * `tokenizer` module of the GENIE library.
  */
 class Encoder final : public core::NameEncoder {
+  /// Number of threads tokenizing the blocks of one access unit.
+  size_t num_threads_;
+
+  /// Number of names per independently tokenized block, 0 for one block per
+  /// access unit.
+  size_t block_size_;
+
  public:
+  /// Number of names per block when tokenizing with several threads.
+  static constexpr size_t kDefaultBlockSize = 16384;
+
+  /**
+   * @brief Constructs a name encoder.
+   *
+   * The names of an access unit are split into blocks of `block_size` names.
+   * Each block starts without reference to the previous name, so blocks can be
+   * tokenized and decoded in parallel. Every block start costs compression, so
+   * a single thread tokenizes the whole access unit as one block unless a
+   * block size is given. For a given block size, the number of threads does
+   * not change the bitstream.
+   *
+   * @param num_threads Number of threads tokenizing one access unit.
+   * @param block_size Number of names per block. 0 selects
+   * `kDefaultBlockSize` for several threads and one block per access unit
+   * otherwise.
+   */
+  explicit Encoder(size_t num_threads = 1, size_t block_size = 0);
+
   /**
    * @brief Processes a chunk of genomic records and encodes their names into
    * tokens.
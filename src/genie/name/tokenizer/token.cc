@@ -64,13 +64,14 @@ const TokenInfo& GetTokenInfo(Tokens t) {
 
 // -----------------------------------------------------------------------------
 
-std::vector<SingleToken> patch(const std::vector<SingleToken>& old_string,
-                               const std::vector<SingleToken>& new_string) {
-  std::vector ret(new_string.size(), SingleToken(Tokens::DUP, 0, ""));
+void patch(const std::vector<SingleToken>& old_string,
+           std::vector<SingleToken>& new_string) {
   if (new_string.front().token == Tokens::DUP) {
     UTILS_DIE_IF(new_string.front().param > 1, "DUP > 1 not supported");
-    UTILS_DIE_IF(new_string.size() > 1, "Found DUP but more than one token");
-    return old_string;
+    UTILS_DIE_IF(new_string.size() > 1 && new_string[1].token != Tokens::END,
+                 "Found DUP but more than one token");
+    new_string = old_string;
+    return;
   }
   if (new_string.front().token != Tokens::DIFF) {
     UTILS_DIE("First token is neither DUP nor DIFF");
@@ -81,7 +82,6 @@ std::vector<SingleToken> patch(const std::vector<SingleToken>& old_string,
                        new_string[i].token == Tokens::DELTA0 ||
                        new_string[i].token == Tokens::MATCH,
                    "Found MATCH/DELTA but no token to match");
-      ret[i] = new_string[i];
       continue;
     }
     switch (new_string[i].token) {
@@ -89,32 +89,30 @@ std::vector<SingleToken> patch(const std::vector<SingleToken>& old_string,
         UTILS_DIE_IF(old_string[i].token == Tokens::DUP ||
                          old_string[i].token == Tokens::DELTA ||
                          old_string[i].token == Tokens::DELTA0 ||
-                         old_string[i].token == Tokens::MATCH ||
                          old_string[i].token == Tokens::MATCH,
                      "Found MATCH but no token to match");
-        ret[i] = old_string[i];
+        new_string[i] = old_string[i];
         break;
       case Tokens::DELTA:
         UTILS_DIE_IF(old_string[i].token != Tokens::DIGITS,
                      "Found DELTA but no digits");
-        ret[i] = SingleToken(Tokens::DIGITS,
-                             old_string[i].param + new_string[i].param, "");
+        new_string[i].token = Tokens::DIGITS;
+        new_string[i].param += old_string[i].param;
         break;
       case Tokens::DELTA0:
         UTILS_DIE_IF(old_string[i].token != Tokens::DIGITS0,
                      "Found DELTA0 but no digits");
-        ret[i] = SingleToken(Tokens::DIGITS0,
-                             old_string[i].param + new_string[i].param, "");
+        new_string[i].token = Tokens::DIGITS0;
+        new_string[i].param += old_string[i].param;
         break;
       case Tokens::DIFF:
       case Tokens::DUP:
-        UTILS_DIE_IF(i != 0,
-                     "Found DIFF or DUP after first token");  // Fall through
+        UTILS_DIE_IF(i != 0, "Found DIFF or DUP after first token");
+        break;
       default:
-        ret[i] = new_string[i];
+        break;
     }
   }
-  return ret;
 }
 
 // -----------------------------------------------------------------------------
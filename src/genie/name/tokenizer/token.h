@@ -159,18 +159,17 @@ struct SingleToken {
 const TokenInfo& GetTokenInfo(Tokens t);
 
 /**
- * @brief Generates a differential patch between two token sequences.
+ * @brief Applies a coded token sequence to the previous token sequence.
  *
- * This function compares an old and a new token sequence and generates a patch
- * representing the changes needed to transform the old sequence into the new
- * one.
+ * This function resolves the references (DUP, MATCH, DELTA, DELTA0) of a coded
+ * token sequence against the tokens of the previous name in place, so that
+ * afterwards the sequence only contains literal tokens.
  *
- * @param old_string The old token sequence.
- * @param new_string The new token sequence.
- * @return A vector of `SingleToken` objects representing the patch.
+ * @param old_string The resolved token sequence of the previous name.
+ * @param new_string The coded token sequence, resolved on return.
  */
-std::vector<SingleToken> patch(const std::vector<SingleToken>& old_string,
-                               const std::vector<SingleToken>& new_string);
+void patch(const std::vector<SingleToken>& old_string,
+           std::vector<SingleToken>& new_string);
 
 // -----------------------------------------------------------------------------
 
@@ -17,8 +17,9 @@
 
 #include "genie/name/tokenizer/tokenizer.h"
 
+#include <cctype>
 #include <limits>
-#include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -30,41 +31,70 @@ namespace genie::name::tokenizer {
 
 // -----------------------------------------------------------------------------
 
-bool TokenState::more() const { return cur_it_ != end_it_; }
+bool TokenView::operator==(const TokenView& t) const {
+  return token == t.token && param == t.param && param_string == t.param_string;
+}
 
 // -----------------------------------------------------------------------------
 
-void TokenState::step() { ++cur_it_; }
+std::vector<uint32_t>& TokenColumns::Get(const uint16_t pos,
+                                         const uint8_t type) {
+  UTILS_DIE_IF(pos > std::numeric_limits<uint16_t>::max() / kSubseqsPerToken,
+               "Too many tokens");
+  if (columns_.size() <= pos) {
+    columns_.resize(pos + 1);
+  }
+  return columns_[pos][type];
+}
 
 // -----------------------------------------------------------------------------
 
-char TokenState::get() const { return *cur_it_; }
+void TokenColumns::Append(const TokenColumns& other) {
+  if (columns_.size() < other.columns_.size()) {
+    columns_.resize(other.columns_.size());
+  }
+  for (size_t pos = 0; pos < other.columns_.size(); ++pos) {
+    for (size_t type = 0; type < kSubseqsPerToken; ++type) {
+      const auto& src = other.columns_[pos][type];
+      auto& dst = columns_[pos][type];
+      dst.insert(dst.end(), src.begin(), src.end());
+    }
+  }
+}
 
 // -----------------------------------------------------------------------------
 
-void TokenState::PushToken(Tokens t, uint32_t param) {
-  cur_rec_.emplace_back(t, param, "");
-  token_pos_++;
+void TokenColumns::Flush(core::AccessUnit::Descriptor& streams) {
+  for (size_t pos = 0; pos < columns_.size(); ++pos) {
+    for (size_t type = 0; type < kSubseqsPerToken; ++type) {
+      auto& column = columns_[pos][type];
+      if (column.empty()) {
+        continue;
+      }
+      streams
+          .GetTokenType(static_cast<uint16_t>(pos), static_cast<uint8_t>(type))
+          .Set(util::DataBlock(&column));
+    }
+  }
+  columns_.clear();
 }
 
 // -----------------------------------------------------------------------------
 
-void TokenState::PushToken(const SingleToken& t) {
-  cur_rec_.emplace_back(t);
-  token_pos_++;
-}
+bool TokenState::more() const { return cur_ < input_.size(); }
 
 // -----------------------------------------------------------------------------
 
-void TokenState::PushTokenString(const std::string& param) {
-  cur_rec_.emplace_back(Tokens::STRING, 0, param);
-  token_pos_++;
-}
+void TokenState::step() { ++cur_; }
 
 // -----------------------------------------------------------------------------
 
-const SingleToken& TokenState::GetOldToken() const {
-  static const SingleToken invalid(Tokens::NONE, 0, "");
+char TokenState::get() const { return input_[cur_]; }
+
+// -----------------------------------------------------------------------------
+
+const TokenView& TokenState::GetOldToken() const {
+  static constexpr TokenView invalid{Tokens::NONE, 0, {}};
   if (old_rec_.size() > token_pos_) {
     return old_rec_[token_pos_];
   }
@@ -73,151 +103,132 @@ const SingleToken& TokenState::GetOldToken() const {
 
 // -----------------------------------------------------------------------------
 
-void TokenState::alphabetic() {
-  SingleToken tok(Tokens::STRING, 0, "");
-  while (more() && isalpha(get())) {
-    tok.param_string += get();
-    step();
+void TokenState::Emit(const Tokens t, const uint32_t param,
+                      const std::string_view param_string) {
+  out_.Get(token_pos_, kTypeSeq).push_back(static_cast<uint8_t>(t));
+  if (const auto param_seq = GetTokenInfo(t).param_seq; param_seq != 0) {
+    auto& column = out_.Get(token_pos_, static_cast<uint8_t>(t));
+    if (t == Tokens::STRING) {
+      for (const auto& c : param_string) {
+        column.push_back(static_cast<uint32_t>(c));
+      }
+      column.push_back('\0');
+    } else if (param_seq == sizeof(uint32_t)) {
+      column.push_back(param >> 24 & 0xff);
+      column.push_back(param >> 16 & 0xff);
+      column.push_back(param >> 8 & 0xff);
+      column.push_back(param & 0xff);
+    } else {
+      column.push_back(param);
+    }
   }
+  token_pos_++;
+}
+
+// -----------------------------------------------------------------------------
+
+void TokenState::PushOrMatch(const TokenView& tok) {
   if (tok == GetOldToken()) {
     // The token is the same as last ID
     // Encode a token_type ID_MATCH
-    PushToken(Tokens::MATCH);
-
+    Emit(Tokens::MATCH, 0);
   } else {
-    PushToken(tok);
+    Emit(tok.token, tok.param, tok.param_string);
   }
+  cur_rec_.push_back(tok);
+}
+
+// -----------------------------------------------------------------------------
+
+void TokenState::alphabetic() {
+  const size_t start = cur_;
+  while (more() && isalpha(static_cast<unsigned char>(get()))) {
+    step();
+  }
+  PushOrMatch({Tokens::STRING, 0, input_.substr(start, cur_ - start)});
 }
 
 // -----------------------------------------------------------------------------
 
 void TokenState::zeros() {
-  SingleToken tok(Tokens::STRING, 0, "");
+  const size_t start = cur_;
   while (more() && get() == '0') {
-    tok.param_string += '0';
     step();
   }
-  if (GetOldToken() == tok) {
-    // The token is the same as last ID
-    // Encode a token_type ID_MATCH
-    PushToken(Tokens::MATCH);
-  } else {
-    PushToken(tok);
-  }
+  PushOrMatch({Tokens::STRING, 0, input_.substr(start, cur_ - start)});
 }
 
 // -----------------------------------------------------------------------------
 
 void TokenState::number() {
   constexpr uint32_t max_number = 1 << 26;  // 8 digits + 1 digit fetched below
-  SingleToken tok(Tokens::DIGITS, 0, "");
-  while (more() && isdigit(get()) && tok.param < max_number) {
+  TokenView tok{Tokens::DIGITS, 0, {}};
+  while (more() && isdigit(static_cast<unsigned char>(get())) &&
+         tok.param < max_number) {
     tok.param *= 10;
     tok.param += get() - '0';
     step();
   }
 
-  const auto delta = tok.param - GetOldToken().param;
-  if (GetOldToken() == tok) {
-    PushToken(Tokens::MATCH);
-  } else if (GetOldToken().token == Tokens::DIGITS &&
-             tok.param > GetOldToken().param &&
+  const auto& old = GetOldToken();
+  const auto delta = tok.param - old.param;
+  if (old == tok) {
+    Emit(Tokens::MATCH, 0);
+  } else if (old.token == Tokens::DIGITS && tok.param > old.param &&
              delta <= std::numeric_limits<uint8_t>::max()) {
-    PushToken(Tokens::DELTA, tok.param - GetOldToken().param);
+    Emit(Tokens::DELTA, delta);
   } else {
-    PushToken(tok);
+    Emit(tok.token, tok.param);
   }
+  cur_rec_.push_back(tok);
 }
 
 // -----------------------------------------------------------------------------
 
 void TokenState::character() {
-  const SingleToken tok(Tokens::CHAR, *cur_it_, "");
+  const TokenView tok{Tokens::CHAR, static_cast<uint32_t>(get()), {}};
   step();
-  if (tok == GetOldToken()) {
-    PushToken(Tokens::MATCH);
-
-  } else {
-    // Encode a token type ID_CHAR and the char
-    PushToken(tok);
-  }
+  PushOrMatch(tok);
 }
 
 // -----------------------------------------------------------------------------
 
-TokenState::TokenState(const std::vector<SingleToken>& old,
-                       const std::string& input)
-    : token_pos_(0),
-      old_rec_(old),
-      cur_it_(input.begin()),
-      end_it_(input.end()) {}
+TokenState::TokenState(TokenColumns& out)
+    : token_pos_(0), cur_(0), out_(out) {}
 
 // -----------------------------------------------------------------------------
 
-std::vector<SingleToken>&& TokenState::run() {
-  if (GetOldToken().token == Tokens::DIFF) {
-    PushToken(Tokens::DIFF, 1);
-  } else {
-    PushToken(Tokens::DIFF, 0);
-  }
+void TokenState::Tokenize(const std::string_view name) {
+  input_ = name;
+  cur_ = 0;
+  token_pos_ = 0;
+  cur_rec_.clear();
+
+  const TokenView diff{
+      Tokens::DIFF, GetOldToken().token == Tokens::DIFF ? 1u : 0u, {}};
+  Emit(diff.token, diff.param);
+  cur_rec_.push_back(diff);
+
   while (more()) {
+    const auto c = static_cast<unsigned char>(get());
     // Check if the token is an alphabetic word
-    if (isalpha(get())) {
+    if (isalpha(c)) {
       alphabetic();
-    } else if (get() == '0') {  // check if the token is a run of zeros
+    } else if (c == '0') {  // check if the token is a run of zeros
       zeros();
-    } else if (isdigit(get())) {  // Check if the token is a number smaller than
-                                  // (1<<29)
+    } else if (isdigit(c)) {  // Check if the token is a number smaller than
+                              // (1<<29)
       number();
     } else {
       character();
     }
   }
 
-  PushToken(Tokens::END);
-  return std::move(cur_rec_);
-}
-
-// -----------------------------------------------------------------------------
-
-void Push32BigEndian(core::AccessUnit::Subsequence& seq, const uint32_t value) {
-  seq.Push(value >> 24 & 0xff);
-  seq.Push(value >> 16 & 0xff);
-  seq.Push(value >> 8 & 0xff);
-  seq.Push(value & 0xff);
-}
-
-// -----------------------------------------------------------------------------
+  Emit(Tokens::END, 0);
+  cur_rec_.push_back({Tokens::END, 0, {}});
 
-void TokenState::encode(const std::vector<SingleToken>& tokens,
-                        core::AccessUnit::Descriptor& streams) {
-  UTILS_DIE_IF(tokens.size() > std::numeric_limits<uint16_t>::max(),
-               "Too many tokens");
-  for (uint16_t i = 0; i < static_cast<uint16_t>(tokens.size()); ++i) {
-    //   while (streams.Size() <= i) {
-    //       streams.emplace_back(getTokenInfo(Tokens::DZLEN).paramSeq + 1,
-    //       util::DataBlock(0, 4));
-    //   }
-    streams.GetTokenType(i, kTypeSeq)
-        .Push(static_cast<uint8_t>(tokens[i].token));
-    if (GetTokenInfo(tokens[i].token).param_seq == 0) {
-      continue;
-    }
-
-    if (tokens[i].token == Tokens::STRING) {
-      for (const auto& c : tokens[i].param_string) {
-        streams.GetTokenType(i, static_cast<uint8_t>(tokens[i].token)).Push(c);
-      }
-      streams.GetTokenType(i, static_cast<uint8_t>(tokens[i].token)).Push('\0');
-    } else if (GetTokenInfo(tokens[i].token).param_seq == sizeof(uint32_t)) {
-      Push32BigEndian(
-          streams.GetTokenType(i, static_cast<uint8_t>(tokens[i].token)),
-          tokens[i].param);
-    } else {
-      streams.GetTokenType(i, static_cast<uint8_t>(tokens[i].token))
-          .Push(tokens[i].param);
-    }
-  }
+  // Keep the tokens of this name as reference, reusing the old buffer
+  std::swap(old_rec_, cur_rec_);
 }
 
 // -----------------------------------------------------------------------------
@@ -15,10 +15,11 @@
  * characters, and zero sequences.
  *
  * @details The `TokenState` class supports various tokenization operations for
- * encoding genomic record names. It tracks the state of the input string, the
- * tokens being generated, and the tokens from previous records for
- * reference-based compression. It also includes static methods for encoding
- * tokens into an `AccessUnit::Descriptor` object.
+ * encoding genomic record names. It tracks the state of the input string and
+ * the tokens of the previous record for reference-based compression, and writes
+ * the generated tokens directly into per token position column buffers
+ * (`TokenColumns`), which are moved into an `AccessUnit::Descriptor` once a
+ * block of names is complete.
  */
 
 #ifndef SRC_GENIE_NAME_TOKENIZER_TOKENIZER_H_
@@ -26,8 +27,9 @@
 
 // -----------------------------------------------------------------------------
 
+#include <array>
 #include <cstdint>
-#include <string>
+#include <string_view>
 #include <vector>
 
 #include "genie/core/access_unit.h"
@@ -38,29 +40,94 @@
 namespace genie::name::tokenizer {
 
 /**
- * @brief Manages the state for tokenizing and encoding genomic record names.
+ * @brief Number of subsequences per token position (type sequence plus one
+ * parameter sequence per token type).
+ */
+constexpr size_t kSubseqsPerToken = 16;
+
+/**
+ * @brief A token referencing the name it was extracted from.
  *
- * The `TokenState` structure is responsible for managing the process of
- * breaking down input strings into individual tokens for genomic name encoding.
- * It supports multiple types of tokens, such as alphabetic characters, numbers,
- * and special sequences, and provides methods to traverse the input string and
- * generate the appropriate tokens.
+ * In contrast to `SingleToken`, string parameters are not copied but kept as
+ * view into the read name, which has to outlive the token.
+ */
+struct TokenView {
+  /// The type of the token.
+  Tokens token;
+
+  /// Optional numeric parameter associated with the token.
+  uint32_t param;
+
+  /// Optional string parameter associated with the token.
+  std::string_view param_string;
+
+  /**
+   * @brief Compares two `TokenView` objects for equality.
+   *
+   * @param t The other `TokenView` to compare with.
+   * @return True if the tokens are equal, false otherwise.
+   */
+  bool operator==(const TokenView& t) const;
+};
+
+/**
+ * @brief Column buffers of the tokenizer streams.
+ *
+ * Holds one buffer per (token position, subsequence) pair, so that encoding a
+ * token is a plain append without any descriptor lookup. Buffers of
+ * independently tokenized blocks can be concatenated in order.
+ */
+class TokenColumns {
+  /// Buffers, indexed by [token position][subsequence].
+  std::vector<std::array<std::vector<uint32_t>, kSubseqsPerToken>> columns_;
+
+ public:
+  /**
+   * @brief Returns the buffer of a subsequence, creating it if necessary.
+   *
+   * @param pos Token position.
+   * @param type Subsequence (kTypeSeq or token type).
+   * @return The column buffer.
+   */
+  std::vector<uint32_t>& Get(uint16_t pos, uint8_t type);
+
+  /**
+   * @brief Appends all buffers of another block behind the buffers of this
+   * block.
+   *
+   * @param other Columns of the following block.
+   */
+  void Append(const TokenColumns& other);
+
+  /**
+   * @brief Moves all buffers into the tokenizer subsequences of a descriptor.
+   *
+   * @param streams The descriptor to store the encoded token streams.
+   */
+  void Flush(core::AccessUnit::Descriptor& streams);
+};
+
+/**
+ * @brief Tokenizes a series of read names against their predecessors.
  */
 class TokenState {
-  /// Current position in the list of old tokens.
-  uint32_t token_pos_;
+  /// Current token position.
+  uint16_t token_pos_;
 
-  /// Reference to the old record's tokens for reference-based compression.
-  const std::vector<SingleToken>& old_rec_;
+  /// Tokens of the previous name, used for reference-based compression.
+  std::vector<TokenView> old_rec_;
 
-  /// List of tokens generated for the current record.
-  std::vector<SingleToken> cur_rec_;
+  /// Tokens of the current name, after resolving matches and deltas.
+  std::vector<TokenView> cur_rec_;
 
-  /// Iterator pointing to the current position in the input string.
-  std::string::const_iterator cur_it_;
+  /// Name currently being tokenized.
+  std::string_view input_;
 
-  /// Iterator pointing to the end of the input string.
-  std::string::const_iterator end_it_;
+  /// Current position in the input string.
+  size_t cur_;
+
+  /// Output streams.
+  TokenColumns& out_;
 
  protected:
   /**
@@ -72,51 +139,41 @@ class TokenState {
   [[nodiscard]] bool more() const;
 
   /**
-   * @brief Advances the iterator to the next character in the input string.
+   * @brief Advances to the next character in the input string.
    */
   void step();
 
   /**
-   * @brief Retrieves the current character pointed to by the iterator.
+   * @brief Retrieves the current character.
    *
    * @return The current character.
    */
   [[nodiscard]] char get() const;
 
   /**
-   * @brief Pushes a new token with a specified type and parameter into the
-   * token list.
-   *
-   * @param t The type of the token.
-   * @param param An optional parameter associated with the token.
-   */
-  void PushToken(Tokens t, uint32_t param = 0);
-
-  /**
-   * @brief Pushes an existing `SingleToken` object into the token list.
+   * @brief Retrieves the old token at the current position for
+   * reference-based encoding.
    *
-   * @param t The token to push.
+   * @return A reference to the old token, or a NONE token if the previous name
+   * was shorter.
    */
-  void PushToken(const SingleToken& t);
+  [[nodiscard]] const TokenView& GetOldToken() const;
 
   /**
-   * @brief Creates a string token from the given parameter and pushes it into
-   * the token list.
+   * @brief Encodes a token, replacing it by MATCH if it equals the old token.
    *
-   * @param param The string value to create a token from.
+   * @param tok The token to encode.
    */
-  void PushTokenString(const std::string& param);
+  void PushOrMatch(const TokenView& tok);
 
   /**
-   * @brief Retrieves the next old token for reference-based encoding.
+   * @brief Writes a token into the output streams.
    *
-   * This function returns the next token from the old record's token list for
-   * reference-based encoding. It advances the internal position pointer after
-   * retrieving the token.
-   *
-   * @return A reference to the next old token.
+   * @param t The token type to write.
+   * @param param Numeric parameter of the token.
+   * @param param_string String parameter of the token.
    */
-  [[nodiscard]] const SingleToken& GetOldToken() const;
+  void Emit(Tokens t, uint32_t param, std::string_view param_string = {});
 
   /**
    * @brief Processes alphabetic characters in the input string.
@@ -152,37 +209,23 @@ class TokenState {
 
  public:
   /**
-   * @brief Constructs a `TokenState` object for the given old tokens and input
-   * string.
+   * @brief Constructs a `TokenState` writing into the given columns.
    *
-   * @param old The list of tokens from the previous record (for reference-based
-   * compression).
-   * @param input The input string to be tokenized.
+   * @param out The column buffers receiving the encoded tokens.
    */
-  TokenState(const std::vector<SingleToken>& old, const std::string& input);
+  explicit TokenState(TokenColumns& out);
 
   /**
-   * @brief Executes the tokenization process and returns the generated tokens.
+   * @brief Tokenizes and encodes one read name.
    *
-   * This function performs the tokenization process on the input string, using
-   * the old tokens for reference-based compression when applicable.
+   * The name is tokenized against the previous name passed to this function.
+   * The first name of a `TokenState` is coded without reference (DIFF 0), so
+   * every `TokenState` produces an independently decodable block. The name
+   * must stay alive until the next name has been tokenized.
    *
-   * @return A list of tokens generated from the input string.
-   */
-  std::vector<SingleToken>&& run();
-
-  /**
-   * @brief Encodes a list of tokens into the specified descriptor streams.
-   *
-   * This static function takes a list of tokens and encodes them into the
-   * specified `core::AccessUnit::Descriptor` object, organizing them into the
-   * appropriate streams.
-   *
-   * @param tokens The list of tokens to encode.
-   * @param streams The descriptor to store the encoded token streams.
+   * @param name The read name.
    */
-  static void encode(const std::vector<SingleToken>& tokens,
-                     core::AccessUnit::Descriptor& streams);
+  void Tokenize(std::string_view name);
 };
 
 // -----------------------------------------------------------------------------
@@ -17,6 +17,7 @@
 
 #include "genie/name/write_out/encoder.h"
 
+#include <string_view>
 #include <tuple>
 #include <utility>
 
@@ -38,11 +39,20 @@ Encoder::Process(const core::record::Chunk& recs) {
   core::AccessUnit::Subsequence sub_seq(
       1, core::GenSubIndex(core::GenDesc::kReadName, 0));
 
-  for (const auto& r : recs.GetData()) {
-    for (auto& c : r.GetName()) {
+  auto push_name = [&sub_seq](const std::string_view name) {
+    for (auto& c : name) {
       sub_seq.Push(c);
     }
     sub_seq.Push('\0');
+  };
+  if (recs.IsBatched()) {
+    for (size_t i = 0; i < recs.GetBatch().Size(); ++i) {
+      push_name(recs.GetBatch().GetName(i));
+    }
+  } else {
+    for (const auto& r : recs.GetData()) {
+      push_name(r.GetName());
+    }
   }
   std::get<0>(ret).Add(std::move(sub_seq));
   std::get<1>(ret).AddDouble("time-namewriteout", watch.Check());
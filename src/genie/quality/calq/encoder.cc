@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -89,6 +90,7 @@ void Encoder::FillCalqStructures(const core::record::Chunk& chunk,
         // create cigar like "x+"
         std::string cigar = std::to_string(qvalues.back().size());
         cigar.append("+");
+        cigars.push_back(std::move(cigar));
       } else {
         auto& s_alignment = dynamic_cast<
             core::record::alignment_split::SameRec&>(
@@ -158,16 +160,14 @@ void Encoder::EncodeAligned(const core::record::Chunk& chunk,
 
 // -----------------------------------------------------------------------------
 
-void Encoder::AddQualities(const core::record::Segment& s,
+void Encoder::AddQualities(const std::string_view qualities,
                            core::AccessUnit::Descriptor& desc,
                            const util::UniformMinMaxQuantizer& quantizer) {
   auto& subsequence = desc.Get(static_cast<uint16_t>(desc.GetSize()) - 1);
 
-  for (const auto& q : s.GetQualities()) {
-    for (const auto& c : q) {
-      const auto index = static_cast<uint8_t>(quantizer.ValueToIndex(c));
-      subsequence.Push(index);
-    }
+  for (const auto& c : qualities) {
+    const auto index = static_cast<uint8_t>(quantizer.ValueToIndex(c));
+    subsequence.Push(index);
   }
 }
 
@@ -195,11 +195,70 @@ void Encoder::EncodeUnaligned(const core::record::Chunk& chunk,
   desc.Add(core::AccessUnit::Subsequence(1, core::gen_sub::kQvSteps0));
 
   // encode values
+  if (chunk.IsBatched()) {
+    const auto& batch = chunk.GetBatch();
+    for (size_t s = 0; s < batch.GetNumSegments(); ++s) {
+      AddQualities(batch.GetQualities(s), desc, quantizer);
+    }
+    return;
+  }
   for (const auto& rec : chunk.GetData()) {
     for (const auto& seg : rec.GetSegments()) {
-      AddQualities(seg, desc, quantizer);
+      for (const auto& q : seg.GetQualities()) {
+        AddQualities(q, desc, quantizer);
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+bool Encoder::IsSupported(const core::record::Chunk& chunk) {
+  if (chunk.IsBatched()) {
+    // Batches come from unaligned reads with one quality string per segment
+    const auto& batch = chunk.GetBatch();
+    for (size_t r = 0; r < batch.Size(); ++r) {
+      if (batch.GetNumSegments(r) > 2) {
+        return false;
+      }
+    }
+    for (size_t s = 0; s < batch.GetNumSegments(); ++s) {
+      if (batch.GetQualities(s).empty() ||
+          batch.GetQualities(s).size() != batch.GetSequence(s).size()) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (chunk.GetData().empty()) {
+    return false;
+  }
+  const bool unaligned =
+      chunk.GetData().front().GetClassId() == ClassType::kClassU;
+  for (const auto& rec : chunk.GetData()) {
+    if (rec.GetSegments().empty() || rec.GetSegments().size() > 2) {
+      return false;
+    }
+    for (const auto& seg : rec.GetSegments()) {
+      if (seg.GetQualities().size() != 1 ||
+          seg.GetQualities().front().size() != seg.GetSequence().size()) {
+        return false;
+      }
+    }
+    if (unaligned) {
+      continue;
+    }
+    if (rec.GetAlignments().empty()) {
+      return false;
+    }
+    if (rec.GetSegments().size() == 2 &&
+        (rec.GetAlignments().front().GetAlignmentSplits().empty() ||
+         rec.GetAlignments().front().GetAlignmentSplits().front()->GetType() !=
+             core::record::AlignmentSplit::Type::kSameRec)) {
+      return false;
     }
   }
+  return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -210,7 +269,9 @@ core::QvEncoder::qv_coded Encoder::Process(const core::record::Chunk& chunk) {
       paramqv1::QualityValues1::QualityParametersPresetId::ASCII, false);
   core::AccessUnit::Descriptor desc(core::GenDesc::kQv);
 
-  if (const ClassType& class_type = chunk.GetData()[0].GetClassId();
+  if (const ClassType class_type = chunk.IsBatched()
+                                       ? chunk.GetBatch().GetClassId(0)
+                                       : chunk.GetData()[0].GetClassId();
       class_type == ClassType::kClassU) {
     EncodeUnaligned(chunk, *param, desc);
   } else {
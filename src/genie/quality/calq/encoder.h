@@ -25,6 +25,8 @@
 
 // -----------------------------------------------------------------------------
 
+#include <string_view>
+
 #include "genie/core/qv_encoder.h"
 #include "genie/quality/calq/calq_coder.h"
 #include "genie/util/uniform_min_max_quantizer.h"
@@ -80,14 +82,14 @@ class Encoder final : public core::QvEncoder {
   /**
    * @brief Adds the quality values of a segment to the access unit descriptor.
    *
-   * This method extracts the quality values of a given segment and uses the
-   * provided quantizer to Compress and add them to the access unit descriptor.
+   * This method uses the provided quantizer to Compress the quality values of
+   * a segment and adds them to the access unit descriptor.
    *
-   * @param s The segment whose quality values are to be added.
+   * @param qualities The quality values of the segment.
    * @param desc The access unit descriptor to store the encoded values.
    * @param quantizer The quantizer used to Compress the quality values.
    */
-  static void AddQualities(const core::record::Segment& s,
+  static void AddQualities(std::string_view qualities,
                            core::AccessUnit::Descriptor& desc,
                            const util::UniformMinMaxQuantizer& quantizer);
 
@@ -108,6 +110,18 @@ class Encoder final : public core::QvEncoder {
                               core::AccessUnit::Descriptor& desc);
 
  public:
+  /**
+   * @brief Checks whether CALQ can encode the quality values of a chunk.
+   *
+   * CALQ needs exactly one quality string per segment, matching the sequence
+   * length, and paired aligned records must be stored in the same record.
+   * Chunks failing these checks have to be coded losslessly instead.
+   *
+   * @param chunk The input chunk containing genomic records to encode.
+   * @return True if the chunk can be passed to Process().
+   */
+  static bool IsSupported(const core::record::Chunk& chunk);
+
   /**
    * @brief Processes the input chunk and encodes the quality values.
    *
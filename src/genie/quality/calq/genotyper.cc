@@ -24,9 +24,8 @@
 
 // -----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <iomanip>
-#include <map>
-#include <numeric>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -77,7 +76,7 @@ static int CombinationsWithRepetitions(  // NOLINT
 
 Genotyper::Genotyper(const int polyploidy, const int qual_offset,
                      const int nr_quantizers, const bool debug)
-    : current_allele_alphabet_(allele_alphabet_),
+    : num_genotypes_(0),
       nr_quantizers_(nr_quantizers),
       polyploidy_(polyploidy),
       qual_offset_(qual_offset),
@@ -111,11 +110,10 @@ double Genotyper::ComputeEntropy(const std::string& seq_pileup,
 
   ComputeGenotypeLikelihoods(seq_pileup, qual_pileup, depth);
 
-  const double entropy = std::accumulate(
-      genotype_likelihoods_.begin(), genotype_likelihoods_.end(), 0.0,
-      [](const double& a, const std::pair<std::string, double>& b) {
-        return a - b.second * log(b.second);
-      });
+  double entropy = 0.0;
+  for (const double p : genotype_likelihoods_) {
+    entropy -= p * log(p);
+  }
 
   return entropy;
 }
@@ -140,13 +138,13 @@ int Genotyper::ComputeQuantizerIndex(const std::string& seq_pileup,
 
   double largest_genotype_likelihood = 0.0;
   double second_largest_genotype_likelihood = 0.0;
-  for (const auto& [fst, snd] : genotype_likelihoods_) {
-    if (snd > second_largest_genotype_likelihood) {
-      second_largest_genotype_likelihood = snd;
+  for (const double likelihood : genotype_likelihoods_) {
+    if (likelihood > second_largest_genotype_likelihood) {
+      second_largest_genotype_likelihood = likelihood;
     }
     if (second_largest_genotype_likelihood > largest_genotype_likelihood) {
       second_largest_genotype_likelihood = largest_genotype_likelihood;
-      largest_genotype_likelihood = snd;
+      largest_genotype_likelihood = likelihood;
     }
   }
 
@@ -173,34 +171,71 @@ int Genotyper::ComputeQuantizerIndex(const std::string& seq_pileup,
 
 // -----------------------------------------------------------------------------
 
-void Genotyper::InitLikelihoods() {
-  // Initialize map containing the allele likelihoods
-  for (const auto& allele : current_allele_alphabet_) {
-    allele_likelihoods_.insert(std::pair(allele, 0.0));
+size_t Genotyper::AlleleCount(const size_t genotype, const char allele) const {
+  const uint8_t a = allele_index_[static_cast<uint8_t>(allele)];
+  if (a == kUnknownAllele) {
+    return 0;
   }
+  return genotype_allele_counts_[genotype * allele_alphabet_size_ + a];
+}
 
-  // Initialize map containing the genotype likelihoods
-  std::vector chosen(polyploidy_, 0);
-  CombinationsWithRepetitions(&genotype_alphabet_, current_allele_alphabet_,
-                              chosen.data(), 0, polyploidy_, 0,
-                              allele_alphabet_size_);
+// -----------------------------------------------------------------------------
 
-  // Initialize genotype alphabet
-  for (auto& genotype : genotype_alphabet_) {
-    genotype_likelihoods_.insert(std::pair(genotype, 0.0));
+void Genotyper::InitLikelihoods() {
+  allele_index_.fill(kUnknownAllele);
+  for (size_t a = 0; a < allele_alphabet_size_; ++a) {
+    allele_index_[static_cast<uint8_t>(allele_alphabet_[a])] =
+        static_cast<uint8_t>(a);
   }
-}
 
-// -----------------------------------------------------------------------------
+  // Enumerate the genotypes in lexicographic order
+  std::vector<std::string> genotype_alphabet;
+  const std::vector<char> alleles(allele_alphabet_.begin(),
+                                  allele_alphabet_.end());
+  std::vector chosen(polyploidy_, 0);
+  CombinationsWithRepetitions(&genotype_alphabet, alleles, chosen.data(), 0,
+                              polyploidy_, 0, allele_alphabet_size_);
+  num_genotypes_ = genotype_alphabet.size();
+
+  genotype_allele_counts_.assign(num_genotypes_ * allele_alphabet_size_, 0);
+  for (size_t g = 0; g < num_genotypes_; ++g) {
+    for (const char allele : genotype_alphabet[g]) {
+      ++genotype_allele_counts_[g * allele_alphabet_size_ +
+                                allele_index_[static_cast<uint8_t>(allele)]];
+    }
+  }
 
-void Genotyper::ResetLikelihoods() {
-  for (auto& [fst, snd] : genotype_likelihoods_) {
-    snd = 0.0;
+  // The likelihood of an observation only depends on how many alleles of the
+  // genotype match it, so one log() per (phred, match count) is enough
+  std::vector<double> log_p((kMaxPhred + 1) * (polyploidy_ + 1));
+  for (size_t q = 0; q <= kMaxPhred; ++q) {
+    const double p_strike = 1 - pow(10.0, -static_cast<double>(q) / 10.0);
+    const double p_error = (1 - p_strike) / (allele_alphabet_size_ - 1);
+    for (int matches = 0; matches <= polyploidy_; ++matches) {
+      const double p =
+          (matches * p_strike + (polyploidy_ - matches) * p_error) /
+          polyploidy_;
+      log_p[q * (polyploidy_ + 1) + matches] = log(p);
+    }
   }
 
-  for (auto& [fst, snd] : allele_likelihoods_) {
-    snd = 0.0;
+  log_likelihood_lut_.assign(
+      (allele_alphabet_size_ + 1) * (kMaxPhred + 1) * num_genotypes_, 0.0);
+  for (size_t obs = 0; obs <= allele_alphabet_size_; ++obs) {
+    for (size_t q = 0; q <= kMaxPhred; ++q) {
+      double* row =
+          &log_likelihood_lut_[(obs * (kMaxPhred + 1) + q) * num_genotypes_];
+      for (size_t g = 0; g < num_genotypes_; ++g) {
+        const size_t matches =
+            obs == kUnknownAllele
+                ? 0
+                : genotype_allele_counts_[g * allele_alphabet_size_ + obs];
+        row[g] = log_p[q * (polyploidy_ + 1) + matches];
+      }
+    }
   }
+
+  genotype_likelihoods_.assign(num_genotypes_, 0.0);
 }
 
 // -----------------------------------------------------------------------------
@@ -208,50 +243,39 @@ void Genotyper::ResetLikelihoods() {
 void Genotyper::ComputeGenotypeLikelihoods(const std::string& seq_pileup,
                                            const std::string& qual_pileup,
                                            const size_t& depth) {
-  ResetLikelihoods();
+  // We are using the Log likelihood to avoid numerical problems
+  double* likelihoods = genotype_likelihoods_.data();
+  const size_t num_genotypes = num_genotypes_;
+  std::fill(likelihoods, likelihoods + num_genotypes, 0.0);
 
-  auto* temp_genotype_likelihoods =
-      static_cast<double*>(calloc(genotype_alphabet_.size(), sizeof(double)));
-  int itr = 0;
   for (size_t d = 0; d < depth; d++) {
-    const auto y = static_cast<char>(seq_pileup[d]);
-    const auto q = static_cast<double>(qual_pileup[d] - qual_offset_);
-
-    double p_strike = 1 - pow(10.0, -q / 10.0);
-    double p_error = (1 - p_strike) / (allele_alphabet_size_ - 1);
-
-    itr = 0;
-    for (const auto& genotype : genotype_alphabet_) {
-      double p = 0.0;
-      for (int i = 0; i < polyploidy_; i++) {
-        p += y == genotype[i] ? p_strike : p_error;
-      }
-      p /= polyploidy_;
-
-      // We are using the Log likelihood to avoid numerical problems
-      temp_genotype_likelihoods[itr++] += log(p);
+    const uint8_t obs = allele_index_[static_cast<uint8_t>(seq_pileup[d])];
+    const int q = std::clamp(qual_pileup[d] - qual_offset_, 0,
+                             static_cast<int>(kMaxPhred));
+    const double* row =
+        &log_likelihood_lut_[(obs * (kMaxPhred + 1) + q) * num_genotypes];
+    for (size_t g = 0; g < num_genotypes; ++g) {
+      likelihoods[g] += row[g];
     }
   }
-  itr = 0;
-  for (const auto& genotype : genotype_alphabet_) {
-    genotype_likelihoods_[genotype] = temp_genotype_likelihoods[itr++];
-  }
-  free(temp_genotype_likelihoods);
 
-  // Normalize the genotype likelihoods
+  // Normalize the genotype likelihoods, shifting by the maximum first so that
+  // deep pileups do not underflow
+  const double max_likelihood =
+      *std::max_element(likelihoods, likelihoods + num_genotypes);
   double cum = 0.0;
-  for (auto& [fst, snd] : genotype_likelihoods_) {
-    snd = exp(snd);
-    cum += snd;
+  for (size_t g = 0; g < num_genotypes; ++g) {
+    likelihoods[g] = exp(likelihoods[g] - max_likelihood);
+    cum += likelihoods[g];
   }
-  for (auto& [fst, snd] : genotype_likelihoods_) {
-    snd /= cum;
+  for (size_t g = 0; g < num_genotypes; ++g) {
+    likelihoods[g] /= cum;
   }
 }
 
 // -----------------------------------------------------------------------------
 
-const std::map<std::string, double>& Genotyper::GetGenotypelikelihoods(
+const std::vector<double>& Genotyper::GetGenotypelikelihoods(
     const std::string& seq_pileup, const std::string& qual_pileup) {
   ComputeGenotypeLikelihoods(seq_pileup, qual_pileup, qual_pileup.size());
   return genotype_likelihoods_;
@@ -25,7 +25,8 @@
 
 // -----------------------------------------------------------------------------
 
-#include <map>
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -97,42 +98,43 @@ class Genotyper {
   /**
    * @brief Retrieves the computed genotype likelihoods for a given pileup.
    *
-   * This method returns a map of genotype strings to their associated
-   * likelihood values based on the input sequence and quality value pileup.
+   * This method returns the normalized likelihood of every genotype based on
+   * the input sequence and quality value pileup. The vector is indexed by
+   * genotype index, see AlleleCount() to inspect a genotype.
    *
    * @param seq_pileup The sequence pileup represented as a string.
    * @param qual_pileup The corresponding quality value pileup represented as a
    * string.
-   * @return A map of genotype strings to their likelihood values.
+   * @return The likelihood of each genotype, indexed by genotype index.
    */
-  const std::map<std::string, double>& GetGenotypelikelihoods(
+  const std::vector<double>& GetGenotypelikelihoods(
       const std::string& seq_pileup, const std::string& qual_pileup);
 
- private:
   /**
-   * @brief Initializes the likelihood maps for alleles and genotypes.
+   * @brief Returns how often an allele occurs in a genotype.
    *
-   * This method sets up the internal data structures for storing allele and
-   * genotype likelihoods based on the allele alphabet and ploidy
-   * configuration.
+   * @param genotype Index of the genotype.
+   * @param allele Allele character, anything but A, C, G, T yields zero.
+   * @return Number of copies of the allele in the genotype.
    */
-  void InitLikelihoods();
+  [[nodiscard]] size_t AlleleCount(size_t genotype, char allele) const;
 
+ private:
   /**
-   * @brief Resets the likelihood values to their initial states.
+   * @brief Builds the genotype index tables and the likelihood lookup table.
    *
-   * This method clears the current likelihood values and resets them
-   * to a neutral state for the next calculation.
+   * Enumerates all genotypes for the configured ploidy, stores the allele
+   * counts of every genotype and precomputes the log likelihood contribution
+   * of each (observed allele, Phred score, genotype) triple.
    */
-  void ResetLikelihoods();
+  void InitLikelihoods();
 
   /**
    * @brief Computes the genotype likelihoods for the given sequence and
    * quality value pileup.
    *
-   * This method calculates the likelihood of each possible genotype based on
-   * the input sequence and quality value pileup. It considers the depth
-   * (length) of the pileup.
+   * Accumulates the precomputed log likelihood rows of all observations and
+   * normalizes the result into genotype_likelihoods_.
    *
    * @param seq_pileup The sequence pileup represented as a string.
    * @param qual_pileup The corresponding quality value pileup represented as a
@@ -145,22 +147,31 @@ class Genotyper {
                                   const size_t& depth);
 
   /// The alphabet of valid alleles.
-  const std::vector<char> allele_alphabet_ = {'A', 'C', 'G', 'T'};
+  static constexpr std::array<char, 4> allele_alphabet_ = {'A', 'C', 'G', 'T'};
 
   /// The Size of the allele alphabet.
   static constexpr size_t allele_alphabet_size_ = 4;
 
-  /// The active allele alphabet.
-  const std::vector<char> current_allele_alphabet_;
+  /// Observation index used for bases outside of the allele alphabet.
+  static constexpr uint8_t kUnknownAllele = allele_alphabet_size_;
+
+  /// Highest Phred score in the lookup table, larger scores are clamped.
+  static constexpr size_t kMaxPhred = 93;
+
+  /// Maps a base character to its observation index.
+  std::array<uint8_t, 256> allele_index_{};
+
+  /// Number of genotypes for the configured ploidy.
+  size_t num_genotypes_;
 
-  /// Map of alleles to their likelihood values.
-  std::map<char, double> allele_likelihoods_;
+  /// Allele counts per genotype, indexed by [genotype][allele].
+  std::vector<uint8_t> genotype_allele_counts_;
 
-  /// List of possible genotypes.
-  std::vector<std::string> genotype_alphabet_;
+  /// Log likelihoods, indexed by [observation][phred][genotype].
+  std::vector<double> log_likelihood_lut_;
 
-  /// Map of genotypes to their likelihood values.
-  std::map<std::string, double> genotype_likelihoods_;
+  /// Genotype likelihoods of the last pileup, indexed by genotype.
+  std::vector<double> genotype_likelihoods_;
 
   /// Number of quantizers available.
   const int nr_quantizers_;
@@ -23,7 +23,6 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
-#include <map>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -121,13 +120,12 @@ std::vector<double> Haplotyper::CalcNonRefLikelihoods(
     const char ref, const std::string& seq_pile,
     const std::string& quality_pile) {
   std::vector result(polyploidy_ + 1, 0.0);
-  const std::map<std::string, double> snp_likelihoods =
+  const std::vector<double>& snp_likelihoods =
       genotyper_.GetGenotypelikelihoods(seq_pile, quality_pile);
 
-  for (const auto& [fst, snd] : snp_likelihoods) {
-    const size_t alt_count =
-        polyploidy_ - std::count(fst.begin(), fst.end(), ref);
-    result[alt_count] += snd;
+  for (size_t g = 0; g < snp_likelihoods.size(); ++g) {
+    const size_t alt_count = polyploidy_ - genotyper_.AlleleCount(g, ref);
+    result[alt_count] += snp_likelihoods[g];
   }
 
   for (double& i : result) {
@@ -111,6 +111,9 @@ void QualityDecoder::DecodeMappedRecordFromBlock(
         }
         break;
       case '-':
+      case '*':
+      case '/':
+      case '%':
         quality_value_pos += op_len;
         break;  // do nothing as these bases are not present
       case ']':
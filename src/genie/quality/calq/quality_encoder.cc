@@ -180,6 +180,9 @@ void QualityEncoder::EncodeMappedQuality(const std::string& quality_values,
         }
         break;
       case '-':
+      case '*':
+      case '/':
+      case '%':
         quantizer_indices_idx += op_len;
         break;  // do nothing as these bases are not present
       case ']':
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "genie/core/cigar_tokenizer.h"
@@ -42,8 +43,11 @@ void Encoder::SetUpParameters(const core::record::Chunk& rec,
   desc.Add(core::AccessUnit::Subsequence(1, core::gen_sub::kQvPresent));
   desc.Add(core::AccessUnit::Subsequence(1, core::gen_sub::kQvCodebook));
   desc.Add(core::AccessUnit::Subsequence(1, core::gen_sub::kQvSteps0));
-  if (rec.GetData().front().GetClassId() == core::record::ClassType::kClassI ||
-      rec.GetData().front().GetClassId() == core::record::ClassType::kClassHm) {
+  const auto class_id = rec.IsBatched()
+                            ? rec.GetBatch().GetClassId(0)
+                            : rec.GetData().front().GetClassId();
+  if (class_id == core::record::ClassType::kClassI ||
+      class_id == core::record::ClassType::kClassHm) {
     desc.Add(core::AccessUnit::Subsequence(1, core::gen_sub::kQvSteps1));
 
     codebook = paramqv1::QualityValues1::GetPresetCodebook(
@@ -56,27 +60,45 @@ void Encoder::SetUpParameters(const core::record::Chunk& rec,
 
 // -----------------------------------------------------------------------------
 
+void Encoder::EncodeAlignedQualities(const std::string_view q,
+                                     const std::string& e_cigar,
+                                     core::AccessUnit::Descriptor& desc) {
+  core::CigarTokenizer::Tokenize(
+      e_cigar, core::GetECigarInfo(),
+      [&desc, &q](const uint8_t cigar, const std::pair<size_t, size_t>& bs,
+                  const std::pair<size_t, size_t>&) -> bool {
+        const auto qvs = q.substr(bs.first, bs.second);
+        const uint8_t codebook =
+            core::GetECigarInfo().lut_step_ref[cigar] ||
+                    GetAlphabetProperties(core::AlphabetId::kAcgtn)
+                        .IsIncluded(static_cast<char>(cigar))
+                ? 2
+                : static_cast<uint8_t>(desc.GetSize()) - 1;
+        for (const auto& c : qvs) {
+          UTILS_DIE_IF(c < 33 || c > 126, "Invalid quality score");
+          desc.Get(codebook).Push(c - 33);
+        }
+        return true;
+      });
+}
+
+// -----------------------------------------------------------------------------
+
+void Encoder::EncodeUnalignedQualities(const std::string_view q,
+                                       core::AccessUnit::Descriptor& desc) {
+  for (const auto& c : q) {
+    UTILS_DIE_IF(c < 33 || c > 126, "Invalid quality score");
+    desc.Get(static_cast<uint16_t>(desc.GetSize()) - 1).Push(c - 33);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 void Encoder::EncodeAlignedSegment(const core::record::Segment& s,
                                    const std::string& e_cigar,
                                    core::AccessUnit::Descriptor& desc) {
   for (const auto& q : s.GetQualities()) {
-    core::CigarTokenizer::Tokenize(
-        e_cigar, core::GetECigarInfo(),
-        [&desc, &q](const uint8_t cigar, const std::pair<size_t, size_t>& bs,
-                    const std::pair<size_t, size_t>&) -> bool {
-          const auto qvs = std::string_view(q).substr(bs.first, bs.second);
-          const uint8_t codebook =
-              core::GetECigarInfo().lut_step_ref[cigar] ||
-                      GetAlphabetProperties(core::AlphabetId::kAcgtn)
-                          .IsIncluded(static_cast<char>(cigar))
-                  ? 2
-                  : static_cast<uint8_t>(desc.GetSize()) - 1;
-          for (const auto& c : qvs) {
-            UTILS_DIE_IF(c < 33 || c > 126, "Invalid quality score");
-            desc.Get(codebook).Push(c - 33);
-          }
-          return true;
-        });
+    EncodeAlignedQualities(q, e_cigar, desc);
   }
 }
 
@@ -85,9 +107,26 @@ void Encoder::EncodeAlignedSegment(const core::record::Segment& s,
 void Encoder::EncodeUnalignedSegment(const core::record::Segment& s,
                                      core::AccessUnit::Descriptor& desc) {
   for (const auto& q : s.GetQualities()) {
-    for (const auto& c : q) {
-      UTILS_DIE_IF(c < 33 || c > 126, "Invalid quality score");
-      desc.Get(static_cast<uint16_t>(desc.GetSize()) - 1).Push(c - 33);
+    EncodeUnalignedQualities(q, desc);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void Encoder::EncodeBatch(const core::record::RecordBatch& batch,
+                          core::AccessUnit::Descriptor& desc) {
+  // Batches hold at most the alignment of the first segment, further
+  // segments are unaligned
+  for (size_t r = 0; r < batch.Size(); ++r) {
+    const auto first = batch.GetFirstSegment(r);
+    for (size_t s = first; s < first + batch.GetNumSegments(r); ++s) {
+      if (s == first &&
+          batch.GetPosition(r) != core::record::RecordBatch::kUnmapped) {
+        EncodeAlignedQualities(batch.GetQualities(s),
+                               std::string(batch.GetECigar(r)), desc);
+      } else {
+        EncodeUnalignedQualities(batch.GetQualities(s), desc);
+      }
     }
   }
 }
@@ -102,33 +141,38 @@ core::QvEncoder::qv_coded Encoder::Process(const core::record::Chunk& rec) {
 
   SetUpParameters(rec, *param, desc);
 
-  for (const auto& r : rec.GetData()) {
-    auto& s_first = r.GetSegments()[0];
-
-    if (r.GetAlignments().empty()) {
-      EncodeUnalignedSegment(s_first, desc);
-    } else {
-      EncodeAlignedSegment(
-          s_first, r.GetAlignments().front().GetAlignment().GetECigar(), desc);
-    }
-
-    if (r.GetSegments().size() == 1) {
-      continue;
-    }
-
-    auto& s_second = r.GetSegments()[1];
-
-    if (r.GetClassId() == core::record::ClassType::kClassHm ||
-        r.GetClassId() == core::record::ClassType::kClassU) {
-      EncodeUnalignedSegment(s_second, desc);
-    } else {
-      EncodeAlignedSegment(
-          s_second,
-          dynamic_cast<const core::record::alignment_split::SameRec*>(
-              r.GetAlignments().front().GetAlignmentSplits().front().get())
-              ->GetAlignment()
-              .GetECigar(),
-          desc);
+  if (rec.IsBatched()) {
+    EncodeBatch(rec.GetBatch(), desc);
+  } else {
+    for (const auto& r : rec.GetData()) {
+      auto& s_first = r.GetSegments()[0];
+
+      if (r.GetAlignments().empty()) {
+        EncodeUnalignedSegment(s_first, desc);
+      } else {
+        EncodeAlignedSegment(
+            s_first, r.GetAlignments().front().GetAlignment().GetECigar(),
+            desc);
+      }
+
+      if (r.GetSegments().size() == 1) {
+        continue;
+      }
+
+      auto& s_second = r.GetSegments()[1];
+
+      if (r.GetClassId() == core::record::ClassType::kClassHm ||
+          r.GetClassId() == core::record::ClassType::kClassU) {
+        EncodeUnalignedSegment(s_second, desc);
+      } else {
+        EncodeAlignedSegment(
+            s_second,
+            dynamic_cast<const core::record::alignment_split::SameRec*>(
+                r.GetAlignments().front().GetAlignmentSplits().front().get())
+                ->GetAlignment()
+                .GetECigar(),
+            desc);
+      }
     }
   }
 
@@ -27,6 +27,7 @@
 // -----------------------------------------------------------------------------
 
 #include <string>
+#include <string_view>
 
 #include "genie/core/qv_encoder.h"
 #include "genie/quality/paramqv1/qv_coding_config_1.h"
@@ -63,6 +64,38 @@ class Encoder final : public core::QvEncoder {
                               paramqv1::QualityValues1& param,
                               core::AccessUnit::Descriptor& desc);
 
+  /**
+   * @brief Encodes the quality values of one aligned segment.
+   *
+   * @param q Quality values of the segment.
+   * @param e_cigar The extended CIGAR string describing the alignment.
+   * @param desc The descriptor to store the encoded segment data.
+   */
+  static void EncodeAlignedQualities(std::string_view q,
+                                     const std::string& e_cigar,
+                                     core::AccessUnit::Descriptor& desc);
+
+  /**
+   * @brief Encodes the quality values of one unaligned segment.
+   *
+   * @param q Quality values of the segment.
+   * @param desc The descriptor to store the encoded segment data.
+   */
+  static void EncodeUnalignedQualities(std::string_view q,
+                                       core::AccessUnit::Descriptor& desc);
+
+  /**
+   * @brief Encodes the quality values of all records of a columnar batch.
+   *
+   * Only the first segment of a record in a batch can be aligned, all other
+   * segments are encoded as unaligned.
+   *
+   * @param batch The records to be encoded.
+   * @param desc The descriptor to store the encoded segment data.
+   */
+  static void EncodeBatch(const core::record::RecordBatch& batch,
+                          core::AccessUnit::Descriptor& desc);
+
   /**
    * @brief Encodes an aligned segment's quality values into the descriptor.
    *
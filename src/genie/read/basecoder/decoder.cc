@@ -23,6 +23,7 @@
 #include <genie/core/record/alignment_split/other_rec.h>
 #include <genie/core/record/alignment_split/unpaired.h>
 
+#include <cctype>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -43,7 +44,15 @@ Decoder::Decoder(core::AccessUnit&& au, const size_t segments, const size_t pos)
       position_(pos),
       length_(container_.GetParameters().GetReadLength()),
       record_counter_(0),
-      number_template_segments_(segments) {}
+      number_template_segments_(segments),
+      msar_counter_(0) {}
+
+// -----------------------------------------------------------------------------
+
+void Decoder::SetMultiSegmentAlignments(std::vector<std::string>&& msar) {
+  msar_ = std::move(msar);
+  msar_counter_ = 0;
+}
 
 // -----------------------------------------------------------------------------
 
@@ -52,13 +61,16 @@ core::record::Record Decoder::Pull(uint16_t ref, std::vector<std::string>&& vec,
   std::vector<std::string> sequences = std::move(vec);
   std::vector<std::string> cigars;
   cigars.reserve(sequences.size());
-  for (auto& sequence : sequences) {
-    cigars.emplace_back(sequence.size(), '=');
+  for (size_t i = 0; i < sequences.size(); ++i) {
+    if (!meta.msar[i].empty()) {
+      RemoveIntrons(meta.msar[i], sequences[i]);
+    }
+    cigars.emplace_back(sequences[i].size(), '=');
   }
   const auto clip_offset = ApplyClips(meta.clips, sequences, cigars);
 
   auto state = Decode(std::get<0>(clip_offset), std::move(sequences.front()),
-                      std::move(cigars.front()));
+                      std::move(cigars.front()), meta.msar[0]);
   switch (meta.decoding_case) {
     case core::gen_const::kPairSameRecord:
       std::get<1>(state).SetRead1First(meta.first1);
@@ -107,7 +119,8 @@ core::record::Record Decoder::Pull(uint16_t ref, std::vector<std::string>&& vec,
   for (size_t i = 1; i < sequences.size(); ++i) {
     DecodeAdditional(
         std::get<1>(clip_offset), std::move(sequences[i]), std::move(cigars[i]),
-        static_cast<uint16_t>(meta.position[1] - meta.position[0]), state);
+        static_cast<uint16_t>(meta.position[1] - meta.position[0]),
+        meta.msar[i], state);
   }
 
   std::get<1>(state).AddAlignment(ref, std::move(std::get<0>(state)));
@@ -140,6 +153,20 @@ Decoder::SegmentMeta Decoder::ReadSegmentMeta() {
 
   meta.clips = DecodeClips();
 
+  // The second segment of class HM is unaligned and has no msar entry
+  const size_t num_aligned =
+      container_.GetClassType() == core::record::ClassType::kClassHm
+          ? 1
+          : meta.num_segments;
+  for (size_t i = 0; i < num_aligned && !msar_.empty(); ++i) {
+    UTILS_DIE_IF(msar_counter_ >= msar_.size(),
+                 "Fewer msar entries than aligned segments");
+    if (msar_[msar_counter_] != "*") {
+      meta.msar[i] = std::move(msar_[msar_counter_]);
+    }
+    msar_counter_++;
+  }
+
   const auto deletions = NumberDeletions(meta.num_segments);
   for (size_t i = 0; i < meta.num_segments; ++i) {
     if (length_ > 0) {
@@ -149,6 +176,7 @@ Decoder::SegmentMeta Decoder::ReadSegmentMeta() {
       meta.length[i] =
           container_.Pull(core::gen_sub::kReadLength) + 1 + deletions[i];
     }
+    meta.length[i] += SpliceLength(meta.msar[i]);
   }
   return meta;
 }
@@ -156,7 +184,8 @@ Decoder::SegmentMeta Decoder::ReadSegmentMeta() {
 // -----------------------------------------------------------------------------
 
 std::tuple<core::record::AlignmentBox, core::record::Record> Decoder::Decode(
-    size_t clip_offset, std::string&& seq, std::string&& cigar) {
+    size_t clip_offset, std::string&& seq, std::string&& cigar,
+    const std::string& msar) {
   auto sequence = std::move(seq);
 
   uint8_t rtype = 0;
@@ -210,7 +239,9 @@ std::tuple<core::record::AlignmentBox, core::record::Record> Decoder::Decode(
   std::string e_cigar = std::move(cigar);
   DecodeMismatches(clip_offset, sequence, e_cigar);
 
-  core::record::Alignment alignment(ContractECigar(e_cigar), reverse_comp);
+  core::record::Alignment alignment(
+      msar.empty() ? ContractECigar(e_cigar) : std::string(msar),
+      reverse_comp);
   alignment.AddMappingScore(static_cast<int32_t>(mapping_score));
 
   std::tuple<core::record::AlignmentBox, core::record::Record> ret;
@@ -272,9 +303,64 @@ std::string Decoder::ContractECigar(const std::string& cigar_long) {
 
 // -----------------------------------------------------------------------------
 
+uint64_t Decoder::SpliceLength(const std::string& e_cigar) {
+  uint64_t length = 0;
+  uint64_t count = 0;
+  for (const char c : e_cigar) {
+    if (isdigit(c)) {
+      count = count * 10 + (c - '0');
+      continue;
+    }
+    if (c == '*' || c == '/' || c == '%') {
+      length += count;
+    }
+    count = 0;
+  }
+  return length;
+}
+
+// -----------------------------------------------------------------------------
+
+void Decoder::RemoveIntrons(const std::string& e_cigar, std::string& ref) {
+  size_t ref_offset = 0;
+  size_t count = 0;
+  for (const char c : e_cigar) {
+    if (isdigit(c)) {
+      count = count * 10 + (c - '0');
+      continue;
+    }
+    switch (c) {
+      case '=':
+      case '-':
+        ref_offset += count;
+        break;
+      case '*':
+      case '/':
+      case '%':
+        UTILS_DIE_IF(ref_offset + count > ref.size(),
+                     "Splice exceeds reference of segment");
+        ref.erase(ref_offset, count);
+        break;
+      case '+':
+      case ')':
+      case ']':
+      case '(':
+      case '[':
+        break;
+      default:
+        // Substituted base
+        ref_offset += 1;
+        break;
+    }
+    count = 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 void Decoder::DecodeAdditional(
     const size_t softclip_offset, std::string&& seq, std::string&& cigar,
-    uint16_t delta_pos,
+    uint16_t delta_pos, const std::string& msar,
     std::tuple<core::record::AlignmentBox, core::record::Record>& state) {
   auto sequence = std::move(seq);
 
@@ -286,7 +372,9 @@ void Decoder::DecodeAdditional(
     const auto mapping_score =
         static_cast<int32_t>(container_.Pull(core::gen_sub::kMappingScore));
 
-    core::record::Alignment alignment(ContractECigar(e_cigar), reverse_comp);
+    core::record::Alignment alignment(
+        msar.empty() ? ContractECigar(e_cigar) : std::string(msar),
+        reverse_comp);
     alignment.AddMappingScore(mapping_score);
     std::get<0>(state).AddAlignmentSplit(
         std::make_unique<core::record::alignment_split::SameRec>(delta_pos,
@@ -60,6 +60,12 @@ class Decoder {
   /// Number of template segments to Decode.
   size_t number_template_segments_;
 
+  /// msar strings of all aligned segments, empty if nothing is spliced.
+  std::vector<std::string> msar_;
+
+  /// Index of the next segment in msar_.
+  size_t msar_counter_;
+
  public:
   /**
    * @brief Constructs a `Decoder` object.
@@ -69,6 +75,13 @@ class Decoder {
    */
   Decoder(core::AccessUnit&& au, size_t segments, size_t pos = 0);
 
+  /**
+   * @brief Sets the decoded msar descriptor of a spliced access unit.
+   * @param msar One string per aligned segment: its e-CIGAR, or "*" if the
+   * alignment follows from the mismatches alone.
+   */
+  void SetMultiSegmentAlignments(std::vector<std::string>&& msar);
+
   /**
    * @brief Holds information about soft and hard clips.
    */
@@ -101,6 +114,9 @@ class Decoder {
 
     /// Clipping information for the segments.
     Clips clips;
+
+    /// msar e-CIGARs of spliced segments, empty for all others.
+    std::array<std::string, 2> msar;
   };
 
   /**
@@ -141,10 +157,12 @@ class Decoder {
    * @param clip_offset Offset for soft clipping.
    * @param seq The sequence to Decode.
    * @param cigar The CIGAR string associated with the sequence.
+   * @param msar e-CIGAR from msar, replaces the decoded one if not empty.
    * @return A tuple containing an alignment box and the corresponding record.
    */
   std::tuple<core::record::AlignmentBox, core::record::Record> Decode(
-      size_t clip_offset, std::string&& seq, std::string&& cigar);
+      size_t clip_offset, std::string&& seq, std::string&& cigar,
+      const std::string& msar);
 
   /**
    * @brief Contracts an extended CIGAR string to a regular CIGAR format.
@@ -153,17 +171,33 @@ class Decoder {
    */
   static std::string ContractECigar(const std::string& cigar_long);
 
+  /**
+   * @brief Sums up the lengths of all splices in an extended CIGAR string.
+   * @param e_cigar Extended CIGAR string.
+   * @return Number of reference bases skipped by splices.
+   */
+  static uint64_t SpliceLength(const std::string& e_cigar);
+
+  /**
+   * @brief Removes the introns from the reference of a spliced segment.
+   * @param e_cigar Extended CIGAR string of the segment.
+   * @param ref Reference starting at the mapping position, spanning the
+   * introns.
+   */
+  static void RemoveIntrons(const std::string& e_cigar, std::string& ref);
+
   /**
    * @brief Decodes additional alignment information.
    * @param softclip_offset Offset for soft clipping.
    * @param seq The sequence to Decode.
    * @param cigar The CIGAR string for alignment.
    * @param delta_pos Position delta for alignment.
+   * @param msar e-CIGAR from msar, replaces the decoded one if not empty.
    * @param state Current state of the alignment box and record.
    */
   void DecodeAdditional(
       size_t softclip_offset, std::string&& seq, std::string&& cigar,
-      uint16_t delta_pos,
+      uint16_t delta_pos, const std::string& msar,
       std::tuple<core::record::AlignmentBox, core::record::Record>& state);
 
   /**
@@ -27,7 +27,9 @@
 #include <vector>
 
 #include "genie/core/record/alignment_split/same_rec.h"
+#include "genie/core/stats/stage_timer.h"
 #include "genie/util/stop_watch.h"
+#include "genie/util/trace.h"
 
 // -----------------------------------------------------------------------------
 
@@ -41,6 +43,9 @@ DecoderStub::DecodingState::DecodingState(core::AccessUnit& t_data) {
   ref = t_data.GetReference();
   qv_stream = std::move(t_data.Get(core::GenDesc::kQv));
   name_stream = std::move(t_data.Get(core::GenDesc::kReadName));
+  if (t_data.GetParameters().IsSplicedReads()) {
+    msar_stream = std::move(t_data.Get(core::GenDesc::kMultiSegmentAlignment));
+  }
   qv_param = t_data.GetParameters().GetQvConfig(t_data.GetClassType()).Clone();
 }
 
@@ -52,6 +57,12 @@ core::record::Chunk DecoderStub::DecodeSequences(DecodingState& state,
   core::record::Chunk chunk;
   chunk.SetStats(std::move(t_data.GetStats()));
   Decoder decoder(std::move(t_data), state.num_segments, t_data.GetMinPos());
+  if (!state.msar_stream.IsEmpty()) {
+    // Laid out like read names, see EncoderStub::EncodeMultiSegmentAlignments
+    auto msar = namecoder_->Process(state.msar_stream);
+    chunk.GetStats().Add(std::get<1>(msar));
+    decoder.SetMultiSegmentAlignments(std::move(std::get<0>(msar)));
+  }
   for (size_t rec_id = 0; rec_id < state.num_records;) {
     auto meta = decoder.ReadSegmentMeta();
 
@@ -73,6 +84,7 @@ core::record::Chunk DecoderStub::DecodeSequences(DecodingState& state,
 
 void DecoderStub::DecodeNames(DecodingState& state,
                               core::record::Chunk& chunk) {
+  core::stats::StageTimer timer(core::stats::Stage::kName);
   const std::tuple<std::vector<std::string>, core::stats::PerfStats> names =
       namecoder_->Process(state.name_stream);
   chunk.GetStats().Add(std::get<1>(names));
@@ -85,6 +97,7 @@ void DecoderStub::DecodeNames(DecodingState& state,
 
 void DecoderStub::DecodeQualities(DecodingState& state,
                                   core::record::Chunk& chunk) {
+  core::stats::StageTimer timer(core::stats::Stage::kQv);
   auto qvs = qvcoder_->Process(*state.qv_param, state.e_cigars, state.positions,
                                state.qv_stream);
   chunk.GetStats().Add(std::get<1>(qvs));
@@ -153,12 +166,17 @@ void DecoderStub::RecordDecodedHook(DecodingState&,
 // -----------------------------------------------------------------------------
 
 void DecoderStub::FlowIn(core::AccessUnit&& t, const util::Section& id) {
+  core::stats::StageTimer timer(core::stats::Stage::kReadCoding);
+  util::TraceScope trace("flow-in", "read-coding",
+                         static_cast<int64_t>(id.start));
   auto t_data = std::move(t);
   t_data = EntropyCodeAu(std::move(t_data), true);
   const auto state = CreateDecodingState(t_data);
   auto chunk = DecodeSequences(*state, t_data);
   DecodeQualities(*state, chunk);
   DecodeNames(*state, chunk);
+  trace.Stop();
+  timer.Stop();
   FlowOut(std::move(chunk), id);
 }
 
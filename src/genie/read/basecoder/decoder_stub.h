@@ -56,6 +56,9 @@ class DecoderStub : public core::ReadDecoder {
     /// Name stream descriptor.
     core::AccessUnit::Descriptor name_stream;
 
+    /// msar descriptor, empty unless the access unit has spliced reads.
+    core::AccessUnit::Descriptor msar_stream;
+
     /// Number of records to Decode.
     size_t num_records;
 
@@ -55,12 +55,12 @@ Encoder::CodingState::CodingState(const std::string& read_seq,
 Encoder::Encoder(const uint64_t starting_mapping_pos)
     : container_(core::parameter::EncodingSet(), 0),
       pos_(starting_mapping_pos),
-      read_counter_(0) {}
+      read_counter_(0),
+      spliced_(false) {}
 
 // -----------------------------------------------------------------------------
 
 void Encoder::EncodeFirstSegment(const core::record::Record& rec) {
-  // TODO(Fabian): Splices
   const auto& alignment =
       rec.GetAlignments().front();  // TODO(Fabian): Multiple alignments.
                                     // Currently only 1 supported
@@ -167,6 +167,7 @@ void Encoder::Add(const core::record::Record& rec, const std::string& ref1,
                           .GetAlignment()
                           .GetECigar();  // TODO(Fabian): Multi-alignments
   clips.first = EncodeCigar(sequence, cigar, ref1, rec.GetClassId());
+  AddMultiSegmentAlignment(cigar);
 
   const auto length_var_1 = rec.GetSegments()[0].GetSequence().length() - 1;
   const auto length_const_1 =
@@ -197,6 +198,7 @@ void Encoder::Add(const core::record::Record& rec, const std::string& ref1,
 
       const auto& cigar2 = split_rec.GetAlignment().GetECigar();
       clips.second = EncodeCigar(sequence2, cigar2, ref2, rec.GetClassId());
+      AddMultiSegmentAlignment(cigar2);
 
       const auto length_var_2 = rec.GetSegments()[1].GetSequence().length() - 1;
       const auto length_const_2 = length_var_2 + 1 +
@@ -446,6 +448,27 @@ Encoder::ClipInformation Encoder::EncodeCigar(
 
 // -----------------------------------------------------------------------------
 
+void Encoder::AddMultiSegmentAlignment(const std::string& cigar) {
+  if (cigar.find_first_of("*/%") == std::string::npos) {
+    msar_.emplace_back("*");
+    return;
+  }
+  msar_.emplace_back(cigar);
+  spliced_ = true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Encoder::IsSpliced() const { return spliced_; }
+
+// -----------------------------------------------------------------------------
+
+const std::vector<std::string>& Encoder::GetMultiSegmentAlignments() const {
+  return msar_;
+}
+
+// -----------------------------------------------------------------------------
+
 core::AccessUnit&& Encoder::MoveStreams() { return std::move(container_); }
 
 // -----------------------------------------------------------------------------
@@ -501,9 +524,8 @@ void Encoder::EncodeClips(
 
 // -----------------------------------------------------------------------------
 
-void Encoder::EncodeSplice(const CodingState& state) {
-  (void)state;
-  UTILS_DIE("Splicing is currently not supported");
+void Encoder::EncodeSplice(CodingState& state) {
+  state.ref_offset += state.count;
 }
 
 // -----------------------------------------------------------------------------
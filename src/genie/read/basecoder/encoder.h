@@ -25,6 +25,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "genie/core/access_unit.h"
 #include "genie/core/record/alignment_split/same_rec.h"
@@ -55,6 +56,12 @@ class Encoder {
   /// Read length.
   std::optional<uint32_t> length_;
 
+  /// msar string of each aligned segment: its e-CIGAR if spliced, else "*".
+  std::vector<std::string> msar_;
+
+  /// Whether any segment so far contains a splice.
+  bool spliced_;
+
   void UpdateLength(uint32_t len) {
     if (length_ == std::nullopt) {
       length_ = len;
@@ -179,10 +186,17 @@ class Encoder {
   void EncodeSubstitution(CodingState& state);
 
   /**
-   * @brief Encodes a splice event.
+   * @brief Encodes a splice event. The intron is skipped in the reference,
+   * the splice itself is only kept in the msar descriptor.
    * @param state Current encoding state.
    */
-  static void EncodeSplice(const CodingState& state);
+  static void EncodeSplice(CodingState& state);
+
+  /**
+   * @brief Adds the msar string of an aligned segment.
+   * @param cigar Extended CIGAR of the segment.
+   */
+  void AddMultiSegmentAlignment(const std::string& cigar);
 
   /**
    * @brief Encodes a match event.
@@ -234,6 +248,20 @@ class Encoder {
    */
   uint32_t GetReadLength() const;
 
+  /**
+   * @brief Checks whether any segment added so far contains a splice.
+   * @return True if the msar descriptor has to be written.
+   */
+  [[nodiscard]] bool IsSpliced() const;
+
+  /**
+   * @brief Retrieves the msar strings, one per aligned segment in coding
+   * order. Segments without splices have "*".
+   * @return msar strings.
+   */
+  [[nodiscard]] const std::vector<std::string>& GetMultiSegmentAlignments()
+      const;
+
   /**
    * @brief Moves the encoded access unit out of the encoder.
    * @return Encoded access unit.
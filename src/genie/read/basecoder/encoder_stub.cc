@@ -23,8 +23,11 @@
 #include <iostream>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "genie/core/stats/stage_timer.h"
 #include "genie/util/stop_watch.h"
+#include "genie/util/trace.h"
 
 // -----------------------------------------------------------------------------
 
@@ -76,6 +79,7 @@ core::AccessUnit EncoderStub::Pack(const size_t id,
 
   auto raw_au = state.read_coder.MoveStreams();
   const auto read_length = state.read_coder.GetReadLength();
+  const bool spliced = state.read_coder.IsSpliced();
 
   // Constant read length means we don't have to store it
   if (read_length != 0) {
@@ -85,11 +89,16 @@ core::AccessUnit EncoderStub::Pack(const size_t id,
   core::parameter::ParameterSet ret(
       static_cast<uint8_t>(id), static_cast<uint8_t>(id), data_type,
       core::AlphabetId::kAcgtn, read_length,
-      state.paired_end, false, qv_depth, 1, false, false);
+      state.paired_end, false, qv_depth, 1, false, spliced);
   ret.GetEncodingSet().AddClass(state.class_type, std::move(std::get<0>(qv)));
 
   raw_au.Get(core::GenDesc::kQv) = std::move(std::get<1>(qv));
   raw_au.Get(core::GenDesc::kReadName) = std::move(read_name);
+  if (spliced) {
+    raw_au.Get(core::GenDesc::kMultiSegmentAlignment) =
+        EncodeMultiSegmentAlignments(
+            namecoder_, state.read_coder.GetMultiSegmentAlignments());
+  }
 
   raw_au.SetParameters(std::move(ret.GetEncodingSet()));
   raw_au.SetReference(state.ref);
@@ -135,6 +144,7 @@ void EncoderStub::RemoveRedundantDescriptors(core::AccessUnit& raw_au) {
 
 core::QvEncoder::qv_coded EncoderStub::EncodeQVs(qv_selector* qv_coder,
                                                  core::record::Chunk& data) {
+  core::stats::StageTimer timer(core::stats::Stage::kQv);
   const util::Watch watch;
   auto qv = qv_coder->Process(data);
   data.GetStats().AddDouble("time-quality", watch.Check());
@@ -145,6 +155,7 @@ core::QvEncoder::qv_coded EncoderStub::EncodeQVs(qv_selector* qv_coder,
 
 core::AccessUnit::Descriptor EncoderStub::EncodeNames(
     name_selector* name_coder, core::record::Chunk& data) {
+  core::stats::StageTimer timer(core::stats::Stage::kName);
   const util::Watch watch;
   auto name = name_coder->Process(data);
   data.GetStats().AddDouble("time-name", watch.Check());
@@ -153,7 +164,32 @@ core::AccessUnit::Descriptor EncoderStub::EncodeNames(
 
 // -----------------------------------------------------------------------------
 
+core::AccessUnit::Descriptor EncoderStub::EncodeMultiSegmentAlignments(
+    name_selector* name_coder, const std::vector<std::string>& msar) {
+  core::stats::StageTimer timer(core::stats::Stage::kName);
+  core::record::Chunk chunk;
+  for (const auto& m : msar) {
+    chunk.GetBatch().AddRecord(m, "", 1, core::record::ClassType::kClassI, 0,
+                               true);
+  }
+  auto tokens = std::get<0>(name_coder->Process(chunk));
+
+  // Same token layout as rname, only the descriptor differs
+  core::AccessUnit::Descriptor ret(core::GenDesc::kMultiSegmentAlignment);
+  for (uint16_t i = 0; i < tokens.GetSize(); ++i) {
+    ret.Add(core::AccessUnit::Subsequence(
+        tokens.Get(i).Move(),
+        core::GenSubIndex{core::GenDesc::kMultiSegmentAlignment, i}));
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
 void EncoderStub::FlowIn(core::record::Chunk&& t, const util::Section& id) {
+  core::stats::StageTimer timer(core::stats::Stage::kReadCoding);
+  util::TraceScope trace("flow-in", "read-coding",
+                         static_cast<int64_t>(id.start));
   core::record::Chunk data = std::move(t);
 
   // Empty block: do nothing
@@ -170,8 +206,12 @@ void EncoderStub::FlowIn(core::record::Chunk&& t, const util::Section& id) {
 
   auto raw_au = Pack(id.start, std::move(qv), std::move(read_name), *state);
   raw_au.SetStats(std::move(data.GetStats()));
+  raw_au.SetStatistics(core::stats::AuStatistics(data.GetData()));
+  raw_au.GetMemory() = std::move(data.GetMemory());
   data.GetData().clear();
   raw_au = EntropyCodeAu(std::move(raw_au));
+  trace.Stop();
+  timer.Stop();
   FlowOut(std::move(raw_au), id);
 }
 
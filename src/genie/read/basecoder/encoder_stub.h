@@ -22,6 +22,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "genie/core/read_encoder.h"
 #include "genie/read/basecoder/encoder.h"
@@ -141,6 +142,16 @@ class EncoderStub : public core::ReadEncoder {
   static core::AccessUnit::Descriptor EncodeNames(name_selector* name_coder,
                                                   core::record::Chunk& data);
 
+  /**
+   * @brief Encode the msar strings of all aligned segments. msar is a
+   * token-type descriptor like rname, so the name coder lays it out.
+   * @param name_coder Name encoder.
+   * @param msar One msar string per aligned segment.
+   * @return Encoded msar descriptor.
+   */
+  static core::AccessUnit::Descriptor EncodeMultiSegmentAlignments(
+      name_selector* name_coder, const std::vector<std::string>& msar);
+
   /**
    * @brief Constructs an EncoderStub with a flag for writing raw data.
    * @param write_raw Flag indicating if raw data should be written.
@@ -142,6 +142,14 @@ std::unique_ptr<Encoder::EncodingState> Encoder::CreateState(
       max_read_size = std::max(max_read_size,
                                static_cast<uint32_t>(s.GetSequence().length()));
     }
+    // Deletions take up reference without adding bases
+    if (!r.GetAlignments().empty() &&
+        r.GetClassId() != core::record::ClassType::kClassHm) {
+      for (size_t i = 0; i < r.GetSegments().size(); ++i) {
+        max_read_size = std::max(
+            max_read_size, static_cast<uint32_t>(r.GetMappedLength(0, i)));
+      }
+    }
   }
   uint32_t buf_max_size = 1024;
   while (buf_max_size < max_read_size * reads_per_assembly) {
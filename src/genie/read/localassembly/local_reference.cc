@@ -17,6 +17,7 @@
 #include "genie/read/localassembly/local_reference.h"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <iostream>
 #include <limits>
@@ -37,6 +38,30 @@ namespace genie::read::localassembly {
 
 // -----------------------------------------------------------------------------
 
+namespace {
+
+/**
+ * @brief Maps a base to its index in the ACGTN alphabet.
+ * @param c Base.
+ * @return Index, or -1 if the base is not part of the alphabet.
+ */
+int SymbolIndex(const char c) {
+  static const auto table = [] {
+    std::array<int8_t, 256> ret{};
+    ret.fill(-1);
+    const auto& alphabet = GetAlphabetProperties(core::AlphabetId::kAcgtn);
+    for (size_t i = 0; i < alphabet.lut.size(); ++i) {
+      ret[static_cast<uint8_t>(alphabet.lut[i])] = static_cast<int8_t>(i);
+    }
+    return ret;
+  }();
+  return table[static_cast<uint8_t>(c)];
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
 LocalReference::LocalReference(const uint32_t cr_buf_max_size)
     : cr_buf_max_size_(cr_buf_max_size), cr_buf_size_(0) {}
 
@@ -103,13 +128,90 @@ std::string LocalReference::preprocess(const std::string& read,
 
 // -----------------------------------------------------------------------------
 
+bool LocalReference::CountVotes(const std::string& read,
+                                const uint64_t position, const bool add) {
+  if (add) {
+    if (pileup_.empty()) {
+      pileup_start_ = position;
+    }
+    const uint64_t begin = std::min(pileup_start_, position);
+    const uint64_t end = std::max(pileup_start_ + pileup_.size(),
+                                  position + read.length());
+    if (end - begin > kMaxPileupSpan) {
+      return false;
+    }
+    while (pileup_start_ > position) {
+      pileup_.emplace_front();
+      --pileup_start_;
+    }
+    pileup_.resize(end - pileup_start_);
+  }
+
+  const uint64_t offset = position - pileup_start_;
+  for (size_t i = 0; i < read.length(); ++i) {
+    if (read[i] == '0') {
+      continue;
+    }
+    const int symbol = SymbolIndex(read[i]);
+    if (symbol < 0) {
+      return false;
+    }
+    auto& votes = pileup_[offset + i][symbol];
+    votes = add ? votes + 1 : votes - 1;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void LocalReference::TrimPileup() {
+  constexpr std::array<uint16_t, 5> kNoVotes{};
+  while (!pileup_.empty() && pileup_.front() == kNoVotes) {
+    pileup_.pop_front();
+    ++pileup_start_;
+  }
+  while (!pileup_.empty() && pileup_.back() == kNoVotes) {
+    pileup_.pop_back();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void LocalReference::RebuildPileup() {
+  uint64_t begin = std::numeric_limits<uint64_t>::max();
+  uint64_t end = 0;
+  for (size_t i = 0; i < sequences_.size(); ++i) {
+    begin = std::min(begin, sequence_positions_[i]);
+    end = std::max(end, sequence_positions_[i] + sequences_[i].length());
+  }
+  if (end > begin && end - begin > kMaxPileupSpan) {
+    return;
+  }
+  pileup_.clear();
+  pileup_valid_ = true;
+  for (size_t i = 0; i < sequences_.size(); ++i) {
+    if (!CountVotes(sequences_[i], sequence_positions_[i], true)) {
+      pileup_.clear();
+      pileup_valid_ = false;
+      return;
+    }
+  }
+  TrimPileup();
+}
+
+// -----------------------------------------------------------------------------
+
 void LocalReference::AddSingleRead(const std::string& record,
                                    const std::string& ecigar,
                                    const uint64_t position) {
-  sequence_positions_.push_back(position);
   const std::string read = preprocess(record, ecigar);
+  sequence_positions_.push_back(position);
   sequences_.push_back(read);
   cr_buf_size_ += static_cast<uint32_t>(read.length());
+  if (pileup_valid_ && !CountVotes(read, position, true)) {
+    pileup_.clear();
+    pileup_valid_ = false;
+  }
 
   while (cr_buf_size_ > cr_buf_max_size_) {
     if (sequences_.size() == 1) {
@@ -117,10 +219,19 @@ void LocalReference::AddSingleRead(const std::string& record,
           "Read too long for current cr_buf_max_size");
     }
     // Erase oldest read
+    if (pileup_valid_) {
+      CountVotes(sequences_.front(), sequence_positions_.front(), false);
+    }
     cr_buf_size_ -= static_cast<uint32_t>(sequences_.front().length());
     sequences_.erase(sequences_.begin());
     sequence_positions_.erase(sequence_positions_.begin());
   }
+
+  if (pileup_valid_) {
+    TrimPileup();
+  } else {
+    RebuildPileup();
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -156,6 +267,7 @@ void LocalReference::AddRead(const core::record::Record& s) {
 std::string LocalReference::GenerateRef(const uint32_t offset,
                                         const uint32_t len) const {
   std::string ref;
+  ref.reserve(len);
   for (uint32_t i = offset; i < offset + len; ++i) {
     ref += MajorityVote(i);
   }
@@ -219,6 +331,31 @@ std::string LocalReference::GetReference(const uint32_t pos_offset,
 // -----------------------------------------------------------------------------
 
 char LocalReference::MajorityVote(const uint32_t offset_to_first) const {
+  if (!pileup_valid_) {
+    return ScanVote(offset_to_first);
+  }
+  if (offset_to_first < pileup_start_ ||
+      offset_to_first - pileup_start_ >= pileup_.size()) {
+    return '\0';
+  }
+
+  // Ties go to the base first in the alphabet
+  const auto& votes = pileup_[offset_to_first - pileup_start_];
+  size_t max = 0;
+  for (size_t i = 1; i < votes.size(); ++i) {
+    if (votes[i] > votes[max]) {
+      max = i;
+    }
+  }
+  if (votes[max] == 0) {
+    return '\0';
+  }
+  return GetAlphabetProperties(core::AlphabetId::kAcgtn).lut[max];
+}
+
+// -----------------------------------------------------------------------------
+
+char LocalReference::ScanVote(const uint32_t offset_to_first) const {
   std::map<char, uint16_t> votes;
 
   // Collect all alignments
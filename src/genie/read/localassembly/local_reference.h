@@ -18,6 +18,8 @@
 
 // -----------------------------------------------------------------------------
 
+#include <array>
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -140,6 +142,47 @@ class LocalReference {
    * @return The maximum buffer Size.
    */
   [[nodiscard]] uint32_t GetMaxBufferSize() const;
+
+ private:
+  /// Maximum number of positions covered by the pileup. Wider windows only
+  /// occur for unsorted input and fall back to scanning the buffer.
+  static constexpr uint64_t kMaxPileupSpan = 1u << 18u;
+
+  /// Votes for A, C, G, T, N per position, starting at `pileup_start_`.
+  std::deque<std::array<uint16_t, 5>> pileup_;
+
+  /// Position of the first entry in `pileup_`.
+  uint64_t pileup_start_ = 0;
+
+  /// False if the pileup is out of sync with the buffer, see kMaxPileupSpan.
+  bool pileup_valid_ = true;
+
+  /**
+   * @brief Adds or removes the votes of a buffered read.
+   * @param read Preprocessed read.
+   * @param position Position of the read.
+   * @param add True to add the votes, false to remove them.
+   * @return False if the read does not fit into the pileup.
+   */
+  bool CountVotes(const std::string& read, uint64_t position, bool add);
+
+  /**
+   * @brief Drops positions without votes at both ends of the pileup.
+   */
+  void TrimPileup();
+
+  /**
+   * @brief Recomputes the pileup from the buffered reads, if they fit.
+   */
+  void RebuildPileup();
+
+  /**
+   * @brief Majority vote scanning all buffered reads. Used while the pileup
+   * is invalid.
+   * @param offset_to_first Position to vote on.
+   * @return The character representing the majority base.
+   */
+  [[nodiscard]] char ScanVote(uint32_t offset_to_first) const;
 };
 
 // -----------------------------------------------------------------------------
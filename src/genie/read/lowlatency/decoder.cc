@@ -20,8 +20,10 @@
 #include <vector>
 
 #include "genie/core/global_cfg.h"
+#include "genie/core/stats/stage_timer.h"
 #include "genie/read/basecoder/decoder.h"
 #include "genie/util/stop_watch.h"
+#include "genie/util/trace.h"
 
 // -----------------------------------------------------------------------------
 
@@ -30,39 +32,45 @@ namespace genie::read::lowlatency {
 // -----------------------------------------------------------------------------
 
 core::record::Chunk Decoder::decode_common(core::AccessUnit&& t) const {
+  core::stats::StageTimer timer(core::stats::Stage::kReadCoding);
   util::Watch watch;
   core::record::Chunk ret;
   core::AccessUnit data = std::move(t);
   data = EntropyCodeAu(std::move(data), true);
   const auto& qv_param = data.GetParameters().GetQvConfig(data.GetClassType());
   auto qv_stream = std::move(data.Get(core::GenDesc::kQv));
+  core::stats::StageTimer name_timer(core::stats::Stage::kName);
   auto names = namecoder_->Process(data.Get(core::GenDesc::kReadName));
+  name_timer.Stop();
   data.GetStats().AddDouble("time-name", watch.Check());
   watch.Reset();
   std::vector<std::string> e_cigars;
   std::vector<uint64_t> positions;
+  // Reads are written straight into the columns of the batch, no record
+  // objects are built
+  auto& batch = ret.GetBatch();
+  const auto& lut = GetAlphabetProperties(core::AlphabetId::kAcgtn).lut;
+  const auto num_template_segments =
+      static_cast<uint8_t>(data.GetParameters().GetNumberTemplateSegments());
   // FIXME: loop condition is only correct if all records have the full number
   // of reads
   size_t i = 0;
   size_t rec_i = 0;
   while (i < data.GetNumReads()) {
-    core::record::Record rec(
-        static_cast<uint8_t>(data.GetParameters().GetNumberTemplateSegments()),
-        core::record::ClassType::kClassU,
-        std::get<0>(names).empty() ? "" : std::move(std::get<0>(names)[rec_i]),
-        "", 0);
-
     size_t num_segments = 1;
-    if (data.GetParameters().GetNumberTemplateSegments() > 1) {
+    bool read_1_first = true;
+    if (num_template_segments > 1) {
       if (auto decoding_case = data.Pull(core::gen_sub::kPairDecodingCase);
           decoding_case == core::gen_const::kPairSameRecord) {
         num_segments = 2;
-      } else if (decoding_case == core::gen_const::kPairR1Unpaired) {
-        rec.SetRead1First(true);
       } else {
-        rec.SetRead1First(false);
+        read_1_first = decoding_case == core::gen_const::kPairR1Unpaired;
       }
     }
+    batch.AddRecord(
+        std::get<0>(names).empty() ? "" : std::get<0>(names)[rec_i], "",
+        num_template_segments, core::record::ClassType::kClassU, 0,
+        read_1_first);
 
     for (size_t j = 0; j < num_segments; ++j) {
       positions.emplace_back(std::numeric_limits<uint64_t>::max());
@@ -71,41 +79,30 @@ core::record::Chunk Decoder::decode_common(core::AccessUnit&& t) const {
         length = data.Pull(core::gen_sub::kReadLength) + 1;
       }
       e_cigars.emplace_back(length, '+');
-      std::string seq(length, '\0');
-      for (auto& c : seq) {
-        c = GetAlphabetProperties(core::AlphabetId::kAcgtn)
-                .lut[data.Pull(core::gen_sub::kUnalignedReads)];
+      char* seq = batch.AddSegment(length);
+      for (size_t k = 0; k < length; ++k) {
+        seq[k] = lut[data.Pull(core::gen_sub::kUnalignedReads)];
       }
-
-      core::record::Segment seg(std::move(seq));
-      rec.AddSegment(std::move(seg));
     }
 
-    ret.GetData().push_back(std::move(rec));
     i += num_segments;
     rec_i++;
   }
 
   data.GetStats().AddDouble("time-lowlatency", watch.Check());
   watch.Reset();
+  core::stats::StageTimer qv_timer(core::stats::Stage::kQv);
   if (auto qvs =
           this->qvcoder_->Process(qv_param, e_cigars, positions, qv_stream);
       !std::get<0>(qvs).empty()) {
-    size_t qv_counter = 0;
-    for (auto& r : ret.GetData()) {
-      for (auto& s : r.GetSegments()) {
-        if (!std::get<0>(qvs)[qv_counter].empty()) {
-          s.AddQualities(std::move(std::get<0>(qvs)[qv_counter]));
-        }
-        qv_counter++;
-      }
-      if (!r.GetSegments().empty()) {
-        r.SetQvDepth(static_cast<uint8_t>(
-            r.GetSegments().front().GetQualities().size()));
+    for (size_t s = 0; s < std::get<0>(qvs).size(); ++s) {
+      if (!std::get<0>(qvs)[s].empty()) {
+        batch.AddQualities(s, std::get<0>(qvs)[s]);
       }
     }
   }
 
+  qv_timer.Stop();
   data.GetStats().AddDouble("time-qv", watch.Check());
   watch.Reset();
 
@@ -117,18 +114,17 @@ core::record::Chunk Decoder::decode_common(core::AccessUnit&& t) const {
 // -----------------------------------------------------------------------------
 
 void Decoder::FlowIn(core::AccessUnit&& t, const util::Section& id) {
-  FlowOut(decode_common(std::move(t)), id);
+  util::TraceScope trace("flow-in", "read-coding",
+                         static_cast<int64_t>(id.start));
+  auto chunk = decode_common(std::move(t));
+  trace.Stop();
+  FlowOut(std::move(chunk), id);
 }
 
 // -----------------------------------------------------------------------------
 
 std::string Decoder::Decode(core::AccessUnit&& t) {
-  return decode_common(std::move(t))
-      .GetData()
-      .front()
-      .GetSegments()
-      .front()
-      .GetSequence();
+  return std::string(decode_common(std::move(t)).GetBatch().GetSequence(0));
 }
 
 // -----------------------------------------------------------------------------
@@ -16,11 +16,14 @@
 #include "genie/read/lowlatency/encoder.h"
 
 #include <memory>
+#include <string_view>
 #include <utility>
 
+#include "genie/core/stats/stage_timer.h"
 #include "genie/name/tokenizer/decoder.h"
 #include "genie/name/tokenizer/encoder.h"
 #include "genie/util/stop_watch.h"
+#include "genie/util/trace.h"
 
 // -----------------------------------------------------------------------------
 
@@ -29,46 +32,59 @@ namespace genie::read::lowlatency {
 // -----------------------------------------------------------------------------
 
 void Encoder::FlowIn(core::record::Chunk&& t, const util::Section& id) {
+  core::stats::StageTimer timer(core::stats::Stage::kReadCoding);
+  util::TraceScope trace("flow-in", "read-coding",
+                         static_cast<int64_t>(id.start));
   util::Watch watch;
   core::record::Chunk data = std::move(t);
 
-  if (data.GetData().empty()) {
+  if (data.Empty()) {
     core::parameter::ParameterSet set;
     core::AccessUnit au(std::move(set.GetEncodingSet()), 0);
     au.SetReference(data.GetRef(), data.GetRefToWrite());
     au.SetReference(static_cast<uint16_t>(data.GetRefId()));
+    trace.Stop();
+    timer.Stop();
     FlowOut(std::move(au), id);
     return;
   }
 
   core::parameter::ParameterSet set;
 
+  // Reads coming from a columnar batch are encoded from the columns, no
+  // record objects are built
+  const auto& batch = data.GetBatch();
+  const bool batched = data.IsBatched();
   LlState state{
-      data.GetData().front().GetSegments().front().GetSequence().length(),
-      data.GetData().front().GetNumberOfTemplateSegments() > 1,
-      core::AccessUnit(std::move(set.GetEncodingSet()), data.GetData().size()),
+      batched ? batch.GetSequence(0).length()
+              : data.GetData().front().GetSegments().front().GetSequence()
+                    .length(),
+      (batched ? batch.GetNumberOfTemplateSegments(0)
+               : data.GetData().front().GetNumberOfTemplateSegments()) > 1,
+      core::AccessUnit(std::move(set.GetEncodingSet()), data.Size()),
       data.IsReferenceOnly()};
   size_t num_reads = 0;
-  for (auto& r : data.GetData()) {
-    for (auto& s : r.GetSegments()) {
-      num_reads++;
-      state.streams.Push(core::gen_sub::kReadLength,
-                         s.GetSequence().length() - 1);
-      if (state.read_length != s.GetSequence().length()) {
-        state.read_length = 0;
-      }
+  auto push_segment = [&](const std::string_view sequence) {
+    num_reads++;
+    state.streams.Push(core::gen_sub::kReadLength, sequence.length() - 1);
+    if (state.read_length != sequence.length()) {
+      state.read_length = 0;
+    }
 
-      for (auto c : s.GetSequence()) {
-        state.streams.Push(
-            core::gen_sub::kUnalignedReads,
-            GetAlphabetProperties(core::AlphabetId::kAcgtn).inverse_lut[c]);
-      }
+    for (auto c : sequence) {
+      state.streams.Push(
+          core::gen_sub::kUnalignedReads,
+          GetAlphabetProperties(core::AlphabetId::kAcgtn).inverse_lut[c]);
     }
-    if (r.GetSegments().size() > 1) {
+  };
+  auto push_pairing = [&](const size_t num_segments,
+                          const uint8_t num_template_segments,
+                          const bool read_1_first) {
+    if (num_segments > 1) {
       state.streams.Push(core::gen_sub::kPairDecodingCase,
                          core::gen_const::kPairSameRecord);
-    } else if (r.GetNumberOfTemplateSegments() > 1) {
-      if (r.GetRead1First()) {
+    } else if (num_template_segments > 1) {
+      if (read_1_first) {
         state.streams.Push(core::gen_sub::kPairDecodingCase,
                            core::gen_const::kPairR1Unpaired);
       } else {
@@ -76,11 +92,33 @@ void Encoder::FlowIn(core::record::Chunk&& t, const util::Section& id) {
                            core::gen_const::kPairR2Unpaired);
       }
     }
+  };
+  if (batched) {
+    for (size_t r = 0; r < batch.Size(); ++r) {
+      for (size_t s = 0; s < batch.GetNumSegments(r); ++s) {
+        push_segment(batch.GetSequence(batch.GetFirstSegment(r) + s));
+      }
+      push_pairing(batch.GetNumSegments(r),
+                   batch.GetNumberOfTemplateSegments(r),
+                   batch.IsRead1First(r));
+    }
+  } else {
+    for (auto& r : data.GetData()) {
+      for (auto& s : r.GetSegments()) {
+        push_segment(s.GetSequence());
+      }
+      push_pairing(r.GetSegments().size(), r.GetNumberOfTemplateSegments(),
+                   r.GetRead1First());
+    }
   }
   watch.Pause();
 
+  core::stats::StageTimer qv_timer(core::stats::Stage::kQv);
   auto qv = qvcoder_->Process(data);
+  qv_timer.Stop();
+  core::stats::StageTimer name_timer(core::stats::Stage::kName);
   auto read_names = namecoder_->Process(data);
+  name_timer.Stop();
   watch.Resume();
   auto raw_au = pack(id, std::get<1>(qv).IsEmpty() ? 0 : 1,
                      std::move(std::get<0>(qv)), state);
@@ -95,6 +133,11 @@ void Encoder::FlowIn(core::record::Chunk&& t, const util::Section& id) {
   }
 
   raw_au.SetStats(std::move(data.GetStats()));
+  if (!data.IsReferenceOnly()) {
+    raw_au.SetStatistics(batched ? core::stats::AuStatistics(batch)
+                                 : core::stats::AuStatistics(data.GetData()));
+  }
+  raw_au.GetMemory() = std::move(data.GetMemory());
   raw_au.GetStats().AddDouble("time-lowlatency", watch.Check());
   raw_au.GetStats().Add(std::get<2>(qv));
   raw_au.GetStats().Add(std::get<1>(read_names));
@@ -103,7 +146,10 @@ void Encoder::FlowIn(core::record::Chunk&& t, const util::Section& id) {
   raw_au.SetReferenceOnly(data.IsReferenceOnly());
   raw_au.SetReference(static_cast<uint16_t>(data.GetRefId()));
   raw_au.SetReference(data.GetRef(), {});
-  data.GetData().clear();
+  // Release the records in one go
+  data = core::record::Chunk();
+  trace.Stop();
+  timer.Stop();
   FlowOut(std::move(raw_au), id);
 }
 
@@ -31,10 +31,12 @@
 #include <utility>
 #include <vector>
 
+#include "genie/core/stats/stage_timer.h"
 #include "genie/read/spring/params.h"
 #include "genie/read/spring/util.h"
 #include "genie/util/log.h"
 #include "genie/util/stop_watch.h"
+#include "genie/util/trace.h"
 #include "kwaymergesort/kwaymergesort.h"
 
 // -----------------------------------------------------------------------------
@@ -315,6 +317,9 @@ Decoder::Decoder(const std::string& working_dir, const bool comb_p,
 // -----------------------------------------------------------------------------
 
 void Decoder::FlowIn(core::AccessUnit&& t, const util::Section& id) {
+  core::stats::StageTimer timer(core::stats::Stage::kReadCoding);
+  util::TraceScope trace("flow-in", "read-coding",
+                         static_cast<int64_t>(id.start));
   core::record::Chunk chunk;
   core::AccessUnit au = EntropyCodeAu(std::move(t), true);
   util::Watch watch;
@@ -345,7 +350,9 @@ void Decoder::FlowIn(core::AccessUnit&& t, const util::Section& id) {
   au.Get(core::gen_sub::kReadLength).SetPosition(0);
 
   watch.Pause();
+  core::stats::StageTimer name_timer(core::stats::Stage::kName);
   auto names = namecoder_->Process(au.Get(core::GenDesc::kReadName));
+  name_timer.Stop();
 
   // if read names is empty but combine_pairs is set to true, raise error
   if (au.GetNumReads() > 0 && std::get<0>(names).empty() && combine_pairs_)
@@ -354,9 +361,11 @@ void Decoder::FlowIn(core::AccessUnit&& t, const util::Section& id) {
         "present for all records.");
 
   au.GetStats().Add(std::get<1>(names));
+  core::stats::StageTimer qv_timer(core::stats::Stage::kQv);
   auto qvs = qvcoder_->Process(
       au.GetParameters().GetQvConfig(core::record::ClassType::kClassU),
       e_cigars, positions, au.Get(core::GenDesc::kQv));
+  qv_timer.Stop();
   au.GetStats().Add(std::get<1>(qvs));
   watch.Resume();
 
@@ -434,6 +443,8 @@ void Decoder::FlowIn(core::AccessUnit&& t, const util::Section& id) {
   chunk.SetStats(std::move(au.GetStats()));
   chunk.GetStats().AddDouble("time-spring-decoder", watch.Check());
   au.Clear();
+  trace.Stop();
+  timer.Stop();
   FlowOut(std::move(chunk), util::Section{id.start, chunk_size, true});
   if (id.length - chunk_size > 0) {
     SkipOut(util::Section{id.start + chunk_size, id.length - chunk_size, true});
@@ -25,6 +25,7 @@
 #include <utility>
 #include <vector>
 
+#include "genie/core/stats/stage_timer.h"
 #include "genie/quality/paramqv1/qv_coding_config_1.h"
 #include "genie/read/spring/call_template_functions.h"
 #include "genie/read/spring/encoder_source.h"
@@ -33,6 +34,7 @@
 #include "genie/util/log.h"
 #include "genie/util/stop_watch.h"
 #include "genie/util/thread_manager.h"
+#include "genie/util/trace.h"
 
 // -----------------------------------------------------------------------------
 
@@ -43,7 +45,12 @@ namespace genie::read::spring {
 // -----------------------------------------------------------------------------
 
 void Encoder::FlowIn(core::record::Chunk&& t, const util::Section& id) {
+  core::stats::StageTimer timer(core::stats::Stage::kReadCoding);
+  util::TraceScope trace("flow-in", "read-coding",
+                         static_cast<int64_t>(id.start));
   preprocessor_.Preprocess(std::move(t), id);
+  trace.Stop();
+  timer.Stop();
   SkipOut(id);
 }
 
@@ -54,6 +61,8 @@ void Encoder::FlushIn(uint64_t& pos) {
     FlushOut(pos);
     return;
   }
+  // Only the calling thread is charged, not the workers spawned from here
+  core::stats::StageTimer timer(core::stats::Stage::kReadCoding);
   preprocessor_.Finish(pos);
   const std::string paired_end_str =
       preprocessor_.cp.paired_end ? "(paired-end)" : "(single-end)";
@@ -88,6 +97,7 @@ void Encoder::FlushIn(uint64_t& pos) {
                              write_out_streams_);
     stats.AddDouble("time-spring-quality-name", watch.Check());
   }
+  timer.Stop();
 
   UTILS_LOG(util::Logger::Severity::INFO, "Writing encoded data to output");
   SpringSource src(this->preprocessor_.temp_dir, this->preprocessor_.cp, params,
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file mapped_file.cc
+ * @brief Implementation of the MappedFile class.
+ *
+ * @copyright This file is part of Genie
+ * See LICENSE and/or visit https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/util/mapped_file.h"
+
+#include <fstream>
+#include <iterator>
+
+#include "genie/util/runtime_exception.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// -----------------------------------------------------------------------------
+
+namespace genie::util {
+
+// -----------------------------------------------------------------------------
+
+MappedFile::MappedFile(const std::string& path)
+    : data_(nullptr), size_(0), mapped_(false) {
+#ifndef _WIN32
+  const int fd = open(path.c_str(), O_RDONLY);
+  UTILS_DIE_IF(fd < 0, "Cannot open file to read: " + path);
+  struct stat info {};
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    UTILS_DIE("Cannot stat file: " + path);
+  }
+  size_ = static_cast<size_t>(info.st_size);
+  if (size_ != 0) {
+    void* map = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED) {
+      // The file is scanned front to back, let the kernel read ahead
+      madvise(map, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(map);
+      mapped_ = true;
+    }
+  }
+  close(fd);
+  if (mapped_ || size_ == 0) {
+    return;
+  }
+#endif
+  // Fallback: read the whole file
+  std::ifstream file(path, std::ios::binary);
+  UTILS_DIE_IF(!file, "Cannot open file to read: " + path);
+  buffer_.assign(std::istreambuf_iterator<char>(file),
+                 std::istreambuf_iterator<char>());
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+}
+
+// -----------------------------------------------------------------------------
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+  if (mapped_) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+#endif
+}
+
+// -----------------------------------------------------------------------------
+
+const char* MappedFile::GetData() const { return data_; }
+
+// -----------------------------------------------------------------------------
+
+size_t MappedFile::GetSize() const { return size_; }
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::util
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
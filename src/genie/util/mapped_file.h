@@ -0,0 +1,77 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file mapped_file.h
+ *
+ * @copyright This file is part of Genie
+ * See LICENSE and/or visit https://github.com/MueFab/genie for more details.
+ *
+ * @brief Declaration of the MappedFile class providing read-only access to a
+ * whole file in memory.
+ *
+ * @details On POSIX systems the file is memory mapped, so only the pages
+ * actually touched are read and multiple threads can scan different parts of
+ * the file without seeking a shared stream. On other systems the file is read
+ * into a buffer.
+ */
+
+#ifndef SRC_GENIE_UTIL_MAPPED_FILE_H_
+#define SRC_GENIE_UTIL_MAPPED_FILE_H_
+
+// -----------------------------------------------------------------------------
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+
+namespace genie::util {
+
+/**
+ * @brief Read-only view of a complete file.
+ */
+class MappedFile {
+ public:
+  /**
+   * @brief Maps a file. Dies if the file can not be opened.
+   * @param path Path of the file.
+   */
+  explicit MappedFile(const std::string& path);
+
+  /**
+   * @brief Unmaps the file.
+   */
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+   * @brief
+   * @return Pointer to the first byte of the file.
+   */
+  [[nodiscard]] const char* GetData() const;
+
+  /**
+   * @brief
+   * @return Size of the file in bytes.
+   */
+  [[nodiscard]] size_t GetSize() const;
+
+ private:
+  const char* data_;          //!< @brief Start of the file contents.
+  size_t size_;               //!< @brief Size of the file contents.
+  bool mapped_;               //!< @brief `data_` is a mapping.
+  std::vector<char> buffer_;  //!< @brief Contents if not mapped.
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::util
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_UTIL_MAPPED_FILE_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
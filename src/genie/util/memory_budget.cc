@@ -0,0 +1,227 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file memory_budget.cc
+ * @brief Implementation of the MemoryBudget class.
+ *
+ * @copyright This file is part of Genie
+ * See LICENSE and/or visit https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/util/memory_budget.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "genie/util/runtime_exception.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::util {
+
+// -----------------------------------------------------------------------------
+
+MemoryBudget::Reservation::Reservation()
+    : budget_(nullptr), bytes_(0), pinned_(false) {}
+
+// -----------------------------------------------------------------------------
+
+MemoryBudget::Reservation::Reservation(MemoryBudget* budget,
+                                       const size_t bytes, const bool pinned)
+    : budget_(budget), bytes_(bytes), pinned_(pinned) {
+  if (budget_) {
+    budget_->Acquire(bytes_, pinned_);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+MemoryBudget::Reservation::~Reservation() { Release(); }
+
+// -----------------------------------------------------------------------------
+
+MemoryBudget::Reservation::Reservation(Reservation&& other) noexcept
+    : budget_(other.budget_), bytes_(other.bytes_), pinned_(other.pinned_) {
+  other.budget_ = nullptr;
+  other.bytes_ = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+MemoryBudget::Reservation& MemoryBudget::Reservation::operator=(
+    Reservation&& other) noexcept {
+  if (this != &other) {
+    Release();
+    budget_ = other.budget_;
+    bytes_ = other.bytes_;
+    pinned_ = other.pinned_;
+    other.budget_ = nullptr;
+    other.bytes_ = 0;
+  }
+  return *this;
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryBudget::Reservation::Grow(const size_t bytes) {
+  if (budget_) {
+    budget_->Acquire(bytes, pinned_);
+    bytes_ += bytes;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryBudget::Reservation::Merge(Reservation&& other) {
+  if (!other.budget_) {
+    return;
+  }
+  if (!budget_) {
+    *this = std::move(other);
+    return;
+  }
+  UTILS_DIE_IF(budget_ != other.budget_,
+               "Can not merge reservations of different budgets");
+  if (other.pinned_ != pinned_) {
+    budget_->Pin(other.bytes_, pinned_);
+  }
+  bytes_ += other.bytes_;
+  other.budget_ = nullptr;
+  other.bytes_ = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryBudget::Reservation::SetPinned(const bool pinned) {
+  if (pinned == pinned_) {
+    return;
+  }
+  if (budget_) {
+    budget_->Pin(bytes_, pinned);
+  }
+  pinned_ = pinned;
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryBudget::Reservation::Release() {
+  if (budget_) {
+    budget_->Return(bytes_, pinned_);
+  }
+  budget_ = nullptr;
+  bytes_ = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+size_t MemoryBudget::Reservation::GetBytes() const { return bytes_; }
+
+// -----------------------------------------------------------------------------
+
+MemoryBudget::MemoryBudget(const size_t limit)
+    : limit_(limit), used_(0), pinned_(0), peak_(0) {}
+
+// -----------------------------------------------------------------------------
+
+void MemoryBudget::SetLimit(const size_t limit) {
+  {
+    std::lock_guard lock(mutex_);
+    limit_ = limit;
+  }
+  released_.notify_all();
+}
+
+// -----------------------------------------------------------------------------
+
+MemoryBudget::Reservation MemoryBudget::Reserve(const size_t bytes,
+                                                const bool pinned) {
+  return {this, bytes, pinned};
+}
+
+// -----------------------------------------------------------------------------
+
+bool MemoryBudget::Exhausted() const {
+  return limit_ != 0 && used_ >= limit_ && used_ > pinned_;
+}
+
+// -----------------------------------------------------------------------------
+
+bool MemoryBudget::IsExhausted() const {
+  std::lock_guard lock(mutex_);
+  return Exhausted();
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryBudget::WaitForSpace() {
+  std::unique_lock lock(mutex_);
+  released_.wait(lock, [&] { return !Exhausted(); });
+}
+
+// -----------------------------------------------------------------------------
+
+size_t MemoryBudget::GetLimit() const {
+  std::lock_guard lock(mutex_);
+  return limit_;
+}
+
+// -----------------------------------------------------------------------------
+
+size_t MemoryBudget::GetUsed() const {
+  std::lock_guard lock(mutex_);
+  return used_;
+}
+
+// -----------------------------------------------------------------------------
+
+size_t MemoryBudget::GetPeak() const {
+  std::lock_guard lock(mutex_);
+  return peak_;
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryBudget::Acquire(const size_t bytes, const bool pinned) {
+  std::lock_guard lock(mutex_);
+  used_ += bytes;
+  if (pinned) {
+    pinned_ += bytes;
+  }
+  peak_ = std::max(peak_, used_);
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryBudget::Return(const size_t bytes, const bool pinned) {
+  {
+    std::lock_guard lock(mutex_);
+    used_ -= bytes;
+    if (pinned) {
+      pinned_ -= bytes;
+    }
+  }
+  released_.notify_all();
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryBudget::Pin(const size_t bytes, const bool pinned) {
+  {
+    std::lock_guard lock(mutex_);
+    if (pinned) {
+      pinned_ += bytes;
+    } else {
+      pinned_ -= bytes;
+    }
+  }
+  // Unpinned bytes do not wake up anyone, but pinned ones may end a wait
+  if (pinned) {
+    released_.notify_all();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::util
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
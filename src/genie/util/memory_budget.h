@@ -0,0 +1,210 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file memory_budget.h
+ *
+ * @copyright This file is part of Genie
+ * See LICENSE and/or visit https://github.com/MueFab/genie for more details.
+ *
+ * @brief Declaration of the MemoryBudget class for bounding the data held by
+ * a pipeline.
+ *
+ * @details Stages of a pipeline reserve bytes from a shared budget for the
+ * data they hold. Reservations travel with the data and return their bytes
+ * to the budget when they are destroyed. The source of the pipeline waits
+ * for the budget before producing more data. Reservations can be pinned:
+ * pinned bytes are held by a stage that can only release them after more
+ * input arrived, so the source never waits for them.
+ */
+
+#ifndef SRC_GENIE_UTIL_MEMORY_BUDGET_H_
+#define SRC_GENIE_UTIL_MEMORY_BUDGET_H_
+
+// -----------------------------------------------------------------------------
+
+#include <condition_variable>  // NOLINT
+#include <cstddef>
+#include <mutex>  // NOLINT
+
+// -----------------------------------------------------------------------------
+
+namespace genie::util {
+
+/**
+ * @brief Shared upper bound for the bytes held by the stages of a pipeline.
+ */
+class MemoryBudget {
+ public:
+  /**
+   * @brief Bytes reserved from a budget. Returns them when destroyed.
+   */
+  class Reservation {
+    MemoryBudget* budget_;  //!< @brief Budget, nullptr if not reserved.
+    size_t bytes_;          //!< @brief Reserved bytes.
+    bool pinned_;           //!< @brief Bytes are pinned, see SetPinned().
+
+   public:
+    /**
+     * @brief Creates an empty reservation.
+     */
+    Reservation();
+
+    /**
+     * @brief Reserves bytes from a budget, see MemoryBudget::Reserve().
+     * @param budget Budget, may be nullptr.
+     * @param bytes Bytes to reserve.
+     * @param pinned Pin the bytes.
+     */
+    Reservation(MemoryBudget* budget, size_t bytes, bool pinned);
+
+    /**
+     * @brief Returns the bytes to the budget.
+     */
+    ~Reservation();
+
+    Reservation(const Reservation&) = delete;
+    Reservation& operator=(const Reservation&) = delete;
+
+    /**
+     * @brief Takes over the bytes of another reservation.
+     * @param other Reservation to take over, is left empty.
+     */
+    Reservation(Reservation&& other) noexcept;
+
+    /**
+     * @brief Returns the own bytes and takes over those of another
+     * reservation.
+     * @param other Reservation to take over, is left empty.
+     * @return This.
+     */
+    Reservation& operator=(Reservation&& other) noexcept;
+
+    /**
+     * @brief Reserves additional bytes from the same budget.
+     * @param bytes Additional bytes.
+     */
+    void Grow(size_t bytes);
+
+    /**
+     * @brief Merges another reservation of the same budget into this one.
+     * @param other Reservation to take over, is left empty.
+     */
+    void Merge(Reservation&& other);
+
+    /**
+     * @brief Pins or unpins the reserved bytes. Stages which need more input
+     * to release their data (e.g. regrouping) pin it; the source does not
+     * wait for pinned bytes, as that would never end.
+     * @param pinned New state.
+     */
+    void SetPinned(bool pinned);
+
+    /**
+     * @brief Returns the bytes to the budget and leaves the reservation empty.
+     */
+    void Release();
+
+    /**
+     * @brief
+     * @return Reserved bytes.
+     */
+    [[nodiscard]] size_t GetBytes() const;
+  };
+
+  /**
+   * @brief Creates a budget.
+   * @param limit Maximum number of bytes, 0 for no limit.
+   */
+  explicit MemoryBudget(size_t limit = 0);
+
+  /**
+   * @brief Changes the limit. Waiting sources are woken up.
+   * @param limit Maximum number of bytes, 0 for no limit.
+   */
+  void SetLimit(size_t limit);
+
+  /**
+   * @brief Reserves bytes. Never blocks, stages always accept the data they
+   * are handed; only the source waits, see WaitForSpace().
+   * @param bytes Bytes to reserve.
+   * @param pinned Pin the bytes, see Reservation::SetPinned().
+   * @return The reservation.
+   */
+  Reservation Reserve(size_t bytes, bool pinned = false);
+
+  /**
+   * @brief Checks if a source has to wait before producing more data.
+   * @return True if the limit is reached and unpinned bytes are still held.
+   */
+  [[nodiscard]] bool IsExhausted() const;
+
+  /**
+   * @brief Blocks while the budget is exhausted.
+   */
+  void WaitForSpace();
+
+  /**
+   * @brief
+   * @return Maximum number of bytes, 0 for no limit.
+   */
+  [[nodiscard]] size_t GetLimit() const;
+
+  /**
+   * @brief
+   * @return Bytes currently reserved.
+   */
+  [[nodiscard]] size_t GetUsed() const;
+
+  /**
+   * @brief
+   * @return Maximum number of bytes reserved at the same time so far.
+   */
+  [[nodiscard]] size_t GetPeak() const;
+
+ private:
+  /**
+   * @brief Updates the counters. Called by reservations.
+   * @param bytes Bytes to add.
+   * @param pinned Whether the bytes are pinned.
+   */
+  void Acquire(size_t bytes, bool pinned);
+
+  /**
+   * @brief Updates the counters and wakes up waiting sources. Called by
+   * reservations.
+   * @param bytes Bytes to remove.
+   * @param pinned Whether the bytes were pinned.
+   */
+  void Return(size_t bytes, bool pinned);
+
+  /**
+   * @brief Moves bytes between the pinned and unpinned counters.
+   * @param bytes Bytes to move.
+   * @param pinned New state of the bytes.
+   */
+  void Pin(size_t bytes, bool pinned);
+
+  /**
+   * @brief See IsExhausted(). Must hold `mutex_`.
+   * @return True if the source has to wait.
+   */
+  [[nodiscard]] bool Exhausted() const;
+
+  mutable std::mutex mutex_;          //!< @brief Guards the counters.
+  std::condition_variable released_;  //!< @brief Signals returned bytes.
+
+  size_t limit_;   //!< @brief Maximum number of bytes, 0 for no limit.
+  size_t used_;    //!< @brief Currently reserved bytes.
+  size_t pinned_;  //!< @brief Currently reserved bytes which are pinned.
+  size_t peak_;    //!< @brief Maximum of `used_`.
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::util
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_UTIL_MEMORY_BUDGET_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
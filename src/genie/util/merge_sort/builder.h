@@ -10,6 +10,8 @@
 
 // -----------------------------------------------------------------------------
 
+#include <deque>
+#include <future>  // NOLINT
 #include <memory>
 #include <string>
 #include <vector>
@@ -34,15 +36,35 @@ namespace genie::util::merge_sort {
  * @tparam SortFun Function to compare two records during sorting.
  * Signature: bool (const T&, const T&). It should return true if the first
  * Element is less than the second.
+ *
+ * With more than one thread, full chunks are sorted and written in the
+ * background while the next chunk is filled. At most `threads` chunks are in
+ * flight, so memory stays bounded by `threads + 1` chunks.
+ *
+ * Chunks on disk are closed until they are merged. If there are more of them
+ * than the maximum fan-in, Finish() first merges groups of them into larger
+ * chunks, so that no more than `max_fan_in` files are open at any time.
  */
 template <class T, typename ReadRecFun, typename WriteRecFun, typename SortFun>
 class Builder {
-  /// Chunks of data (including those on disk)
-  std::vector<std::unique_ptr<Chunk<T>>> chunks_;
+  /// Files of the sorted chunks written so far, oldest first
+  std::deque<std::string> runs_;
 
   /// Current chunk of data (in memory)
   std::unique_ptr<ChunkMemory<T>> cur_chunk_;
 
+  /// Chunks being sorted and written in the background, oldest first
+  std::deque<std::future<std::string>> spilling_;
+
+  /// Number of chunks started so far, used to name the files
+  size_t num_chunks_;
+
+  /// Maximum number of chunks sorted and written in parallel
+  size_t threads_;
+
+  /// Maximum number of files merged at once
+  size_t max_fan_in_;
+
   /// Maximum size of a chunk
   size_t chunk_size_;
 
@@ -58,7 +80,16 @@ class Builder {
   /// Function to compare two records during sorting
   SortFun sort_fun_;
 
+  /**
+   * @brief Merge the oldest files into a new file at the end of the list
+   * @param count Number of files to merge
+   */
+  void MergeRuns(size_t count);
+
  public:
+  /// Maximum fan-in if none is given
+  static constexpr size_t kDefaultMaxFanIn = 64;
+
   /**
    * @brief Construct a new MergeSortChunkBuilder object
    * @param chunk_size Maximum size of a chunk. 0 = infinite
@@ -66,15 +97,35 @@ class Builder {
    * @param read_fun Function to read a record from a file.
    * @param write_fun Function to write a record to a file.
    * @param sort_fun Function to compare two records during sorting.
+   * @param threads Maximum number of chunks sorted and written in parallel.
+   * 1 = sort and write synchronously.
+   * @param max_fan_in Maximum number of files merged at once, at least 2
    */
   Builder(size_t chunk_size, std::string file_base_name, ReadRecFun read_fun,
-          WriteRecFun write_fun, SortFun sort_fun);
+          WriteRecFun write_fun, SortFun sort_fun, size_t threads = 1,
+          size_t max_fan_in = kDefaultMaxFanIn);
 
   /**
-   * @brief Manually start a new chunk
+   * @brief Wait for chunks still being written and delete the files not
+   * handed to a merger
+   */
+  ~Builder();
+
+  Builder(const Builder&) = delete;             //!< @brief
+  Builder& operator=(const Builder&) = delete;  //!< @brief
+
+  /**
+   * @brief Manually start a new chunk. The current chunk is sorted and
+   * written to a file, in the background if more than one thread is allowed.
    */
   void NewChunk();
 
+  /**
+   * @brief Number of records in the chunk currently filled
+   * @return Number of records
+   */
+  [[nodiscard]] size_t GetCurrentChunkSize() const;
+
   /**
    * @brief Add a record to the builder
    * @param record Record to add
@@ -82,7 +133,8 @@ class Builder {
   void AddRecord(T record);
 
   /**
-   * @brief Finish the builder and return a MergeSortMerger object
+   * @brief Finish the builder and return a MergeSortMerger object. Files
+   * beyond the maximum fan-in are merged into larger files first.
    * @param force_file If true, the last chunk is written to a file. Otherwise,
    * it remains in memory for the subsequent MergeSortMerger object
    * @return MergeSortMerger<T, SortFun>
@@ -10,11 +10,19 @@
 
 // -----------------------------------------------------------------------------
 
+#include <algorithm>
+#include <filesystem>  // NOLINT
+#include <fstream>
+#include <future>  // NOLINT
 #include <memory>
 #include <string>
+#include <system_error>
 #include <utility>
+#include <vector>
 
-#include "genie//util/merge_sort/builder.h"
+#include "genie/util/merge_sort/builder.h"
+#include "genie/util/merge_sort/chunk_file.h"
+#include "genie/util/runtime_exception.h"
 
 // -----------------------------------------------------------------------------
 
@@ -22,21 +30,45 @@ namespace genie::util::merge_sort {
 template <class T, typename ReadRecFun, typename WriteRecFun, typename SortFun>
 Builder<T, ReadRecFun, WriteRecFun, SortFun>::Builder(
     const size_t chunk_size, std::string file_base_name, ReadRecFun read_fun,
-    WriteRecFun write_fun, SortFun sort_fun)
-    : chunk_size_(chunk_size),
+    WriteRecFun write_fun, SortFun sort_fun, const size_t threads,
+    const size_t max_fan_in)
+    : num_chunks_(0),
+      threads_(threads),
+      max_fan_in_(max_fan_in),
+      chunk_size_(chunk_size),
       file_base_name_(std::move(file_base_name)),
       read_fun_(read_fun),
       write_fun_(write_fun),
       sort_fun_(sort_fun) {
+  UTILS_DIE_IF(max_fan_in_ < 2, "Merge fan-in must be at least 2");
   cur_chunk_ = std::make_unique<ChunkMemory<T>>();
 }
 
 // -----------------------------------------------------------------------------
 
+template <class T, typename ReadRecFun, typename WriteRecFun, typename SortFun>
+Builder<T, ReadRecFun, WriteRecFun, SortFun>::~Builder() {
+  for (auto& f : spilling_) {
+    if (f.valid()) {
+      try {
+        runs_.emplace_back(f.get());
+      } catch (...) {
+        // The chunk was not written, there is no file to delete
+      }
+    }
+  }
+  for (const auto& r : runs_) {
+    std::error_code error;
+    std::filesystem::remove(r, error);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 template <class T, typename ReadRecFun, typename WriteRecFun, typename SortFun>
 void Builder<T, ReadRecFun, WriteRecFun, SortFun>::AddRecord(T record) {
   cur_chunk_->AddRecord(std::move(record));
-  if (cur_chunk_->size() >= chunk_size_) {
+  if (chunk_size_ != 0 && cur_chunk_->size() >= chunk_size_) {
     NewChunk();
   }
 }
@@ -45,10 +77,53 @@ void Builder<T, ReadRecFun, WriteRecFun, SortFun>::AddRecord(T record) {
 
 template <class T, typename ReadRecFun, typename WriteRecFun, typename SortFun>
 void Builder<T, ReadRecFun, WriteRecFun, SortFun>::NewChunk() {
-  cur_chunk_->sort(sort_fun_);
-  chunks_.emplace_back(cur_chunk_->ToFile(
-      file_base_name_ + std::to_string(chunks_.size()), read_fun_, write_fun_));
+  auto spill = [chunk = std::move(cur_chunk_),
+                name = file_base_name_ + std::to_string(num_chunks_++),
+                write_fun = write_fun_, sort_fun = sort_fun_]() -> std::string {
+    chunk->sort(sort_fun);
+    chunk->Write(name, write_fun);
+    return name;
+  };
   cur_chunk_ = std::make_unique<ChunkMemory<T>>();
+  if (threads_ <= 1) {
+    runs_.emplace_back(spill());
+    return;
+  }
+  while (spilling_.size() >= threads_) {
+    runs_.emplace_back(spilling_.front().get());
+    spilling_.pop_front();
+  }
+  spilling_.emplace_back(std::async(std::launch::async, std::move(spill)));
+}
+
+// -----------------------------------------------------------------------------
+
+template <class T, typename ReadRecFun, typename WriteRecFun, typename SortFun>
+size_t Builder<T, ReadRecFun, WriteRecFun, SortFun>::GetCurrentChunkSize()
+    const {
+  return cur_chunk_->size();
+}
+
+// -----------------------------------------------------------------------------
+
+template <class T, typename ReadRecFun, typename WriteRecFun, typename SortFun>
+void Builder<T, ReadRecFun, WriteRecFun, SortFun>::MergeRuns(
+    const size_t count) {
+  std::vector<std::unique_ptr<Chunk<T>>> inputs;
+  inputs.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    // The chunk owns the file from here on and deletes it once merged
+    inputs.emplace_back(
+        std::make_unique<ChunkFile<T, ReadRecFun>>(runs_.front(), read_fun_));
+    runs_.pop_front();
+  }
+  runs_.emplace_back(file_base_name_ + std::to_string(num_chunks_++));
+  Merger<T, SortFun> merger(sort_fun_, std::move(inputs));
+  std::ofstream outfile(runs_.back(), std::ios::binary);
+  while (!merger.IsEmpty()) {
+    write_fun_(outfile, merger.Get());
+  }
+  UTILS_DIE_IF(!outfile, "MergeSortBuilder output error");
 }
 
 // -----------------------------------------------------------------------------
@@ -56,18 +131,36 @@ void Builder<T, ReadRecFun, WriteRecFun, SortFun>::NewChunk() {
 template <class T, typename ReadRecFun, typename WriteRecFun, typename SortFun>
 Merger<T, SortFun> Builder<T, ReadRecFun, WriteRecFun, SortFun>::Finish(
     const bool force_file) {
-  if (cur_chunk_->IsEmpty()) {
-    return Merger<T, SortFun>(sort_fun_, std::move(chunks_));
+  while (!spilling_.empty()) {
+    runs_.emplace_back(spilling_.front().get());
+    spilling_.pop_front();
+  }
+  std::unique_ptr<Chunk<T>> last_chunk;
+  if (!cur_chunk_->IsEmpty()) {
+    cur_chunk_->sort(sort_fun_);
+    if (force_file) {
+      runs_.emplace_back(file_base_name_ + std::to_string(num_chunks_++));
+      cur_chunk_->Write(runs_.back(), write_fun_);
+    } else {
+      last_chunk = std::move(cur_chunk_);
+    }
+  }
+
+  // Merge just enough of the oldest, smallest files to leave max_fan_in_
+  while (runs_.size() > max_fan_in_) {
+    MergeRuns(std::min(max_fan_in_, runs_.size() - max_fan_in_ + 1));
+  }
+
+  std::vector<std::unique_ptr<Chunk<T>>> chunks;
+  while (!runs_.empty()) {
+    chunks.emplace_back(
+        std::make_unique<ChunkFile<T, ReadRecFun>>(runs_.front(), read_fun_));
+    runs_.pop_front();
   }
-  cur_chunk_->sort(sort_fun_);
-  if (force_file) {
-    chunks_.emplace_back(
-        cur_chunk_->ToFile(file_base_name_ + std::to_string(chunks_.size()),
-                           read_fun_, write_fun_));
-  } else {
-    chunks_.emplace_back(std::move(cur_chunk_));
+  if (last_chunk) {
+    chunks.emplace_back(std::move(last_chunk));
   }
-  return Merger<T, SortFun>(sort_fun_, std::move(chunks_));
+  return Merger<T, SortFun>(sort_fun_, std::move(chunks));
 }
 
 // -----------------------------------------------------------------------------
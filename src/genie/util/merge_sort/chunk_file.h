@@ -52,6 +52,14 @@ class ChunkFile final : public Chunk<T> {
   explicit ChunkFile(std::vector<T> sorted_records, const std::string& filename,
                      WriteRecFun write_fun, ReadRecFun fun);
 
+  /**
+   * @brief Open a file of sorted records that was written before
+   * @param filename Name of the file, which is deleted with the chunk
+   * @param fun Function to read a record from a file.
+   * Signature: std::optional<T> (std::ifstream&)
+   */
+  ChunkFile(const std::string& filename, ReadRecFun fun);
+
   /**
    * @brief Destroy the MergeSortChunkFile object and delete the file
    */
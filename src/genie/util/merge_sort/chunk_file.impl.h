@@ -26,14 +26,24 @@ ChunkFile<T, ReadRecFun>::ChunkFile(std::vector<T> sorted_records,
                                     WriteRecFun write_fun, ReadRecFun fun)
     : filename_(filename), read_fun_(fun) {
   {
-    std::ofstream outfile(filename);
+    std::ofstream outfile(filename, std::ios::binary);
 
     for (const auto& r : sorted_records) {
       write_fun(outfile, r);
     }
   }
   sorted_records.clear();
-  file_ = std::ifstream(filename);
+  file_ = std::ifstream(filename, std::ios::binary);
+  UTILS_DIE_IF(!file_, "MergeSortChunkFile input error");
+  cur_record_ = read_fun_(file_);
+}
+
+// -----------------------------------------------------------------------------
+
+template <class T, typename ReadRecFun>
+ChunkFile<T, ReadRecFun>::ChunkFile(const std::string& filename,
+                                    ReadRecFun fun)
+    : file_(filename, std::ios::binary), filename_(filename), read_fun_(fun) {
   UTILS_DIE_IF(!file_, "MergeSortChunkFile input error");
   cur_record_ = read_fun_(file_);
 }
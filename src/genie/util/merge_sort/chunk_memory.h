@@ -76,6 +76,17 @@ class ChunkMemory final : public Chunk<T> {
   [[nodiscard]] std::unique_ptr<ChunkFile<T, ReadRecFun>> ToFile(
       const std::string& name, ReadRecFun read_fun, WriteRecFun write_fun);
 
+  /**
+   * @brief Write the records to a file without opening it for reading, and
+   * release them
+   * @tparam WriteRecFun Function to write a record to a file.
+   * Signature: void (std::ofstream&, const T&)
+   * @param name Name of the file
+   * @param write_fun Function to write a record to a file.
+   */
+  template <typename WriteRecFun>
+  void Write(const std::string& name, WriteRecFun write_fun);
+
   /**
    * @brief Add a record to the chunk
    * @param record Record to add
@@ -9,11 +9,14 @@
 #define SRC_GENIE_UTIL_MERGE_SORT_CHUNK_MEMORY_IMPL_H_
 
 #include <algorithm>
+#include <fstream>
 #include <string>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "genie/util/merge_sort/chunk_memory.h"
+#include "genie/util/runtime_exception.h"
 
 // -----------------------------------------------------------------------------
 
@@ -64,6 +67,22 @@ std::unique_ptr<ChunkFile<T, ReadRecFun>> ChunkMemory<T>::ToFile(
 
 // -----------------------------------------------------------------------------
 
+template <class T>
+template <typename WriteRecFun>
+void ChunkMemory<T>::Write(const std::string& name, WriteRecFun write_fun) {
+  {
+    std::ofstream outfile(name, std::ios::binary);
+    for (const auto& r : records_) {
+      write_fun(outfile, r);
+    }
+    UTILS_DIE_IF(!outfile, "MergeSortChunkMemory output error");
+  }
+  records_ = std::vector<T>();
+  pos_ = 0;
+}
+
+// -----------------------------------------------------------------------------
+
 template <class T>
 void ChunkMemory<T>::AddRecord(T record) {
   records_.emplace_back(std::move(record));
@@ -31,16 +31,17 @@ namespace genie::util::merge_sort {
 template <class T, typename SortFun>
 class Merger {
   class Comparer {
-    const SortFun& sort_fun_;
-    const std::vector<std::unique_ptr<Chunk<T>>>& chunks_;
+    const SortFun* sort_fun_;
+    const std::vector<std::unique_ptr<Chunk<T>>>* chunks_;
 
    public:
     explicit Comparer(const SortFun& sort_fun,
                       const std::vector<std::unique_ptr<Chunk<T>>>& chunks)
-        : sort_fun_(sort_fun), chunks_(chunks) {}
+        : sort_fun_(&sort_fun), chunks_(&chunks) {}
 
     bool operator()(const size_t a, const size_t b) const {
-      return !sort_fun_(chunks_[a]->Top(), chunks_[b]->Top());
+      // Max-heap order: b comes first if it is less than a
+      return (*sort_fun_)((*chunks_)[b]->Top(), (*chunks_)[a]->Top());
     }
   };
 
@@ -66,12 +67,29 @@ class Merger {
   explicit Merger(SortFun sort_fun,
                   std::vector<std::unique_ptr<Chunk<T>>> chunks);
 
+  /**
+   * @brief Take over the chunks of another merger. The comparator refers to
+   * members, so the queue is rebuilt instead of moved.
+   * @param other Merger to take over
+   */
+  Merger(Merger&& other) noexcept;
+
+  Merger(const Merger&) = delete;             //!< @brief
+  Merger& operator=(const Merger&) = delete;  //!< @brief
+  Merger& operator=(Merger&&) = delete;       //!< @brief
+
   /**
    * @brief Check if there are no more records in the merger
    * @return True if the merger is empty
    */
   [[nodiscard]] bool IsEmpty() const;
 
+  /**
+   * @brief Lookup the next element in the merger without removing it
+   * @return The next element
+   */
+  [[nodiscard]] const T& Top() const;
+
   /**
    * @brief Lookup and move the next element in the merger
    * @return The next element
@@ -36,6 +36,14 @@ Merger<T, SortFun>::Merger(SortFun sort_fun,
 
 // -----------------------------------------------------------------------------
 
+template <class T, typename SortFun>
+Merger<T, SortFun>::Merger(Merger&& other) noexcept
+    : Merger(std::move(other.sort_fun_), std::move(other.chunks_)) {
+  other.queue_ = decltype(queue_)(other.cmp_);
+}
+
+// -----------------------------------------------------------------------------
+
 template <class T, typename SortFun>
 bool Merger<T, SortFun>::IsEmpty() const {
   return queue_.empty();
@@ -43,6 +51,13 @@ bool Merger<T, SortFun>::IsEmpty() const {
 
 // -----------------------------------------------------------------------------
 
+template <class T, typename SortFun>
+const T& Merger<T, SortFun>::Top() const {
+  return chunks_[queue_.top()]->Top();
+}
+
+// -----------------------------------------------------------------------------
+
 template <class T, typename SortFun>
 T Merger<T, SortFun>::Get() {
   const auto idx = queue_.top();
@@ -0,0 +1,136 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file object_pool.h
+ *
+ * @copyright This file is part of Genie
+ * See LICENSE and/or visit https://github.com/MueFab/genie for more details.
+ *
+ * @brief Declaration of the ObjectPool class template for reusing expensive
+ * objects across calls.
+ *
+ * @details Objects are lent out for the duration of a call and returned
+ * afterwards, so a pool holds at most as many objects as threads ever used it
+ * concurrently. Unlike thread local storage, the objects are owned by the pool
+ * and are freed together with it.
+ */
+
+#ifndef SRC_GENIE_UTIL_OBJECT_POOL_H_
+#define SRC_GENIE_UTIL_OBJECT_POOL_H_
+
+// -----------------------------------------------------------------------------
+
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <vector>
+
+// -----------------------------------------------------------------------------
+
+namespace genie::util {
+
+/**
+ * @brief Pool of reusable objects.
+ *
+ * @tparam Type The type of the pooled objects.
+ */
+template <typename Type>
+class ObjectPool {
+ public:
+  /// Creates a new object if the pool is empty.
+  using Factory = std::function<std::unique_ptr<Type>()>;
+
+  /**
+   * @brief An object borrowed from the pool, returned on destruction.
+   */
+  class Lease {
+   public:
+    /**
+     * @brief Returns the object to the pool.
+     */
+    ~Lease();
+
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+
+    /**
+     * @brief Takes over another lease.
+     * @param other Lease to move from, empty afterwards.
+     */
+    Lease(Lease&& other) noexcept = default;
+
+    /**
+     * @brief
+     * @return The borrowed object.
+     */
+    Type& operator*() const;
+
+    /**
+     * @brief
+     * @return The borrowed object.
+     */
+    Type* operator->() const;
+
+   private:
+    friend class ObjectPool;
+
+    /**
+     * @brief Constructs a lease.
+     * @param pool Owner of the object.
+     * @param object The borrowed object.
+     */
+    Lease(ObjectPool* pool, std::unique_ptr<Type> object);
+
+    ObjectPool* pool_;              //!< @brief Owner of the object.
+    std::unique_ptr<Type> object_;  //!< @brief The borrowed object.
+  };
+
+  /**
+   * @brief Constructs an empty pool.
+   * @param factory Creates new objects, default constructs by default.
+   */
+  explicit ObjectPool(Factory factory = [] {
+    return std::make_unique<Type>();
+  });
+
+  ObjectPool(const ObjectPool&) = delete;
+  ObjectPool& operator=(const ObjectPool&) = delete;
+
+  /**
+   * @brief Borrows an object, creating one if none is available. The pool
+   * must outlive the lease.
+   * @return The lease.
+   */
+  Lease Acquire();
+
+  /**
+   * @brief
+   * @return Number of objects currently available in the pool.
+   */
+  size_t GetAvailable() const;
+
+ private:
+  /**
+   * @brief Returns an object to the pool.
+   * @param object The object.
+   */
+  void Release(std::unique_ptr<Type> object);
+
+  Factory factory_;                          //!< @brief Creates new objects.
+  mutable std::mutex mutex_;                 //!< @brief Guards `available_`.
+  std::vector<std::unique_ptr<Type>> available_;  //!< @brief Idle objects.
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::util
+
+// -----------------------------------------------------------------------------
+
+#include "genie/util/object_pool.impl.h"  // NOLINT
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_UTIL_OBJECT_POOL_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
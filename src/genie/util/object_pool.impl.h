@@ -0,0 +1,97 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file object_pool.impl.h
+ * @brief Implementation of the ObjectPool class template.
+ *
+ * @copyright This file is part of Genie
+ * See LICENSE and/or visit https://github.com/MueFab/genie for more details.
+ */
+
+#ifndef SRC_GENIE_UTIL_OBJECT_POOL_IMPL_H_
+#define SRC_GENIE_UTIL_OBJECT_POOL_IMPL_H_
+
+// -----------------------------------------------------------------------------
+
+#include <memory>
+#include <utility>
+
+// -----------------------------------------------------------------------------
+
+namespace genie::util {
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+ObjectPool<Type>::Lease::Lease(ObjectPool* pool, std::unique_ptr<Type> object)
+    : pool_(pool), object_(std::move(object)) {}
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+ObjectPool<Type>::Lease::~Lease() {
+  if (object_) {
+    pool_->Release(std::move(object_));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+Type& ObjectPool<Type>::Lease::operator*() const {
+  return *object_;
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+Type* ObjectPool<Type>::Lease::operator->() const {
+  return object_.get();
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+ObjectPool<Type>::ObjectPool(Factory factory) : factory_(std::move(factory)) {}
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+typename ObjectPool<Type>::Lease ObjectPool<Type>::Acquire() {
+  {
+    std::lock_guard lock(mutex_);
+    if (!available_.empty()) {
+      auto object = std::move(available_.back());
+      available_.pop_back();
+      return Lease(this, std::move(object));
+    }
+  }
+  // Create outside the lock, construction may be expensive
+  return Lease(this, factory_());
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+size_t ObjectPool<Type>::GetAvailable() const {
+  std::lock_guard lock(mutex_);
+  return available_.size();
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+void ObjectPool<Type>::Release(std::unique_ptr<Type> object) {
+  std::lock_guard lock(mutex_);
+  available_.push_back(std::move(object));
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::util
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_UTIL_OBJECT_POOL_IMPL_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -20,6 +20,10 @@
 
 #include "genie/util/ordered_section.h"
 
+#include <cstdint>
+
+#include "genie/util/trace.h"
+
 // -----------------------------------------------------------------------------
 
 namespace genie::util {
@@ -28,6 +32,7 @@ namespace genie::util {
 
 OrderedSection::OrderedSection(OrderedLock* lock, const Section& id)
     : lock_(lock), length_(id.length) {
+  TraceScope trace("ordered-wait", "wait", static_cast<int64_t>(id.start));
   lock_->Wait(id.start);
 }
 
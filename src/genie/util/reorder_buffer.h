@@ -0,0 +1,161 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file reorder_buffer.h
+ *
+ * @copyright This file is part of Genie
+ * See LICENSE and/or visit https://github.com/MueFab/genie for more details.
+ *
+ * @brief Declaration of the ReorderBuffer class template for asynchronous,
+ * ordered output.
+ *
+ * @details Sections of a multithreaded pipeline finish out of order, but
+ * output has to be written in section order. `OrderedSection` achieves this
+ * by blocking each worker until all earlier sections have been written, so a
+ * single slow section stalls every other worker. A `ReorderBuffer` instead
+ * owns a dedicated writer thread. Workers hand their finished items over and
+ * return immediately; the writer consumes them in order of `Section::start`.
+ * Workers only block if the buffer is full, which bounds the memory held by
+ * out of order items.
+ */
+
+#ifndef SRC_GENIE_UTIL_REORDER_BUFFER_H_
+#define SRC_GENIE_UTIL_REORDER_BUFFER_H_
+
+// -----------------------------------------------------------------------------
+
+#include <condition_variable>  // NOLINT
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>  // NOLINT
+#include <optional>
+#include <thread>  // NOLINT
+
+#include "genie/util/drain.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::util {
+
+/**
+ * @brief Passes items to a consumer on a dedicated thread, in section order.
+ *
+ * @tparam Type The type of the buffered items.
+ */
+template <typename Type>
+class ReorderBuffer {
+ public:
+  /// Default maximum number of buffered items.
+  static constexpr size_t kDefaultCapacity = 16;
+
+  /**
+   * @brief Function writing one item. Called on the writer thread only, so
+   * it may access output state without further synchronization.
+   */
+  using Consumer = std::function<void(Type&&)>;
+
+  /**
+   * @brief Starts the writer thread.
+   *
+   * @param consumer Function called for every item, in section order.
+   * @param capacity Maximum number of buffered items. The item of the next
+   * section in order is always accepted, so the buffer can not dead lock.
+   */
+  explicit ReorderBuffer(Consumer consumer,
+                         size_t capacity = kDefaultCapacity);
+
+  /**
+   * @brief Stops the writer thread. Items which have not been consumed yet
+   * are discarded, call Flush() first to write everything.
+   */
+  ~ReorderBuffer();
+
+  ReorderBuffer(const ReorderBuffer&) = delete;
+  ReorderBuffer& operator=(const ReorderBuffer&) = delete;
+
+  /**
+   * @brief Hands an item over to the writer thread.
+   *
+   * Blocks only while the buffer is full and the item is not the next one
+   * in order. Rethrows any exception raised by the consumer. Each producer
+   * thread has to hand over its own sections in increasing order, as the
+   * pipeline workers do.
+   *
+   * @param t The item.
+   * @param id Section of the item.
+   */
+  void Push(Type&& t, const Section& id);
+
+  /**
+   * @brief Marks a section as finished without an item.
+   *
+   * @param id Section to skip.
+   */
+  void Skip(const Section& id);
+
+  /**
+   * @brief Waits until all items handed over so far have been consumed.
+   *
+   * Rethrows any exception raised by the consumer.
+   */
+  void Flush();
+
+ private:
+  /**
+   * @brief A buffered section.
+   */
+  struct Item {
+    Section section;           //!< @brief Section of the item.
+    std::optional<Type> data;  //!< @brief Item, empty for skipped sections.
+  };
+
+  /**
+   * @brief Main loop of the writer thread.
+   */
+  void Run();
+
+  /**
+   * @brief Looks up the item of the next section. Must hold `mutex_`.
+   *
+   * @return Iterator to the item, or `pending_.end()` if it has not arrived.
+   */
+  typename std::multimap<size_t, Item>::iterator Next();
+
+  /**
+   * @brief Enqueues an item, see Push(). Must not hold `mutex_`.
+   *
+   * @param item The item.
+   */
+  void Enqueue(Item&& item);
+
+  Consumer consumer_;  //!< @brief Output function.
+  size_t capacity_;    //!< @brief Maximum number of buffered items.
+
+  std::mutex mutex_;                 //!< @brief Guards all state below.
+  std::condition_variable added_;    //!< @brief Signals new items.
+  std::condition_variable removed_;  //!< @brief Signals consumed items.
+
+  std::multimap<size_t, Item> pending_;  //!< @brief Items by section start.
+  size_t next_;                          //!< @brief Next section to consume.
+  bool busy_;                            //!< @brief Writer is consuming.
+  bool stop_;                            //!< @brief Writer should exit.
+  std::exception_ptr error_;             //!< @brief Consumer exception.
+
+  std::thread writer_;  //!< @brief Writer thread, started last.
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::util
+
+// -----------------------------------------------------------------------------
+
+#include "genie/util/reorder_buffer.impl.h"  // NOLINT
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_UTIL_REORDER_BUFFER_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,160 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file reorder_buffer.impl.h
+ * @brief Implementation of the ReorderBuffer class template.
+ *
+ * @copyright This file is part of Genie
+ * See LICENSE and/or visit https://github.com/MueFab/genie for more details.
+ */
+
+#ifndef SRC_GENIE_UTIL_REORDER_BUFFER_IMPL_H_
+#define SRC_GENIE_UTIL_REORDER_BUFFER_IMPL_H_
+
+// -----------------------------------------------------------------------------
+
+#include <utility>
+
+#include "genie/util/runtime_exception.h"
+#include "genie/util/trace.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::util {
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+ReorderBuffer<Type>::ReorderBuffer(Consumer consumer, const size_t capacity)
+    : consumer_(std::move(consumer)),
+      capacity_(capacity),
+      next_(0),
+      busy_(false),
+      stop_(false) {
+  UTILS_DIE_IF(capacity_ == 0, "Reorder buffer capacity must not be zero");
+  writer_ = std::thread(&ReorderBuffer::Run, this);
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+ReorderBuffer<Type>::~ReorderBuffer() {
+  {
+    std::lock_guard lock(mutex_);
+    stop_ = true;
+  }
+  added_.notify_all();
+  writer_.join();
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+typename std::multimap<size_t, typename ReorderBuffer<Type>::Item>::iterator
+ReorderBuffer<Type>::Next() {
+  auto [begin, end] = pending_.equal_range(next_);
+  // Empty sections do not advance the position, consume them first
+  for (auto it = begin; it != end; ++it) {
+    if (it->second.section.length == 0) {
+      return it;
+    }
+  }
+  return begin != end ? begin : pending_.end();
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+void ReorderBuffer<Type>::Run() {
+  std::unique_lock lock(mutex_);
+  while (true) {
+    added_.wait(lock, [&] { return stop_ || Next() != pending_.end(); });
+    if (stop_) {
+      return;
+    }
+    const auto it = Next();
+    Item item = std::move(it->second);
+    pending_.erase(it);
+    const bool failed = error_ != nullptr;
+    busy_ = true;
+    lock.unlock();
+
+    std::exception_ptr error;
+    if (item.data && !failed) {
+      try {
+        consumer_(std::move(*item.data));
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+    item.data.reset();
+
+    lock.lock();
+    if (error && !error_) {
+      error_ = error;
+    }
+    busy_ = false;
+    next_ += item.section.length;
+    removed_.notify_all();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+void ReorderBuffer<Type>::Enqueue(Item&& item) {
+  std::unique_lock lock(mutex_);
+  {
+    TraceScope trace("reorder-wait", "wait",
+                     static_cast<int64_t>(item.section.start));
+    removed_.wait(lock, [&] {
+      return error_ || item.section.start == next_ ||
+             pending_.size() < capacity_;
+    });
+  }
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+  pending_.emplace(item.section.start, std::move(item));
+  lock.unlock();
+  added_.notify_one();
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+void ReorderBuffer<Type>::Push(Type&& t, const Section& id) {
+  Enqueue(Item{id, std::move(t)});
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+void ReorderBuffer<Type>::Skip(const Section& id) {
+  Enqueue(Item{id, std::nullopt});
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Type>
+void ReorderBuffer<Type>::Flush() {
+  std::unique_lock lock(mutex_);
+  {
+    TraceScope trace("reorder-flush", "wait", TraceScope::kNone);
+    removed_.wait(lock,
+                  [&] { return error_ || (pending_.empty() && !busy_); });
+  }
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::util
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_UTIL_REORDER_BUFFER_IMPL_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
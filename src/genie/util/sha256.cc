@@ -0,0 +1,304 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file sha256.cc
+ * @brief Implementation of the Sha256 class.
+ *
+ * @copyright This file is part of Genie
+ * See LICENSE and/or visit https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/util/sha256.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define GENIE_SHA256_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+// -----------------------------------------------------------------------------
+
+namespace genie::util {
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/// Round constants.
+alignas(16) constexpr uint32_t kRoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+// -----------------------------------------------------------------------------
+
+uint32_t RotateRight(const uint32_t x, const int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Portable compression function.
+ * @param state Intermediate hash value.
+ * @param data Input blocks.
+ * @param blocks Number of 64 byte blocks.
+ */
+void CompressGeneric(uint32_t* state, const uint8_t* data, size_t blocks) {
+  for (; blocks; --blocks, data += 64) {
+    uint32_t w[64];
+    for (size_t i = 0; i < 16; ++i) {
+      w[i] = static_cast<uint32_t>(data[4 * i]) << 24 |
+             static_cast<uint32_t>(data[4 * i + 1]) << 16 |
+             static_cast<uint32_t>(data[4 * i + 2]) << 8 |
+             static_cast<uint32_t>(data[4 * i + 3]);
+    }
+    for (size_t i = 16; i < 64; ++i) {
+      const uint32_t s0 = RotateRight(w[i - 15], 7) ^
+                          RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+      const uint32_t s1 = RotateRight(w[i - 2], 17) ^
+                          RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (size_t i = 0; i < 64; ++i) {
+      const uint32_t s1 =
+          RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+      const uint32_t ch = (e & f) ^ (~e & g);
+      const uint32_t t1 = h + s1 + ch + kRoundConstants[i] + w[i];
+      const uint32_t s0 =
+          RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+      const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+      const uint32_t t2 = s0 + maj;
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+#ifdef GENIE_SHA256_X86
+
+/**
+ * @brief Compression function using the x86 SHA extensions.
+ * @param state Intermediate hash value.
+ * @param data Input blocks.
+ * @param blocks Number of 64 byte blocks.
+ */
+__attribute__((target("sha,sse4.1,ssse3"))) void CompressX86(
+    uint32_t* state, const uint8_t* data, size_t blocks) {
+  const __m128i byte_swap =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  // The instructions expect the state as (A, B, E, F) and (C, D, G, H)
+  __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+  __m128i state1 =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4));
+  tmp = _mm_shuffle_epi32(tmp, 0xB1);
+  state1 = _mm_shuffle_epi32(state1, 0x1B);
+  __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+  for (; blocks; --blocks, data += 64) {
+    const __m128i abef = state0;
+    const __m128i cdgh = state1;
+
+    __m128i msg[4];
+    for (size_t i = 0; i < 4; ++i) {
+      msg[i] = _mm_shuffle_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)),
+          byte_swap);
+    }
+
+    // 16 groups of four rounds. Message words are scheduled in the four
+    // registers of `msg` in a rotating fashion.
+    for (size_t g = 0; g < 16; ++g) {
+      __m128i& cur = msg[g & 3];
+      __m128i& prev = msg[(g + 3) & 3];
+      __m128i& next = msg[(g + 1) & 3];
+      __m128i k = _mm_add_epi32(
+          cur, _mm_load_si128(
+                   reinterpret_cast<const __m128i*>(kRoundConstants + 4 * g)));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, k);
+      if (g >= 3 && g <= 14) {
+        next = _mm_add_epi32(next, _mm_alignr_epi8(cur, prev, 4));
+        next = _mm_sha256msg2_epu32(next, cur);
+      }
+      k = _mm_shuffle_epi32(k, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, k);
+      if (g >= 1 && g <= 12) {
+        prev = _mm_sha256msg1_epu32(prev, cur);
+      }
+    }
+
+    state0 = _mm_add_epi32(state0, abef);
+    state1 = _mm_add_epi32(state1, cdgh);
+  }
+
+  tmp = _mm_shuffle_epi32(state0, 0x1B);
+  state1 = _mm_shuffle_epi32(state1, 0xB1);
+  state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+  state1 = _mm_alignr_epi8(state1, tmp, 8);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state), state0);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), state1);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Checks for SSSE3, SSE4.1 and the SHA extensions.
+ * @return True if CompressX86() can be used.
+ */
+bool CpuHasSha() {
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  const bool ssse3 = ecx & (1u << 9u);
+  const bool sse41 = ecx & (1u << 19u);
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  const bool sha = ebx & (1u << 29u);
+  return ssse3 && sse41 && sha;
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+
+using CompressFunction = void (*)(uint32_t*, const uint8_t*, size_t);
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Selects the compression function once.
+ * @return The fastest supported compression function.
+ */
+CompressFunction GetCompress() {
+  static const CompressFunction compress = [] {
+#ifdef GENIE_SHA256_X86
+    if (CpuHasSha()) {
+      return &CompressX86;
+    }
+#endif
+    return &CompressGeneric;
+  }();
+  return compress;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+Sha256::Sha256()
+    : state_{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f,
+             0x9b05688c, 0x1f83d9ab, 0x5be0cd19},
+      block_{},
+      block_fill_(0),
+      total_(0) {}
+
+// -----------------------------------------------------------------------------
+
+void Sha256::Update(const void* data, size_t length) {
+  auto bytes = static_cast<const uint8_t*>(data);
+  total_ += length;
+  const auto compress = GetCompress();
+  if (block_fill_) {
+    const size_t n = std::min(length, block_.size() - block_fill_);
+    std::memcpy(block_.data() + block_fill_, bytes, n);
+    block_fill_ += n;
+    bytes += n;
+    length -= n;
+    if (block_fill_ < block_.size()) {
+      return;
+    }
+    compress(state_.data(), block_.data(), 1);
+    block_fill_ = 0;
+  }
+  if (const size_t blocks = length / 64) {
+    compress(state_.data(), bytes, blocks);
+    bytes += blocks * 64;
+    length -= blocks * 64;
+  }
+  std::memcpy(block_.data(), bytes, length);
+  block_fill_ = length;
+}
+
+// -----------------------------------------------------------------------------
+
+Sha256::Digest Sha256::Finish() {
+  const uint64_t bits = total_ * 8;
+  constexpr uint8_t kPadding[64] = {0x80};
+  Update(kPadding, 1 + (119 - block_fill_) % 64);
+  uint8_t length[8];
+  for (size_t i = 0; i < 8; ++i) {
+    length[i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+  }
+  Update(length, sizeof(length));
+
+  Digest ret;
+  for (size_t i = 0; i < 8; ++i) {
+    for (size_t j = 0; j < 4; ++j) {
+      ret[4 * i + j] = static_cast<uint8_t>(state_[i] >> (24 - 8 * j));
+    }
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+std::string Sha256::FinishHex() {
+  static constexpr char kHex[] = "0123456789abcdef";
+  std::string ret;
+  for (const auto b : Finish()) {
+    ret += kHex[b >> 4];
+    ret += kHex[b & 0xF];
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Sha256::IsAccelerated() {
+#ifdef GENIE_SHA256_X86
+  return GetCompress() == &CompressX86;
+#else
+  return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::util
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
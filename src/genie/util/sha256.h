@@ -0,0 +1,87 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file sha256.h
+ *
+ * @copyright This file is part of Genie
+ * See LICENSE and/or visit https://github.com/MueFab/genie for more details.
+ *
+ * @brief Declaration of the Sha256 class for incremental SHA-256 hashing.
+ *
+ * @details The compression function uses the x86 SHA extensions if the CPU
+ * supports them and falls back to a portable implementation otherwise. The
+ * choice is made once at runtime, so binaries stay portable.
+ */
+
+#ifndef SRC_GENIE_UTIL_SHA256_H_
+#define SRC_GENIE_UTIL_SHA256_H_
+
+// -----------------------------------------------------------------------------
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// -----------------------------------------------------------------------------
+
+namespace genie::util {
+
+/**
+ * @brief Incremental SHA-256 hash computation.
+ */
+class Sha256 {
+ public:
+  /// Size of a digest in bytes.
+  static constexpr size_t kDigestSize = 32;
+
+  /// A binary digest.
+  using Digest = std::array<uint8_t, kDigestSize>;
+
+  /**
+   * @brief Starts a new hash computation.
+   */
+  Sha256();
+
+  /**
+   * @brief Hashes more data.
+   * @param data Pointer to the data.
+   * @param length Number of bytes.
+   */
+  void Update(const void* data, size_t length);
+
+  /**
+   * @brief Finishes the computation. The object must not be updated anymore
+   * afterwards.
+   * @return The digest.
+   */
+  Digest Finish();
+
+  /**
+   * @brief Finishes the computation, see Finish().
+   * @return The digest as lower case hex string.
+   */
+  std::string FinishHex();
+
+  /**
+   * @brief Checks which implementation is used.
+   * @return True if the x86 SHA extensions are used.
+   */
+  static bool IsAccelerated();
+
+ private:
+  std::array<uint32_t, 8> state_;  //!< @brief Intermediate hash value.
+  std::array<uint8_t, 64> block_;  //!< @brief Partially filled block.
+  size_t block_fill_;              //!< @brief Bytes used in `block_`.
+  uint64_t total_;                 //!< @brief Bytes hashed so far.
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::util
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_UTIL_SHA256_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,177 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/util/trace.h"
+
+#include <atomic>
+#include <iomanip>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <vector>
+
+// -----------------------------------------------------------------------------
+
+namespace genie::util {
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief One finished span.
+ */
+struct Event {
+  const char* name;      //!< @brief
+  const char* category;  //!< @brief
+  int64_t au;            //!< @brief Access unit id or TraceScope::kNone.
+  int64_t begin_ns;      //!< @brief Relative to the trace epoch.
+  int64_t end_ns;        //!< @brief Relative to the trace epoch.
+};
+
+/**
+ * @brief Spans of one thread. Only written by the owning thread.
+ */
+struct ThreadBuffer {
+  size_t tid;                 //!< @brief Sequential thread number.
+  std::vector<Event> events;  //!< @brief
+};
+
+std::atomic<bool> trace_enabled{false};
+
+/// Time zero of the trace.
+const Clock::time_point epoch = Clock::now();
+
+/// All buffers ever created. Buffers outlive their threads, so the spans of
+/// finished worker threads can still be written.
+std::mutex registry_mutex;
+std::vector<std::unique_ptr<ThreadBuffer>> registry;
+
+thread_local ThreadBuffer* local_buffer = nullptr;
+
+/// Access unit of the innermost tagged scope of this thread.
+thread_local int64_t current_au = TraceScope::kNone;
+
+/**
+ * @brief Gets the buffer of the calling thread, registering it on first use.
+ * @return The buffer.
+ */
+ThreadBuffer& LocalBuffer() {
+  if (!local_buffer) {
+    std::lock_guard guard(registry_mutex);
+    registry.push_back(std::make_unique<ThreadBuffer>());
+    local_buffer = registry.back().get();
+    local_buffer->tid = registry.size();
+    local_buffer->events.reserve(4096);
+  }
+  return *local_buffer;
+}
+
+/**
+ * @brief Converts a time point to nanoseconds since the trace epoch.
+ * @param t Time point.
+ * @return Nanoseconds.
+ */
+int64_t ToNs(const Clock::time_point t) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t - epoch)
+      .count();
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+void Tracer::SetEnabled(const bool enabled) {
+  trace_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+
+bool Tracer::IsEnabled() {
+  return trace_enabled.load(std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+
+void Tracer::Write(std::ostream& stream) {
+  std::lock_guard guard(registry_mutex);
+  const auto flags = stream.flags();
+  stream << std::fixed << std::setprecision(3);
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto& buffer : registry) {
+    stream << (first ? "\n" : ",\n");
+    first = false;
+    stream << R"({"name":"thread_name","ph":"M","pid":1,"tid":)"
+           << buffer->tid << R"(,"args":{"name":"thread )" << buffer->tid
+           << "\"}}";
+    for (const auto& e : buffer->events) {
+      // Chrome expects microseconds
+      stream << ",\n{\"name\":\"" << e.name << "\",\"cat\":\"" << e.category
+             << R"(","ph":"X","pid":1,"tid":)" << buffer->tid
+             << ",\"ts\":" << static_cast<double>(e.begin_ns) / 1e3
+             << ",\"dur\":"
+             << static_cast<double>(e.end_ns - e.begin_ns) / 1e3;
+      if (e.au != TraceScope::kNone) {
+        stream << ",\"args\":{\"au\":" << e.au << "}";
+      }
+      stream << "}";
+    }
+  }
+  stream << "\n]}\n";
+  stream.flags(flags);
+}
+
+// -----------------------------------------------------------------------------
+
+void Tracer::Clear() {
+  std::lock_guard guard(registry_mutex);
+  for (const auto& buffer : registry) {
+    buffer->events.clear();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TraceScope::TraceScope(const char* name, const char* category,
+                       const int64_t au)
+    : name_(name),
+      category_(category),
+      au_(au == kInherit ? current_au : au),
+      parent_au_(current_au),
+      active_(Tracer::IsEnabled()) {
+  if (!active_) {
+    return;
+  }
+  current_au = au_;
+  start_ = Clock::now();
+}
+
+// -----------------------------------------------------------------------------
+
+TraceScope::~TraceScope() { Stop(); }
+
+// -----------------------------------------------------------------------------
+
+void TraceScope::Stop() {
+  if (!active_) {
+    return;
+  }
+  active_ = false;
+  const auto end = Clock::now();
+  current_au = parent_au_;
+  LocalBuffer().events.push_back(
+      {name_, category_, au_, ToNs(start_), ToNs(end)});
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::util
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ *
+ * @brief Timeline of pipeline activity in the Chrome trace event format.
+ *
+ * Every thread appends finished spans to its own buffer, so recording takes no
+ * lock. The buffers are only merged when the trace is written, which happens
+ * after the pipeline has finished. The resulting JSON can be opened with
+ * chrome://tracing or https://ui.perfetto.dev.
+ */
+
+#ifndef SRC_GENIE_UTIL_TRACE_H_
+#define SRC_GENIE_UTIL_TRACE_H_
+
+// -----------------------------------------------------------------------------
+
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <ostream>
+
+// -----------------------------------------------------------------------------
+
+namespace genie::util {
+
+/**
+ * @brief Global switch and output of the trace.
+ */
+class Tracer {
+ public:
+  /**
+   * @brief Turns recording on or off. Off by default.
+   * @param enabled New state.
+   */
+  static void SetEnabled(bool enabled);
+
+  /**
+   * @brief Checks if spans are recorded.
+   * @return True if enabled.
+   */
+  static bool IsEnabled();
+
+  /**
+   * @brief Writes all spans recorded so far as Chrome trace JSON. Must not be
+   * called while other threads are still recording.
+   * @param stream Output.
+   */
+  static void Write(std::ostream& stream);
+
+  /**
+   * @brief Discards all spans recorded so far. Same restriction as Write().
+   */
+  static void Clear();
+};
+
+/**
+ * @brief Records its scope as one span on the timeline of the calling thread.
+ *
+ * Spans carry the access unit they work on. Scopes nested on the same thread
+ * inherit the access unit of the enclosing scope, so e.g. the entropy coding
+ * of a descriptor is tagged without passing the id down the call stack.
+ */
+class TraceScope {
+ public:
+  /// Access unit id meaning "same as the enclosing scope".
+  static constexpr int64_t kInherit = -2;
+
+  /// Access unit id meaning "not related to an access unit".
+  static constexpr int64_t kNone = -1;
+
+  /**
+   * @brief Starts the span.
+   * @param name Span name. Must stay valid until the trace is written, i.e.
+   * should be a literal or a static table entry.
+   * @param category Span category, same lifetime requirement as name.
+   * @param au Access unit id (usually the first record position of the
+   * section), kInherit or kNone.
+   */
+  TraceScope(const char* name, const char* category, int64_t au = kInherit);
+
+  /**
+   * @brief Ends the span if not already done.
+   */
+  ~TraceScope();
+
+  /**
+   * @brief Ends the span early, e.g. before handing data on to the next
+   * stage. Scopes must end in reverse order of their creation.
+   */
+  void Stop();
+
+  TraceScope(const TraceScope&) = delete;             //!< @brief
+  TraceScope& operator=(const TraceScope&) = delete;  //!< @brief
+
+ private:
+  const char* name_;                            //!< @brief
+  const char* category_;                        //!< @brief
+  int64_t au_;                                  //!< @brief Tagged id.
+  int64_t parent_au_;                           //!< @brief Restored on exit.
+  std::chrono::steady_clock::time_point start_;  //!< @brief
+  bool active_;  //!< @brief False once stopped or if tracing was off.
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::util
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_UTIL_TRACE_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
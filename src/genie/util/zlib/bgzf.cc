@@ -0,0 +1,103 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/muefab/genie for more details.
+ */
+
+#include "genie/util/zlib/bgzf.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "genie/util/runtime_exception.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie::util::zlib {
+
+// -----------------------------------------------------------------------------
+
+constexpr size_t kBgzfHeaderSize = 18;
+constexpr size_t kBgzfFooterSize = 8;
+constexpr size_t kBgzfMaxBlockSize = 0x10000;
+
+// -----------------------------------------------------------------------------
+
+void PutLittleEndian(std::string& out, const size_t pos, const uint32_t value,
+                     const size_t bytes) {
+  for (size_t i = 0; i < bytes; ++i) {
+    out[pos + i] = static_cast<char>(value >> (8 * i) & 0xff);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void CompressBgzf(std::string_view in, std::string& out,
+                  const int compression_level) {
+  z_stream stream{};
+  UTILS_DIE_IF(deflateInit2(&stream, compression_level, Z_DEFLATED, -15, 8,
+                            Z_DEFAULT_STRATEGY) != Z_OK,
+               "Could not initialize deflate");
+
+  while (!in.empty()) {
+    const size_t length = std::min(in.size(), kBgzfBlockSize);
+    const size_t block_start = out.size();
+    const size_t bound = deflateBound(&stream, static_cast<uLong>(length));
+    out.resize(block_start + kBgzfHeaderSize + bound + kBgzfFooterSize);
+
+    // gzip header with the BGZF "BC" extra field
+    constexpr unsigned char header[kBgzfHeaderSize] = {
+        0x1f, 0x8b, 8, 4, 0, 0, 0, 0, 0, 0xff, 6, 0, 'B', 'C', 2, 0, 0, 0};
+    std::copy(std::begin(header), std::end(header), out.begin() + block_start);
+
+    stream.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));  // NOLINT
+    stream.avail_in = static_cast<uInt>(length);
+    stream.next_out = reinterpret_cast<Bytef*>(  // NOLINT
+        &out[block_start + kBgzfHeaderSize]);
+    stream.avail_out = static_cast<uInt>(bound);
+    UTILS_DIE_IF(deflate(&stream, Z_FINISH) != Z_STREAM_END,
+                 "BGZF block compression failed");
+    const size_t compressed = bound - stream.avail_out;
+    const size_t block_size = kBgzfHeaderSize + compressed + kBgzfFooterSize;
+    UTILS_DIE_IF(block_size > kBgzfMaxBlockSize, "BGZF block too large");
+
+    PutLittleEndian(out, block_start + 16,
+                    static_cast<uint32_t>(block_size - 1), 2);
+    const auto crc =
+        crc32(crc32(0, nullptr, 0),
+              reinterpret_cast<const Bytef*>(in.data()),  // NOLINT
+              static_cast<uInt>(length));
+    const size_t footer = block_start + kBgzfHeaderSize + compressed;
+    PutLittleEndian(out, footer, static_cast<uint32_t>(crc), 4);
+    PutLittleEndian(out, footer + 4, static_cast<uint32_t>(length), 4);
+    out.resize(footer + kBgzfFooterSize);
+
+    in.remove_prefix(length);
+    deflateReset(&stream);
+  }
+
+  deflateEnd(&stream);
+}
+
+// -----------------------------------------------------------------------------
+
+std::string_view BgzfEofBlock() {
+  static constexpr char eof[28] = {
+      '\x1f', '\x8b', '\x08', '\x04', '\x00', '\x00', '\x00',
+      '\x00', '\x00', '\xff', '\x06', '\x00', '\x42', '\x43',
+      '\x02', '\x00', '\x1b', '\x00', '\x03', '\x00', '\x00',
+      '\x00', '\x00', '\x00', '\x00', '\x00', '\x00', '\x00'};
+  return {eof, sizeof(eof)};
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::util::zlib
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,52 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/muefab/genie for more details.
+ */
+
+#ifndef SRC_GENIE_UTIL_ZLIB_BGZF_H_
+#define SRC_GENIE_UTIL_ZLIB_BGZF_H_
+
+// -----------------------------------------------------------------------------
+
+#include <string>
+#include <string_view>
+
+// -----------------------------------------------------------------------------
+
+namespace genie::util::zlib {
+
+/**
+ * Maximum number of uncompressed bytes in one BGZF block.
+ */
+constexpr size_t kBgzfBlockSize = 0xff00;
+
+/**
+ * Compresses a buffer into BGZF blocks and appends them to the output.
+ *
+ * Every block is a complete gzip member, so the blocks of independently
+ * compressed buffers can simply be concatenated. The result can be read by any
+ * gzip decoder and indexed by BGZF aware tools.
+ * @param in Uncompressed data.
+ * @param out Output buffer, the blocks are appended.
+ * @param compression_level Compression level (1-9, -1 for default).
+ */
+void CompressBgzf(std::string_view in, std::string& out,
+                  int compression_level = -1);
+
+/**
+ * Returns the empty block marking the end of a BGZF file.
+ * @return The end of file block.
+ */
+std::string_view BgzfEofBlock();
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie::util::zlib
+
+// -----------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_UTIL_ZLIB_BGZF_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ * @brief Record to descriptor stream conversion of the aligned read coders.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "genie/read/basecoder/decoder.h"
+#include "genie/read/basecoder/encoder.h"
+#include "synthetic.h"
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/// Number of records per access unit.
+constexpr size_t kRecords = 20000;
+
+/// Bases per read.
+constexpr size_t kReadLength = 150;
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Shared input of the basecoder benchmarks.
+ */
+struct BasecoderInput {
+  std::string reference;             //!< @brief Reads are sampled from here.
+  genie::core::record::Chunk chunk;  //!< @brief Aligned records.
+
+  BasecoderInput()
+      : reference(genie_benchmarks::RandomReference(kRecords * kReadLength)),
+        chunk(genie_benchmarks::MappedChunk(reference, kRecords,
+                                            kReadLength)) {}
+
+  /**
+   * @brief Encodes all records into one access unit.
+   * @return Raw descriptor streams.
+   */
+  [[nodiscard]] genie::core::AccessUnit Encode() const {
+    genie::read::basecoder::Encoder encoder(
+        chunk.GetData().front().GetAlignments().front().GetPosition());
+    for (const auto& rec : chunk.GetData()) {
+      const auto position = rec.GetAlignments().front().GetPosition();
+      encoder.Add(rec, reference.substr(position, kReadLength), "");
+    }
+    return std::move(encoder.MoveStreams());
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+const BasecoderInput& GetInput() {
+  static const BasecoderInput input;
+  return input;
+}
+
+// -----------------------------------------------------------------------------
+
+void BM_BasecoderEncode(benchmark::State& state) {
+  const auto& input = GetInput();
+  for (auto _ : state) {
+    auto au = input.Encode();
+    benchmark::DoNotOptimize(au);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kRecords * kReadLength));
+  state.counters["records"] =
+      benchmark::Counter(static_cast<double>(kRecords),
+                         benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// -----------------------------------------------------------------------------
+
+void BM_BasecoderDecode(benchmark::State& state) {
+  const auto& input = GetInput();
+  for (auto _ : state) {
+    // Access units are move-only, encode a fresh one untimed
+    state.PauseTiming();
+    auto au = input.Encode();
+    state.ResumeTiming();
+    genie::read::basecoder::Decoder decoder(std::move(au), 1);
+    for (size_t i = 0; i < kRecords; ++i) {
+      const auto meta = decoder.ReadSegmentMeta();
+      std::vector<std::string> refs = {input.reference.substr(
+          meta.position[0], meta.length[0])};
+      auto rec = decoder.Pull(0, std::move(refs), meta);
+      benchmark::DoNotOptimize(rec);
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kRecords * kReadLength));
+  state.counters["records"] =
+      benchmark::Counter(static_cast<double>(kRecords),
+                         benchmark::Counter::kIsIterationInvariantRate);
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+BENCHMARK(BM_BasecoderEncode)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BasecoderDecode)->Unit(benchmark::kMillisecond);
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
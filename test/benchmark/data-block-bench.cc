@@ -0,0 +1,113 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ * @brief Symbol access of DataBlock and access unit subsequences.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include "genie/core/access_unit.h"
+#include "genie/util/block_stepper.h"
+#include "genie/util/data_block.h"
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/// Number of symbols per iteration.
+constexpr size_t kSymbols = 1 << 20;
+
+// -----------------------------------------------------------------------------
+
+void BM_DataBlockPushBack(benchmark::State& state) {
+  const auto word_size = static_cast<uint8_t>(state.range(0));
+  for (auto _ : state) {
+    genie::util::DataBlock block(0, word_size);
+    for (uint64_t i = 0; i < kSymbols; ++i) {
+      block.PushBack(i & 0x7f);
+    }
+    benchmark::DoNotOptimize(block.GetData());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kSymbols * word_size));
+}
+
+// -----------------------------------------------------------------------------
+
+void BM_DataBlockGet(benchmark::State& state) {
+  const auto word_size = static_cast<uint8_t>(state.range(0));
+  genie::util::DataBlock block(kSymbols, word_size);
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < kSymbols; ++i) {
+      sum += block.Get(i);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kSymbols * word_size));
+}
+
+// -----------------------------------------------------------------------------
+
+void BM_DataBlockStepper(benchmark::State& state) {
+  const auto word_size = static_cast<uint8_t>(state.range(0));
+  genie::util::DataBlock block(kSymbols, word_size);
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    for (auto r = block.GetReader(); r.IsValid(); r.Inc()) {
+      sum += r.Get();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kSymbols * word_size));
+}
+
+// -----------------------------------------------------------------------------
+
+void BM_SubsequencePushPull(benchmark::State& state) {
+  const auto word_size = static_cast<uint8_t>(state.range(0));
+  for (auto _ : state) {
+    genie::core::AccessUnit::Subsequence sub(
+        word_size, genie::core::gen_sub::kPositionFirst);
+    for (uint64_t i = 0; i < kSymbols; ++i) {
+      sub.Push(i & 0x7f);
+    }
+    uint64_t sum = 0;
+    while (!sub.end()) {
+      sum += sub.Pull();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kSymbols * word_size));
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+BENCHMARK(BM_DataBlockPushBack)
+    ->ArgName("word")
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+BENCHMARK(BM_DataBlockGet)
+    ->ArgName("word")
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+BENCHMARK(BM_DataBlockStepper)
+    ->ArgName("word")
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+BENCHMARK(BM_SubsequencePushPull)
+    ->ArgName("word")
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ * @brief Entropy codecs, each run on every descriptor type.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <tuple>
+
+#include "genie/entropy/bsc/decoder.h"
+#include "genie/entropy/bsc/encoder.h"
+#include "genie/entropy/gabac/decoder.h"
+#include "genie/entropy/gabac/encoder.h"
+#include "genie/entropy/lzma/decoder.h"
+#include "genie/entropy/lzma/encoder.h"
+#include "genie/entropy/zstd/decoder.h"
+#include "genie/entropy/zstd/encoder.h"
+#include "synthetic.h"
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/// Symbols per subsequence, roughly the size of one access unit.
+constexpr size_t kSymbols = 1 << 16;
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Raw size of a descriptor.
+ * @param desc The descriptor.
+ * @return Bytes over all subsequences.
+ */
+int64_t RawSize(const genie::core::AccessUnit::Descriptor& desc) {
+  int64_t ret = 0;
+  for (const auto& sub : desc) {
+    ret += static_cast<int64_t>(sub.GetRawSize());
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Encoder>
+void BM_EntropyEncode(benchmark::State& state) {
+  const auto id = static_cast<genie::core::GenDesc>(state.range(0));
+  const auto input = genie_benchmarks::SyntheticDescriptor(id, kSymbols);
+  state.SetLabel(genie::core::GetDescriptor(id).name);
+  Encoder encoder(false);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto desc = input;
+    state.ResumeTiming();
+    auto coded = encoder.Process(desc);
+    benchmark::DoNotOptimize(coded);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          RawSize(input));
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Encoder, typename Decoder>
+void BM_EntropyDecode(benchmark::State& state) {
+  const auto id = static_cast<genie::core::GenDesc>(state.range(0));
+  auto input = genie_benchmarks::SyntheticDescriptor(id, kSymbols);
+  const auto raw_size = RawSize(input);
+  state.SetLabel(genie::core::GetDescriptor(id).name);
+  auto coded = Encoder(false).Process(input);
+  Decoder decoder;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto desc = std::get<1>(coded);
+    state.ResumeTiming();
+    auto decoded = decoder.Process(std::get<0>(coded), desc, false);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * raw_size);
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+namespace gabac = genie::entropy::gabac;
+namespace zstd = genie::entropy::zstd;
+namespace lzma = genie::entropy::lzma;
+namespace bsc = genie::entropy::bsc;
+
+using genie_benchmarks::kNumDescriptors;
+
+BENCHMARK_TEMPLATE(BM_EntropyEncode, gabac::Encoder)
+    ->DenseRange(0, kNumDescriptors - 1);
+BENCHMARK_TEMPLATE(BM_EntropyDecode, gabac::Encoder, gabac::Decoder)
+    ->DenseRange(0, kNumDescriptors - 1);
+BENCHMARK_TEMPLATE(BM_EntropyEncode, zstd::Encoder)
+    ->DenseRange(0, kNumDescriptors - 1);
+BENCHMARK_TEMPLATE(BM_EntropyDecode, zstd::Encoder, zstd::Decoder)
+    ->DenseRange(0, kNumDescriptors - 1);
+BENCHMARK_TEMPLATE(BM_EntropyEncode, lzma::Encoder)
+    ->DenseRange(0, kNumDescriptors - 1);
+BENCHMARK_TEMPLATE(BM_EntropyDecode, lzma::Encoder, lzma::Decoder)
+    ->DenseRange(0, kNumDescriptors - 1);
+BENCHMARK_TEMPLATE(BM_EntropyEncode, bsc::Encoder)
+    ->DenseRange(0, kNumDescriptors - 1);
+BENCHMARK_TEMPLATE(BM_EntropyDecode, bsc::Encoder, bsc::Decoder)
+    ->DenseRange(0, kNumDescriptors - 1);
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
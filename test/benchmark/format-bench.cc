@@ -0,0 +1,134 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ * @brief FASTQ parsing and formatting.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <utility>
+
+#include "genie/core/classifier_bypass.h"
+#include "genie/format/fastq/exporter.h"
+#include "genie/format/fastq/importer.h"
+#include "synthetic.h"
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/// Number of synthetic records.
+constexpr size_t kRecords = 100000;
+
+/// Bases per synthetic read.
+constexpr size_t kReadLength = 150;
+
+/// Records per importer block, the default of the transcoder.
+constexpr size_t kBlockSize = 10000;
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Stream buffer discarding everything, so only formatting is timed.
+ */
+class NullBuffer final : public std::streambuf {
+ protected:
+  int overflow(const int c) override { return c; }
+  std::streamsize xsputn(const char*, const std::streamsize n) override {
+    return n;
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Parses FASTQ text and reports throughput.
+ * @param state Benchmark state.
+ * @param text File contents.
+ */
+void RunFastqImport(benchmark::State& state, const std::string& text) {
+  const auto records = std::count(text.begin(), text.end(), '\n') /
+                       genie::format::fastq::kLinesPerRecord;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::istringstream stream(text);
+    state.ResumeTiming();
+    genie::format::fastq::Importer importer(kBlockSize, stream);
+    genie::core::ClassifierBypass classifier;
+    bool more = true;
+    while (more) {
+      more = importer.PumpRetrieve(&classifier);
+      auto chunk = classifier.GetChunk();
+      benchmark::DoNotOptimize(chunk);
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(text.size()));
+  state.counters["records"] =
+      benchmark::Counter(static_cast<double>(records),
+                         benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// -----------------------------------------------------------------------------
+
+void BM_FastqImportSynthetic(benchmark::State& state) {
+  RunFastqImport(state, genie_benchmarks::FastqText(
+                            genie_benchmarks::UnmappedChunk(kRecords,
+                                                            kReadLength)));
+}
+
+// -----------------------------------------------------------------------------
+
+void BM_FastqImportSample(benchmark::State& state) {
+  RunFastqImport(state, genie_benchmarks::RepeatDataFile(
+                            "fastq/fourteen-records.fastq", 16 << 20));
+}
+
+// -----------------------------------------------------------------------------
+
+void BM_FastqExport(benchmark::State& state) {
+  const bool bgzf = state.range(0) != 0;
+  const auto input =
+      genie_benchmarks::UnmappedChunk(kRecords, kReadLength);
+  const auto text_size = genie_benchmarks::FastqText(input).size();
+  NullBuffer buffer;
+  std::ostream output(&buffer);
+  for (auto _ : state) {
+    // Chunks are move-only, copy the records untimed
+    state.PauseTiming();
+    genie::core::record::Chunk chunk;
+    chunk.GetData() = input.GetData();
+    state.ResumeTiming();
+    genie::format::fastq::Exporter exporter(output, bgzf);
+    exporter.FlowIn(std::move(chunk), {0, kRecords, false});
+    uint64_t pos = 0;
+    exporter.FlushIn(pos);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(text_size));
+  state.counters["records"] = benchmark::Counter(
+      kRecords, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+BENCHMARK(BM_FastqImportSynthetic)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FastqImportSample)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FastqExport)
+    ->ArgName("bgzf")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
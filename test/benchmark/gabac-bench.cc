@@ -0,0 +1,156 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ * @brief CABAC coding of one transformed subsequence per GABAC binarization.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "genie/entropy/gabac/decode_transformed_sub_seq.h"
+#include "genie/entropy/gabac/encode_transformed_sub_seq.h"
+#include "genie/entropy/paramcabac/transformed_sub_seq.h"
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+namespace paramcabac = genie::entropy::paramcabac;
+using BinarizationId = paramcabac::BinarizationParameters::BinarizationId;
+
+/// Number of symbols coded per iteration.
+constexpr size_t kSymbols = 1 << 18;
+
+/// Size of the output symbols in bits.
+constexpr uint8_t kSymbolBits = 8;
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief A binarization and the symbols it is exercised with.
+ */
+struct BinarizationCase {
+  std::string name;             //!< @brief Label of the benchmark.
+  BinarizationId id;            //!< @brief Binarization.
+  std::vector<uint8_t> params;  //!< @brief Binarization parameters.
+  uint64_t max_value;           //!< @brief Largest symbol it can code.
+  uint8_t subsym_bits;          //!< @brief Coding sub-symbol size.
+  bool bypass;                  //!< @brief Skip context modeling.
+};
+
+// -----------------------------------------------------------------------------
+
+const std::vector<BinarizationCase>& GetCases() {
+  static const std::vector<BinarizationCase> cases = {
+      {"BI/bypass", BinarizationId::BI, {}, 255, kSymbolBits, true},
+      {"BI", BinarizationId::BI, {}, 255, kSymbolBits, false},
+      {"TU", BinarizationId::TU, {31}, 31, kSymbolBits, false},
+      {"EG", BinarizationId::EG, {}, 255, kSymbolBits, false},
+      // Split units are coded as sub-symbols of the same size
+      {"SUTU", BinarizationId::SUTU, {2}, 255, 2, false},
+  };
+  return cases;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Builds the configuration of a benchmark case.
+ * @param c The case.
+ * @param coding_order Number of previous symbols used as context.
+ * @return Configuration of one untransformed subsequence.
+ */
+paramcabac::TransformedSubSeq MakeConfig(const BinarizationCase& c,
+                                         const uint8_t coding_order) {
+  paramcabac::Binarization binarization(
+      c.id, c.bypass, paramcabac::BinarizationParameters(c.id, c.params),
+      paramcabac::Context(true, kSymbolBits, c.subsym_bits, true));
+  return {paramcabac::SupportValues::TransformIdSubsym::NO_TRANSFORM,
+          paramcabac::SupportValues(kSymbolBits, c.subsym_bits, coding_order),
+          std::move(binarization), genie::core::gen_sub::kMappingScore};
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Generates geometrically distributed symbols.
+ * @param max_value Largest symbol.
+ * @return The symbols.
+ */
+genie::util::DataBlock MakeSymbols(const uint64_t max_value) {
+  std::mt19937_64 rng(0);
+  std::geometric_distribution<uint64_t> dist(0.1);
+  genie::util::DataBlock ret(0, 1);
+  for (size_t i = 0; i < kSymbols; ++i) {
+    ret.PushBack(std::min(dist(rng), max_value));
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+void BM_GabacEncode(benchmark::State& state) {
+  const auto& c = GetCases()[static_cast<size_t>(state.range(0))];
+  const auto config = MakeConfig(c, static_cast<uint8_t>(state.range(1)));
+  const auto input = MakeSymbols(c.max_value);
+  state.SetLabel(c.name);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto symbols = input;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(
+        genie::entropy::gabac::EncodeTransformSubSeq(config, &symbols));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(input.GetRawSize()));
+}
+
+// -----------------------------------------------------------------------------
+
+void BM_GabacDecode(benchmark::State& state) {
+  const auto& c = GetCases()[static_cast<size_t>(state.range(0))];
+  const auto config = MakeConfig(c, static_cast<uint8_t>(state.range(1)));
+  auto encoded = MakeSymbols(c.max_value);
+  const auto raw_size = static_cast<int64_t>(encoded.GetRawSize());
+  genie::entropy::gabac::EncodeTransformSubSeq(config, &encoded);
+  state.SetLabel(c.name);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto bitstream = encoded;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(genie::entropy::gabac::DecodeTransformSubSeq(
+        config, kSymbols, &bitstream, 1));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * raw_size);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Runs every binarization with coding order 0 and 1.
+ * @param b The benchmark.
+ */
+void AllCases(benchmark::internal::Benchmark* b) {
+  for (int64_t i = 0; i < static_cast<int64_t>(GetCases().size()); ++i) {
+    b->Args({i, 0});
+    b->Args({i, 1});
+  }
+  b->ArgNames({"binarization", "order"});
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+BENCHMARK(BM_GabacEncode)->Apply(AllCases);
+BENCHMARK(BM_GabacDecode)->Apply(AllCases);
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,100 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ * @brief Read name tokenization.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "genie/name/tokenizer/decoder.h"
+#include "genie/name/tokenizer/encoder.h"
+#include "synthetic.h"
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/// Number of names per access unit.
+constexpr size_t kNames = 100000;
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Builds records that carry only a name.
+ * @return Chunk of class U records.
+ */
+genie::core::record::Chunk MakeChunk() {
+  genie::core::record::Chunk ret;
+  for (auto& name : genie_benchmarks::IlluminaNames(kNames)) {
+    ret.GetData().emplace_back(1, genie::core::record::ClassType::kClassU,
+                               std::move(name), "", 0);
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Total length of all names.
+ * @param chunk The records.
+ * @return Bytes.
+ */
+int64_t NameBytes(const genie::core::record::Chunk& chunk) {
+  int64_t ret = 0;
+  for (const auto& rec : chunk.GetData()) {
+    ret += static_cast<int64_t>(rec.GetName().size());
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+void BM_NameEncode(benchmark::State& state) {
+  const auto chunk = MakeChunk();
+  genie::name::tokenizer::Encoder encoder(
+      static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto desc = encoder.Process(chunk);
+    benchmark::DoNotOptimize(desc);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          NameBytes(chunk));
+  state.counters["records"] = benchmark::Counter(
+      kNames, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// -----------------------------------------------------------------------------
+
+void BM_NameDecode(benchmark::State& state) {
+  const auto chunk = MakeChunk();
+  const auto encoded = std::get<0>(genie::name::tokenizer::Encoder(
+      static_cast<size_t>(state.range(0))).Process(chunk));
+  genie::name::tokenizer::Decoder decoder(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto desc = encoded;
+    state.ResumeTiming();
+    auto names = decoder.Process(desc);
+    benchmark::DoNotOptimize(names);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          NameBytes(chunk));
+  state.counters["records"] = benchmark::Counter(
+      kNames, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+BENCHMARK(BM_NameEncode)->ArgName("threads")->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK(BM_NameDecode)->ArgName("threads")->Arg(1)->Arg(4)->UseRealTime();
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,178 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ * @brief SAM parsing and formatting.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "genie/format/sam/exporter.h"
+#include "genie/format/sam/sam_reader.h"
+#include "synthetic.h"
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/// Number of synthetic records.
+constexpr size_t kRecords = 100000;
+
+/// Bases per synthetic read.
+constexpr size_t kReadLength = 150;
+
+/// Minimal size of the file built from the checked-in sample.
+constexpr size_t kSampleSize = 16 << 20;
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief SAM files written once for all benchmarks, removed at exit.
+ */
+struct SamFiles {
+  std::string synthetic;  //!< @brief Path of the synthetic file.
+  std::string sample;     //!< @brief Path of the repeated sample file.
+  size_t synthetic_size;  //!< @brief Size of the synthetic file.
+  size_t sample_size;     //!< @brief Size of the sample file.
+  size_t sample_records;  //!< @brief Records in the sample file.
+
+  SamFiles() {
+    const auto dir = std::filesystem::temp_directory_path();
+    synthetic = (dir / "genie-benchmark-synthetic.sam").string();
+    sample = (dir / "genie-benchmark-sample.sam").string();
+
+    // Synthetic alignments
+    const auto reference =
+        genie_benchmarks::RandomReference(kRecords * kReadLength);
+    const auto chunk =
+        genie_benchmarks::MappedChunk(reference, kRecords, kReadLength);
+    std::string text = "@HD\tVN:1.6\tSO:coordinate\n@SQ\tSN:chr1\tLN:" +
+                       std::to_string(reference.size()) + "\n";
+    for (const auto& rec : chunk.GetData()) {
+      const auto& segment = rec.GetSegments().front();
+      text += rec.GetName() + "\t0\tchr1\t" +
+              std::to_string(rec.GetAlignments().front().GetPosition() + 1) +
+              "\t60\t" + std::to_string(kReadLength) + "M\t*\t0\t0\t" +
+              segment.GetSequence() + "\t" + segment.GetQualities().front() +
+              "\n";
+    }
+    synthetic_size = text.size();
+    std::ofstream(synthetic, std::ios::binary) << text;
+
+    // Checked-in sample, header once and records repeated
+    const auto file = genie_benchmarks::RepeatDataFile(
+        "sam/single_reads_multi_records.rname.sam", 1);
+    size_t body_begin = 0;
+    while (body_begin < file.size() && file[body_begin] == '@') {
+      body_begin = file.find('\n', body_begin) + 1;
+    }
+    const auto body = file.substr(body_begin);
+    text = file.substr(0, body_begin);
+    sample_records = 0;
+    while (text.size() < kSampleSize) {
+      text += body;
+      sample_records += static_cast<size_t>(
+          std::count(body.begin(), body.end(), '\n'));
+    }
+    sample_size = text.size();
+    std::ofstream(sample, std::ios::binary) << text;
+  }
+
+  ~SamFiles() {
+    std::error_code ec;
+    std::filesystem::remove(synthetic, ec);
+    std::filesystem::remove(sample, ec);
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+const SamFiles& GetFiles() {
+  static const SamFiles files;
+  return files;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Parses a SAM file and reports throughput.
+ * @param state Benchmark state.
+ * @param path File to parse.
+ * @param size Size of the file.
+ * @param records Number of records in the file.
+ */
+void RunSamRead(benchmark::State& state, const std::string& path,
+                const size_t size, const size_t records) {
+  for (auto _ : state) {
+    genie::format::sam::SamReader reader(path);
+    while (reader.Peek() != std::nullopt) {
+      auto rec = reader.Move();
+      benchmark::DoNotOptimize(rec);
+      reader.Read();
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(size));
+  state.counters["records"] =
+      benchmark::Counter(static_cast<double>(records),
+                         benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// -----------------------------------------------------------------------------
+
+void BM_SamReadSynthetic(benchmark::State& state) {
+  const auto& files = GetFiles();
+  RunSamRead(state, files.synthetic, files.synthetic_size, kRecords);
+}
+
+// -----------------------------------------------------------------------------
+
+void BM_SamReadSample(benchmark::State& state) {
+  const auto& files = GetFiles();
+  RunSamRead(state, files.sample, files.sample_size, files.sample_records);
+}
+
+// -----------------------------------------------------------------------------
+
+void BM_SamExport(benchmark::State& state) {
+  const auto& files = GetFiles();
+  const auto reference =
+      genie_benchmarks::RandomReference(kRecords * kReadLength);
+  const auto input =
+      genie_benchmarks::MappedChunk(reference, kRecords, kReadLength);
+  for (auto _ : state) {
+    // Chunks are move-only, copy the records untimed
+    state.PauseTiming();
+    genie::core::record::Chunk chunk;
+    chunk.GetData() = input.GetData();
+    state.ResumeTiming();
+    // Without a reference file, sequences are named by their index
+    genie::format::sam::Exporter exporter("", "/dev/null");
+    exporter.FlowIn(std::move(chunk), {0, kRecords, false});
+    uint64_t pos = 0;
+    exporter.FlushIn(pos);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(files.synthetic_size));
+  state.counters["records"] = benchmark::Counter(
+      kRecords, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+BENCHMARK(BM_SamReadSynthetic)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SamReadSample)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SamExport)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,220 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "synthetic.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <tuple>
+#include <utility>
+
+#include "genie/core/record/alignment_box.h"
+#include "genie/name/tokenizer/encoder.h"
+#include "genie/util/runtime_exception.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie_benchmarks {
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+constexpr char kBases[] = "ACGT";
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Generates a quality string, degrading towards the end of the read.
+ * @param length Number of bases.
+ * @param rng Random generator.
+ * @return Phred+33 qualities.
+ */
+std::string RandomQualities(const size_t length, std::mt19937_64& rng) {
+  std::string ret(length, 'F');
+  std::geometric_distribution<int> drop(0.3);
+  for (size_t i = 0; i < length; ++i) {
+    const int q = 40 - static_cast<int>(i * 10 / length) - drop(rng);
+    ret[i] = static_cast<char>(33 + std::max(q, 2));
+  }
+  return ret;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+std::string RandomReference(const size_t length, const uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::string ret(length, 'A');
+  for (auto& c : ret) {
+    c = kBases[rng() & 3];
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+std::vector<std::string> IlluminaNames(const size_t count) {
+  std::vector<std::string> ret;
+  ret.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    ret.push_back("A00123:8:H5KJ2DSXX:" + std::to_string(1 + i / 50000) + ":" +
+                  std::to_string(1101 + i / 5000 % 50) + ":" +
+                  std::to_string(1000 + i * 7 % 30000) + ":" +
+                  std::to_string(1000 + i * 13 % 35000));
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+genie::core::AccessUnit::Descriptor SyntheticDescriptor(
+    const genie::core::GenDesc desc, const size_t symbols,
+    const uint64_t seed) {
+  if (desc == genie::core::GenDesc::kReadName) {
+    genie::core::record::Chunk chunk;
+    for (auto& name : IlluminaNames(symbols)) {
+      chunk.GetData().emplace_back(1, genie::core::record::ClassType::kClassU,
+                                   std::move(name), "", 0);
+    }
+    genie::name::tokenizer::Encoder encoder;
+    return std::get<0>(encoder.Process(chunk));
+  }
+
+  std::mt19937_64 rng(seed);
+  std::geometric_distribution<uint64_t> dist(0.2);
+  genie::core::AccessUnit::Descriptor ret(desc);
+  for (const auto& sub_seq : genie::core::GetDescriptor(desc).sub_seqs) {
+    genie::core::AccessUnit::Subsequence sub(
+        genie::core::Range2Bytes(sub_seq.range), sub_seq.id);
+    // Small values dominate in all record coder streams
+    auto max = static_cast<uint64_t>(
+        std::min<int64_t>(sub_seq.range.second, 1000));
+    if (sub_seq.id == genie::core::gen_sub::kRtype) {
+      // Only aligned classes share an access unit with a record type stream
+      max = static_cast<uint64_t>(genie::core::record::ClassType::kClassI);
+    }
+    // Substituted bases depend on a reference base that differs from them
+    const bool dependent = sub.GetDependency() != nullptr;
+    for (size_t i = 0; i < symbols; ++i) {
+      const auto value = std::min(dist(rng), max);
+      sub.Push(value);
+      if (dependent) {
+        sub.PushDependency((value + 1) % (max + 1));
+      }
+    }
+    ret.Add(std::move(sub));
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+genie::core::record::Chunk UnmappedChunk(const size_t records,
+                                         const size_t read_length,
+                                         const uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  genie::core::record::Chunk ret;
+  auto names = IlluminaNames(records);
+  for (auto& name : names) {
+    genie::core::record::Record rec(
+        1, genie::core::record::ClassType::kClassU, std::move(name), "", 0);
+    std::string sequence(read_length, 'A');
+    for (auto& c : sequence) {
+      c = kBases[rng() & 3];
+    }
+    genie::core::record::Segment segment(std::move(sequence));
+    segment.AddQualities(RandomQualities(read_length, rng));
+    rec.AddSegment(std::move(segment));
+    ret.GetData().push_back(std::move(rec));
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+genie::core::record::Chunk MappedChunk(const std::string& reference,
+                                       const size_t records,
+                                       const size_t read_length,
+                                       const uint64_t seed) {
+  UTILS_DIE_IF(reference.size() < 2 * read_length, "Reference too short");
+  std::mt19937_64 rng(seed);
+  const auto max_position = reference.size() - read_length;
+  const auto step = std::max<uint64_t>(1, 2 * max_position / records);
+  genie::core::record::Chunk ret;
+  auto names = IlluminaNames(records);
+  uint64_t position = 0;
+  for (auto& name : names) {
+    position = std::min(position + rng() % step, max_position);
+    std::string sequence = reference.substr(position, read_length);
+
+    // One substitution, never at the read ends
+    const size_t mismatch = 1 + rng() % (read_length - 2);
+    sequence[mismatch] = sequence[mismatch] == 'A' ? 'C' : 'A';
+    std::string e_cigar = std::to_string(mismatch) + "=" + sequence[mismatch] +
+                          std::to_string(read_length - mismatch - 1) + "=";
+
+    genie::core::record::Record rec(
+        1, genie::core::record::ClassType::kClassM, std::move(name), "", 0);
+    genie::core::record::Segment segment(std::move(sequence));
+    segment.AddQualities(RandomQualities(read_length, rng));
+    rec.AddSegment(std::move(segment));
+    genie::core::record::Alignment alignment(std::move(e_cigar), 0);
+    alignment.AddMappingScore(60);
+    rec.AddAlignment(
+        0, genie::core::record::AlignmentBox(position, std::move(alignment)));
+    ret.GetData().push_back(std::move(rec));
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+std::string FastqText(const genie::core::record::Chunk& chunk) {
+  std::string ret;
+  for (const auto& rec : chunk.GetData()) {
+    const auto& segment = rec.GetSegments().front();
+    ret += '@';
+    ret += rec.GetName();
+    ret += '\n';
+    ret += segment.GetSequence();
+    ret += "\n+\n";
+    ret += segment.GetQualities().front();
+    ret += '\n';
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+std::string RepeatDataFile(const std::string& name, const size_t min_size) {
+  const std::string path = std::string(GENIE_DATA_DIR) + "/" + name;
+  std::ifstream file(path, std::ios::binary);
+  UTILS_DIE_IF(!file, "Cannot open file to read: " + path);
+  std::string contents{std::istreambuf_iterator<char>(file),
+                       std::istreambuf_iterator<char>()};
+  UTILS_DIE_IF(contents.empty(), "Empty data file: " + path);
+  if (contents.back() != '\n') {
+    contents += '\n';
+  }
+  std::string ret;
+  ret.reserve(min_size + contents.size());
+  while (ret.size() < min_size) {
+    ret += contents;
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace genie_benchmarks
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
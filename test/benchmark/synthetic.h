@@ -0,0 +1,104 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ * @brief Deterministic synthetic inputs shared by the microbenchmarks.
+ */
+
+#ifndef TEST_BENCHMARK_SYNTHETIC_H_
+#define TEST_BENCHMARK_SYNTHETIC_H_
+
+// -----------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "genie/core/access_unit.h"
+#include "genie/core/record/chunk.h"
+
+// -----------------------------------------------------------------------------
+
+namespace genie_benchmarks {
+
+/// Descriptors covered by the entropy codec benchmarks, kPosition to
+/// kReadName. The reference transformation descriptors are never emitted.
+constexpr int64_t kNumDescriptors =
+    static_cast<int64_t>(genie::core::GenDesc::kReadName) + 1;
+
+/**
+ * @brief Generates a random nucleotide sequence.
+ * @param length Number of bases.
+ * @param seed Seed of the generator.
+ * @return Sequence over ACGT.
+ */
+std::string RandomReference(size_t length, uint64_t seed = 0);
+
+/**
+ * @brief Generates Illumina style read names.
+ * @param count Number of names.
+ * @return The names, sorted like a sequencer would emit them.
+ */
+std::vector<std::string> IlluminaNames(size_t count);
+
+/**
+ * @brief Fills all subsequences of a descriptor with skewed values inside
+ * their legal ranges, similar to what the record coders emit. The read name
+ * descriptor is produced by the name tokenizer instead.
+ * @param desc Descriptor to generate.
+ * @param symbols Number of symbols per subsequence, names for kReadName.
+ * @param seed Seed of the generator.
+ * @return The filled descriptor.
+ */
+genie::core::AccessUnit::Descriptor SyntheticDescriptor(
+    genie::core::GenDesc desc, size_t symbols, uint64_t seed = 0);
+
+/**
+ * @brief Generates unpaired, unaligned records with qualities.
+ * @param records Number of records.
+ * @param read_length Number of bases per read.
+ * @param seed Seed of the generator.
+ * @return Class U chunk.
+ */
+genie::core::record::Chunk UnmappedChunk(size_t records, size_t read_length,
+                                         uint64_t seed = 0);
+
+/**
+ * @brief Generates sorted single end alignments against a reference, with
+ * one substitution per read.
+ * @param reference Reference sequence, reads are sampled from it.
+ * @param records Number of records.
+ * @param read_length Number of bases per read.
+ * @param seed Seed of the generator.
+ * @return Class M chunk on sequence 0.
+ */
+genie::core::record::Chunk MappedChunk(const std::string& reference,
+                                       size_t records, size_t read_length,
+                                       uint64_t seed = 0);
+
+/**
+ * @brief Renders records as FASTQ text.
+ * @param chunk Single end records with qualities.
+ * @return FASTQ file contents.
+ */
+std::string FastqText(const genie::core::record::Chunk& chunk);
+
+/**
+ * @brief Reads a file from the checked-in test data, repeated until it has at
+ * least the requested size.
+ * @param name Path relative to the data directory.
+ * @param min_size Minimal size in bytes.
+ * @return File contents.
+ */
+std::string RepeatDataFile(const std::string& name, size_t min_size);
+
+}  // namespace genie_benchmarks
+
+// -----------------------------------------------------------------------------
+
+#endif  // TEST_BENCHMARK_SYNTHETIC_H_
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -1,6 +1,23 @@
 #include "helpers.h"
 
 namespace util_tests {
+
+genie::core::AccessUnit::Descriptor MakePositions(const uint64_t seed,
+                                                  const uint64_t count) {
+  genie::core::AccessUnit::Descriptor desc(genie::core::GenDesc::kPosition);
+  for (const auto& sub_seq :
+       genie::core::GetDescriptor(genie::core::GenDesc::kPosition).sub_seqs) {
+    desc.Add(genie::core::AccessUnit::Subsequence(
+        genie::core::Range2Bytes(sub_seq.range), sub_seq.id));
+  }
+  uint64_t pos = seed;
+  for (uint64_t i = 0; i < count; ++i) {
+    pos += 100 + (i * 7919 + seed) % 37;
+    desc.Get(0).Push(pos);
+  }
+  return desc;
+}
+
 /*
 std::string exec(const std::string &cmd) {
     FILE *pipe = popen(cmd.c_str(), "r");
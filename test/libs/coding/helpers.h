@@ -1,12 +1,25 @@
 #ifndef UTIL_TESTS_HELPERS_H_
 #define UTIL_TESTS_HELPERS_H_
 
+#include <cstdint>
 #include <string>
 
+#include "genie/core/access_unit.h"
+
 namespace util_tests {
 
 std::string exec(const std::string &cmd);
 
+/**
+ * @brief Builds a position descriptor with increasing, slightly irregular
+ * values in its first subsequence.
+ * @param seed Start position, also varies the gaps.
+ * @param count Number of positions.
+ * @return Descriptor with all position subsequences present.
+ */
+genie::core::AccessUnit::Descriptor MakePositions(uint64_t seed,
+                                                  uint64_t count = 2000);
+
 }  // namespace util_tests
 
 #endif  // UTIL_TESTS_HELPERS_H_
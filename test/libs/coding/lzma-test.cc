@@ -0,0 +1,42 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#include <utility>
+
+#include "genie/entropy/lzma/decoder.h"
+#include "genie/entropy/lzma/encoder.h"
+#include "helpers.h"
+
+// -----------------------------------------------------------------------------
+
+using util_tests::MakePositions;
+
+// -----------------------------------------------------------------------------
+
+TEST(Lzma, ContextsAreReusedAcrossDescriptors) {  // NOLINT(cert-err58-cpp)
+  genie::entropy::lzma::Encoder encoder(false);
+  genie::entropy::lzma::Decoder decoder;
+
+  // Alternate sizes so the reused scratch buffers shrink and grow
+  for (const uint64_t count : {5000, 10, 20000, 1, 300}) {
+    auto desc = MakePositions(count, count);
+    auto coded = encoder.Process(desc);
+    auto [decoded, stats] =
+        decoder.Process(std::get<0>(coded), std::get<1>(coded), false);
+
+    auto expected = MakePositions(count, count);
+    ASSERT_EQ(decoded.Get(0).GetNumSymbols(), count);
+    while (!expected.Get(0).end()) {
+      EXPECT_EQ(decoded.Get(0).Pull(), expected.Get(0).Pull());
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
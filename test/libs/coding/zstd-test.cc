@@ -0,0 +1,98 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "genie/core/parameter/descriptor_present/descriptor_present.h"
+#include "genie/entropy/zstd/decoder.h"
+#include "genie/entropy/zstd/encoder.h"
+#include "genie/entropy/zstd/param_decoder.h"
+#include "helpers.h"
+
+// -----------------------------------------------------------------------------
+
+using util_tests::MakePositions;
+
+namespace {
+
+const genie::entropy::zstd::DecoderRegular& GetConfig(
+    const genie::core::parameter::DescriptorSubSequenceCfg& param) {
+  const auto& present =
+      dynamic_cast<const genie::core::parameter::desc_pres::DescriptorPresent&>(
+          param.Get());
+  return dynamic_cast<const genie::entropy::zstd::DecoderRegular&>(
+      present.GetDecoder());
+}
+
+// -----------------------------------------------------------------------------
+
+void ExpectRoundTrip(genie::core::EntropyEncoder::entropy_coded& coded,
+                     const uint64_t seed) {
+  auto expected = MakePositions(seed);
+  genie::entropy::zstd::Decoder decoder;
+  auto [decoded, stats] =
+      decoder.Process(std::get<0>(coded), std::get<1>(coded), false);
+  ASSERT_EQ(decoded.Get(0).GetNumSymbols(), expected.Get(0).GetNumSymbols());
+  while (!expected.Get(0).end()) {
+    EXPECT_EQ(decoded.Get(0).Pull(), expected.Get(0).Pull());
+  }
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+TEST(Zstd, RoundTripWithoutDictionary) {  // NOLINT(cert-err58-cpp)
+  genie::entropy::zstd::Encoder encoder(false, 19);
+  auto desc = MakePositions(1);
+  auto coded = encoder.Process(desc);
+  EXPECT_FALSE(GetConfig(std::get<0>(coded)).GetSubsequenceCfg(0)
+                   .GetDictionary());
+  ExpectRoundTrip(coded, 1);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(Zstd, DictionaryIsTrainedAndStored) {  // NOLINT(cert-err58-cpp)
+  genie::entropy::zstd::Encoder encoder(false, 3, 4);
+  for (uint64_t seed = 0; seed < 3; ++seed) {
+    auto desc = MakePositions(seed);
+    auto coded = encoder.Process(desc);
+    EXPECT_FALSE(GetConfig(std::get<0>(coded)).GetSubsequenceCfg(0)
+                     .GetDictionary());
+    ExpectRoundTrip(coded, seed);
+  }
+  for (uint64_t seed = 3; seed < 6; ++seed) {
+    auto desc = MakePositions(seed);
+    auto coded = encoder.Process(desc);
+    const auto& config = GetConfig(std::get<0>(coded));
+    ASSERT_TRUE(config.GetSubsequenceCfg(0).GetDictionary());
+
+    // The dictionary survives serialization of the parameters
+    std::stringstream stream;
+    {
+      genie::util::BitWriter writer(stream);
+      config.Write(writer);
+      writer.FlushBits();
+    }
+    genie::util::BitReader reader(stream);
+    EXPECT_EQ(reader.Read<uint8_t>(), genie::entropy::zstd::kModeZstd);
+    const genie::entropy::zstd::DecoderRegular read(
+        genie::core::GenDesc::kPosition, reader);
+    EXPECT_TRUE(read.Equals(&config));
+
+    ExpectRoundTrip(coded, seed);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
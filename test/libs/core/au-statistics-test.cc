@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "genie/core/c_api.h"
+#include "genie/core/meta/block_header/enabled.h"
+#include "genie/core/meta/dataset.h"
+#include "genie/core/stats/au_statistics.h"
+#include "helpers.h"
+
+using core_tests::MakeMappedRecord;
+using core_tests::MakePairedRecord;
+using genie::core::record::ClassType;
+using genie::core::record::Record;
+using genie::core::record::Segment;
+using genie::core::stats::AuStatistics;
+namespace api = genie::core::api;
+
+namespace {
+
+Record SingleRecord(const uint64_t position, const std::string& ecigar,
+                    const uint8_t reverse, const uint8_t flags = 0) {
+  return MakeMappedRecord(ClassType::kClassI, position,
+                          {std::string(10, 'A'), ecigar, reverse, 30}, flags);
+}
+
+Record PairedRecord(const uint64_t position) {
+  return MakePairedRecord(ClassType::kClassP, position,
+                          {std::string(10, 'C'), "10=", 0}, 50,
+                          {std::string(10, 'G'), "10=", 1}, 0x04);
+}
+
+Record UnmappedRecord() {
+  Record rec(1, ClassType::kClassU, "u", "", 0x02);
+  rec.AddSegment(Segment(std::string(20, 'T')));
+  return rec;
+}
+
+}  // namespace
+
+TEST(AuStatistics, countsRecords) {  // NOLINT(cert-err58-cpp)
+  std::vector<Record> records;
+  records.push_back(SingleRecord(100, "10=", 0));
+  records.push_back(SingleRecord(120, "(2)3=C2+1=3-2=", 1));
+  records.push_back(SingleRecord(140, "[3]10=", 0, 0x01));
+  records.push_back(PairedRecord(200));
+  const auto stats = AuStatistics(records).ToSimpleStatistics();
+
+  EXPECT_EQ(stats.reads_number, 4u);
+  EXPECT_EQ(stats.segments_number_reads_distribution,
+            (std::vector<uint64_t>{0, 3, 1}));
+  EXPECT_EQ(stats.properly_paired_number, 1u);
+  EXPECT_EQ(stats.optical_duplicates_number, 1u);
+  EXPECT_EQ(stats.segment_length[0], 10u);
+  EXPECT_EQ(stats.segment_length[1], 10u);
+
+  EXPECT_EQ(stats.mapped_strand_segment_distribution[static_cast<uint8_t>(
+                api::Strand::kForward)],
+            3u);
+  EXPECT_EQ(stats.mapped_strand_segment_distribution[static_cast<uint8_t>(
+                api::Strand::kReverse)],
+            2u);
+  EXPECT_EQ(stats.mapped_strand_pair_distribution[static_cast<uint8_t>(
+                api::StrandPaired::kForwardReverse)],
+            1u);
+
+  // One substitution, one insertion of 2 and one deletion of 3 bases
+  EXPECT_EQ(stats.substitutions_number[1], 1u);
+  EXPECT_EQ(stats.insertions_length[1], 2u);
+  EXPECT_EQ(stats.deletions_length[1], 3u);
+  EXPECT_EQ(stats.errors_number[1], 3u);
+  EXPECT_EQ(stats.errors_number[0], 0u);
+
+  EXPECT_EQ(stats.clipped_segment_distribution[static_cast<uint8_t>(
+                api::ClipTypeCombination::kNone)],
+            3u);
+  EXPECT_EQ(stats.clipped_segment_distribution[static_cast<uint8_t>(
+                api::ClipTypeCombination::kSoft)],
+            1u);
+  EXPECT_EQ(stats.clipped_segment_distribution[static_cast<uint8_t>(
+                api::ClipTypeCombination::kSoftHard)],
+            1u);
+  EXPECT_EQ(stats.class_segment_distribution[0], 2u);
+  EXPECT_EQ(stats.class_segment_distribution[3], 3u);
+  EXPECT_EQ(stats.alignment_score[2], 30u);
+}
+
+TEST(AuStatistics, mergeMatchesWholeSet) {  // NOLINT(cert-err58-cpp)
+  std::vector<Record> first;
+  first.push_back(SingleRecord(100, "4=A5=", 0));
+  first.push_back(UnmappedRecord());
+  std::vector<Record> second;
+  second.push_back(SingleRecord(300, "2=1+7=", 1));
+  second.push_back(PairedRecord(400));
+
+  std::vector<Record> all;
+  for (const auto& r : first) {
+    all.push_back(r);
+  }
+  for (const auto& r : second) {
+    all.push_back(r);
+  }
+
+  AuStatistics merged(first);
+  merged.Merge(AuStatistics(second));
+  EXPECT_EQ(merged.ToJson(), AuStatistics(all).ToJson());
+  EXPECT_EQ(merged.GetNumReads(), 4u);
+  EXPECT_EQ(merged.ToSimpleStatistics().quality_check_failed_reads_number,
+            1u);
+}
+
+TEST(AuStatistics, datasetMergesOverlappingUnits) {  // NOLINT(cert-err58-cpp)
+  genie::core::meta::Dataset dataset(
+      0, std::make_unique<genie::core::meta::block_header::Enabled>(false,
+                                                                   false),
+      "", "");
+  for (size_t i = 0; i < 3; ++i) {
+    genie::core::meta::AccessUnit au(i);
+    au.SetStatistics(AuStatistics(
+        std::vector<Record>{SingleRecord(1000 * i, "10=", 0),
+                            SingleRecord(1000 * i + 500, "10=", 0)}));
+    dataset.AddAccessUnit(std::move(au));
+  }
+
+  // Survives the json sidecar
+  const genie::core::meta::Dataset loaded(dataset.ToJson());
+  EXPECT_EQ(loaded.GetStatistics(0, 0, 10000).GetNumReads(), 6u);
+  EXPECT_EQ(loaded.GetStatistics(0, 1200, 1300).GetNumReads(), 2u);
+  EXPECT_EQ(loaded.GetStatistics(0, 509, 1000).GetNumReads(), 4u);
+  EXPECT_EQ(loaded.GetStatistics(0, 5000, 6000).GetNumReads(), 0u);
+  EXPECT_EQ(loaded.GetStatistics(1, 0, 10000).GetNumReads(), 0u);
+}
+
+TEST(AuStatistics, advancedSplitsByStrand) {  // NOLINT(cert-err58-cpp)
+  std::vector<Record> records;
+  records.push_back(SingleRecord(100, "10=", 0));
+  records.push_back(SingleRecord(120, "4=A5=", 1));
+  records.push_back(SingleRecord(140, "10=", 1));
+  records.push_back(UnmappedRecord());
+  const auto middle = records.begin() + 2;
+  AuStatistics merged(std::vector<Record>(records.begin(), middle));
+  merged.Merge(AuStatistics(std::vector<Record>(middle, records.end())));
+  EXPECT_EQ(merged.ToJson(), AuStatistics(records).ToJson());
+
+  const auto stats = merged.ToAdvancedStatistics();
+  const auto& forward = stats.simple_statistics[static_cast<uint8_t>(
+      api::StrandStrict::kForward)];
+  const auto& reverse = stats.simple_statistics[static_cast<uint8_t>(
+      api::StrandStrict::kReverse)];
+  EXPECT_EQ(forward.reads_number, 1u);
+  EXPECT_EQ(reverse.reads_number, 2u);
+  EXPECT_EQ(reverse.substitutions_number[1], 1u);
+  EXPECT_EQ(forward.substitutions_number[1], 0u);
+}
+
+TEST(AuStatistics, genieStateMergesDataset) {  // NOLINT(cert-err58-cpp)
+  genie::core::meta::Dataset dataset(
+      0, std::make_unique<genie::core::meta::block_header::Enabled>(false,
+                                                                   false),
+      "", "");
+  for (size_t i = 0; i < 2; ++i) {
+    genie::core::meta::AccessUnit au(i);
+    au.SetStatistics(AuStatistics(std::vector<Record>{
+        SingleRecord(1000 * i, "10=", 0), PairedRecord(1000 * i + 100)}));
+    dataset.AddAccessUnit(std::move(au));
+  }
+  api::GenieState::AddDataset(1, 2, std::move(dataset));
+
+  const auto simple = api::GenieState::GetSimpleStatistics(1, 2, 0, 0, 1050);
+  ASSERT_EQ(simple.size(), 1u);
+  EXPECT_EQ(simple.front().reads_number, 4u);
+  EXPECT_EQ(simple.front().segments_number_reads_distribution,
+            (std::vector<uint64_t>{0, 2, 2}));
+  const auto advanced =
+      api::GenieState::GetAdvancedStatistics(1, 2, 0, 1000, 1050);
+  ASSERT_EQ(advanced.size(), 1u);
+  EXPECT_EQ(advanced.front().simple_statistics[0].reads_number, 2u);
+  EXPECT_EQ(advanced.front().simple_statistics[1].reads_number, 0u);
+
+  const uint64_t max_segments = 4;
+  GenieSimpleSegmentStatistics* c_stats = nullptr;
+  ASSERT_EQ(
+      GenieGetSimpleStatistics(1, 2, 0, 0, 1050, &max_segments, &c_stats),
+      kGenieReturnCodeGSuccess);
+  EXPECT_EQ(c_stats->reads_number, 4u);
+  EXPECT_EQ(c_stats->segments_number_reads_distribution[2], 2u);
+  EXPECT_EQ(c_stats->segments_number_reads_distribution[3], 0u);
+  GenieFreeSimpleStatistics(c_stats);
+
+  EXPECT_THROW(api::GenieState::GetSimpleStatistics(1, 3, 0, 0, 1050),
+               api::ExceptionDatasetNotFound);
+  EXPECT_EQ(
+      GenieGetSimpleStatistics(1, 3, 0, 0, 1050, &max_segments, &c_stats),
+      kGenieReturnCodeGDatasetNotfound);
+  api::GenieState::RemoveDataset(1, 2);
+  EXPECT_THROW(api::GenieState::GetSimpleStatistics(1, 2, 0, 0, 1050),
+               api::ExceptionDatasetNotFound);
+}
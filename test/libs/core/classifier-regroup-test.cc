@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "genie/core/classifier_regroup.h"
+#include "genie/core/reference_manager.h"
+#include "helpers.h"
+
+using genie::core::ClassifierRegroup;
+using genie::core::ReferenceManager;
+using genie::core::record::Chunk;
+using genie::core::record::ClassType;
+using genie::core::record::Record;
+
+namespace {
+
+class StringReference final : public genie::core::Reference {
+  std::string sequence_;
+
+ public:
+  StringReference(std::string name, std::string sequence)
+      : Reference(std::move(name), 0, sequence.size()),
+        sequence_(std::move(sequence)) {}
+
+  std::string GetSequence(const uint64_t start, const uint64_t end) override {
+    return sequence_.substr(start, end - start);
+  }
+};
+
+Record MappedRecord(const std::string& reference, const uint64_t position,
+                    const size_t length) {
+  return core_tests::MakeMappedRecord(
+      ClassType::kClassM, position,
+      {reference.substr(position, length), std::to_string(length) + "=", 0, 60},
+      0, "r" + std::to_string(position));
+}
+
+}  // namespace
+
+TEST(ClassifierRegroup, excerptGrowsAcrossReferenceChunks) {  // NOLINT
+  const size_t chunk_size = ReferenceManager::GetChunkSize();
+  std::string reference(2 * chunk_size + 1000, 'A');
+  std::mt19937 rng(1);
+  for (auto& c : reference) {
+    c = "ACGT"[rng() % 4];
+  }
+  ReferenceManager mgr(4);
+  mgr.AddRef(0, std::make_unique<StringReference>("chr1", reference));
+
+  ClassifierRegroup classifier(1000, &mgr,
+                               ClassifierRegroup::RefMode::kNone, false);
+  Chunk input;
+  input.SetRefId(0);
+  const uint64_t first = 100;
+  uint64_t last = first;
+  for (uint64_t pos = first; pos <= 2 * chunk_size + 500;
+       pos += chunk_size / 4) {
+    input.GetData().push_back(MappedRecord(reference, pos, 100));
+    last = pos;
+  }
+  // Runs past the end of the reference, so it is not covered
+  input.GetData().push_back(
+      MappedRecord(reference + std::string(100, 'A'), reference.size() - 50,
+                   100));
+  const size_t records = input.GetData().size();
+  classifier.Add(std::move(input));
+  classifier.Flush();
+
+  size_t ref_based = 0;
+  size_t total = 0;
+  for (auto out = classifier.GetChunk(); !out.GetData().empty();
+       out = classifier.GetChunk()) {
+    total += out.GetData().size();
+    if (out.GetRef().GetRefName().empty()) {
+      continue;
+    }
+    ref_based += out.GetData().size();
+    const auto& excerpt = out.GetRef();
+    EXPECT_EQ(excerpt.GetRefName(), "chr1");
+    EXPECT_EQ(excerpt.GetGlobalStart(), first);
+    EXPECT_EQ(excerpt.GetGlobalEnd(), last + 100);
+    EXPECT_EQ(excerpt.GetString(first, first + 100),
+              reference.substr(first, 100));
+    EXPECT_EQ(excerpt.GetString(last, last + 100),
+              reference.substr(last, 100));
+  }
+  EXPECT_EQ(total, records);
+  EXPECT_EQ(ref_based, records - 1);
+}
+
+TEST(ClassifierRegroup, batchedReadsStayColumnar) {  // NOLINT
+  ReferenceManager mgr(4);
+  ClassifierRegroup classifier(3, &mgr, ClassifierRegroup::RefMode::kNone,
+                               false);
+  // Two importer chunks of 2 reads each, regrouped into chunks of 3
+  for (size_t c = 0; c < 2; ++c) {
+    Chunk input;
+    for (size_t r = 0; r < 2; ++r) {
+      const auto name = "read" + std::to_string(2 * c + r);
+      input.GetBatch().AddRecord(name, "", 1, ClassType::kClassU, 0, true);
+      std::string("ACGT").copy(input.GetBatch().AddSegment(4), 4);
+      input.GetBatch().AddQualities(r, "IIII");
+    }
+    classifier.Add(std::move(input));
+  }
+  classifier.Flush();
+
+  std::vector<std::string> names;
+  for (auto out = classifier.GetChunk(); !out.Empty();
+       out = classifier.GetChunk()) {
+    ASSERT_TRUE(out.IsBatched());
+    for (size_t r = 0; r < out.GetBatch().Size(); ++r) {
+      names.emplace_back(out.GetBatch().GetName(r));
+      EXPECT_EQ(out.GetBatch().GetQualities(r), "IIII");
+    }
+  }
+  EXPECT_EQ(names, (std::vector<std::string>{"read0", "read1", "read2",
+                                             "read3"}));
+}
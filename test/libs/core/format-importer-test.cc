@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "genie/core/classifier_bypass.h"
+#include "genie/core/format_importer.h"
+#include "genie/util/thread_manager.h"
+
+using genie::core::Classifier;
+using genie::core::ClassifierBypass;
+using genie::core::FormatImporter;
+using genie::core::record::Chunk;
+using genie::core::record::ClassType;
+using genie::core::record::Record;
+using genie::core::record::Segment;
+using genie::util::Section;
+
+namespace {
+
+/// Hands one single-record chunk per call to the classifier.
+class CountingImporter final : public FormatImporter {
+  size_t left_;
+
+ protected:
+  bool PumpRetrieve(Classifier* classifier) override {
+    if (!left_) {
+      return false;
+    }
+    --left_;
+    Record rec(1, ClassType::kClassU, "r", "", 0);
+    rec.AddSegment(Segment("ACGT"));
+    Chunk chunk;
+    chunk.GetData().push_back(std::move(rec));
+    classifier->Add(std::move(chunk));
+    return true;
+  }
+
+ public:
+  explicit CountingImporter(const size_t chunks) : left_(chunks) {}
+};
+
+/// Records the order of the sections and whether warm-up sections overlap.
+class OrderSink final : public genie::util::Drain<Chunk> {
+  std::atomic<int> in_flight_{0};
+
+ public:
+  std::mutex lock;
+  std::vector<size_t> starts;
+  std::atomic<bool> warm_up_over{false};
+  std::atomic<bool> overlapped{false};
+
+  void FlowIn(Chunk&&, const Section& id) override {
+    if (in_flight_++ && !warm_up_over) {
+      overlapped = true;
+    }
+    // Give the other threads a chance to overtake
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    {
+      std::lock_guard guard(lock);
+      starts.push_back(id.start);
+    }
+    --in_flight_;
+  }
+
+  void FlushIn(uint64_t&) override {}
+
+  void SkipIn(const Section&) override {}
+};
+
+/**
+ * @brief Imports the given number of chunks on several threads.
+ * @param chunks Number of chunks to import.
+ * @param warm_up Number of sections to pass in order.
+ * @param sink Receives the chunks.
+ * @return Number of sections that had arrived when the warm-up ended, one
+ * entry per call of the callback.
+ */
+std::vector<size_t> Import(const size_t chunks, const size_t warm_up,
+                           OrderSink& sink) {
+  CountingImporter importer(chunks);
+  ClassifierBypass classifier;
+  importer.SetClassifier(&classifier);
+  importer.SetDrain(&sink);
+  std::vector<size_t> done;
+  importer.SetWarmUp(warm_up, [&] {
+    done.push_back(sink.starts.size());
+    sink.warm_up_over = true;
+  });
+  genie::util::ThreadManager threads(4, 0);
+  threads.SetSource({&importer});
+  threads.Run();
+  return done;
+}
+
+}  // namespace
+
+TEST(FormatImporter, warmUpPassesSectionsInOrder) {  // NOLINT
+  OrderSink sink;
+  const auto done = Import(40, 10, sink);
+
+  ASSERT_EQ(done, std::vector<size_t>{10});
+  EXPECT_FALSE(sink.overlapped);
+  ASSERT_EQ(sink.starts.size(), 40);
+  for (size_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(sink.starts[i], i);
+  }
+}
+
+TEST(FormatImporter, warmUpEndsWithShortInput) {  // NOLINT
+  OrderSink sink;
+  const auto done = Import(3, 10, sink);
+
+  ASSERT_EQ(done, std::vector<size_t>{3});
+  EXPECT_FALSE(sink.overlapped);
+  EXPECT_EQ(sink.starts, (std::vector<size_t>{0, 1, 2}));
+}
@@ -0,0 +1,68 @@
+#include "helpers.h"
+
+#include <memory>
+#include <utility>
+
+#include "genie/core/record/alignment_split/same_rec.h"
+
+namespace core_tests {
+
+SegmentSpec::SegmentSpec(std::string sequence, std::string ecigar,
+                         const uint8_t reverse,
+                         const std::optional<int32_t> mapping_score,
+                         std::string qualities)
+    : sequence(std::move(sequence)),
+      ecigar(std::move(ecigar)),
+      reverse(reverse),
+      mapping_score(mapping_score),
+      qualities(std::move(qualities)) {}
+
+namespace {
+
+genie::core::record::Segment MakeSegment(const SegmentSpec& spec) {
+  genie::core::record::Segment segment{std::string(spec.sequence)};
+  if (!spec.qualities.empty()) {
+    segment.AddQualities(std::string(spec.qualities));
+  }
+  return segment;
+}
+
+genie::core::record::Alignment MakeAlignment(const SegmentSpec& spec) {
+  genie::core::record::Alignment alignment(std::string(spec.ecigar),
+                                           spec.reverse);
+  if (spec.mapping_score) {
+    alignment.AddMappingScore(*spec.mapping_score);
+  }
+  return alignment;
+}
+
+}  // namespace
+
+genie::core::record::Record MakeMappedRecord(
+    const genie::core::record::ClassType class_id, const uint64_t position,
+    const SegmentSpec& segment, const uint8_t flags, const std::string& name,
+    const std::string& group, const uint16_t seq_id) {
+  genie::core::record::Record rec(1, class_id, std::string(name),
+                                  std::string(group), flags);
+  rec.AddSegment(MakeSegment(segment));
+  rec.AddAlignment(seq_id, genie::core::record::AlignmentBox(
+                               position, MakeAlignment(segment)));
+  return rec;
+}
+
+genie::core::record::Record MakePairedRecord(
+    const genie::core::record::ClassType class_id, const uint64_t position,
+    const SegmentSpec& first, const int64_t delta, const SegmentSpec& second,
+    const uint8_t flags, const std::string& name) {
+  genie::core::record::Record rec(2, class_id, std::string(name), "", flags);
+  rec.AddSegment(MakeSegment(first));
+  rec.AddSegment(MakeSegment(second));
+  genie::core::record::AlignmentBox box(position, MakeAlignment(first));
+  box.AddAlignmentSplit(
+      std::make_unique<genie::core::record::alignment_split::SameRec>(
+          delta, MakeAlignment(second)));
+  rec.AddAlignment(0, std::move(box));
+  return rec;
+}
+
+}  // namespace core_tests
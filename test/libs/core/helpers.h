@@ -0,0 +1,63 @@
+#ifndef CORE_TESTS_HELPERS_H_
+#define CORE_TESTS_HELPERS_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "genie/core/record/record.h"
+
+namespace core_tests {
+
+/**
+ * @brief One aligned segment of a record built by the helpers below.
+ */
+struct SegmentSpec {
+  std::string sequence;                  //!< Bases of the segment.
+  std::string ecigar;                    //!< Extended CIGAR of the alignment.
+  uint8_t reverse;                       //!< Reverse complement flag.
+  std::optional<int32_t> mapping_score;  //!< No mapping score if empty.
+  std::string qualities;                 //!< No quality values if empty.
+
+  SegmentSpec(std::string sequence, std::string ecigar, uint8_t reverse = 0,
+              std::optional<int32_t> mapping_score = std::nullopt,
+              std::string qualities = "");
+};
+
+/**
+ * @brief Builds a single-end record with one alignment.
+ * @param class_id Record class.
+ * @param position Mapping position.
+ * @param segment The segment and its alignment.
+ * @param flags Record flags.
+ * @param name Read name.
+ * @param group Read group.
+ * @param seq_id Reference sequence of the alignment.
+ * @return The record.
+ */
+genie::core::record::Record MakeMappedRecord(
+    genie::core::record::ClassType class_id, uint64_t position,
+    const SegmentSpec& segment, uint8_t flags = 0,
+    const std::string& name = "r", const std::string& group = "",
+    uint16_t seq_id = 0);
+
+/**
+ * @brief Builds a paired record with both segments aligned in the same
+ * record. Both segments must have a mapping score, or neither.
+ * @param class_id Record class.
+ * @param position Mapping position of the first segment.
+ * @param first The first segment and its alignment.
+ * @param delta Position of the second segment relative to the first.
+ * @param second The second segment and its alignment.
+ * @param flags Record flags.
+ * @param name Read name.
+ * @return The record.
+ */
+genie::core::record::Record MakePairedRecord(
+    genie::core::record::ClassType class_id, uint64_t position,
+    const SegmentSpec& first, int64_t delta, const SegmentSpec& second,
+    uint8_t flags = 0, const std::string& name = "r");
+
+}  // namespace core_tests
+
+#endif  // CORE_TESTS_HELPERS_H_
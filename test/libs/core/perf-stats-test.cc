@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "genie/core/stats/descriptor_metrics.h"
+#include "genie/core/stats/perf_stats.h"
+
+using genie::core::stats::Intern;
+using genie::core::stats::PerfStats;
+
+TEST(PerfStats, internIsStable) {  // NOLINT(cert-err58-cpp)
+  const auto id = Intern("test-intern");
+  EXPECT_EQ(id, Intern("test-intern"));
+  EXPECT_NE(id, Intern("test-intern-other"));
+  EXPECT_EQ(genie::core::stats::MetricRegistry::Instance().GetName(id),
+            "test-intern");
+}
+
+TEST(PerfStats, aggregateAndMerge) {  // NOLINT(cert-err58-cpp)
+  const auto id = Intern("size-test-merge");
+  PerfStats a;
+  a.AddInteger(id, 3);
+  a.AddInteger(id, 100);
+  PerfStats b;
+  b.AddInteger("size-test-merge", 1);
+  b.AddDouble("time-test-merge", 0.5);
+  a.Add(b);
+
+  const auto* stat = a.Get(id);
+  ASSERT_NE(stat, nullptr);
+  EXPECT_EQ(stat->ctr, 3u);
+  EXPECT_EQ(stat->sum.i_data, 104);
+  EXPECT_EQ(stat->min.i_data, 1);
+  EXPECT_EQ(stat->max.i_data, 100);
+  EXPECT_EQ(stat->histogram[1], 1u);  // 1
+  EXPECT_EQ(stat->histogram[2], 1u);  // 3
+  EXPECT_EQ(stat->histogram[7], 1u);  // 100
+
+  const auto json = a.ToJson();
+  EXPECT_EQ(json["size-test-merge"]["sum"], 104);
+  EXPECT_EQ(json["time-test-merge"]["count"], 1);
+
+  std::stringstream prometheus;
+  a.WritePrometheus(prometheus);
+  EXPECT_NE(prometheus.str().find("genie_size_test_merge_count 3\n"),
+            std::string::npos);
+  EXPECT_NE(
+      prometheus.str().find("genie_size_test_merge_bucket{le=\"+Inf\"} 3"),
+      std::string::npos);
+}
+
+TEST(PerfStats, disabled) {  // NOLINT(cert-err58-cpp)
+  PerfStats::SetEnabled(false);
+  PerfStats stats;
+  stats.AddInteger("size-test-disabled", 1);
+  PerfStats::SetEnabled(true);
+  EXPECT_EQ(stats.begin(), stats.end());
+}
+
+TEST(PerfStats, descriptorMetrics) {  // NOLINT(cert-err58-cpp)
+  const genie::core::stats::DescriptorMetrics metrics("testcodec");
+  const auto& registry = genie::core::stats::MetricRegistry::Instance();
+  EXPECT_EQ(registry.GetName(metrics.TotalRaw()), "size-testcodec-total-raw");
+  EXPECT_EQ(registry.GetName(metrics.Time()), "time-testcodec");
+  EXPECT_EQ(
+      registry.GetName(metrics.Raw(genie::core::gen_sub::kPositionFirst)),
+      "size-testcodec-pos-first-raw");
+  EXPECT_EQ(registry.GetName(
+                metrics.Comp({genie::core::GenDesc::kReadName, 0x42})),
+            "size-testcodec-rname-comp");
+}
+
+TEST(PerfStats, descriptorMetricsShared) {  // NOLINT(cert-err58-cpp)
+  const auto& a = genie::core::stats::DescriptorMetrics::Get("sharedcodec");
+  const auto& b = genie::core::stats::DescriptorMetrics::Get("sharedcodec");
+  EXPECT_EQ(&a, &b);
+  EXPECT_EQ(genie::core::stats::MetricRegistry::Instance().GetName(a.Time()),
+            "time-sharedcodec");
+  EXPECT_NE(&genie::core::stats::DescriptorMetrics::Get("othercodec"), &a);
+}
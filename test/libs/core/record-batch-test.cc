@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "genie/core/record/chunk.h"
+#include "genie/core/record/record_batch.h"
+#include "genie/util/runtime_exception.h"
+#include "helpers.h"
+
+using genie::core::record::ClassType;
+using genie::core::record::Record;
+using genie::core::record::RecordBatch;
+using genie::core::record::Segment;
+
+namespace {
+
+Record MappedRecord() {
+  return core_tests::MakeMappedRecord(ClassType::kClassM, 1000,
+                                      {"ACGTA", "2=C2=", 1, 42, "IIIII"}, 0x02,
+                                      "mapped", "grp", 3);
+}
+
+Record PairedRecord() {
+  Record rec(2, ClassType::kClassU, "pair", "", 0, false);
+  rec.AddSegment(Segment(std::string("AAAA")));
+  rec.AddSegment(Segment(std::string("CCC")));
+  return rec;
+}
+
+}  // namespace
+
+TEST(RecordBatch, roundTripsRecords) {  // NOLINT(cert-err58-cpp)
+  RecordBatch batch;
+  batch.Add(MappedRecord());
+  batch.Add(PairedRecord());
+
+  ASSERT_EQ(batch.Size(), 2u);
+  EXPECT_EQ(batch.GetNumSegments(), 3u);
+  EXPECT_EQ(batch.GetFirstSegment(1), 1u);
+  EXPECT_EQ(batch.GetNumSegments(1), 2u);
+  EXPECT_EQ(batch.GetName(0), "mapped");
+  EXPECT_EQ(batch.GetGroup(0), "grp");
+  EXPECT_EQ(batch.GetPosition(0), 1000u);
+  EXPECT_EQ(batch.GetSeqId(0), 3u);
+  EXPECT_EQ(batch.GetECigar(0), "2=C2=");
+  EXPECT_EQ(batch.GetMappingScore(0), 42);
+  EXPECT_EQ(batch.GetPosition(1), RecordBatch::kUnmapped);
+  EXPECT_FALSE(batch.IsRead1First(1));
+  EXPECT_EQ(batch.GetSequence(2), "CCC");
+  EXPECT_EQ(batch.GetQualities(0), "IIIII");
+  EXPECT_TRUE(batch.GetQualities(1).empty());
+
+  std::vector<Record> records;
+  batch.MoveTo(records);
+  EXPECT_TRUE(batch.Empty());
+  ASSERT_EQ(records.size(), 2u);
+
+  const auto& mapped = records[0];
+  EXPECT_EQ(mapped.GetClassId(), ClassType::kClassM);
+  EXPECT_EQ(mapped.GetFlags(), 0x02);
+  EXPECT_EQ(mapped.GetSegments().front().GetQualities().front(), "IIIII");
+  EXPECT_EQ(mapped.GetAlignmentSharedData().GetSeqId(), 3u);
+  const auto& box = mapped.GetAlignments().front();
+  EXPECT_EQ(box.GetPosition(), 1000u);
+  EXPECT_EQ(box.GetAlignment().GetECigar(), "2=C2=");
+  EXPECT_EQ(box.GetAlignment().GetRComp(), 1);
+  EXPECT_EQ(box.GetAlignment().GetMappingScores().front(), 42);
+
+  const auto& paired = records[1];
+  EXPECT_EQ(paired.GetNumberOfTemplateSegments(), 2);
+  EXPECT_FALSE(paired.IsRead1First());
+  EXPECT_TRUE(paired.GetAlignments().empty());
+  ASSERT_EQ(paired.GetSegments().size(), 2u);
+  EXPECT_EQ(paired.GetSegments()[1].GetSequence(), "CCC");
+  EXPECT_TRUE(paired.GetSegments()[1].GetQualities().empty());
+}
+
+TEST(RecordBatch, padsSkippedQualities) {  // NOLINT(cert-err58-cpp)
+  RecordBatch batch;
+  for (const auto* seq : {"AC", "GTT", "A"}) {
+    batch.AddRecord("", "", 1, ClassType::kClassU, 0, true);
+    std::string(seq).copy(batch.AddSegment(std::string(seq).size()), 3);
+  }
+  batch.AddQualities(1, "FFF");
+  EXPECT_TRUE(batch.GetQualities(0).empty());
+  EXPECT_EQ(batch.GetQualities(1), "FFF");
+  EXPECT_TRUE(batch.GetQualities(2).empty());
+  EXPECT_EQ(batch.GetSequence(1), "GTT");
+  EXPECT_THROW(batch.AddQualities(0, "FF"), genie::util::RuntimeException);
+}
+
+TEST(RecordBatch, movedFromBatchIsUsable) {  // NOLINT(cert-err58-cpp)
+  RecordBatch batch;
+  batch.Add(MappedRecord());
+  RecordBatch copy;
+  copy.Append(batch, 0);
+  EXPECT_EQ(copy.GetRecord(0).GetName(), "mapped");
+  EXPECT_EQ(copy.GetMemoryUsage(0), batch.GetMemoryUsage(0));
+
+  RecordBatch moved(std::move(batch));
+  EXPECT_EQ(moved.Size(), 1u);
+  EXPECT_TRUE(batch.Empty());  // NOLINT(bugprone-use-after-move)
+  batch.Add(PairedRecord());
+  EXPECT_EQ(batch.GetSequence(1), "CCC");
+
+  moved = std::move(batch);
+  EXPECT_EQ(moved.GetName(0), "pair");
+  EXPECT_TRUE(batch.Empty());  // NOLINT(bugprone-use-after-move)
+}
+
+TEST(RecordBatch, chunkMaterializesBatch) {  // NOLINT(cert-err58-cpp)
+  genie::core::record::Chunk chunk;
+  chunk.GetBatch().Add(PairedRecord());
+  chunk.GetBatch().Add(PairedRecord());
+  EXPECT_TRUE(chunk.IsBatched());
+  EXPECT_EQ(chunk.Size(), 2u);
+  EXPECT_EQ(chunk.GetData().size(), 2u);
+  EXPECT_FALSE(chunk.IsBatched());
+  EXPECT_TRUE(chunk.GetBatch().Empty());
+  EXPECT_EQ(chunk.GetData()[0].GetName(), "pair");
+}
+
+TEST(RecordBatch, constChunkDoesNotMaterialize) {  // NOLINT(cert-err58-cpp)
+  genie::core::record::Chunk chunk;
+  chunk.GetBatch().Add(PairedRecord());
+  const auto& view = chunk;
+  EXPECT_THROW(static_cast<void>(view.GetData()),
+               genie::util::RuntimeException);
+  EXPECT_TRUE(chunk.IsBatched());
+
+  chunk.MaterializeRecords();
+  EXPECT_FALSE(chunk.IsBatched());
+  EXPECT_EQ(view.GetData().size(), 1u);
+  EXPECT_EQ(view.GetData()[0].GetSegments()[1].GetSequence(), "CCC");
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <chrono>  // NOLINT
+#include <thread>  // NOLINT
+
+#include "genie/core/stats/perf_stats.h"
+#include "genie/core/stats/stage_timer.h"
+
+using genie::core::stats::GetStageName;
+using genie::core::stats::PerfStats;
+using genie::core::stats::Stage;
+using genie::core::stats::StageTimer;
+
+namespace {
+
+void Sleep(const int ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+}  // namespace
+
+TEST(StageTimer, nestedTimeIsExclusive) {  // NOLINT(cert-err58-cpp)
+  StageTimer::Reset();
+  {
+    StageTimer read(Stage::kReadCoding);
+    Sleep(20);
+    {
+      StageTimer entropy(Stage::kEntropy);
+      Sleep(40);
+    }
+    Sleep(20);
+    read.Stop();
+    // Not charged, the timer is stopped
+    Sleep(40);
+  }
+  const auto times = StageTimer::Collect();
+  const auto& read = times[static_cast<size_t>(Stage::kReadCoding)];
+  const auto& entropy = times[static_cast<size_t>(Stage::kEntropy)];
+  EXPECT_EQ(read.calls, 1u);
+  EXPECT_EQ(entropy.calls, 1u);
+  EXPECT_GE(read.busy, 0.039);
+  EXPECT_LT(read.busy, 0.075);
+  EXPECT_GE(entropy.busy, 0.039);
+  EXPECT_LT(entropy.busy, 0.075);
+  EXPECT_EQ(times[static_cast<size_t>(Stage::kImport)].calls, 0u);
+}
+
+TEST(StageTimer, sumsThreads) {  // NOLINT(cert-err58-cpp)
+  StageTimer::Reset();
+  auto work = [] {
+    StageTimer timer(Stage::kExport);
+    Sleep(20);
+  };
+  std::thread a(work);
+  std::thread b(work);
+  a.join();
+  b.join();
+  const auto time = StageTimer::Collect()[static_cast<size_t>(Stage::kExport)];
+  EXPECT_EQ(time.calls, 2u);
+  EXPECT_GE(time.busy, 0.039);
+}
+
+TEST(StageTimer, disabled) {  // NOLINT(cert-err58-cpp)
+  StageTimer::Reset();
+  PerfStats::SetEnabled(false);
+  {
+    StageTimer timer(Stage::kImport);
+    Sleep(1);
+  }
+  PerfStats::SetEnabled(true);
+  EXPECT_EQ(StageTimer::Collect()[0].calls, 0u);
+  EXPECT_EQ(GetStageName(Stage::kReadCoding), "read-coding");
+}
@@ -0,0 +1,130 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/format/fastq/importer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "genie/core/classifier_bypass.h"
+#include "genie/util/drain.h"
+#include "genie/util/thread_manager.h"
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+constexpr size_t kBlockSize = 16;
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Collects the read names of every section, keyed by the id of its
+ * first record.
+ */
+class NameSink final : public genie::util::Drain<genie::core::record::Chunk> {
+ public:
+  std::mutex lock;
+  std::map<uint64_t, std::vector<std::string>> sections;
+  bool duplicate = false;
+
+  void FlowIn(genie::core::record::Chunk&& chunk,
+              const genie::util::Section& id) override {
+    const auto& batch = chunk.GetBatch();
+    std::vector<std::string> names;
+    for (size_t i = 0; i < batch.Size(); ++i) {
+      names.emplace_back(batch.GetName(i));
+    }
+    EXPECT_EQ(names.size(), id.length);
+    std::lock_guard guard(lock);
+    duplicate |= !sections.emplace(id.start, std::move(names)).second;
+  }
+
+  void FlushIn(uint64_t&) override {}
+
+  void SkipIn(const genie::util::Section&) override {}
+};
+
+// -----------------------------------------------------------------------------
+
+std::string ReadName(const size_t lane, const size_t read) {
+  return "l" + std::to_string(lane) + "r" + std::to_string(read);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Imports single-end lanes on several threads.
+ * @param reads Number of reads in each lane.
+ * @param threads Number of threads.
+ * @return Read names in record id order.
+ */
+std::vector<std::string> Import(const std::vector<size_t>& reads,
+                                const size_t threads) {
+  std::vector<std::unique_ptr<std::stringstream>> files;
+  std::vector<std::vector<std::istream*>> lanes;
+  for (size_t lane = 0; lane < reads.size(); ++lane) {
+    files.emplace_back(std::make_unique<std::stringstream>());
+    for (size_t read = 0; read < reads[lane]; ++read) {
+      *files.back() << "@" << ReadName(lane, read) << "\nACGT\n+\nIIII\n";
+    }
+    lanes.push_back({files.back().get()});
+  }
+
+  genie::format::fastq::Importer importer(kBlockSize, lanes);
+  genie::core::ClassifierBypass classifier;
+  NameSink sink;
+  importer.SetClassifier(&classifier);
+  importer.SetDrain(&sink);
+  genie::util::ThreadManager manager(threads, 0);
+  manager.SetSource({&importer});
+  manager.Run();
+
+  EXPECT_FALSE(sink.duplicate);
+  std::vector<std::string> names;
+  for (const auto& [start, section] : sink.sections) {
+    // Record ids are dense, no two sections overlap
+    EXPECT_EQ(start, names.size());
+    names.insert(names.end(), section.begin(), section.end());
+  }
+  return names;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+TEST(FastqImporter, lanesInterleaveRoundRobin) {  // NOLINT(cert-err58-cpp)
+  const std::vector<size_t> reads = {100, 37, 0, 70};
+
+  // Blocks of equal index from all lanes, skipping lanes that ran out
+  std::vector<std::string> expected;
+  for (size_t block = 0; block * kBlockSize < 100; ++block) {
+    for (size_t lane = 0; lane < reads.size(); ++lane) {
+      for (size_t read = block * kBlockSize;
+           read < std::min(reads[lane], (block + 1) * kBlockSize); ++read) {
+        expected.push_back(ReadName(lane, read));
+      }
+    }
+  }
+
+  EXPECT_EQ(Import(reads, 1), expected);
+  for (int run = 0; run < 20; ++run) {
+    EXPECT_EQ(Import(reads, 4), expected);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
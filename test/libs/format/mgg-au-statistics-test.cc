@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "genie/format/mgg/au_statistics.h"
+#include "genie/util/bit_reader.h"
+#include "genie/util/bit_writer.h"
+#include "../core/helpers.h"
+
+using genie::core::record::ClassType;
+using genie::core::record::Record;
+
+namespace {
+
+Record MappedRecord(const uint64_t position, const uint8_t reverse) {
+  return core_tests::MakeMappedRecord(ClassType::kClassM, position,
+                                      {std::string(10, 'A'), "4=C5=", reverse});
+}
+
+}  // namespace
+
+TEST(MggAuStatistics, boxRoundTrips) {  // NOLINT(cert-err58-cpp)
+  const genie::core::stats::AuStatistics statistics(
+      std::vector<Record>{MappedRecord(100, 0), MappedRecord(200, 1)});
+  const genie::format::mgg::AuStatistics box(statistics);
+
+  std::stringstream stream;
+  {
+    genie::util::BitWriter writer(stream);
+    box.Write(writer);
+  }
+
+  genie::util::BitReader reader(stream);
+  std::string key(4, '\0');
+  reader.ReadAlignedBytes(key.data(), key.length());
+  EXPECT_EQ(key, "aust");
+  genie::format::mgg::AuStatistics read(reader);
+  EXPECT_TRUE(read == box);
+  EXPECT_EQ(read.GetStatistics().ToJson(), statistics.ToJson());
+  EXPECT_TRUE(read.GetStatistics().Overlaps(0, 150, 250));
+  EXPECT_EQ(read.decapsulate().ToAdvancedStatistics()
+                .simple_statistics[1]
+                .substitutions_number[1],
+            1u);
+}
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/format/mgrec/importer.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "genie/core/classifier_bypass.h"
+#include "genie/util/bit_reader.h"
+#include "genie/util/bit_writer.h"
+#include "../core/helpers.h"
+
+using genie::core::record::ClassType;
+using genie::core::record::Record;
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+Record AlignedRecord(const ClassType type, const std::string& name,
+                     const std::string& ecigar,
+                     const std::string& mate_ecigar = "") {
+  const core_tests::SegmentSpec segment{"ACGTACGTAC", ecigar, 0, 60};
+  if (mate_ecigar.empty()) {
+    return core_tests::MakeMappedRecord(type, 100, segment, 0, name);
+  }
+  return core_tests::MakePairedRecord(type, 100, segment, 200,
+                                      {"ACGTACGTAC", mate_ecigar, 0, 60}, 0,
+                                      name);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Imports records with support checking enabled.
+ * @param records Records to import.
+ * @param diverted Receives the names of the records written to the
+ * unsupported stream.
+ * @return Names of the records passed on for encoding.
+ */
+std::vector<std::string> Import(const std::vector<Record>& records,
+                                std::vector<std::string>& diverted) {
+  std::stringstream input;
+  {
+    genie::util::BitWriter writer(input);
+    for (const auto& rec : records) {
+      rec.Write(writer);
+    }
+  }
+
+  std::stringstream unsupported;
+  std::vector<std::string> imported;
+  {
+    genie::format::mgrec::Importer importer(records.size() + 1, input,
+                                            unsupported);
+    genie::core::ClassifierBypass classifier;
+    while (importer.PumpRetrieve(&classifier)) {
+    }
+    for (auto chunk = classifier.GetChunk(); !chunk.GetData().empty();
+         chunk = classifier.GetChunk()) {
+      for (const auto& rec : chunk.GetData()) {
+        imported.push_back(rec.GetName());
+      }
+    }
+  }
+
+  genie::util::BitReader reader(unsupported);
+  while (true) {
+    Record rec(reader);
+    if (!reader.IsStreamGood()) {
+      break;
+    }
+    diverted.push_back(rec.GetName());
+  }
+  return imported;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+TEST(MgrecImporter, importsSplicedRecordsOfEveryClass) {  // NOLINT
+  std::vector<Record> records;
+  records.push_back(AlignedRecord(ClassType::kClassM, "m", "10="));
+  records.push_back(AlignedRecord(ClassType::kClassM, "m-spliced", "3=50*7="));
+  records.push_back(AlignedRecord(ClassType::kClassP, "p-spliced", "5=9/5="));
+  records.push_back(AlignedRecord(ClassType::kClassI, "i-spliced", "5=9%5="));
+  records.push_back(
+      AlignedRecord(ClassType::kClassM, "mate-spliced", "10=", "4=20*6="));
+  records.push_back(AlignedRecord(ClassType::kClassM, "pair", "10=", "10="));
+  records.push_back(AlignedRecord(ClassType::kClassHm, "hm", "3=50*7="));
+
+  // Class HM is still diverted, spliced or not
+  std::vector<std::string> diverted;
+  const auto imported = Import(records, diverted);
+  EXPECT_EQ(imported,
+            (std::vector<std::string>{"m", "m-spliced", "p-spliced",
+                                      "i-spliced", "mate-spliced", "pair"}));
+  EXPECT_EQ(diverted, (std::vector<std::string>{"hm"}));
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
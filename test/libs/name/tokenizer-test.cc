@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "genie/core/record/chunk.h"
+#include "genie/name/tokenizer/decoder.h"
+#include "genie/name/tokenizer/encoder.h"
+#include "genie/name/tokenizer/tokenizer.h"
+
+namespace {
+
+genie::core::record::Chunk MakeChunk(const std::vector<std::string>& names) {
+  genie::core::record::Chunk chunk;
+  for (auto name : names) {
+    chunk.GetData().emplace_back(1, genie::core::record::ClassType::kClassU,
+                                 std::move(name), "", 0);
+  }
+  return chunk;
+}
+
+std::vector<std::string> RoundTrip(const std::vector<std::string>& names,
+                                   size_t enc_threads, size_t block_size,
+                                   size_t dec_threads) {
+  genie::name::tokenizer::Encoder encoder(enc_threads, block_size);
+  auto desc = std::get<0>(encoder.Process(MakeChunk(names)));
+  genie::name::tokenizer::Decoder decoder(dec_threads);
+  return std::get<0>(decoder.Process(desc));
+}
+
+std::vector<std::string> IlluminaNames(size_t count) {
+  std::vector<std::string> names;
+  for (size_t i = 0; i < count; ++i) {
+    names.push_back("A00123:8:H5KJ2DSXX:" + std::to_string(1 + i / 500) +
+                    ":" + std::to_string(1101 + i % 7) + ":" +
+                    std::to_string(1000 + i * 3) + ":00" +
+                    std::to_string(i % 13) + (i % 5 ? "" : "/1"));
+  }
+  return names;
+}
+
+void PushName(genie::name::tokenizer::TokenColumns& columns,
+              const genie::name::tokenizer::Tokens first, const uint32_t param,
+              const std::string& text) {
+  using genie::name::tokenizer::Tokens;
+  using genie::name::tokenizer::kTypeSeq;
+  const auto push32 = [&](const uint16_t pos, const Tokens type) {
+    auto& column = columns.Get(pos, static_cast<uint8_t>(type));
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      column.push_back(param >> shift & 0xff);
+    }
+  };
+  columns.Get(0, kTypeSeq).push_back(static_cast<uint8_t>(first));
+  push32(0, first);
+  uint16_t pos = 1;
+  if (!text.empty()) {
+    columns.Get(pos, kTypeSeq).push_back(static_cast<uint8_t>(Tokens::STRING));
+    auto& column = columns.Get(pos, static_cast<uint8_t>(Tokens::STRING));
+    column.insert(column.end(), text.begin(), text.end());
+    column.push_back('\0');
+    ++pos;
+  }
+  columns.Get(pos, kTypeSeq).push_back(static_cast<uint8_t>(Tokens::END));
+}
+
+void ExpectSameStreams(genie::name::tokenizer::Encoder& first,
+                       genie::name::tokenizer::Encoder& second,
+                       const std::vector<std::string>& names) {
+  auto a = std::get<0>(first.Process(MakeChunk(names)));
+  auto b = std::get<0>(second.Process(MakeChunk(names)));
+  ASSERT_EQ(a.GetSize(), b.GetSize());
+  for (uint16_t i = 0; i < a.GetSize(); ++i) {
+    ASSERT_EQ(a.Get(i).GetNumSymbols(), b.Get(i).GetNumSymbols());
+    for (size_t j = 0; j < a.Get(i).GetNumSymbols(); ++j) {
+      ASSERT_EQ(a.Get(i).Get(j), b.Get(i).Get(j));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(NameTokenizer, RoundTripSingleBlock) {
+  const std::vector<std::string> names = {
+      "SRR001.1", "SRR001.2", "SRR001.2", "SRR001.300", "SRR002.1",
+      "",         "read_7",   "read_0007", "x:99999999999:y"};
+  EXPECT_EQ(RoundTrip(names, 1, 1000, 1), names);
+}
+
+TEST(NameTokenizer, RoundTripBlocks) {
+  const auto names = IlluminaNames(1000);
+  EXPECT_EQ(RoundTrip(names, 1, 64, 1), names);
+  EXPECT_EQ(RoundTrip(names, 4, 64, 4), names);
+  EXPECT_EQ(RoundTrip(names, 4, 1, 3), names);
+}
+
+TEST(NameTokenizer, ThreadCountDoesNotChangeStreams) {
+  const auto names = IlluminaNames(500);
+  genie::name::tokenizer::Encoder single(1, 50);
+  genie::name::tokenizer::Encoder multi(8, 50);
+  ExpectSameStreams(single, multi, names);
+}
+
+TEST(NameTokenizer, DefaultBlockSizeDependsOnThreads) {
+  using genie::name::tokenizer::Encoder;
+  const auto names = IlluminaNames(Encoder::kDefaultBlockSize + 100);
+  Encoder whole_au(1, names.size());
+  Encoder single;
+  ExpectSameStreams(whole_au, single, names);
+  Encoder blocks(1, Encoder::kDefaultBlockSize);
+  Encoder multi(4);
+  ExpectSameStreams(blocks, multi, names);
+}
+
+TEST(NameTokenizer, LeadingDupDoesNotStartBlock) {
+  using genie::name::tokenizer::Tokens;
+  genie::name::tokenizer::TokenColumns columns;
+  PushName(columns, Tokens::DIFF, 0, "first");
+  PushName(columns, Tokens::DUP, 1, "");
+  PushName(columns, Tokens::DIFF, 0, "second");
+  PushName(columns, Tokens::DUP, 1, "");
+  genie::core::AccessUnit::Descriptor desc(genie::core::GenDesc::kReadName);
+  columns.Flush(desc);
+
+  const std::vector<std::string> expected = {"first", "first", "second",
+                                             "second"};
+  for (const size_t threads : {1, 2}) {
+    auto copy = desc;
+    genie::name::tokenizer::Decoder decoder(threads);
+    EXPECT_EQ(std::get<0>(decoder.Process(copy)), expected);
+  }
+}
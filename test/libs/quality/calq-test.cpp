@@ -3,6 +3,7 @@
 #include <iostream>
 
 #include "genie/quality/calq/calq_coder.h"
+#include "genie/quality/calq/genotyper.h"
 #include "genie/quality/calq/record_pileup.h"
 
 TEST(CalqTest, recordPileupBasic) {
@@ -233,4 +234,32 @@ TEST(CalqTest, recordPileupGetRecordsBefore) {
   EXPECT_EQ(records[1].sequences[1], "GG");
   EXPECT_EQ(records[1].quality_values[0], "gg");
   EXPECT_EQ(records[1].quality_values[1], "gg");
-}
\ No newline at end of file
+}
+
+TEST(CalqTest, genotyperLikelihoods) {
+  genie::quality::calq::Genotyper genotyper(2, 33, 8, false);
+
+  // genotypes are enumerated lexicographically: AA, AC, AG, AT, CC, ...
+  const auto& likelihoods =
+      genotyper.GetGenotypelikelihoods("AAAAAA", "IIIIII");
+  ASSERT_EQ(likelihoods.size(), 10u);
+  EXPECT_EQ(genotyper.AlleleCount(0, 'A'), 2u);
+  EXPECT_EQ(genotyper.AlleleCount(1, 'C'), 1u);
+  EXPECT_EQ(genotyper.AlleleCount(1, 'N'), 0u);
+
+  double sum = 0.0;
+  for (const double l : likelihoods) {
+    sum += l;
+  }
+  EXPECT_NEAR(sum, 1.0, 1e-9);
+  EXPECT_GT(likelihoods[0], 0.9);
+
+  // a clean homozygous column is certain, a 50/50 column is not
+  EXPECT_EQ(genotyper.ComputeQuantizerIndex("AAAAAA", "IIIIII"), 0);
+  EXPECT_GT(genotyper.ComputeQuantizerIndex("AC", "##"), 0);
+
+  // very deep pileups must not underflow
+  const std::string deep_seq(10000, 'G');
+  const std::string deep_qual(10000, 'I');
+  EXPECT_EQ(genotyper.ComputeQuantizerIndex(deep_seq, deep_qual), 0);
+}
@@ -123,4 +123,28 @@ TEST(LocalReferenceTest, wrongUsage) {
   local_ref = LocalReference(32);
   EXPECT_THROW(local_ref.AddSingleRead("AAA", "1+1=", 0),
                genie::util::RuntimeException);
-}
\ No newline at end of file
+}
+
+TEST(LocalReferenceTest, slidingWindow) {
+  LocalReference local_ref(15);
+  const std::string reference = "ACGTTGCAACGGTCATTGCA";
+
+  // old reads leave the window and must not vote anymore
+  local_ref.AddSingleRead("AAAAA", "5=", 5);
+  for (uint64_t pos = 0; pos + 5 <= reference.size(); pos += 5) {
+    local_ref.AddSingleRead(reference.substr(pos, 5), "5=", pos);
+  }
+  EXPECT_EQ(local_ref.GetReference(0, 5), std::string(5, '\0'));
+  EXPECT_EQ(local_ref.GetReference(5, 15), reference.substr(5, 15));
+}
+
+TEST(LocalReferenceTest, distantReads) {
+  LocalReference local_ref(1024);
+
+  // reads far apart, as in unsorted input
+  local_ref.AddSingleRead("ACGT", "4=", 0);
+  local_ref.AddSingleRead("GGCC", "4=", 1u << 30u);
+  local_ref.AddSingleRead("TCGT", "4=", 0);
+  EXPECT_EQ(local_ref.GetReference(0, 4), "ACGT");
+  EXPECT_EQ(local_ref.GetReference(1u << 30u, 4), "GGCC");
+}
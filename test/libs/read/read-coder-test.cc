@@ -0,0 +1,497 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cctype>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "genie/core/record/alignment_split/same_rec.h"
+#include "genie/entropy/gabac/decoder.h"
+#include "genie/entropy/gabac/encoder.h"
+#include "genie/name/tokenizer/decoder.h"
+#include "genie/name/tokenizer/encoder.h"
+#include "genie/quality/calq/decoder.h"
+#include "genie/quality/calq/encoder.h"
+#include "genie/quality/qvwriteout/encoder.h"
+#include "genie/read/localassembly/decoder.h"
+#include "genie/read/localassembly/encoder.h"
+#include "genie/read/refcoder/decoder.h"
+#include "genie/read/refcoder/encoder.h"
+#include "../core/helpers.h"
+
+using genie::core::record::ClassType;
+using genie::core::record::Record;
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/**
+ * @brief Pseudo-random reference that the test reads are cut from.
+ * @return 8000 bases.
+ */
+const std::string& Reference() {
+  static const std::string ref = [] {
+    std::string ret;
+    uint32_t state = 1;
+    for (size_t i = 0; i < 8000; ++i) {
+      state = state * 1103515245 + 12345;
+      ret += "ACGT"[(state >> 16) & 3];
+    }
+    return ret;
+  }();
+  return ref;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Reference excerpt as the classifier loads it for an access unit.
+ * @param records Records of the access unit in position order.
+ * @return The excerpt, starting at the first mapping position.
+ */
+genie::core::ReferenceManager::ReferenceExcerpt Excerpt(
+    const std::vector<Record>& records) {
+  genie::core::ReferenceManager::ReferenceExcerpt ret(
+      "ref", records.front().GetAlignments().front().GetPosition(),
+      Reference().size());
+  ret.MapChunkAt(0, std::make_shared<const std::string>(Reference()));
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Cuts the bases of an alignment out of the reference. Substituted
+ * bases are taken from the e-CIGAR, inserted and soft clipped bases are 'A'.
+ * @param position Mapping position.
+ * @param ecigar Extended CIGAR of the alignment.
+ * @return The read sequence.
+ */
+std::string Read(uint64_t position, const std::string& ecigar) {
+  std::string ret;
+  size_t count = 0;
+  for (const char c : ecigar) {
+    if (std::isdigit(c)) {
+      count = count * 10 + (c - '0');
+      continue;
+    }
+    switch (c) {
+      case '=':
+        ret += Reference().substr(position, count);
+        position += count;
+        break;
+      case '+':
+      case ')':
+        ret += std::string(count, 'A');
+        break;
+      case '-':
+      case '*':
+      case '/':
+      case '%':
+        position += count;
+        break;
+      case '(':
+      case '[':
+      case ']':
+        break;
+      default:
+        ret += c;
+        position += 1;
+        break;
+    }
+    count = 0;
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Builds an aligned segment cut out of the reference.
+ * @param position Mapping position.
+ * @param ecigar Extended CIGAR of the alignment.
+ * @return The segment with mapping score and quality values.
+ */
+core_tests::SegmentSpec Aligned(const uint64_t position,
+                                const std::string& ecigar) {
+  auto sequence = Read(position, ecigar);
+  std::string qualities(sequence.size(), 'I');
+  return {std::move(sequence), ecigar, 0, 60, std::move(qualities)};
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Builds a class HM record, the second segment is unaligned.
+ * @param name Read name.
+ * @param position Mapping position of the first segment.
+ * @param ecigar Extended CIGAR of the first segment.
+ * @return The record.
+ */
+Record HalfMapped(const std::string& name, const uint64_t position,
+                  const std::string& ecigar) {
+  const auto first = Aligned(position, ecigar);
+  Record rec(2, ClassType::kClassHm, std::string(name), "", 0);
+  genie::core::record::Segment segment(std::string(first.sequence));
+  segment.AddQualities(std::string(first.qualities));
+  rec.AddSegment(std::move(segment));
+  genie::core::record::Segment mate(std::string("TTGACCATGA"));
+  mate.AddQualities(std::string(10, 'I'));
+  rec.AddSegment(std::move(mate));
+  genie::core::record::Alignment alignment(std::string(ecigar), 0);
+  alignment.AddMappingScore(60);
+  rec.AddAlignment(0, genie::core::record::AlignmentBox(position,
+                                                        std::move(alignment)));
+  return rec;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Collects the records of every decoded access unit.
+ */
+class RecordSink final : public genie::util::Drain<genie::core::record::Chunk> {
+ public:
+  std::vector<Record> records;
+
+  void FlowIn(genie::core::record::Chunk&& chunk,
+              const genie::util::Section&) override {
+    for (auto& rec : chunk.GetData()) {
+      records.emplace_back(std::move(rec));
+    }
+  }
+
+  void FlushIn(uint64_t&) override {}
+
+  void SkipIn(const genie::util::Section&) override {}
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Collects the encoded access units.
+ */
+class AuSink final : public genie::util::Drain<genie::core::AccessUnit> {
+ public:
+  std::vector<genie::core::AccessUnit> units;
+
+  void FlowIn(genie::core::AccessUnit&& au,
+              const genie::util::Section&) override {
+    units.emplace_back(std::move(au));
+  }
+
+  void FlushIn(uint64_t&) override {}
+
+  void SkipIn(const genie::util::Section&) override {}
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Quality, name and entropy coders shared by both directions, the
+ * same ones the gabac pipeline uses.
+ */
+struct Coders {
+  genie::quality::qvwriteout::Encoder qv_encoder;
+  genie::quality::calq::Encoder calq_encoder;
+  genie::name::tokenizer::Encoder name_encoder;
+  genie::entropy::gabac::Encoder entropy_encoder{false};
+  genie::quality::calq::Decoder qv_decoder;
+  genie::name::tokenizer::Decoder name_decoder;
+  genie::entropy::gabac::Decoder entropy_decoder;
+
+  genie::core::ReadEncoder::qv_selector qv_encoders;
+  genie::core::ReadEncoder::name_selector name_encoders;
+  genie::core::ReadEncoder::entropy_selector entropy_encoders;
+  genie::core::ReadDecoder::qv_selector qv_decoders;
+  genie::core::ReadDecoder::name_selector name_decoders;
+  genie::core::ReadDecoder::entropy_selector entropy_decoders;
+
+  explicit Coders(const bool calq) {
+    qv_encoders.AddMod(calq ? static_cast<genie::core::QvEncoder*>(&calq_encoder)
+                            : &qv_encoder);
+    name_encoders.AddMod(&name_encoder);
+    entropy_encoders.AddMod(&entropy_encoder);
+    qv_decoders.AddMod(&qv_decoder);
+    name_decoders.AddMod(&name_decoder);
+    entropy_decoders.AddMod(&entropy_decoder);
+  }
+
+  void Attach(genie::core::ReadEncoder& encoder) {
+    encoder.SetQvCoder(&qv_encoders);
+    encoder.SetNameCoder(&name_encoders);
+    encoder.SetEntropyCoder(&entropy_encoders);
+  }
+
+  void Attach(genie::core::ReadDecoder& decoder) {
+    decoder.SetQvCoder(&qv_decoders);
+    decoder.SetNameCoder(&name_decoders);
+    decoder.SetEntropyCoder(&entropy_decoders);
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Encodes records as one access unit.
+ * @param records Records of one class in position order.
+ * @param reference_based Use the reference-based coder instead of local
+ * assembly.
+ * @param coders Quality, name and entropy coders.
+ * @return The encoded access unit.
+ */
+genie::core::AccessUnit Encode(const std::vector<Record>& records,
+                               const bool reference_based, Coders& coders) {
+  std::unique_ptr<genie::core::ReadEncoder> encoder;
+  if (reference_based) {
+    encoder = std::make_unique<genie::read::refcoder::Encoder>(false);
+  } else {
+    encoder =
+        std::make_unique<genie::read::localassembly::Encoder>(false, false);
+  }
+  AuSink sink;
+  coders.Attach(*encoder);
+  encoder->SetDrain(&sink);
+
+  genie::core::record::Chunk chunk;
+  chunk.GetData() = records;
+  if (reference_based) {
+    chunk.GetRef() = Excerpt(records);
+  }
+  encoder->FlowIn(std::move(chunk), {0, records.size(), false});
+  EXPECT_EQ(sink.units.size(), 1);
+  return std::move(sink.units.front());
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Encodes records as one access unit and decodes it again.
+ * @param records Records of one class in position order.
+ * @param reference_based Use the reference-based coder instead of local
+ * assembly.
+ * @param calq Code quality values with CALQ instead of writing them out.
+ * @return The decoded records.
+ */
+std::vector<Record> RoundTrip(const std::vector<Record>& records,
+                              const bool reference_based,
+                              const bool calq = false) {
+  Coders coders(calq);
+  auto au = Encode(records, reference_based, coders);
+
+  std::unique_ptr<genie::core::ReadDecoder> decoder;
+  if (reference_based) {
+    decoder = std::make_unique<genie::read::refcoder::Decoder>();
+    au.SetReference(Excerpt(records), {});
+  } else {
+    decoder = std::make_unique<genie::read::localassembly::Decoder>();
+  }
+  RecordSink sink;
+  coders.Attach(*decoder);
+  decoder->SetDrain(&sink);
+  decoder->FlowIn(std::move(au), {0, records.size(), false});
+  return std::move(sink.records);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Checks that the sequence and alignment of every segment survived.
+ * Local assembly codes mismatches against its own reference, so unspliced
+ * e-CIGARs are only compared for the reference-based coder.
+ * @param decoded Decoded records.
+ * @param records Original records.
+ * @param reference_based Records were coded against the reference.
+ * @param exact_qualities Quality values were coded losslessly.
+ */
+void ExpectSameAlignments(const std::vector<Record>& decoded,
+                          const std::vector<Record>& records,
+                          const bool reference_based,
+                          const bool exact_qualities = true) {
+  const auto expect_same_cigar = [&](const std::string& dec,
+                                     const std::string& rec,
+                                     const std::string& name) {
+    if (reference_based || rec.find_first_of("*/%") != std::string::npos) {
+      EXPECT_EQ(dec, rec) << name;
+    }
+  };
+  ASSERT_EQ(decoded.size(), records.size());
+  for (size_t i = 0; i < records.size(); ++i) {
+    const auto& rec = records[i];
+    const auto& dec = decoded[i];
+    EXPECT_EQ(dec.GetName(), rec.GetName());
+    ASSERT_EQ(dec.GetSegments().size(), rec.GetSegments().size());
+    for (size_t s = 0; s < rec.GetSegments().size(); ++s) {
+      const auto& segment = rec.GetSegments()[s];
+      const auto& dec_segment = dec.GetSegments()[s];
+      EXPECT_EQ(dec_segment.GetSequence(), segment.GetSequence())
+          << rec.GetName();
+      ASSERT_EQ(dec_segment.GetQualities().size(),
+                segment.GetQualities().size());
+      for (size_t q = 0; q < segment.GetQualities().size(); ++q) {
+        if (exact_qualities) {
+          EXPECT_EQ(dec_segment.GetQualities()[q], segment.GetQualities()[q])
+              << rec.GetName();
+        } else {
+          EXPECT_EQ(dec_segment.GetQualities()[q].size(),
+                    segment.GetQualities()[q].size())
+              << rec.GetName();
+        }
+      }
+    }
+    const auto& box = rec.GetAlignments().front();
+    const auto& dec_box = dec.GetAlignments().front();
+    EXPECT_EQ(dec_box.GetPosition(), box.GetPosition()) << rec.GetName();
+    expect_same_cigar(dec_box.GetAlignment().GetECigar(),
+                      box.GetAlignment().GetECigar(), rec.GetName());
+    if (rec.GetClassId() == ClassType::kClassHm ||
+        rec.GetSegments().size() < 2) {
+      continue;
+    }
+    const auto& split =
+        dynamic_cast<const genie::core::record::alignment_split::SameRec&>(
+            *box.GetAlignmentSplits().front());
+    const auto& dec_split =
+        dynamic_cast<const genie::core::record::alignment_split::SameRec&>(
+            *dec_box.GetAlignmentSplits().front());
+    EXPECT_EQ(dec_split.GetDelta(), split.GetDelta()) << rec.GetName();
+    expect_same_cigar(dec_split.GetAlignment().GetECigar(),
+                      split.GetAlignment().GetECigar(), rec.GetName());
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Builds single-end records of one class.
+ * @param type Record class.
+ * @param alignments Name, position and e-CIGAR of each record.
+ * @return The records.
+ */
+std::vector<Record> SingleEnd(
+    const ClassType type,
+    const std::vector<std::tuple<std::string, uint64_t, std::string>>&
+        alignments) {
+  std::vector<Record> ret;
+  for (const auto& [name, position, ecigar] : alignments) {
+    ret.push_back(core_tests::MakeMappedRecord(
+        type, position, Aligned(position, ecigar), 0, name));
+  }
+  return ret;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+TEST(LocalAssembly, longDeletionRoundTrip) {  // NOLINT(cert-err58-cpp)
+  // The deletion spans more reference than the assembly window of ten short
+  // reads would hold
+  const auto records = SingleEnd(ClassType::kClassI, {{"a", 100, "10="},
+                                                      {"b", 104, "6=3000-4="},
+                                                      {"c", 3108, "10="}});
+  ExpectSameAlignments(RoundTrip(records, false), records, false);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(ReadCoder, splicedSingleEndRoundTrip) {  // NOLINT(cert-err58-cpp)
+  const std::vector<std::pair<ClassType, std::vector<Record>>> classes = {
+      {ClassType::kClassP,
+       SingleEnd(ClassType::kClassP, {{"p0", 10, "20="},
+                                      {"p1", 15, "6=300*14="},
+                                      {"p2", 30, "4=40/8=1000%8="},
+                                      {"p3", 40, "20="}})},
+      {ClassType::kClassN,
+       SingleEnd(ClassType::kClassN, {{"n0", 10, "20="},
+                                      {"n1", 15, "3=N2=300*14="},
+                                      {"n2", 30, "4=40/7=N1000%8="}})},
+      {ClassType::kClassM,
+       SingleEnd(ClassType::kClassM, {{"m0", 10, "20="},
+                                      {"m1", 15, "3=A2=300*14="},
+                                      {"m2", 30, "4=40/7=C2000%8="}})},
+      {ClassType::kClassI,
+       SingleEnd(ClassType::kClassI, {{"i0", 10, "20="},
+                                      {"i1", 15, "4=2+3=100*2-5=(3)"},
+                                      {"i2", 20, "(2)5=50%1-5=G"},
+                                      {"i3", 25, "[2]5=3000/5=[4]"},
+                                      {"i4", 40, "3=2-10*5=4+7=20*3="}})}};
+  for (const auto& [type, records] : classes) {
+    for (const bool reference_based : {true, false}) {
+      SCOPED_TRACE(std::to_string(static_cast<int>(type)) +
+                   (reference_based ? " reference" : " local assembly"));
+      ExpectSameAlignments(RoundTrip(records, reference_based), records,
+                           reference_based);
+      ExpectSameAlignments(RoundTrip(records, reference_based, true), records,
+                           reference_based, false);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(ReadCoder, splicedPairedRoundTrip) {  // NOLINT(cert-err58-cpp)
+  for (const auto type : {ClassType::kClassM, ClassType::kClassI}) {
+    std::vector<Record> records;
+    records.push_back(core_tests::MakePairedRecord(
+        type, 100, Aligned(100, "10="), 200, Aligned(300, "5=60*5="), 0,
+        "second-spliced"));
+    records.push_back(core_tests::MakePairedRecord(
+        type, 120, Aligned(120, "4=30/6="), 150, Aligned(270, "10="), 0,
+        "first-spliced"));
+    records.push_back(core_tests::MakePairedRecord(
+        type, 130, Aligned(130, "3=500%7="), 900, Aligned(1030, "2=80*8="),
+        0, "both-spliced"));
+    records.push_back(core_tests::MakePairedRecord(
+        type, 140, Aligned(140, "10="), 100, Aligned(240, "10="), 0,
+        "unspliced"));
+    for (const bool reference_based : {true, false}) {
+      SCOPED_TRACE(std::to_string(static_cast<int>(type)) +
+                   (reference_based ? " reference" : " local assembly"));
+      ExpectSameAlignments(RoundTrip(records, reference_based), records,
+                           reference_based);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(ReadCoder, splicedHalfMappedRoundTrip) {  // NOLINT(cert-err58-cpp)
+  const std::vector<Record> records = {HalfMapped("hm0", 10, "20="),
+                                       HalfMapped("hm1", 15, "6=300*14="),
+                                       HalfMapped("hm2", 20, "4=40%6=")};
+  // Gabac refuses class HM with local assembly
+  ExpectSameAlignments(RoundTrip(records, true), records, true);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(ReadCoder, msarOnlyWithSplices) {  // NOLINT(cert-err58-cpp)
+  Coders coders(false);
+  const auto unspliced = Encode(
+      SingleEnd(ClassType::kClassI, {{"a", 10, "20="}, {"b", 15, "5=2-15="}}),
+      true, coders);
+  EXPECT_FALSE(unspliced.GetParameters().IsSplicedReads());
+  EXPECT_TRUE(
+      unspliced.Get(genie::core::GenDesc::kMultiSegmentAlignment).IsEmpty());
+
+  const auto spliced = Encode(
+      SingleEnd(ClassType::kClassI, {{"a", 10, "20="}, {"b", 15, "5=20*15="}}),
+      true, coders);
+  EXPECT_TRUE(spliced.GetParameters().IsSplicedReads());
+  EXPECT_FALSE(
+      spliced.Get(genie::core::GenDesc::kMultiSegmentAlignment).IsEmpty());
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,163 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/util/zlib/bgzf.h"
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+uint32_t GetLittleEndian(const std::string_view data, const size_t pos,
+                         const size_t bytes) {
+  uint32_t value = 0;
+  for (size_t i = 0; i < bytes; ++i) {
+    value |= static_cast<uint32_t>(static_cast<uint8_t>(data[pos + i]))
+             << (8 * i);
+  }
+  return value;
+}
+
+// -----------------------------------------------------------------------------
+
+struct Block {
+  std::string data;  // Inflated payload
+  size_t size;       // Size of the compressed block
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Splits a BGZF stream into blocks, checking the header, the BSIZE
+ * extra field and the footer of each.
+ */
+std::vector<Block> ReadBlocks(std::string_view in) {
+  std::vector<Block> blocks;
+  while (!in.empty()) {
+    EXPECT_GE(in.size(), 18u + 8u);
+    EXPECT_EQ(static_cast<uint8_t>(in[0]), 0x1f);
+    EXPECT_EQ(static_cast<uint8_t>(in[1]), 0x8b);
+    EXPECT_EQ(in[3], 4);  // FEXTRA
+    EXPECT_EQ(GetLittleEndian(in, 10, 2), 6u);
+    EXPECT_EQ(in.substr(12, 2), "BC");
+    EXPECT_EQ(GetLittleEndian(in, 14, 2), 2u);
+    const size_t size = GetLittleEndian(in, 16, 2) + 1;
+    EXPECT_LE(size, in.size());
+    if (size > in.size()) {
+      return blocks;
+    }
+
+    Block block{std::string(GetLittleEndian(in, size - 4, 4), '\0'), size};
+    z_stream stream{};
+    EXPECT_EQ(inflateInit2(&stream, -15), Z_OK);
+    stream.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(in.data() + 18));  // NOLINT
+    stream.avail_in = static_cast<uInt>(size - 18 - 8);
+    stream.next_out = reinterpret_cast<Bytef*>(block.data.data());  // NOLINT
+    stream.avail_out = static_cast<uInt>(block.data.size());
+    EXPECT_EQ(inflate(&stream, Z_FINISH), Z_STREAM_END);
+    EXPECT_EQ(stream.avail_out, 0u);
+    inflateEnd(&stream);
+
+    const auto crc = crc32(
+        crc32(0, nullptr, 0),
+        reinterpret_cast<const Bytef*>(block.data.data()),  // NOLINT
+        static_cast<uInt>(block.data.size()));
+    EXPECT_EQ(GetLittleEndian(in, size - 8, 4), static_cast<uint32_t>(crc));
+
+    blocks.push_back(std::move(block));
+    in.remove_prefix(size);
+  }
+  return blocks;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+TEST(Bgzf, SplitsAtBlockLimit) {  // NOLINT(cert-err58-cpp)
+  // Random bytes do not compress, so the blocks come close to the size limit
+  std::mt19937 rng(7);
+  std::string data(3 * genie::util::zlib::kBgzfBlockSize + 123, '\0');
+  for (auto& c : data) {
+    c = static_cast<char>(rng());
+  }
+  std::string out;
+  genie::util::zlib::CompressBgzf(data, out);
+
+  const auto blocks = ReadBlocks(out);
+  ASSERT_EQ(blocks.size(), 4u);
+  std::string joined;
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    EXPECT_EQ(blocks[i].data.size(),
+              i < 3 ? genie::util::zlib::kBgzfBlockSize : 123);
+    EXPECT_LE(blocks[i].size, 0x10000u);
+    joined += blocks[i].data;
+  }
+  EXPECT_EQ(joined, data);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(Bgzf, AppendsAndConcatenates) {  // NOLINT(cert-err58-cpp)
+  std::string out = "prefix";
+  genie::util::zlib::CompressBgzf("ACGT\n", out);
+  genie::util::zlib::CompressBgzf("", out);
+  genie::util::zlib::CompressBgzf(std::string(100000, 'N'), out, 9);
+  ASSERT_EQ(out.substr(0, 6), "prefix");
+
+  const auto blocks = ReadBlocks(std::string_view(out).substr(6));
+  ASSERT_EQ(blocks.size(), 3u);
+  EXPECT_EQ(blocks[0].data, "ACGT\n");
+  EXPECT_EQ(blocks[1].data + blocks[2].data, std::string(100000, 'N'));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(Bgzf, EofBlock) {  // NOLINT(cert-err58-cpp)
+  const auto eof = genie::util::zlib::BgzfEofBlock();
+  ASSERT_EQ(eof.size(), 28u);
+
+  const auto blocks = ReadBlocks(eof);
+  ASSERT_EQ(blocks.size(), 1u);
+  EXPECT_EQ(blocks[0].size, 28u);
+  EXPECT_TRUE(blocks[0].data.empty());
+
+  // A complete file, read back by a plain gzip decoder
+  std::string file;
+  genie::util::zlib::CompressBgzf("@r\nACGT\n+\nIIII\n", file);
+  file += eof;
+  std::string inflated;
+  z_stream stream{};
+  ASSERT_EQ(inflateInit2(&stream, 15 + 16), Z_OK);
+  stream.next_in = reinterpret_cast<Bytef*>(file.data());  // NOLINT
+  stream.avail_in = static_cast<uInt>(file.size());
+  char buffer[256];
+  while (stream.avail_in) {
+    stream.next_out = reinterpret_cast<Bytef*>(buffer);  // NOLINT
+    stream.avail_out = sizeof(buffer);
+    const int ret = inflate(&stream, Z_NO_FLUSH);
+    ASSERT_TRUE(ret == Z_OK || ret == Z_STREAM_END);
+    inflated.append(buffer, sizeof(buffer) - stream.avail_out);
+    if (ret == Z_STREAM_END) {
+      inflateReset(&stream);
+    }
+  }
+  inflateEnd(&stream);
+  EXPECT_EQ(inflated, "@r\nACGT\n+\nIIII\n");
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>  // NOLINT
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "genie/format/sam/coordinate_sorter.h"
+
+namespace genie::format::sam {
+
+namespace {
+
+SamRecord MakeRecord(const std::string& name, const int32_t rid,
+                     const uint32_t pos, const uint16_t flag) {
+  SamRecord rec;
+  rec.qname_ = name;
+  rec.flag_ = flag;
+  rec.rid_ = rid;
+  rec.pos_ = pos;
+  rec.mapq_ = 60;
+  rec.cigar_ = SamRecord::ParseCigar("4M");
+  rec.mate_rid_ = rid;
+  rec.mate_pos_ = pos;
+  rec.seq_ = "ACGT";
+  rec.qual_ = "IIII";
+  return rec;
+}
+
+}  // namespace
+
+TEST(CoordinateSorter, SortsThroughSpilledRuns) {  // NOLINT(cert-err58-cpp)
+  const auto base =
+      (std::filesystem::temp_directory_path() / "genie_coord_sort_").string();
+  // Budget for only a few records per run, so most of them are spilled
+  CoordinateSorter sorter(
+      base, 3 * CoordinateSorter::GetMemorySize(MakeRecord("r000", 0, 0, 0)),
+      2);
+
+  constexpr int kReads = 100;
+  for (int i = 0; i < kReads; ++i) {
+    const auto name = "r" + std::to_string(1000 + i);
+    const int32_t rid = i % 3 == 0 ? -1 : i % 2;
+    sorter.Add(MakeRecord(name, rid, static_cast<uint32_t>((i * 7) % 13), 1));
+  }
+  sorter.Finish();
+
+  std::vector<SamRecord> sorted;
+  while (const auto* next = sorter.Peek()) {
+    const auto name = next->qname_;
+    sorted.emplace_back(sorter.Get());
+    EXPECT_EQ(sorted.back().qname_, name);
+  }
+
+  ASSERT_EQ(sorted.size(), static_cast<size_t>(kReads));
+  for (size_t i = 1; i < sorted.size(); ++i) {
+    const auto& a = sorted[i - 1];
+    const auto& b = sorted[i];
+    const auto rid_a = static_cast<uint32_t>(a.rid_);
+    const auto rid_b = static_cast<uint32_t>(b.rid_);
+    EXPECT_TRUE(rid_a < rid_b || (rid_a == rid_b && a.pos_ <= b.pos_));
+  }
+  EXPECT_EQ(sorted.back().rid_, -1);
+  EXPECT_EQ(sorted.front().GetCigar(), "4M");
+  EXPECT_EQ(sorted.front().seq_, "ACGT");
+  EXPECT_EQ(sorted.front().qual_, "IIII");
+}
+
+TEST(CoordinateSorter, MergesMoreRunsThanFanIn) {  // NOLINT(cert-err58-cpp)
+  const auto base =
+      (std::filesystem::temp_directory_path() / "genie_coord_fan_in_")
+          .string();
+  // One record per run, merged four at a time
+  CoordinateSorter sorter(
+      base, CoordinateSorter::GetMemorySize(MakeRecord("r000", 0, 0, 0)), 1,
+      4);
+
+  constexpr int kReads = 50;
+  for (int i = 0; i < kReads; ++i) {
+    auto rec = MakeRecord("r" + std::to_string(1000 + i), 0,
+                          static_cast<uint32_t>((i * 17) % kReads), 1);
+    rec.seq_ = i % 2 ? "ACGTN" : "acgtx";
+    rec.qual_ = "IIII#";
+    rec.cigar_ = SamRecord::ParseCigar("2S3M");
+    rec.ParseOptionalField("NM:i:" + std::to_string(i));
+    sorter.Add(std::move(rec));
+  }
+  sorter.Finish();
+
+  for (int i = 0; i < kReads; ++i) {
+    ASSERT_NE(sorter.Peek(), nullptr);
+    const auto rec = sorter.Get();
+    EXPECT_EQ(rec.pos_, static_cast<uint32_t>(i));
+    const int index = std::stoi(rec.qname_.substr(1)) - 1000;
+    EXPECT_EQ((index * 17) % kReads, i);
+    EXPECT_EQ(rec.seq_, index % 2 ? "ACGTN" : "acgtx");
+    EXPECT_EQ(rec.qual_, "IIII#");
+    EXPECT_EQ(rec.GetCigar(), "2S3M");
+    ASSERT_EQ(rec.optional_fields_.size(), 1u);
+    EXPECT_EQ(rec.optional_fields_.front().tag, "NM:i");
+    EXPECT_EQ(rec.optional_fields_.front().value, std::to_string(index));
+  }
+  EXPECT_EQ(sorter.Peek(), nullptr);
+}
+
+TEST(CoordinateSorter, UnmappedMatesStayAdjacent) {  // NOLINT(cert-err58-cpp)
+  const auto base =
+      (std::filesystem::temp_directory_path() / "genie_coord_unmapped_")
+          .string();
+  CoordinateSorter sorter(base, 0, 1);
+  sorter.Add(MakeRecord("b", -1, 0xffffffff, 0x8D));
+  sorter.Add(MakeRecord("a", -1, 0xffffffff, 0x4D));
+  sorter.Add(MakeRecord("b", -1, 0xffffffff, 0x4D));
+  sorter.Add(MakeRecord("a", -1, 0xffffffff, 0x8D));
+  sorter.Finish();
+
+  std::vector<std::string> names;
+  while (sorter.Peek() != nullptr) {
+    names.push_back(sorter.Get().qname_);
+  }
+  EXPECT_EQ(names, (std::vector<std::string>{"a", "a", "b", "b"}));
+}
+
+}  // namespace genie::format::sam
@@ -0,0 +1,72 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/util/memory_budget.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <thread>  // NOLINT
+#include <utility>
+
+// -----------------------------------------------------------------------------
+
+TEST(MemoryBudget, ReservationsReturnBytes) {  // NOLINT(cert-err58-cpp)
+  genie::util::MemoryBudget budget(100);
+  {
+    auto a = budget.Reserve(40);
+    auto b = budget.Reserve(30, true);
+    EXPECT_EQ(budget.GetUsed(), 70);
+    a.Merge(std::move(b));
+    EXPECT_EQ(a.GetBytes(), 70);
+    EXPECT_EQ(b.GetBytes(), 0);
+    a.Grow(10);
+    genie::util::MemoryBudget::Reservation c = std::move(a);
+    EXPECT_EQ(budget.GetUsed(), 80);
+  }
+  EXPECT_EQ(budget.GetUsed(), 0);
+  EXPECT_EQ(budget.GetPeak(), 80);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(MemoryBudget, PinnedBytesDoNotExhaust) {  // NOLINT(cert-err58-cpp)
+  genie::util::MemoryBudget budget(100);
+  auto pinned = budget.Reserve(150, true);
+  EXPECT_FALSE(budget.IsExhausted());
+  auto in_flight = budget.Reserve(10);
+  EXPECT_TRUE(budget.IsExhausted());
+  pinned.SetPinned(false);
+  EXPECT_TRUE(budget.IsExhausted());
+  pinned.Release();
+  EXPECT_FALSE(budget.IsExhausted());
+
+  genie::util::MemoryBudget unlimited;
+  auto large = unlimited.Reserve(1000);
+  EXPECT_FALSE(unlimited.IsExhausted());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(MemoryBudget, WaitForSpaceBlocksUntilRelease) {  // NOLINT(cert-err58-cpp)
+  genie::util::MemoryBudget budget(100);
+  auto reservation = budget.Reserve(100);
+  std::atomic<bool> done{false};
+  std::thread waiter([&] {
+    budget.WaitForSpace();
+    done = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_FALSE(done);
+  reservation.Release();
+  waiter.join();
+  EXPECT_TRUE(done);
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <filesystem>  // NOLINT
 #include <fstream>
 #include <optional>
 #include <sstream>
@@ -100,3 +101,64 @@ TEST_F(MergeSortBuilderTest, EmptyBuilderTest) {
 
   EXPECT_TRUE(merger.IsEmpty());
 }
+
+// Test spilling chunks in the background and moving the merger
+TEST_F(MergeSortBuilderTest, ParallelSpillTest) {
+  BuilderType builder(7, temp_file_base_name_ + "_parallel", MockReadRecord,
+                      MockWriteRecord, MockSortFunction, 3);
+
+  std::vector<int> expected;
+  for (int i = 0; i < 200; ++i) {
+    const int value = (i * 37) % 101;
+    builder.AddRecord(value);
+    expected.push_back(value);
+  }
+  std::sort(expected.begin(), expected.end());
+
+  auto merger = builder.Finish(false);
+  auto moved = std::move(merger);
+
+  std::vector<int> result;
+  while (!moved.IsEmpty()) {
+    const int top = moved.Top();
+    result.push_back(moved.Get());
+    EXPECT_EQ(result.back(), top);
+  }
+
+  EXPECT_EQ(result, expected);
+}
+
+// Test merging more chunks than the fan-in in several passes
+TEST_F(MergeSortBuilderTest, MaxFanInTest) {
+  const std::string base = temp_file_base_name_ + "_fan_in_";
+  auto count_files = [&base]() {
+    size_t ret = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(".")) {
+      ret += entry.path().filename().string().rfind(base, 0) == 0;
+    }
+    return ret;
+  };
+
+  std::vector<int> expected;
+  {
+    BuilderType builder(5, base, MockReadRecord, MockWriteRecord,
+                        MockSortFunction, 1, 3);
+    for (int i = 0; i < 203; ++i) {
+      const int value = (i * 53) % 97;
+      builder.AddRecord(value);
+      expected.push_back(value);
+    }
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(count_files(), 40u);
+
+    auto merger = builder.Finish(true);
+    EXPECT_EQ(count_files(), 3u);
+
+    std::vector<int> result;
+    while (!merger.IsEmpty()) {
+      result.push_back(merger.Get());
+    }
+    EXPECT_EQ(result, expected);
+  }
+  EXPECT_EQ(count_files(), 0u);
+}
@@ -0,0 +1,43 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/util/object_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <utility>
+
+// -----------------------------------------------------------------------------
+
+TEST(ObjectPool, ObjectsAreReused) {  // NOLINT(cert-err58-cpp)
+  int created = 0;
+  genie::util::ObjectPool<int> pool([&created] {
+    return std::make_unique<int>(created++);
+  });
+  const int* first = nullptr;
+  {
+    auto lease = pool.Acquire();
+    first = &*lease;
+    EXPECT_EQ(*lease, 0);
+    EXPECT_EQ(pool.GetAvailable(), 0);
+  }
+  EXPECT_EQ(pool.GetAvailable(), 1);
+  {
+    auto lease = pool.Acquire();
+    EXPECT_EQ(&*lease, first);
+    auto other = pool.Acquire();
+    EXPECT_EQ(*other, 1);
+    auto moved = std::move(other);
+    EXPECT_EQ(pool.GetAvailable(), 0);
+  }
+  EXPECT_EQ(pool.GetAvailable(), 2);
+  EXPECT_EQ(created, 2);
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
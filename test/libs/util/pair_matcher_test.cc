@@ -1,5 +1,9 @@
 #include "../../../src/genie/format/sam/pair_matcher.h"
 
+#include <limits>
+#include <string>
+#include <utility>
+
 #include "genie/format/sam/sam_record.h"
 #include "gtest/gtest.h"
 
@@ -113,4 +117,30 @@ TEST_F(PairMatcherTest, AbandonAndRetrieveLowestPosition) {
   EXPECT_EQ(matcher_.GetLowestUnmatchedPosition(), 20);
 }
 
+TEST_F(PairMatcherTest, MatchAmongManyAtSameLocus) {
+  constexpr int kReads = 1000;
+  for (int i = 0; i < kReads; ++i) {
+    SamRecord record;
+    record.qname_ = "read" + std::to_string(i);
+    record.pos_ = 10;
+    record.mate_pos_ = 15;
+    matcher_.AddUnmatchedRead(std::move(record));
+  }
+
+  for (int i = kReads - 1; i >= 0; --i) {
+    SamRecord mate;
+    mate.qname_ = "read" + std::to_string(i);
+    mate.pos_ = 15;
+    mate.mate_pos_ = 10;
+    auto found = matcher_.Match(mate);
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(found->qname_, mate.qname_);
+    EXPECT_FALSE(matcher_.Match(mate).has_value());
+  }
+
+  EXPECT_EQ(matcher_.GetLowestUnmatchedPosition(),
+            std::numeric_limits<uint64_t>::max());
+  EXPECT_TRUE(matcher_.Abandon(100).empty());
+}
+
 }  // namespace genie::format::sam::sam_to_mgrec
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/util/reorder_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>  // NOLINT
+#include <random>
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <vector>
+
+// -----------------------------------------------------------------------------
+
+TEST(ReorderBuffer, ConsumesInSectionOrder) {  // NOLINT(cert-err58-cpp)
+  constexpr size_t num_sections = 200;
+  std::vector<size_t> consumed;
+  genie::util::ReorderBuffer<size_t> buffer(
+      [&](size_t&& v) { consumed.push_back(v); }, 4);
+
+  // Like pipeline workers, each producer owns one section at a time and
+  // finishes it after a random delay. Skipped sections carry no item.
+  std::vector<std::thread> producers;
+  constexpr size_t num_producers = 8;
+  for (size_t p = 0; p < num_producers; ++p) {
+    producers.emplace_back([&, p] {
+      std::mt19937 rng(static_cast<unsigned>(p));
+      std::uniform_int_distribution<int> delay(0, 500);
+      for (size_t i = p; i < num_sections; i += num_producers) {
+        std::this_thread::sleep_for(std::chrono::microseconds(delay(rng)));
+        const genie::util::Section section{i, 1, false};
+        if (i % 10 == 3) {
+          buffer.Skip(section);
+        } else {
+          buffer.Push(size_t{i}, section);
+        }
+      }
+    });
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  buffer.Flush();
+
+  std::vector<size_t> expected;
+  for (size_t i = 0; i < num_sections; ++i) {
+    if (i % 10 != 3) {
+      expected.push_back(i);
+    }
+  }
+  EXPECT_EQ(consumed, expected);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(ReorderBuffer, ForwardsConsumerErrors) {  // NOLINT(cert-err58-cpp)
+  genie::util::ReorderBuffer<int> buffer(
+      [](int&&) { throw std::runtime_error("write failed"); });
+  buffer.Push(1, {0, 1, false});
+  EXPECT_THROW(buffer.Flush(), std::runtime_error);
+  EXPECT_THROW(buffer.Push(2, {1, 1, false}), std::runtime_error);
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "genie/format/sam/sam_record.h"
+
+namespace genie::format::sam {
+
+namespace {
+
+/**
+ * @brief Packs a record into the BAM memory layout.
+ */
+class BamRecord {
+  std::vector<uint8_t> data_;
+  bam1_t rec_{};
+
+ public:
+  BamRecord(const std::string& qname, const std::vector<uint32_t>& cigar,
+            const std::string& seq, const std::vector<uint8_t>& qual) {
+    static const std::string kBases = "=ACMGRSVTWYHKDBN";
+    data_.insert(data_.end(), qname.begin(), qname.end());
+    data_.push_back(0);
+    const auto* cigar_bytes = reinterpret_cast<const uint8_t*>(cigar.data());
+    data_.insert(data_.end(), cigar_bytes, cigar_bytes + cigar.size() * 4);
+    for (size_t i = 0; i < seq.size(); i += 2) {
+      uint8_t byte = static_cast<uint8_t>(kBases.find(seq[i]) << 4);
+      if (i + 1 < seq.size()) {
+        byte |= static_cast<uint8_t>(kBases.find(seq[i + 1]));
+      }
+      data_.push_back(byte);
+    }
+    data_.insert(data_.end(), qual.begin(), qual.end());
+    rec_.data = data_.data();
+    rec_.l_data = static_cast<int>(data_.size());
+    rec_.core.l_qname = static_cast<uint16_t>(qname.size() + 1);
+    rec_.core.n_cigar = static_cast<uint32_t>(cigar.size());
+    rec_.core.l_qseq = static_cast<int32_t>(seq.size());
+    rec_.core.pos = 99;
+    rec_.core.qual = 60;
+  }
+
+  [[nodiscard]] const bam1_t* Get() const { return &rec_; }
+};
+
+}  // namespace
+
+TEST(SamRecord, FromBam) {  // NOLINT(cert-err58-cpp)
+  const std::vector<uint32_t> cigar = {bam_cigar_gen(2, BAM_CSOFT_CLIP),
+                                       bam_cigar_gen(3, BAM_CMATCH),
+                                       bam_cigar_gen(1, BAM_CDIFF),
+                                       bam_cigar_gen(1, BAM_CINS)};
+  const BamRecord bam("read1", cigar, "ACGTNCG", {0, 10, 20, 30, 40, 2, 3});
+  const SamRecord rec(bam.Get());
+  EXPECT_EQ(rec.GetQname(), "read1");
+  EXPECT_EQ(rec.GetPos(), 99u);
+  EXPECT_EQ(rec.GetMapq(), 60);
+  EXPECT_EQ(rec.GetSeq(), "ACGTNCG");
+  EXPECT_EQ(rec.GetQual(), "!+5?I#$");
+  EXPECT_EQ(rec.GetCigar(), "2S3M1X1I");
+  EXPECT_EQ(rec.GetECigar(), "(2)3=C1+");
+}
+
+TEST(SamRecord, OddSequenceLength) {  // NOLINT(cert-err58-cpp)
+  const BamRecord bam("r", {bam_cigar_gen(3, BAM_CMATCH)}, "GTA", {1, 2, 3});
+  const SamRecord rec(bam.Get());
+  EXPECT_EQ(rec.GetSeq(), "GTA");
+  EXPECT_EQ(rec.GetQual(), "\"#$");
+}
+
+TEST(SamRecord, TextAndBinaryCigarAgree) {  // NOLINT(cert-err58-cpp)
+  const std::string seq = "ACGTACGTACGTACGTACGT";
+  for (const std::string cigar :
+       {"20M", "5S10M5S", "3H4M2D8M2I6M3H", "2=1X17=", "10M100N10M", "*"}) {
+    const auto ops = SamRecord::ParseCigar(cigar);
+    EXPECT_EQ(SamRecord::CigarToString(ops), cigar == "*" ? "" : cigar);
+    EXPECT_EQ(SamRecord::ConvertCigar2ECigar(ops, seq),
+              SamRecord::ConvertCigar2ECigar(cigar, seq));
+  }
+  EXPECT_EQ(SamRecord::ConvertCigar2ECigar("3H4M2D8M2I6M3H", seq),
+            "[3]4=2-8=2+6=[3]");
+  EXPECT_ANY_THROW(SamRecord::ParseCigar("10"));
+  EXPECT_ANY_THROW(SamRecord::ParseCigar("M"));
+  EXPECT_ANY_THROW(SamRecord::ParseCigar("10Q"));
+}
+
+}  // namespace genie::format::sam
@@ -0,0 +1,58 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include "genie/util/sha256.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+std::string Hash(const std::string& data) {
+  genie::util::Sha256 sha;
+  sha.Update(data.data(), data.size());
+  return sha.FinishHex();
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+TEST(Sha256, KnownVectors) {  // NOLINT(cert-err58-cpp)
+  EXPECT_EQ(Hash(""),
+            "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  EXPECT_EQ(Hash("abc"),
+            "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  EXPECT_EQ(Hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+            "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+  EXPECT_EQ(Hash(std::string(1000000, 'a')),
+            "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(Sha256, IncrementalUpdates) {  // NOLINT(cert-err58-cpp)
+  std::string data;
+  for (size_t i = 0; i < 1000; ++i) {
+    data += static_cast<char>("ACGTN"[(i * 7) % 5]);
+  }
+  const auto expected = Hash(data);
+  for (const size_t step : {1, 3, 63, 64, 65, 200}) {
+    genie::util::Sha256 sha;
+    for (size_t pos = 0; pos < data.size(); pos += step) {
+      sha.Update(data.data() + pos, std::min(step, data.size() - pos));
+    }
+    EXPECT_EQ(sha.FinishHex(), expected) << "step " << step;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2018-2024 The Genie Authors.
+ * @file
+ * @copyright This file is part of Genie. See LICENSE and/or
+ * https://github.com/MueFab/genie for more details.
+ */
+
+#include <genie/util/trace.h>
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT
+
+#include "nlohmann/json.hpp"
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+nlohmann::json WriteTrace() {
+  std::stringstream stream;
+  genie::util::Tracer::Write(stream);
+  return nlohmann::json::parse(stream.str());
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+TEST(TraceTest, NestedScopesInheritAccessUnit) {  // NOLINT(cert-err58-cpp)
+  genie::util::Tracer::Clear();
+  genie::util::Tracer::SetEnabled(true);
+  {
+    genie::util::TraceScope outer("flow-in", "read-coding", 42);
+    { genie::util::TraceScope inner("rlen", "entropy"); }
+  }
+  { genie::util::TraceScope untagged("pump", "import"); }
+  genie::util::Tracer::SetEnabled(false);
+  { genie::util::TraceScope ignored("pump", "import"); }
+
+  const auto trace = WriteTrace();
+  std::map<std::string, nlohmann::json> spans;
+  for (const auto& e : trace["traceEvents"]) {
+    if (e["ph"] == "X") {
+      EXPECT_EQ(spans.count(e["name"]), 0u);
+      spans[e["name"]] = e;
+    }
+  }
+  ASSERT_EQ(spans.size(), 3u);
+  EXPECT_EQ(spans["flow-in"]["args"]["au"], 42);
+  EXPECT_EQ(spans["rlen"]["args"]["au"], 42);
+  EXPECT_EQ(spans["rlen"]["cat"], "entropy");
+  EXPECT_EQ(spans["pump"].count("args"), 0u);
+  EXPECT_GE(spans["rlen"]["ts"].get<double>(),
+            spans["flow-in"]["ts"].get<double>());
+  EXPECT_LE(spans["rlen"]["dur"].get<double>(),
+            spans["flow-in"]["dur"].get<double>());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(TraceTest, ThreadsGetOwnTimeline) {  // NOLINT(cert-err58-cpp)
+  genie::util::Tracer::Clear();
+  genie::util::Tracer::SetEnabled(true);
+  auto work = [] { genie::util::TraceScope scope("work", "test", 1); };
+  std::thread a(work);
+  std::thread b(work);
+  a.join();
+  b.join();
+  genie::util::Tracer::SetEnabled(false);
+
+  const auto trace = WriteTrace();
+  std::set<int64_t> tids;
+  for (const auto& e : trace["traceEvents"]) {
+    if (e["ph"] == "X") {
+      tids.insert(e["tid"].get<int64_t>());
+    }
+  }
+  EXPECT_EQ(tids.size(), 2u);
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------